@@ -0,0 +1,171 @@
+#ifndef SPINNER_CACHEFILE_H
+#define SPINNER_CACHEFILE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+// Tools for content-addressed on-disk caches (SpaceCache, SpectrumCache).
+// Every entry is one binary file, whose name is the hash of the key.
+namespace common::cache {
+
+// FNV-1a hash, it does not depend on the implementation of std::hash:
+inline uint64_t stableHash(const std::string& string) {
+    uint64_t hash = UINT64_C(14695981039346656037);
+    for (unsigned char c : string) {
+        hash ^= c;
+        hash *= UINT64_C(1099511628211);
+    }
+    return hash;
+}
+
+inline std::filesystem::path
+pathOfEntry(const std::filesystem::path& directory, const std::string& key, const std::string& extension) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx", (unsigned long long)stableHash(key));
+    return directory / (name + extension);
+}
+
+inline uint64_t alignTo8(uint64_t offset) {
+    return (offset + 7) / 8 * 8;
+}
+
+inline void writePaddingTo8(std::ofstream& stream) {
+    const char zeros[8] = {};
+    uint64_t position = stream.tellp();
+    stream.write(zeros, alignTo8(position) - position);
+}
+
+// Read-only memory mapping of the whole file, it is unmapped in the destructor.
+// data() is nullptr, if the file cannot be mapped.
+class MappedFile {
+  public:
+    explicit MappedFile(const std::filesystem::path& path) {
+        int file_descriptor = open(path.c_str(), O_RDONLY);
+        if (file_descriptor < 0) {
+            return;
+        }
+        struct stat file_status;
+        if (fstat(file_descriptor, &file_status) == 0 && file_status.st_size > 0) {
+            void* data = mmap(nullptr, file_status.st_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+            if (data != MAP_FAILED) {
+                data_ = static_cast<const char*>(data);
+                size_ = file_status.st_size;
+            }
+        }
+        close(file_descriptor);
+    }
+    ~MappedFile() {
+        if (data_ != nullptr) {
+            munmap(const_cast<char*>(data_), size_);
+        }
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const {
+        return data_;
+    }
+    uint64_t size() const {
+        return size_;
+    }
+    // checks that [offset, offset + size) is inside the file:
+    bool contains(uint64_t offset, uint64_t size) const {
+        return offset <= size_ && size <= size_ - offset;
+    }
+    // checks that array of number T starting from offset is aligned and inside the file:
+    template <typename T>
+    bool containsArray(uint64_t offset, uint64_t number) const {
+        return offset % alignof(T) == 0 && number <= size_ / sizeof(T) && contains(offset, number * sizeof(T));
+    }
+
+  private:
+    const char* data_ = nullptr;
+    uint64_t size_ = 0;
+};
+
+// The entry is written to the temporary file and renamed,
+// so other processes never read the partially written entry.
+// Returns false, if the entry cannot be written.
+inline bool writeEntry(const std::filesystem::path& path, const std::function<void(std::ofstream&)>& write) {
+    auto temporary_path = path;
+    temporary_path += ".tmp" + std::to_string(getpid());
+    std::error_code error_code;
+    {
+        std::ofstream stream(temporary_path, std::ios::binary | std::ios::trunc);
+        write(stream);
+        if (!stream) {
+            stream.close();
+            std::filesystem::remove(temporary_path, error_code);
+            return false;
+        }
+    }
+    std::filesystem::rename(temporary_path, path, error_code);
+    if (error_code) {
+        std::filesystem::remove(temporary_path, error_code);
+        return false;
+    }
+    return true;
+}
+
+inline void markAsRecentlyUsed(const std::filesystem::path& path) {
+    std::error_code error_code;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error_code);
+}
+
+// Removes the least recently used entries with the extension,
+// until their total size is not bigger than size_limit:
+inline void removeLeastRecentlyUsedEntries(
+    const std::filesystem::path& directory,
+    const std::string& extension,
+    uintmax_t size_limit) {
+    struct Entry {
+        std::filesystem::file_time_type last_use;
+        uintmax_t size;
+        std::filesystem::path path;
+    };
+    std::vector<Entry> entries;
+    uintmax_t total_size = 0;
+    std::error_code error_code;
+    for (const auto& directory_entry : std::filesystem::directory_iterator(directory, error_code)) {
+        if (!directory_entry.is_regular_file(error_code) || directory_entry.path().extension() != extension) {
+            continue;
+        }
+        Entry entry {
+            directory_entry.last_write_time(error_code),
+            directory_entry.file_size(error_code),
+            directory_entry.path()};
+        if (error_code) {
+            continue;
+        }
+        total_size += entry.size;
+        entries.push_back(std::move(entry));
+    }
+    if (total_size <= size_limit) {
+        return;
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.last_use < b.last_use;
+    });
+    for (const auto& entry : entries) {
+        if (total_size <= size_limit) {
+            break;
+        }
+        if (std::filesystem::remove(entry.path, error_code)) {
+            total_size -= entry.size;
+        }
+    }
+}
+
+}  // namespace common::cache
+
+#endif  //SPINNER_CACHEFILE_H
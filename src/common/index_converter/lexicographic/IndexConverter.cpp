@@ -1,9 +1,34 @@
 #include "IndexConverter.h"
 #include <functional>
 #include <numeric>
+#include "src/common/MumxHash.h"
 #include "src/common/PrintingFunctions.h"
 #include "src/common/index_converter/AbstractIndexConverter.h"
 
+namespace {
+// Division of 32-bit numbers by multiplication, see D. Lemire, O. Kaser, N. Kurz,
+// "Faster remainder by direct computation" (2019). The reciprocal of one is zero.
+uint64_t reciprocal(uint32_t divisor) {
+    return divisor == 1 ? 0 : UINT64_C(0xFFFFFFFFFFFFFFFF) / divisor + 1;
+}
+
+uint32_t divide(uint32_t numerator, uint32_t divisor, uint64_t reciprocal) {
+    if (divisor == 1) {
+        return numerator;
+    }
+    uint64_t high;
+    ankerl::umul128(reciprocal, numerator, &high);
+    return high;
+}
+
+uint32_t modulo(uint32_t numerator, uint32_t divisor, uint64_t reciprocal) {
+    uint64_t lowbits = reciprocal * numerator;
+    uint64_t high;
+    ankerl::umul128(lowbits, divisor, &high);
+    return high;
+}
+}  // namespace
+
 namespace index_converter::lexicographic {
 
 IndexConverter::IndexConverter(std::vector<spin_algebra::Multiplicity> mults) :
@@ -16,6 +41,12 @@ IndexConverter::IndexConverter(std::vector<spin_algebra::Multiplicity> mults) :
         get_mults().rend(),
         cumulative_product_.rbegin() + 1,
         std::multiplies<>());
+    for (auto value : cumulative_product_) {
+        reciprocals_of_cumulative_product_.push_back(reciprocal(value));
+    }
+    for (auto mult : get_mults()) {
+        reciprocals_of_mults_.push_back(reciprocal(mult));
+    }
     common::lexIndexConverterPrint(*this);
 }
 
@@ -30,7 +61,28 @@ std::vector<uint8_t> IndexConverter::convert_lex_index_to_all_sz_projections(uin
 uint8_t IndexConverter::convert_lex_index_to_one_sz_projection(
     uint32_t lex,
     uint32_t center) const {
-    return (lex % cumulative_product_[center]) / cumulative_product_[center + 1];
+    // (lex % cumulative_product_[center]) / cumulative_product_[center + 1]:
+    uint32_t quotient =
+        divide(lex, cumulative_product_[center + 1], reciprocals_of_cumulative_product_[center + 1]);
+    return modulo(quotient, get_mults()[center], reciprocals_of_mults_[center]);
+}
+
+std::vector<uint8_t> IndexConverter::convert_lex_indexes_to_all_sz_projections(
+    std::span<const uint32_t> lex_indexes) const {
+    size_t size = lex_indexes.size();
+    std::vector<uint8_t> projections(get_mults().size() * size);
+    for (size_t center = 0; center < get_mults().size(); ++center) {
+        uint32_t divisor = cumulative_product_[center + 1];
+        uint64_t reciprocal_of_divisor = reciprocals_of_cumulative_product_[center + 1];
+        uint32_t mult = get_mults()[center];
+        uint64_t reciprocal_of_mult = reciprocals_of_mults_[center];
+        uint8_t* projections_of_center = projections.data() + center * size;
+        for (size_t i = 0; i < size; ++i) {
+            uint32_t quotient = divide(lex_indexes[i], divisor, reciprocal_of_divisor);
+            projections_of_center[i] = modulo(quotient, mult, reciprocal_of_mult);
+        }
+    }
+    return projections;
 }
 
 uint32_t IndexConverter::convert_sz_projections_to_lex_index(
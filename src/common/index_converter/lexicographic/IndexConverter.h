@@ -2,6 +2,7 @@
 #define SPINNER_LEXINDEXCONVERTER_H
 
 #include <cstdint>
+#include <span>
 #include <vector>
 
 #include "src/spin_algebra/Multiplicity.h"
@@ -13,6 +14,9 @@ class IndexConverter : public AbstractIndexConverter {
     explicit IndexConverter(std::vector<spin_algebra::Multiplicity> mults);
     std::vector<uint8_t> convert_lex_index_to_all_sz_projections(uint32_t lex) const;
     uint8_t convert_lex_index_to_one_sz_projection(uint32_t lex, uint32_t center) const;
+    // Decodes projections of all centers for all lex indexes in one pass.
+    // Projections of center c are stored in [c * lex_indexes.size(), (c + 1) * lex_indexes.size()).
+    std::vector<uint8_t> convert_lex_indexes_to_all_sz_projections(std::span<const uint32_t> lex_indexes) const;
     uint32_t convert_sz_projections_to_lex_index(const std::vector<uint8_t>& nzs) const;
 
     uint8_t convert_index_to_tz_projection(uint32_t index) const override;
@@ -22,6 +26,9 @@ class IndexConverter : public AbstractIndexConverter {
 
   private:
     std::vector<uint32_t> cumulative_product_;
+    // n / d and n % d are calculated as multiplications by precomputed reciprocals of d:
+    std::vector<uint64_t> reciprocals_of_cumulative_product_;
+    std::vector<uint64_t> reciprocals_of_mults_;
 };
 }  // namespace index_converter::lexicographic
 
@@ -21,9 +21,8 @@ IndexConverter::IndexConverter(
 	auto number_of_initial_mults_ = get_mults().size();
     auto number_of_all_mults_ = number_of_initial_mults_ + order_of_summation_->size();
 
-    auto empty_level = Level(
-        std::make_shared<std::vector<spin_algebra::Multiplicity>>(get_mults()),
-        order_of_summation_->size());
+    initial_multiplicities_ = std::make_shared<const std::vector<spin_algebra::Multiplicity>>(get_mults());
+    auto empty_level = Level(initial_multiplicities_.get(), order_of_summation_->size());
 
     std::vector<Level> result_of_summation = {empty_level};
 
@@ -71,6 +70,14 @@ IndexConverter::IndexConverter(
         ++i;
     }
 
+    for (size_t j = 0; j < s_squared_levels_.size(); ++j) {
+        const auto& block = s_squared_levels_[j];
+        for (size_t number_of_level = 0; number_of_level < block.size(); ++number_of_level) {
+            uint32_t index = cumulative_sum_[j] + number_of_level * block[number_of_level].total();
+            indexes_of_levels_.emplace(block[number_of_level], index);
+        }
+    }
+
     common::orderOfSummationPrint(*order_of_summation);
 
     common::sSquaredIndexConverterPrint(*this);
@@ -115,22 +122,11 @@ std::pair<const Level&, uint8_t> IndexConverter::convert_index_to_state(uint32_t
 
 // TODO: work with projection instead of unshifted_projection?
 std::optional<uint32_t> IndexConverter::convert_state_to_index(const Level& level, uint8_t projection) const {
-    auto total_multiplicity = level.total();
-
-    auto index_of_block = (total_multiplicity - 1) / 2;
-
-    const auto& block = s_squared_levels_[index_of_block];
-
-    auto iterator_in_block = std::lower_bound(block.begin(), block.end(), level);
-    if (iterator_in_block == block.end() || std::is_neq(*iterator_in_block <=> level)) {
+    auto iterator = indexes_of_levels_.find(level);
+    if (iterator == indexes_of_levels_.end()) {
         return std::nullopt;
     }
-    
-    auto number_of_level = std::distance(block.begin(), iterator_in_block);
-
-    auto index_in_block = number_of_level * total_multiplicity + projection;
-
-    return index_in_block + cumulative_sum_[index_of_block];
+    return iterator->second + projection;
 }
 
 std::shared_ptr<const OrderOfSummation> IndexConverter::getOrderOfSummation() const {
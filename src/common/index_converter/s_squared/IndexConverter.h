@@ -5,6 +5,7 @@
 #include "src/spin_algebra/Multiplicity.h"
 #include "OrderOfSummation.h"
 #include "Level.h"
+#include <hash_table8.hpp>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -27,7 +28,11 @@ public:
 
 private:
     std::shared_ptr<const OrderOfSummation> order_of_summation_;
+    // levels do not own initial multiplicities, so they are kept here:
+    std::shared_ptr<const std::vector<spin_algebra::Multiplicity>> initial_multiplicities_;
     std::vector<std::vector<Level>> s_squared_levels_;
+    // index of zero projection of every level:
+    emhash8::HashMap<Level, uint32_t, LevelHash> indexes_of_levels_;
     std::vector<size_t> cumulative_sum_;
 };
 } // namespace index_converter::s_squared
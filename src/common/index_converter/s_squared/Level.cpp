@@ -1,64 +1,101 @@
 #include "Level.h"
+
 #include <stdexcept>
+#include <string>
+
+#include "src/common/MumxHash.h"
+
+namespace {
+constexpr size_t MULTIPLICITIES_PER_WORD = 64 / index_converter::s_squared::Level::BITS_PER_MULTIPLICITY;
+constexpr uint64_t MASK = index_converter::s_squared::Level::MAX_MULTIPLICITY;
+}  // namespace
 
 namespace index_converter::s_squared {
 
-Level::Level(std::shared_ptr<std::vector<spin_algebra::Multiplicity>> initialMultiplicities,
+Level::Level(const std::vector<spin_algebra::Multiplicity>* initialMultiplicities,
         size_t number_of_summations) {
-    initialMultiplicities_ = std::move(initialMultiplicities);
-    intermediateMultiplicities_.resize(number_of_summations, 0);
+    if (number_of_summations > MAX_NUMBER_OF_SUMMATIONS) {
+        throw std::length_error(
+            "Level cannot contain more than " + std::to_string(MAX_NUMBER_OF_SUMMATIONS) + " summations");
+    }
+    initialMultiplicities_ = initialMultiplicities;
+    numberOfSummations_ = number_of_summations;
 }
 
-std::shared_ptr<std::vector<spin_algebra::Multiplicity>> Level::getInitialMultiplicities() const {
+const std::vector<spin_algebra::Multiplicity>* Level::getInitialMultiplicities() const {
     return initialMultiplicities_;
 }
 
+spin_algebra::Multiplicity Level::getIntermediateMultiplicity(size_t position) const {
+    size_t shift = position % MULTIPLICITIES_PER_WORD * BITS_PER_MULTIPLICITY;
+    return (packedIntermediateMultiplicities_[position / MULTIPLICITIES_PER_WORD] >> shift) & MASK;
+}
+
 spin_algebra::Multiplicity Level::getMultiplicity(size_t number) const {
     size_t initial_multiplicities_size = initialMultiplicities_->size();
-    size_t intermediate_multiplicities_size = intermediateMultiplicities_.size();
     if (number < initial_multiplicities_size) {
         return initialMultiplicities_->at(number);
     } else {
-        return intermediateMultiplicities_.at(number - initial_multiplicities_size);
+        size_t position = number - initial_multiplicities_size;
+        if (position >= numberOfSummations_) {
+            throw std::out_of_range("Level does not contain multiplicity " + std::to_string(number));
+        }
+        return getIntermediateMultiplicity(position);
     }
 }
 
 spin_algebra::Multiplicity Level::total() const {
-    return intermediateMultiplicities_.back();
+    return getIntermediateMultiplicity(numberOfSummations_ - 1);
 }
 
 size_t Level::getSize() const {
-    return initialMultiplicities_->size() + intermediateMultiplicities_.size();
+    return initialMultiplicities_->size() + numberOfSummations_;
 }
 
 void Level::setMultiplicity(size_t number, spin_algebra::Multiplicity multiplicity) {
     size_t initial_multiplicities_size = initialMultiplicities_->size();
     if (number < initial_multiplicities_size) {
         throw std::invalid_argument("Cannot set initial multiplicity");
-    } else {
-        size_t position_to_change = number - initial_multiplicities_size;
-        if (intermediateMultiplicities_.at(position_to_change) == 0) {
-            intermediateMultiplicities_[position_to_change] = multiplicity;
-        } else {
-            throw std::invalid_argument("Position was already set");
-        }
     }
+    size_t position_to_change = number - initial_multiplicities_size;
+    if (position_to_change >= numberOfSummations_) {
+        throw std::out_of_range("Level does not contain multiplicity " + std::to_string(number));
+    }
+    if (multiplicity > MAX_MULTIPLICITY) {
+        throw std::length_error(
+            "Level cannot contain multiplicity bigger than " + std::to_string(MAX_MULTIPLICITY));
+    }
+    if (getIntermediateMultiplicity(position_to_change) != 0) {
+        throw std::invalid_argument("Position was already set");
+    }
+    size_t shift = position_to_change % MULTIPLICITIES_PER_WORD * BITS_PER_MULTIPLICITY;
+    packedIntermediateMultiplicities_[position_to_change / MULTIPLICITIES_PER_WORD] |=
+        (uint64_t)multiplicity << shift;
 }
 
 std::strong_ordering Level::operator<=>(const Level& rhs) const {
-    for (int i = intermediateMultiplicities_.size() - 1; i >= 0; --i) {
-        if (intermediateMultiplicities_[i] < rhs.intermediateMultiplicities_[i]) {
-            return std::strong_ordering::less;
-        }
-        if (intermediateMultiplicities_[i] > rhs.intermediateMultiplicities_[i]) {
-            return std::strong_ordering::greater;
+    for (int i = NUMBER_OF_WORDS - 1; i >= 0; --i) {
+        if (packedIntermediateMultiplicities_[i] != rhs.packedIntermediateMultiplicities_[i]) {
+            return packedIntermediateMultiplicities_[i] <=> rhs.packedIntermediateMultiplicities_[i];
         }
     }
     return std::strong_ordering::equal;
 }
 
+bool Level::operator==(const Level& rhs) const {
+    return packedIntermediateMultiplicities_ == rhs.packedIntermediateMultiplicities_;
+}
+
+size_t Level::hash() const {
+    uint64_t answer = 0;
+    for (auto word : packedIntermediateMultiplicities_) {
+        answer = ankerl::MumxHash<uint64_t>()(answer ^ word);
+    }
+    return answer;
+}
+
 double Level::getSpin(size_t number) const {
     return ((double)getMultiplicity(number) - 1.0) / 2.0;
 }
 
-} // namespace index_converter::s_squared
\ No newline at end of file
+} // namespace index_converter::s_squared
@@ -3,21 +3,32 @@
 
 #include "src/spin_algebra/Multiplicity.h"
 
+#include <array>
 #include <compare>
-#include <memory>
+#include <cstdint>
 #include <vector>
 
 namespace index_converter::s_squared {
+// Intermediate multiplicities are bit-packed in a fixed number of words, so levels can be copied,
+// compared and hashed without allocations. Initial multiplicities are not owned by level,
+// they must outlive it (usually they are owned by IndexConverter).
 class Level {
   public:
+    static constexpr size_t BITS_PER_MULTIPLICITY = 8;
+    static constexpr size_t NUMBER_OF_WORDS = 4;
+    static constexpr size_t MAX_NUMBER_OF_SUMMATIONS = NUMBER_OF_WORDS * 64 / BITS_PER_MULTIPLICITY;
+    static constexpr spin_algebra::Multiplicity MAX_MULTIPLICITY = (1 << BITS_PER_MULTIPLICITY) - 1;
+
     Level(
-        std::shared_ptr<std::vector<spin_algebra::Multiplicity>> initialMultiplicities,
+        const std::vector<spin_algebra::Multiplicity>* initialMultiplicities,
         size_t number_of_summations);
     void setMultiplicity(size_t number, spin_algebra::Multiplicity multiplicity);
 
-    std::shared_ptr<std::vector<spin_algebra::Multiplicity>> getInitialMultiplicities() const;
+    const std::vector<spin_algebra::Multiplicity>* getInitialMultiplicities() const;
 
     std::strong_ordering operator<=>(const Level& rhs) const;
+    bool operator==(const Level& rhs) const;
+    size_t hash() const;
 
     spin_algebra::Multiplicity getMultiplicity(size_t number) const;
     double getSpin(size_t number) const;
@@ -25,9 +36,20 @@ class Level {
     spin_algebra::Multiplicity total() const;
 
   private:
-    std::shared_ptr<std::vector<spin_algebra::Multiplicity>> initialMultiplicities_;
-    std::vector<spin_algebra::Multiplicity> intermediateMultiplicities_;
+    const std::vector<spin_algebra::Multiplicity>* initialMultiplicities_;
+    // the k-th intermediate multiplicity is stored in bits [k % 8 * 8, k % 8 * 8 + 8) of k / 8 word,
+    // so comparison of words from the last one is comparison of multiplicities from the last one:
+    std::array<uint64_t, NUMBER_OF_WORDS> packedIntermediateMultiplicities_ = {};
+    uint8_t numberOfSummations_;
+
+    spin_algebra::Multiplicity getIntermediateMultiplicity(size_t position) const;
+};
+
+struct LevelHash {
+    size_t operator()(const Level& level) const {
+        return level.hash();
+    }
 };
 } // namespace index_converter::s_squared
 
-#endif // SPINNER_S2LEVEL_H
\ No newline at end of file
+#endif // SPINNER_S2LEVEL_H
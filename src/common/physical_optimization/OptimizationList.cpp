@@ -57,11 +57,71 @@ OptimizationList& OptimizationList::FTLMApproximate(FTLMSettings ftlmSettings) {
     if (ftlmSettings.number_of_seeds == 0) {
         throw std::invalid_argument("Number of seeds in FTLM equals to zero");
     }
+    if (isBoltzmannWindowed()) {
+        throw std::invalid_argument("Cannot use Boltzmann window with FTLM");
+    }
+    if (isWarmStarted()) {
+        throw std::invalid_argument("Cannot use warm start with FTLM");
+    }
     isFTLMApproximated_ = true;
     ftlmSettings_ = ftlmSettings;
     return *this;
 }
 
+OptimizationList& OptimizationList::BoltzmannWindow(BoltzmannWindowSettings boltzmannWindowSettings) {
+    if (isFTLMApproximated()) {
+        throw std::invalid_argument("Cannot use Boltzmann window with FTLM");
+    }
+    if (boltzmannWindowSettings.max_temperature <= 0) {
+        throw std::invalid_argument("Maximum temperature of Boltzmann window must be positive");
+    }
+    if (boltzmannWindowSettings.number_of_kT <= 0) {
+        throw std::invalid_argument("Number of kT in Boltzmann window must be positive");
+    }
+    isBoltzmannWindowed_ = true;
+    boltzmannWindowSettings_ = boltzmannWindowSettings;
+    return *this;
+}
+
+OptimizationList& OptimizationList::WarmStart(WarmStartSettings warmStartSettings) {
+    if (isFTLMApproximated()) {
+        throw std::invalid_argument("Cannot use warm start with FTLM");
+    }
+    if (warmStartSettings.tolerance <= 0) {
+        throw std::invalid_argument("Tolerance of warm start must be positive");
+    }
+    if (warmStartSettings.max_iterations == 0) {
+        throw std::invalid_argument("Number of iterations of warm start equals to zero");
+    }
+    isWarmStarted_ = true;
+    warmStartSettings_ = warmStartSettings;
+    return *this;
+}
+
+OptimizationList&
+OptimizationList::DegeneracyCompress(DegeneracyCompressionSettings degeneracyCompressionSettings) {
+    if (degeneracyCompressionSettings.tolerance < 0) {
+        throw std::invalid_argument("Tolerance of degeneracy compression must be non-negative");
+    }
+    isDegeneracyCompressed_ = true;
+    degeneracyCompressionSettings_ = degeneracyCompressionSettings;
+    return *this;
+}
+
+OptimizationList& OptimizationList::ScheduleBlocks(BlockSchedulingSettings blockSchedulingSettings) {
+    if (blockSchedulingSettings.memory_budget.has_value()
+        && blockSchedulingSettings.memory_budget.value() == 0) {
+        throw std::invalid_argument("Memory budget must be positive");
+    }
+    blockSchedulingSettings_ = blockSchedulingSettings;
+    return *this;
+}
+
+OptimizationList& OptimizationList::CacheLinearHamiltonian() {
+    isLinearHamiltonianCached_ = true;
+    return *this;
+}
+
 OptimizationList& OptimizationList::Symmetrize(group::Group new_group) {
     // check if user trying to use the same Group for a second time:
     if (std::count(groupsToApply_.begin(), groupsToApply_.end(), new_group)) {
@@ -148,6 +208,22 @@ bool OptimizationList::isFTLMApproximated() const {
     return isFTLMApproximated_;
 }
 
+bool OptimizationList::isBoltzmannWindowed() const {
+    return isBoltzmannWindowed_;
+}
+
+bool OptimizationList::isWarmStarted() const {
+    return isWarmStarted_;
+}
+
+bool OptimizationList::isDegeneracyCompressed() const {
+    return isDegeneracyCompressed_;
+}
+
+bool OptimizationList::isLinearHamiltonianCached() const {
+    return isLinearHamiltonianCached_;
+}
+
 const std::vector<group::Group>& OptimizationList::getGroupsToApply() const {
     return groupsToApply_;
 }
@@ -160,4 +236,21 @@ const OptimizationList::FTLMSettings& OptimizationList::getFTLMSettings() const
     return ftlmSettings_.value();
 }
 
+const OptimizationList::BoltzmannWindowSettings& OptimizationList::getBoltzmannWindowSettings() const {
+    return boltzmannWindowSettings_.value();
+}
+
+const OptimizationList::WarmStartSettings& OptimizationList::getWarmStartSettings() const {
+    return warmStartSettings_.value();
+}
+
+const OptimizationList::DegeneracyCompressionSettings&
+OptimizationList::getDegeneracyCompressionSettings() const {
+    return degeneracyCompressionSettings_.value();
+}
+
+const OptimizationList::BlockSchedulingSettings& OptimizationList::getBlockSchedulingSettings() const {
+    return blockSchedulingSettings_;
+}
+
 }  // namespace common::physical_optimization
\ No newline at end of file
@@ -14,6 +14,45 @@ class OptimizationList {
       size_t krylov_subspace_size;
       size_t exact_decomposition_threshold;
       size_t number_of_seeds;
+      // Hamiltonian of blocks larger than matrix_free_threshold is not stored,
+      // but applied to Krylov vectors on the fly:
+      size_t matrix_free_threshold = 1000000;
+      // if uncertainty_threshold is set, number_of_seeds more seeds are added until
+      // the FTLM standard deviation of mu^2 at every temperature is below it,
+      // but no more than max_number_of_seeds seeds are used:
+      std::optional<double> uncertainty_threshold;
+      size_t max_number_of_seeds = 1000;
+      // if convergence_tolerance is set, Krylov procedure of a seed is stopped earlier,
+      // when the Ritz values within convergence_energy_window above the lowest one have converged:
+      std::optional<double> convergence_tolerance;
+      double convergence_energy_window = 12000;
+      // if two_pass_lanczos is true, Krylov vectors are not stored, but regenerated from
+      // the Krylov matrix during the unitary transformations; it halves the speed, but saves memory:
+      bool two_pass_lanczos = false;
+    };
+    // states above (the lowest energy of block + number_of_kT * max_temperature)
+    // do not contribute to the partition function and are not calculated:
+    struct BoltzmannWindowSettings {
+      double max_temperature;
+      double number_of_kT = 40;
+    };
+    // eigenvectors of the previous iteration are refined instead of the full eigendecomposition,
+    // if the relative residuals do not converge within max_iterations, the full one is used:
+    struct WarmStartSettings {
+      double tolerance = 1e-8;
+      size_t max_iterations = 5;
+    };
+    // states, which energies differ by less than tolerance, are merged into one level
+    // with the summed weight before ensemble averaging:
+    struct DegeneracyCompressionSettings {
+      double tolerance = 1e-8;
+    };
+    // blocks are diagonalized simultaneously only while their estimated memory (in bytes) fits
+    // into memory_budget, by default there is no limit. In streaming mode eigenvectors of block
+    // are released as soon as all quantities of the block are calculated:
+    struct BlockSchedulingSettings {
+      std::optional<size_t> memory_budget;
+      bool streaming = false;
     };
 
     explicit OptimizationList(BasisType basis_type = BasisType::LEX);
@@ -27,6 +66,14 @@ class OptimizationList {
     Symmetrize(group::Group::GroupType group_type, std::vector<group::Permutation> generators);
     OptimizationList& NonAbelianSimplify();
     OptimizationList& FTLMApproximate(FTLMSettings ftlmSettings);
+    OptimizationList& BoltzmannWindow(BoltzmannWindowSettings boltzmannWindowSettings);
+    OptimizationList& WarmStart(WarmStartSettings warmStartSettings);
+    OptimizationList& DegeneracyCompress(DegeneracyCompressionSettings degeneracyCompressionSettings);
+    OptimizationList& ScheduleBlocks(BlockSchedulingSettings blockSchedulingSettings);
+    // Hamiltonian is assembled from the cached submatrices of its derivatives with respect to
+    // changeable J and D, it is faster in fits, but K+1 matrices per block (K is the number of
+    // changeable J and D) are kept between iterations and are not counted in the memory budget:
+    OptimizationList& CacheLinearHamiltonian();
 
     bool isLexBasis() const;
     bool isITOBasis() const;
@@ -35,9 +82,17 @@ class OptimizationList {
     bool isPositiveProjectionsEliminated() const;
     bool isNonMinimalProjectionsEliminated() const;
     bool isFTLMApproximated() const;
+    bool isBoltzmannWindowed() const;
+    bool isWarmStarted() const;
+    bool isDegeneracyCompressed() const;
+    bool isLinearHamiltonianCached() const;
     const std::vector<group::Group>& getGroupsToApply() const;
     bool isNonAbelianSimplified() const;
     const FTLMSettings& getFTLMSettings() const;
+    const BoltzmannWindowSettings& getBoltzmannWindowSettings() const;
+    const WarmStartSettings& getWarmStartSettings() const;
+    const DegeneracyCompressionSettings& getDegeneracyCompressionSettings() const;
+    const BlockSchedulingSettings& getBlockSchedulingSettings() const;
 
   private:
     bool isTzSorted_ = false;
@@ -50,6 +105,19 @@ class OptimizationList {
 
     bool isFTLMApproximated_ = false;
     std::optional<FTLMSettings> ftlmSettings_;
+
+    bool isBoltzmannWindowed_ = false;
+    std::optional<BoltzmannWindowSettings> boltzmannWindowSettings_;
+
+    bool isWarmStarted_ = false;
+    std::optional<WarmStartSettings> warmStartSettings_;
+
+    bool isDegeneracyCompressed_ = false;
+    std::optional<DegeneracyCompressionSettings> degeneracyCompressionSettings_;
+
+    BlockSchedulingSettings blockSchedulingSettings_;
+
+    bool isLinearHamiltonianCached_ = false;
 };
 }  // namespace common::physical_optimization
 #endif  //SPINNER_OPTIMIZATIONLIST_H
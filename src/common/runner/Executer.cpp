@@ -6,6 +6,7 @@
 namespace runner {
 void Executer::execute(input::Parser parser) {
     auto optimization_list = parser.getOptimizationList().value();
+    optimization_list.ScheduleBlocks(parser.getBlockSchedulingSettings());
     auto factoriesList = parser.getFactoriesList().value();
 
     for (const auto& model_input : parser.getModelInputs()) {
@@ -15,10 +16,12 @@ void Executer::execute(input::Parser parser) {
         auto runner = runner::Runner(model_input, optimization_list, factoriesList);
 
         if (parser.getTemperaturesForSimulation().has_value()) {
+            runner.initializeSimulationTemperatures(parser.getTemperaturesForSimulation().value());
+            const auto& temperatures = parser.getTemperaturesForSimulation().value();
+            auto values = runner.getMagneticSusceptibilityController().calculateTheoreticalMuSquared(temperatures);
             std::vector<magnetic_susceptibility::ValueAtTemperature> theor_values;
-            for (auto temp : parser.getTemperaturesForSimulation().value()) {
-                auto value = runner.getMagneticSusceptibilityController().calculateTheoreticalMuSquared(temp);
-                theor_values.push_back({temp, value});
+            for (size_t i = 0; i < temperatures.size(); ++i) {
+                theor_values.push_back({temperatures[i], values[i]});
             }
 
             common::theoreticalValuesPrint(theor_values);
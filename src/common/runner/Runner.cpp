@@ -1,5 +1,6 @@
 #include "Runner.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "magic_enum.hpp"
@@ -9,6 +10,7 @@
 #include "src/common/UncertainValue.h"
 #include "src/eigendecompositor/AllQuantitiesGetter.h"
 #include "src/eigendecompositor/EigendecompositorConstructor.h"
+#include "src/eigendecompositor/SpectrumCache.h"
 #include "src/entities/magnetic_susceptibility/worker/WorkerConstructor.h"
 #include "src/space/optimization/OptimizedSpaceConstructor.h"
 
@@ -85,6 +87,33 @@ const space::Space& runner::Runner::getSpace() const {
 }
 
 void Runner::BuildSpectra() {
+    LoadOrBuildSpectra();
+    // every rebuild (e.g., at the new point of fit) can change the uncertainty:
+    addSeedsUntilUncertaintyIsSmall();
+}
+
+void Runner::LoadOrBuildSpectra() {
+    // FTLM spectra are stochastic and depend on the number of seeds, so they are not cached:
+    bool is_cache_used = eigendecompositor::SpectrumCache::isEnabled() && !getOptimizationList().isFTLMApproximated();
+    std::string cache_key;
+    if (is_cache_used) {
+        cache_key = eigendecompositor::SpectrumCache::constructKey(
+            consistentModelOptimizationList_,
+            dataStructuresFactories_);
+        if (eigendecompositor::SpectrumCache::load(cache_key, *flattenedSpectra_, dataStructuresFactories_)) {
+            common::Logger::detailed("Spectra were loaded from the cache.");
+            flattenedSpectraAreBuilt_ = true;
+            eigendecompositorIsUpToDate_ = false;
+            return;
+        }
+    }
+    BuildSpectraByEigendecompositor();
+    if (is_cache_used) {
+        eigendecompositor::SpectrumCache::store(cache_key, *flattenedSpectra_);
+    }
+}
+
+void Runner::BuildSpectraByEigendecompositor() {
     eigendecompositor_->BuildSpectra(
         consistentModelOptimizationList_.getOperatorsForExplicitConstruction(),
         consistentModelOptimizationList_.getDerivativeOperatorsForExplicitConstruction(),
@@ -93,6 +122,13 @@ void Runner::BuildSpectra() {
     flattenedSpectra_->updateDerivativeValues(*eigendecompositor_, 
         getSymbolicWorker().getChangeableNames(), 
         getDataStructuresFactories());
+    if (getOptimizationList().isDegeneracyCompressed()) {
+        flattenedSpectra_->compressDegeneracies(
+            getOptimizationList().getDegeneracyCompressionSettings().tolerance,
+            getDataStructuresFactories());
+    }
+    flattenedSpectraAreBuilt_ = true;
+    eigendecompositorIsUpToDate_ = true;
     for (const auto& quantity_enum : magic_enum::enum_values<common::QuantityEnum>()) {
         auto maybe_matrix = getMatrix(quantity_enum);
         if (maybe_matrix.has_value()) {
@@ -154,6 +190,8 @@ void Runner::BuildMuSquaredWorker() {
 
         magnetic_susceptibility_controller_ = magnetic_susceptibility::MagneticSusceptibilityController(
             std::move(magnetic_susceptibility_worker));
+        // spectra were built before the controller, so they have not been checked yet:
+        addSeedsUntilUncertaintyIsSmall();
     }
 
     if (experimental_values_worker_.has_value()) {
@@ -162,6 +200,52 @@ void Runner::BuildMuSquaredWorker() {
     }
 }
 
+void Runner::addSeedsUntilUncertaintyIsSmall() {
+    const auto& optimization_list = getOptimizationList();
+    if (!optimization_list.isFTLMApproximated()
+        || !optimization_list.getFTLMSettings().uncertainty_threshold.has_value()
+        || !magnetic_susceptibility_controller_.has_value()) {
+        return;
+    }
+    double uncertainty_threshold = optimization_list.getFTLMSettings().uncertainty_threshold.value();
+
+    std::vector<double> temperatures;
+    if (experimental_values_worker_.has_value()) {
+        temperatures = experimental_values_worker_.value()->getTemperatures();
+    } else if (simulation_temperatures_.has_value()) {
+        temperatures = simulation_temperatures_.value();
+    }
+
+    while (true) {
+        double max_uncertainty = 0;
+        auto values = magnetic_susceptibility_controller_.value().calculateTheoreticalMuSquared(temperatures);
+        for (const auto& value : values) {
+            max_uncertainty = std::max(max_uncertainty, value.stdevs()[common::FTLM]);
+        }
+        if (max_uncertainty <= uncertainty_threshold) {
+            return;
+        }
+        if (!eigendecompositor_->increaseNumberOfSeeds()) {
+            common::Logger::detailed(
+                "FTLM standard deviation of mu^2 is {}, but the number of seeds cannot be increased.",
+                max_uncertainty);
+            return;
+        }
+        common::Logger::detailed(
+            "FTLM standard deviation of mu^2 is {}, the number of seeds is increased.",
+            max_uncertainty);
+        LoadOrBuildSpectra();
+    }
+}
+
+void Runner::initializeSimulationTemperatures(std::vector<double> temperatures) {
+    simulation_temperatures_ = std::move(temperatures);
+
+    if (magnetic_susceptibility_controller_.has_value()) {
+        addSeedsUntilUncertaintyIsSmall();
+    }
+}
+
 void Runner::initializeExperimentalValues(
     const std::shared_ptr<magnetic_susceptibility::ExperimentalValuesWorker>& experimental_values_worker) {
     if (experimental_values_worker_.has_value()) {
@@ -322,15 +406,16 @@ quantum::linear_algebra::FactoriesList Runner::getDataStructuresFactories() cons
 }
 
 const eigendecompositor::AllQuantitiesGetter& Runner::getAllQuantitiesGetter() {
-    if (!eigendecompositor_->BuildSpectraWasCalled()) {
-        BuildSpectra();
+    // spectra could be loaded from the cache, but matrices and spectra of blocks are not cached:
+    if (!eigendecompositorIsUpToDate_) {
+        BuildSpectraByEigendecompositor();
     }
 
     return *eigendecompositor_;
 }
 
 const std::shared_ptr<eigendecompositor::FlattenedSpectra>& Runner::getFlattenedSpectra() {
-    if (!eigendecompositor_->BuildSpectraWasCalled()) {
+    if (!flattenedSpectraAreBuilt_) {
         BuildSpectra();
     }
 
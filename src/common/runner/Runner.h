@@ -42,6 +42,8 @@ class Runner {
             magnetic_susceptibility::per_point);
     void initializeExperimentalValues(
         const std::shared_ptr<magnetic_susceptibility::ExperimentalValuesWorker>& experimental_values_worker);
+    // temperatures, at which FTLM uncertainty of mu^2 is controlled, if there are no experimental values:
+    void initializeSimulationTemperatures(std::vector<double> temperatures);
     std::map<model::symbols::SymbolName, double> calculateTotalDerivatives();
     void minimizeResidualError(std::shared_ptr<nonlinear_solver::AbstractNonlinearSolver>);
 
@@ -69,11 +71,21 @@ class Runner {
     quantum::linear_algebra::FactoriesList dataStructuresFactories_;
     std::unique_ptr<eigendecompositor::AbstractEigendecompositor> eigendecompositor_;
     std::shared_ptr<eigendecompositor::FlattenedSpectra> flattenedSpectra_;
+    bool flattenedSpectraAreBuilt_ = false;
+    // false, if the last flattened spectra were loaded from SpectrumCache:
+    bool eigendecompositorIsUpToDate_ = false;
 
     // SPECTRUM OPERATIONS
+    // loads flattened spectra from SpectrumCache or builds them by eigendecompositor,
+    // then adds FTLM seeds until the FTLM standard deviation of mu^2 is below the threshold:
     void BuildSpectra();
+    // loads flattened spectra from SpectrumCache or builds them by eigendecompositor:
+    void LoadOrBuildSpectra();
+    void BuildSpectraByEigendecompositor();
     // CHIT OPERATIONS
     void BuildMuSquaredWorker();
+    // adds FTLM seeds until the FTLM standard deviation of mu^2 is below the threshold:
+    void addSeedsUntilUncertaintyIsSmall();
 
     void initializeDerivatives();
 
@@ -93,6 +105,7 @@ class Runner {
         magnetic_susceptibility_controller_;
     std::optional<std::shared_ptr<magnetic_susceptibility::ExperimentalValuesWorker>>
         experimental_values_worker_;
+    std::optional<std::vector<double>> simulation_temperatures_;
 
 };
 }  // namespace runner
@@ -2,10 +2,12 @@
 
 #include <cassert>
 #include <functional>
+#include <omp.h>
 #include <stdexcept>
 #include "src/common/Logger.h"
 #include "src/common/OneOrMany.h"
 #include "src/common/Quantity.h"
+#include "src/eigendecompositor/BlockScheduler.h"
 
 namespace {
 template <typename T, typename U>
@@ -80,6 +82,9 @@ std::optional<OneOrMany<U>> getEntity(
 
 namespace eigendecompositor {
 
+AbstractEigendecompositor::AbstractEigendecompositor(size_t memory_budget) :
+    memory_budget_(memory_budget) {}
+
 void AbstractEigendecompositor::BuildSpectra(
     const std::map<common::QuantityEnum, std::shared_ptr<const model::operators::Operator>>&
         operators,
@@ -100,20 +105,41 @@ void AbstractEigendecompositor::BuildSpectra(
         assert(derivatives_operators_to_calculate.size() == 0);
     }
 
-    // todo: MemoryManager will have the special function: it will estimate required
-    //  memory for each block and pick num_threads based on the sum of max values
-    //  thus, openblas_num_threads can be set as floor(max_threads / num_threads)
+    BlockScheduler scheduler(memory_budget_, omp_get_max_threads());
+    auto plan = scheduler.plan(
+        space,
+        BlockScheduler::numberOfDenseMatrices(operators, derivatives_operators));
+
+    // Blocks are sorted by their cost, the largest ones are started first and get most of threads,
+    // the small ones are picked up by idle threads of the team.
+    // BLAS/LAPACK threads of each block are nested into the task-level parallelism:
+    int previous_max_active_levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(std::max(previous_max_active_levels, 2));
 
     common::Logger::debug_msg("Eigendecomposition of...");
-#pragma omp parallel master 
-    for (size_t i = 0; i < space.getBlocks().size(); ++i) 
-#pragma omp task
-    {
-        common::Logger::debug_msg("block {} has started", i);
-        const auto& subspace = space.getBlocks().at(i);
-        BuildSubspectra(i, subspace);
-        common::Logger::debug_msg("block {} is finished", i);
+#pragma omp parallel master
+    for (auto block_plan : plan) {
+        // blocks are admitted in waves: if there is no enough memory for the block,
+        // the master waits for (and helps to run) the already admitted blocks:
+        if (!scheduler.tryAdmit(block_plan.estimated_memory)) {
+#pragma omp taskwait
+            // there are no admitted blocks now, so the block is always admitted:
+            [[maybe_unused]] bool is_admitted = scheduler.tryAdmit(block_plan.estimated_memory);
+            assert(is_admitted);
+        }
+#pragma omp task firstprivate(block_plan) shared(scheduler, space)
+        {
+            int blas_threads = scheduler.start(block_plan.estimated_cost);
+            omp_set_num_threads(blas_threads);
+            size_t i = block_plan.number_of_block;
+            common::Logger::debug_msg("block {} has started using {} threads", i, blas_threads);
+            const auto& subspace = space.getBlocks().at(i);
+            BuildSubspectra(i, subspace);
+            common::Logger::debug_msg("block {} is finished", i);
+            scheduler.finish(block_plan.estimated_memory, blas_threads);
+        }
     }
+    omp_set_max_active_levels(previous_max_active_levels);
     common::Logger::separate(2, common::debug);
 
     finalize();
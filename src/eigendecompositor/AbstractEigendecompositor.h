@@ -1,6 +1,8 @@
 #ifndef SPINNER_ABSTRACTEIGENDECOMPOSITOR_H
 #define SPINNER_ABSTRACTEIGENDECOMPOSITOR_H
 
+#include <limits>
+
 #include "src/common/OneOrMany.h"
 #include "src/eigendecompositor/AllQuantitiesGetter.h"
 
@@ -40,9 +42,19 @@ class AbstractEigendecompositor : public AllQuantitiesGetter {
     virtual std::optional<OneOrMany<std::shared_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix>>>
     BuildSubspectra(size_t number_of_block, const space::Subspace& subspace) = 0;
     virtual void finalize() = 0;
+    // Increases the number of FTLM seeds, next BuildSpectra uses them.
+    // Returns false, if the number of seeds cannot be increased:
+    virtual bool increaseNumberOfSeeds() {
+        return false;
+    }
+  protected:
+    // blocks are diagonalized simultaneously only while their estimated memory (in bytes)
+    // fits into memory_budget, by default there is no limit:
+    explicit AbstractEigendecompositor(size_t memory_budget = std::numeric_limits<size_t>::max());
   private:
     bool buildSpectraWasCalled = false;
     uint32_t number_of_subspaces_;
+    size_t memory_budget_;
 };
 
 }  // namespace eigendecompositor
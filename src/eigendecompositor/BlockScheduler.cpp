@@ -0,0 +1,175 @@
+#include "BlockScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "src/common/Logger.h"
+
+namespace {
+double to_MiB(size_t bytes) {
+    return (double)bytes / (1024.0 * 1024.0);
+}
+}  // namespace
+
+namespace eigendecompositor {
+
+BlockScheduler::BlockScheduler(size_t memory_budget, int max_threads) :
+    memory_budget_(memory_budget),
+    max_threads_(std::max(1, max_threads)) {
+    if (memory_budget_ == 0) {
+        throw std::invalid_argument("Memory budget of BlockScheduler must be positive");
+    }
+}
+
+size_t BlockScheduler::numberOfDenseMatrices(
+    const std::map<common::QuantityEnum, std::shared_ptr<const model::operators::Operator>>&
+        operators,
+    const std::map<
+        std::pair<common::QuantityEnum, model::symbols::SymbolName>,
+        std::shared_ptr<const model::operators::Operator>>& derivatives_operators) {
+    bool do_we_need_eigenvectors =
+        !(operators.size() <= 1 && derivatives_operators.empty());
+    if (!do_we_need_eigenvectors) {
+        // hamiltonian matrix and workspace of eigensolver
+        return 2;
+    }
+    // hamiltonian matrix, eigenvectors and workspace of eigensolver / unitary transformation,
+    // non-energy submatrices are sparse, the dense transformation transforms them one by one,
+    // so they share the same workspace
+    return 3;
+}
+
+size_t BlockScheduler::estimateMemory(uint32_t size_of_block, size_t number_of_dense_matrices) {
+    return (size_t)size_of_block * (size_t)size_of_block * sizeof(double) * number_of_dense_matrices;
+}
+
+double BlockScheduler::estimateCost(uint32_t size_of_block) {
+    // both full and partial dense eigendecompositions scale as O(n^3)
+    return (double)size_of_block * (double)size_of_block * (double)size_of_block;
+}
+
+std::vector<BlockScheduler::BlockPlan>
+BlockScheduler::plan(const space::Space& space, size_t number_of_dense_matrices) {
+    std::vector<BlockPlan> answer;
+    answer.reserve(space.getBlocks().size());
+    size_t max_estimated_memory = 0;
+    size_t total_estimated_memory = 0;
+    double total_estimated_cost = 0;
+    for (size_t i = 0; i < space.getBlocks().size(); ++i) {
+        uint32_t size_of_block = space.getBlocks()[i].size();
+        size_t estimated_memory = estimateMemory(size_of_block, number_of_dense_matrices);
+        double estimated_cost = estimateCost(size_of_block);
+        answer.push_back({i, size_of_block, estimated_memory, estimated_cost});
+        max_estimated_memory = std::max(max_estimated_memory, estimated_memory);
+        total_estimated_memory += estimated_memory;
+        total_estimated_cost += estimated_cost;
+    }
+    // the largest blocks are started first, so they do not finish single-threaded at the end:
+    std::stable_sort(answer.begin(), answer.end(), [](const BlockPlan& a, const BlockPlan& b) {
+        return a.estimated_cost > b.estimated_cost;
+    });
+    remaining_cost_ = total_estimated_cost;
+    remaining_blocks_ = (int)answer.size();
+
+    size_t blocks_in_budget = max_estimated_memory == 0
+        ? answer.size()
+        : std::max((size_t)1, memory_budget_ / max_estimated_memory);
+    concurrency_ = (int)std::max(
+        (size_t)1,
+        std::min({(size_t)max_threads_, answer.size(), blocks_in_budget}));
+
+    common::Logger::detailed_msg("Block scheduler plan:");
+    if (memory_budget_ == std::numeric_limits<size_t>::max()) {
+        common::Logger::detailed("memory budget: unlimited");
+    } else {
+        common::Logger::detailed("memory budget: {:.1f} MiB", to_MiB(memory_budget_));
+    }
+    common::Logger::detailed(
+        "number of blocks: {}, dense matrices per block: {}, estimated memory of all blocks: {:.1f} MiB",
+        answer.size(),
+        number_of_dense_matrices,
+        to_MiB(total_estimated_memory));
+    common::Logger::detailed(
+        "the largest block requires {:.1f} MiB, up to {} of {} threads can diagonalize blocks simultaneously",
+        to_MiB(max_estimated_memory),
+        concurrency_,
+        max_threads_);
+    if (!answer.empty() && total_estimated_cost > 0) {
+        common::Logger::detailed(
+            "the largest block (#{}, size {}) takes {:.1f}% of the total O(n^3) cost",
+            answer.front().number_of_block,
+            answer.front().size_of_block,
+            100.0 * answer.front().estimated_cost / total_estimated_cost);
+    }
+    if (max_estimated_memory > memory_budget_) {
+        common::Logger::detailed(
+            "the largest block does not fit into the memory budget, it will be diagonalized alone");
+    }
+    for (const auto& block_plan : answer) {
+        common::Logger::debug(
+            "block {}: size {}, estimated memory {:.1f} MiB",
+            block_plan.number_of_block,
+            block_plan.size_of_block,
+            to_MiB(block_plan.estimated_memory));
+    }
+    common::Logger::separate(2, common::detailed);
+
+    return answer;
+}
+
+int BlockScheduler::getConcurrency() const {
+    return concurrency_;
+}
+
+bool BlockScheduler::tryAdmit(size_t estimated_memory) {
+    bool admitted = false;
+#pragma omp critical(block_scheduler)
+    {
+        // at least one block must be admitted, even if it does not fit into the budget
+        if (admitted_blocks_ == 0
+            || (used_memory_ <= memory_budget_ && estimated_memory <= memory_budget_ - used_memory_)) {
+            used_memory_ += estimated_memory;
+            ++admitted_blocks_;
+            admitted = true;
+        }
+    }
+    return admitted;
+}
+
+int BlockScheduler::start(double estimated_cost) {
+    int blas_threads;
+#pragma omp critical(block_scheduler)
+    {
+        int free_threads = std::max(1, max_threads_ - used_threads_);
+        // if memory does not allow to run many blocks, the threads are shared between the running ones:
+        int free_slots = std::max(1, concurrency_ - running_blocks_);
+        int threads_by_memory = free_threads / free_slots;
+        // otherwise, the block gets the part of free threads equal to its part of the remaining cost:
+        double remaining_cost = std::max(remaining_cost_, estimated_cost);
+        int threads_by_cost = remaining_cost > 0
+            ? (int)std::lround(free_threads * estimated_cost / remaining_cost)
+            : 1;
+        // but at least one thread is left for each of the blocks, which have not been started yet:
+        int waiting_blocks = std::max(0, remaining_blocks_ - 1);
+        int max_blas_threads = free_threads - std::min(waiting_blocks, free_threads - 1);
+        blas_threads = std::clamp(std::max(threads_by_memory, threads_by_cost), 1, max_blas_threads);
+        remaining_cost_ = std::max(0.0, remaining_cost_ - estimated_cost);
+        remaining_blocks_ = std::max(0, remaining_blocks_ - 1);
+        ++running_blocks_;
+        used_threads_ += blas_threads;
+    }
+    return blas_threads;
+}
+
+void BlockScheduler::finish(size_t estimated_memory, int blas_threads) {
+#pragma omp critical(block_scheduler)
+    {
+        used_memory_ -= estimated_memory;
+        --admitted_blocks_;
+        --running_blocks_;
+        used_threads_ -= blas_threads;
+    }
+}
+
+}  // namespace eigendecompositor
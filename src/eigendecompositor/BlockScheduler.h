@@ -0,0 +1,74 @@
+#ifndef SPINNER_BLOCKSCHEDULER_H
+#define SPINNER_BLOCKSCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "src/common/Quantity.h"
+#include "src/model/operators/Operator.h"
+#include "src/model/symbols/SymbolName.h"
+#include "src/space/Space.h"
+
+namespace eigendecompositor {
+
+// BlockScheduler decides, when the eigendecomposition of the block can be started.
+// It estimates required memory for each block and admits new blocks only while
+// the sum of estimations of running blocks fits into the memory budget.
+// Blocks are started in descending order of their O(n^3) cost. The starting block gets
+// the part of free threads for BLAS/LAPACK (or Eigen) proportional to its part of
+// the remaining cost, so the largest blocks run multithreaded, while small blocks
+// are packed onto the remaining threads one thread per block by OpenMP task scheduling.
+class BlockScheduler {
+  public:
+    struct BlockPlan {
+        size_t number_of_block;
+        uint32_t size_of_block;
+        size_t estimated_memory;
+        double estimated_cost;
+    };
+
+    BlockScheduler(size_t memory_budget, int max_threads);
+
+    // the number of dense size x size matrices, which can be alive during eigendecomposition of block
+    static size_t numberOfDenseMatrices(
+        const std::map<common::QuantityEnum, std::shared_ptr<const model::operators::Operator>>&
+            operators,
+        const std::map<
+            std::pair<common::QuantityEnum, model::symbols::SymbolName>,
+            std::shared_ptr<const model::operators::Operator>>& derivatives_operators);
+    static size_t estimateMemory(uint32_t size_of_block, size_t number_of_dense_matrices);
+    static double estimateCost(uint32_t size_of_block);
+
+    // returns blocks sorted in descending order of their cost
+    std::vector<BlockPlan> plan(const space::Space& space, size_t number_of_dense_matrices);
+    // the number of blocks, which can be diagonalized simultaneously
+    int getConcurrency() const;
+
+    // thread-safe, returns false if there is no enough memory for the block
+    bool tryAdmit(size_t estimated_memory);
+    // thread-safe, returns the number of BLAS threads for the starting block
+    int start(double estimated_cost);
+    // thread-safe, releases threads and memory of the finished block
+    void finish(size_t estimated_memory, int blas_threads);
+
+  private:
+    size_t memory_budget_;
+    int max_threads_;
+    int concurrency_ = 1;
+
+    size_t used_memory_ = 0;
+    int admitted_blocks_ = 0;
+    int running_blocks_ = 0;
+    int used_threads_ = 0;
+    double remaining_cost_ = 0;
+    int remaining_blocks_ = 0;
+};
+
+}  // namespace eigendecompositor
+
+#endif  //SPINNER_BLOCKSCHEDULER_H
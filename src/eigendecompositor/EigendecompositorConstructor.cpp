@@ -6,6 +6,7 @@
 #include "src/eigendecompositor/ExplicitQuantitiesEigendecompositor.h"
 #include "src/eigendecompositor/FTLMEigendecompositor.h"
 #include "src/eigendecompositor/ImplicitQuantityEigendecompositor.h"
+#include "src/eigendecompositor/LinearHamiltonianCache.h"
 #include "src/eigendecompositor/OneSymbolInHamiltonianEigendecompositor.h"
 
 namespace eigendecompositor {
@@ -16,6 +17,45 @@ std::unique_ptr<AbstractEigendecompositor> EigendecompositorConstructor::constru
     const auto& indexConverter =
         consistentModelOptimizationList.getIndexConverter();
 
+    const auto& symbolic_worker =
+        consistentModelOptimizationList.getModel().getSymbolicWorker();
+
+    // todo: we need only J and D if there is no field
+    size_t number_of_all_J =
+        symbolic_worker.getAllNames(model::symbols::J).size();
+    size_t number_of_changeable_J =
+        symbolic_worker.getChangeableNames(model::symbols::J).size();
+    size_t number_of_all_D =
+        symbolic_worker.getAllNames(model::symbols::D).size();
+    size_t number_of_changeable_D =
+        symbolic_worker.getChangeableNames(model::symbols::D).size();
+    bool is_one_symbol_in_hamiltonian =
+        number_of_all_J == 1 && number_of_changeable_J == 1 && number_of_all_D == 0
+        || number_of_all_J == 0 && number_of_all_D == 1 && number_of_changeable_D == 1;
+
+    std::optional<std::vector<LinearHamiltonianCache::SymbolPart>> linear_symbol_parts;
+    if (consistentModelOptimizationList.getOptimizationList().isLinearHamiltonianCached()
+        && !is_one_symbol_in_hamiltonian && number_of_changeable_J + number_of_changeable_D > 0) {
+        // Hamiltonian is linear in J and D, its derivatives are parts of the Hamiltonian:
+        linear_symbol_parts.emplace();
+        for (auto type_enum : {model::symbols::J, model::symbols::D}) {
+            for (const auto& symbol_name : symbolic_worker.getChangeableNames(type_enum)) {
+                auto getter = [&symbolic_worker, symbol_name]() {
+                    return symbolic_worker.getValueOfName(symbol_name);
+                };
+                linear_symbol_parts.value().push_back(
+                    {symbol_name,
+                     consistentModelOptimizationList.getModel()
+                         .getOperatorDerivative(common::Energy, symbol_name)
+                         .value(),
+                     getter});
+            }
+        }
+    }
+
+    const auto& block_scheduling_settings =
+        consistentModelOptimizationList.getOptimizationList().getBlockSchedulingSettings();
+
     common::Logger::detailed_msg("Eigendecompositor information:");
     common::Logger::detailed("ExactEigendecompositor will be used");
     std::unique_ptr<eigendecompositor::AbstractEigendecompositor> eigendecompositor;
@@ -23,33 +63,88 @@ std::unique_ptr<AbstractEigendecompositor> EigendecompositorConstructor::constru
     if (consistentModelOptimizationList.getOptimizationList().isFTLMApproximated()) {
         auto FTLM_settings = consistentModelOptimizationList.getOptimizationList().getFTLMSettings();
         common::Logger::detailed("FTLMEigendecompositor will be used");
+        std::optional<quantum::linear_algebra::KrylovConvergence> krylov_convergence;
+        if (FTLM_settings.convergence_tolerance.has_value()) {
+            krylov_convergence = quantum::linear_algebra::KrylovConvergence{
+                FTLM_settings.convergence_tolerance.value(),
+                FTLM_settings.convergence_energy_window};
+        }
+        std::optional<LinearHamiltonianCache> sparse_hamiltonian_cache;
+        if (linear_symbol_parts.has_value()) {
+            common::Logger::detailed(
+                "Sparsity pattern of Hamiltonian will be cached, values will be assembled from {} symbols.",
+                linear_symbol_parts.value().size());
+            // return_sparse_if_possible is true, because krylov eigendecomposition of sparse matrix is faster
+            sparse_hamiltonian_cache = LinearHamiltonianCache(
+                std::move(linear_symbol_parts.value()), indexConverter, factories, true);
+        }
         eigendecompositor =
             std::make_unique<eigendecompositor::FTLMEigendecompositor>(
                 indexConverter,
                 factories,
                 FTLM_settings.krylov_subspace_size,
                 FTLM_settings.exact_decomposition_threshold,
-                FTLM_settings.number_of_seeds);
+                FTLM_settings.number_of_seeds,
+                FTLM_settings.matrix_free_threshold,
+                FTLM_settings.uncertainty_threshold.has_value()
+                    ? FTLM_settings.max_number_of_seeds
+                    : FTLM_settings.number_of_seeds,
+                krylov_convergence,
+                FTLM_settings.two_pass_lanczos,
+                std::move(sparse_hamiltonian_cache));
     } else {
+        std::optional<LinearHamiltonianCache> linear_hamiltonian_cache;
+        if (linear_symbol_parts.has_value()) {
+            common::Logger::detailed(
+                "Hamiltonian will be assembled from cached submatrices of {} symbols.",
+                linear_symbol_parts.value().size());
+            linear_hamiltonian_cache =
+                LinearHamiltonianCache(std::move(linear_symbol_parts.value()), indexConverter, factories);
+        }
+        std::optional<double> energy_window;
+        const auto& optimization_list = consistentModelOptimizationList.getOptimizationList();
+        if (optimization_list.isBoltzmannWindowed()) {
+            const auto& settings = optimization_list.getBoltzmannWindowSettings();
+            if (is_one_symbol_in_hamiltonian) {
+                // eigenvectors are calculated only once and rescaled,
+                // so the truncated states can fall into the window for other values of the symbol:
+                common::Logger::detailed(
+                    "Boltzmann window will not be used with OneSymbolInHamiltonianEigendecompositor.");
+            } else {
+                energy_window = settings.number_of_kT * settings.max_temperature;
+                common::Logger::detailed(
+                    "Only eigenpairs within {} K ({} kT at {} K) above the lowest energy of block will be calculated.",
+                    energy_window.value(),
+                    settings.number_of_kT,
+                    settings.max_temperature);
+            }
+        }
+        std::optional<common::physical_optimization::OptimizationList::WarmStartSettings>
+            warm_start_settings;
+        if (optimization_list.isWarmStarted()) {
+            if (is_one_symbol_in_hamiltonian) {
+                common::Logger::detailed(
+                    "Warm start will not be used with OneSymbolInHamiltonianEigendecompositor.");
+            } else if (block_scheduling_settings.streaming) {
+                // warm start keeps eigenvectors of all blocks between iterations:
+                common::Logger::detailed("Warm start will not be used with streaming of blocks.");
+            } else {
+                warm_start_settings = optimization_list.getWarmStartSettings();
+                common::Logger::detailed(
+                    "Eigenvectors of the previous iteration will be refined up to relative residual {} in {} iterations.",
+                    warm_start_settings->tolerance,
+                    warm_start_settings->max_iterations);
+            }
+        }
         eigendecompositor = std::make_unique<eigendecompositor::ExactEigendecompositor>(
             indexConverter,
-            factories);
+            factories,
+            std::move(linear_hamiltonian_cache),
+            energy_window,
+            warm_start_settings);
     }
 
-    const auto& symbolic_worker =
-        consistentModelOptimizationList.getModel().getSymbolicWorker();
-
-    // todo: we need only J and D if there is no field
-    size_t number_of_all_J =
-        symbolic_worker.getAllNames(model::symbols::J).size();
-    size_t number_of_changeable_J =
-        symbolic_worker.getChangeableNames(model::symbols::J).size();
-    size_t number_of_all_D =
-        symbolic_worker.getAllNames(model::symbols::D).size();
-    size_t number_of_changeable_D =
-        symbolic_worker.getChangeableNames(model::symbols::D).size();
-    if (number_of_all_J == 1 && number_of_changeable_J == 1 && number_of_all_D == 0
-        || number_of_all_J == 0 && number_of_all_D == 1 && number_of_changeable_D == 1) {
+    if (is_one_symbol_in_hamiltonian) {
         model::symbols::SymbolName symbol_name;
         if (number_of_all_J == 1) {
             symbol_name = symbolic_worker.getChangeableNames(model::symbols::J)[0];
@@ -63,10 +158,15 @@ std::unique_ptr<AbstractEigendecompositor> EigendecompositorConstructor::constru
             "OneSymbolInHamiltonianEigendecompositor will be used, "
             "the name of the parameter is {}.",
             symbol_name.get_name());
+        if (block_scheduling_settings.streaming) {
+            common::Logger::detailed(
+                "Eigenvectors will not be kept, spectra will be rebuilt if other quantities require them.");
+        }
         eigendecompositor =
             std::make_unique<eigendecompositor::OneSymbolInHamiltonianEigendecompositor>(
                 std::move(eigendecompositor),
-                getter);
+                getter,
+                !block_scheduling_settings.streaming);
     }
 
     if (consistentModelOptimizationList.isImplicitSSquarePossible()) {
@@ -90,7 +190,8 @@ std::unique_ptr<AbstractEigendecompositor> EigendecompositorConstructor::constru
     eigendecompositor = std::make_unique<eigendecompositor::ExplicitQuantitiesEigendecompositor>(
         std::move(eigendecompositor),
         indexConverter,
-        factories);
+        factories,
+        block_scheduling_settings.memory_budget.value_or(std::numeric_limits<size_t>::max()));
 
     common::Logger::separate(0, common::detailed);
 
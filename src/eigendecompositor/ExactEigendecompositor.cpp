@@ -1,16 +1,30 @@
 #include "ExactEigendecompositor.h"
 
 #include <functional>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
+#include "src/common/Logger.h"
+
 namespace eigendecompositor {
 
 ExactEigendecompositor::ExactEigendecompositor(
     std::shared_ptr<const index_converter::AbstractIndexConverter> converter,
-    quantum::linear_algebra::FactoriesList factories_list) :
+    quantum::linear_algebra::FactoriesList factories_list,
+    std::optional<LinearHamiltonianCache> linear_hamiltonian_cache,
+    std::optional<double> energy_window,
+    std::optional<common::physical_optimization::OptimizationList::WarmStartSettings>
+        warm_start_settings) :
     converter_(std::move(converter)),
-    factories_list_(std::move(factories_list)) {}
+    factories_list_(std::move(factories_list)),
+    linear_hamiltonian_cache_(std::move(linear_hamiltonian_cache)),
+    energy_window_(energy_window),
+    warm_start_settings_(warm_start_settings) {
+    if (energy_window_.has_value() && energy_window_.value() <= 0) {
+        throw std::invalid_argument("Energy window of ExactEigendecompositor must be positive");
+    }
+}
 
 std::optional<OneOrMany<std::shared_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix>>>
 ExactEigendecompositor::BuildSubspectra(
@@ -20,24 +34,33 @@ ExactEigendecompositor::BuildSubspectra(
         mb_unitary_transformation_matrix;
 
     // return_sparse_if_possible is false, because eigendecomposition of dense matrix is faster
-    auto hamiltonian_submatrix = Submatrix(subspace, *energy_operator_, converter_, factories_list_, false);
+    auto hamiltonian_submatrix = linear_hamiltonian_cache_.has_value()
+        ? linear_hamiltonian_cache_->construct(number_of_block, subspace, *energy_operator_)
+        : Submatrix(subspace, *energy_operator_, converter_, factories_list_, false);
 
     if (!do_we_need_eigenvectors_) {
-        // if we need to explicitly calculate _only_ energy, we do not need eigenvectors:
+        // if we need to explicitly calculate _only_ energy, we do not need eigenvectors
+        // (energy window does not make eigenvalues-only decomposition cheaper):
         auto energy_spectrum = energy_subspectrum_eigenvalues_only(hamiltonian_submatrix);
         energy_.spectrum_.blocks[number_of_block] = std::move(energy_spectrum);
     } else {
-        auto pair = energy_subspectrum_with_eigenvectors(hamiltonian_submatrix);
+        auto pair = energy_subspectrum_with_eigenvectors(hamiltonian_submatrix, number_of_block);
         mb_unitary_transformation_matrix = std::move(pair.second);
         energy_.spectrum_.blocks[number_of_block] = std::move(pair.first);
+        if (warm_start_settings_.has_value()) {
+            previous_eigenvectors_[number_of_block] = mb_unitary_transformation_matrix.value();
+        }
     }
 #ifndef NDEBUG
     energy_.matrix_.blocks[number_of_block] = std::move(hamiltonian_submatrix);
 #endif
 
-    if (!first_iteration_has_been_done_) {
+    size_t size_of_subspectrum = energy_.spectrum_.blocks[number_of_block].raw_data->size();
+    if (!first_iteration_has_been_done_ || weights_[number_of_block]->size() != size_of_subspectrum) {
         weights_[number_of_block] = factories_list_.createVector();
-        weights_[number_of_block]->add_identical_values(subspace.size(), subspace.properties.degeneracy);
+        weights_[number_of_block]->add_identical_values(
+            size_of_subspectrum,
+            subspace.properties.degeneracy);
     }
 
     return mb_unitary_transformation_matrix;
@@ -56,6 +79,10 @@ void ExactEigendecompositor::initialize(
     energy_.spectrum_.blocks.resize(number_of_subspaces);
     if (!first_iteration_has_been_done_) {
         weights_.resize(number_of_subspaces);
+        previous_eigenvectors_.resize(number_of_subspaces);
+    }
+    if (linear_hamiltonian_cache_.has_value()) {
+        linear_hamiltonian_cache_->initialize(number_of_subspaces);
     }
 
     energy_operator_ = operators_to_calculate.at(common::Energy);
@@ -112,13 +139,38 @@ Subspectrum ExactEigendecompositor::energy_subspectrum_eigenvalues_only(
 
 std::pair<Subspectrum, std::unique_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix>>
 ExactEigendecompositor::energy_subspectrum_with_eigenvectors(
-    const Submatrix& hamiltonian_submatrix) {
-    auto eigencouple = hamiltonian_submatrix.raw_data->diagonalizeValuesVectors();
+    const Submatrix& hamiltonian_submatrix,
+    size_t number_of_block) const {
+    std::optional<quantum::linear_algebra::EigenCouple> mb_eigencouple;
+
+    const auto& previous_eigenvectors = previous_eigenvectors_[number_of_block];
+    if (warm_start_settings_.has_value() && previous_eigenvectors != nullptr) {
+        // if the previous eigenvectors were truncated by the window, the refinement checks,
+        // that the states above them have not come into the window:
+        bool are_truncated = energy_window_.has_value()
+            && previous_eigenvectors->size_cols() < previous_eigenvectors->size_rows();
+        mb_eigencouple = hamiltonian_submatrix.raw_data->refineDiagonalizeValuesVectors(
+            *previous_eigenvectors,
+            warm_start_settings_->tolerance,
+            warm_start_settings_->max_iterations,
+            are_truncated ? energy_window_ : std::nullopt);
+        if (!mb_eigencouple.has_value()) {
+            common::Logger::debug(
+                "Warm start of block {} has not converged, full eigendecomposition will be used",
+                number_of_block);
+        }
+    }
+
+    if (!mb_eigencouple.has_value()) {
+        mb_eigencouple = energy_window_.has_value()
+            ? hamiltonian_submatrix.raw_data->diagonalizeValuesVectorsInWindow(energy_window_.value())
+            : hamiltonian_submatrix.raw_data->diagonalizeValuesVectors();
+    }
 
     auto energy_subspectrum =
-        Subspectrum(std::move(eigencouple.eigenvalues), hamiltonian_submatrix.properties);
+        Subspectrum(std::move(mb_eigencouple->eigenvalues), hamiltonian_submatrix.properties);
 
-    return {std::move(energy_subspectrum), std::move(eigencouple.eigenvectors)};
+    return {std::move(energy_subspectrum), std::move(mb_eigencouple->eigenvectors)};
 }
 
-}  // namespace eigendecompositor
+}  // namespace eigendecompositor
\ No newline at end of file
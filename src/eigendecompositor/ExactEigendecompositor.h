@@ -5,13 +5,19 @@
 #include <optional>
 
 #include "AbstractEigendecompositor.h"
+#include "LinearHamiltonianCache.h"
+#include "src/common/physical_optimization/OptimizationList.h"
 
 namespace eigendecompositor {
 class ExactEigendecompositor: public AbstractEigendecompositor {
   public:
     ExactEigendecompositor(
         std::shared_ptr<const index_converter::AbstractIndexConverter> converter,
-        quantum::linear_algebra::FactoriesList factories_list);
+        quantum::linear_algebra::FactoriesList factories_list,
+        std::optional<LinearHamiltonianCache> linear_hamiltonian_cache = std::nullopt,
+        std::optional<double> energy_window = std::nullopt,
+        std::optional<common::physical_optimization::OptimizationList::WarmStartSettings>
+            warm_start_settings = std::nullopt);
     std::optional<OneOrMany<std::shared_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix>>>
     BuildSubspectra(
         size_t number_of_block, const space::Subspace& subspace) override;
@@ -42,14 +48,24 @@ class ExactEigendecompositor: public AbstractEigendecompositor {
     quantum::linear_algebra::FactoriesList factories_list_;
     common::Quantity energy_;
     std::shared_ptr<const model::operators::Operator> energy_operator_;
+    std::optional<LinearHamiltonianCache> linear_hamiltonian_cache_;
+    // if set, only eigenpairs with energies not greater than (the lowest energy of block + window)
+    // are calculated, so the size of subspectrum can be less than the size of block:
+    std::optional<double> energy_window_;
+    // if set, eigenvectors of the previous iteration are refined instead of full eigendecomposition:
+    std::optional<common::physical_optimization::OptimizationList::WarmStartSettings>
+        warm_start_settings_;
+    std::vector<std::shared_ptr<const quantum::linear_algebra::AbstractDenseSemiunitaryMatrix>>
+        previous_eigenvectors_;
     bool do_we_need_eigenvectors_;
     bool first_iteration_has_been_done_ = false;
     std::vector<std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>> weights_;
 
     static Subspectrum energy_subspectrum_eigenvalues_only(const Submatrix& hamiltonian_submatrix);
-    static std::
-        pair<Subspectrum, std::unique_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix>>
-        energy_subspectrum_with_eigenvectors(const Submatrix& hamiltonian_submatrix);
+    std::pair<Subspectrum, std::unique_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix>>
+        energy_subspectrum_with_eigenvectors(
+            const Submatrix& hamiltonian_submatrix,
+            size_t number_of_block) const;
 };
 
 }  // namespace eigendecompositor
@@ -1,13 +1,16 @@
 #include "ExplicitQuantitiesEigendecompositor.h"
 
 #include <utility>
+#include <vector>
 
 namespace eigendecompositor {
 
 ExplicitQuantitiesEigendecompositor::ExplicitQuantitiesEigendecompositor(
     std::unique_ptr<AbstractEigendecompositor> eigendecompositor,
     std::shared_ptr<const index_converter::AbstractIndexConverter> converter,
-    quantum::linear_algebra::FactoriesList factories_list) :
+    quantum::linear_algebra::FactoriesList factories_list,
+    size_t memory_budget) :
+    AbstractEigendecompositor(memory_budget),
     eigendecompositor_(std::move(eigendecompositor)),
     converter_(std::move(converter)),
     factories_list_(std::move(factories_list)) {}
@@ -61,32 +64,45 @@ ExplicitQuantitiesEigendecompositor::BuildSubspectra(
     const space::Subspace& subspace) {
     auto mb_unitary_transformation_matrix =
         eigendecompositor_->BuildSubspectra(number_of_block, subspace);
+    if (quantities_operators_map_.empty() && derivatives_operators_map_.empty()) {
+        return mb_unitary_transformation_matrix;
+    }
 
+    // all submatrices are constructed before the transformation, so the work of unitary transformation
+    // (e.g., the regeneration of Krylov vectors) is shared between them:
+    std::vector<Submatrix> non_hamiltonian_submatrices;
+    non_hamiltonian_submatrices.reserve(quantities_operators_map_.size() + derivatives_operators_map_.size());
     for (const auto& [quantity_enum, operator_to_calculate] : quantities_operators_map_) {
         // return_sparse_if_possible is true, because unitary transformation of sparse matrix is faster
-        auto non_hamiltonian_submatrix =
-            Submatrix(subspace, *operator_to_calculate, converter_, factories_list_, true);
+        non_hamiltonian_submatrices.emplace_back(
+            subspace, *operator_to_calculate, converter_, factories_list_, true);
+    }
+    for (const auto& [pair, derivative_operator] : derivatives_operators_map_) {
+        non_hamiltonian_submatrices.emplace_back(
+            subspace, *derivative_operator, converter_, factories_list_, true);
+    }
+    auto non_hamiltonian_subspectra =
+        non_energy_subspectra(non_hamiltonian_submatrices, mb_unitary_transformation_matrix.value());
+
+    size_t i = 0;
+    for (const auto& [quantity_enum, operator_to_calculate] : quantities_operators_map_) {
         auto& quantity_spectrum = quantities_spectra_map_[quantity_enum];
-        quantity_spectrum[number_of_block] = non_energy_subspectrum(
-            non_hamiltonian_submatrix,
-            mb_unitary_transformation_matrix.value());
+        quantity_spectrum[number_of_block] = std::move(non_hamiltonian_subspectra[i]);
 #ifndef NDEBUG
         auto& quantity_matrix = quantities_matrix_map_[quantity_enum];
-        quantity_matrix[number_of_block] = std::move(non_hamiltonian_submatrix);
+        quantity_matrix[number_of_block] = std::move(non_hamiltonian_submatrices[i]);
 #endif
+        ++i;
     }
 
-    for (auto& [pair, derivative_operator] : derivatives_operators_map_) {
-        // return_sparse_if_possible is true, because unitary transformation of sparse matrix is faster
-        auto derivative_submatrix =
-            Submatrix(subspace, *derivative_operator, converter_, factories_list_, true);
+    for (const auto& [pair, derivative_operator] : derivatives_operators_map_) {
         auto& derivative_spectrum = derivatives_spectra_map_[pair];
-        derivative_spectrum[number_of_block] =
-            non_energy_subspectrum(derivative_submatrix, mb_unitary_transformation_matrix.value());
+        derivative_spectrum[number_of_block] = std::move(non_hamiltonian_subspectra[i]);
 #ifndef NDEBUG
         auto& derivative_matrix = derivatives_matrix_map_[pair];
-        derivative_matrix[number_of_block] = std::move(derivative_submatrix);
+        derivative_matrix[number_of_block] = std::move(non_hamiltonian_submatrices[i]);
 #endif
+        ++i;
     }
 
     return mb_unitary_transformation_matrix;
@@ -151,24 +167,52 @@ void ExplicitQuantitiesEigendecompositor::initialize(
     }
 }
 
+bool ExplicitQuantitiesEigendecompositor::increaseNumberOfSeeds() {
+    return eigendecompositor_->increaseNumberOfSeeds();
+}
+
 void ExplicitQuantitiesEigendecompositor::finalize() {
     eigendecompositor_->finalize();
 }
 
-OneOrMany<Subspectrum> ExplicitQuantitiesEigendecompositor::non_energy_subspectrum(
-    const Submatrix& non_hamiltonian_submatrix,
+std::vector<OneOrMany<Subspectrum>> ExplicitQuantitiesEigendecompositor::non_energy_subspectra(
+    const std::vector<Submatrix>& non_hamiltonian_submatrices,
     const OneOrMany<std::shared_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix>>&
         unitary_transformation_matrix) {
-    return transform_one_or_many(
-    std::function([&non_hamiltonian_submatrix](std::shared_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix> unitary_transformation_matrix) {
+    std::vector<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDiagonalizableMatrix>>>
+        raw_data_of_submatrices;
+    for (const auto& submatrix : non_hamiltonian_submatrices) {
+        raw_data_of_submatrices.emplace_back(submatrix.raw_data);
+    }
+
+    // every unitary transformation matrix transforms all submatrices at once:
+    auto subspectra_of_unitary_matrices = transform_one_or_many(
+    std::function([&non_hamiltonian_submatrices, &raw_data_of_submatrices](std::shared_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix> unitary_transformation_matrix) {
         const auto& transformer = unitary_transformation_matrix->getUnitaryTransformer();
-        auto raw_data = transformer->calculateUnitaryTransformationOfMatrix(
-            non_hamiltonian_submatrix.raw_data);
-    
-        auto non_energy_subspectrum =
-            Subspectrum(std::move(raw_data), non_hamiltonian_submatrix.properties);
-    
-        return std::move(non_energy_subspectrum);
+        auto raw_data = transformer->calculateUnitaryTransformationOfMatrices(raw_data_of_submatrices);
+
+        std::vector<Subspectrum> non_energy_subspectra;
+        non_energy_subspectra.reserve(raw_data.size());
+        for (size_t i = 0; i < raw_data.size(); ++i) {
+            non_energy_subspectra.emplace_back(
+                std::move(raw_data[i]), non_hamiltonian_submatrices[i].properties);
+        }
+        return non_energy_subspectra;
     }), unitary_transformation_matrix);
+
+    std::vector<OneOrMany<Subspectrum>> answer;
+    answer.reserve(non_hamiltonian_submatrices.size());
+    for (size_t i = 0; i < non_hamiltonian_submatrices.size(); ++i) {
+        if (holdsOne(subspectra_of_unitary_matrices)) {
+            answer.emplace_back(std::move(std::get<std::vector<Subspectrum>>(subspectra_of_unitary_matrices)[i]));
+        } else {
+            std::vector<Subspectrum> many;
+            for (auto& subspectra : std::get<std::vector<std::vector<Subspectrum>>>(subspectra_of_unitary_matrices)) {
+                many.emplace_back(std::move(subspectra[i]));
+            }
+            answer.emplace_back(std::move(many));
+        }
+    }
+    return answer;
 }
 }  // namespace eigendecompositor
\ No newline at end of file
@@ -10,7 +10,8 @@ class ExplicitQuantitiesEigendecompositor: public AbstractEigendecompositor {
     ExplicitQuantitiesEigendecompositor(
         std::unique_ptr<AbstractEigendecompositor> eigendecompositor,
         std::shared_ptr<const index_converter::AbstractIndexConverter> converter,
-        quantum::linear_algebra::FactoriesList factories_list);
+        quantum::linear_algebra::FactoriesList factories_list,
+        size_t memory_budget = std::numeric_limits<size_t>::max());
     std::optional<OneOrMany<std::reference_wrapper<const Subspectrum>>>
     getSubspectrum(common::QuantityEnum, size_t number_of_block) const override;
     std::optional<OneOrMany<std::reference_wrapper<const Submatrix>>>
@@ -34,6 +35,7 @@ class ExplicitQuantitiesEigendecompositor: public AbstractEigendecompositor {
     std::optional<OneOrMany<std::shared_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix>>>
     BuildSubspectra(size_t number_of_block, const space::Subspace& subspace) override;
     void finalize() override;
+    bool increaseNumberOfSeeds() override;
 
   private:
     std::unique_ptr<AbstractEigendecompositor> eigendecompositor_;
@@ -50,8 +52,9 @@ class ExplicitQuantitiesEigendecompositor: public AbstractEigendecompositor {
         std::shared_ptr<const model::operators::Operator>>
         derivatives_operators_map_;
 
-    static OneOrMany<Subspectrum> non_energy_subspectrum(
-        const Submatrix& non_hamiltonian_submatrix,
+    // answer[i] is the subspectrum of non_hamiltonian_submatrices[i]:
+    static std::vector<OneOrMany<Subspectrum>> non_energy_subspectra(
+        const std::vector<Submatrix>& non_hamiltonian_submatrices,
         const OneOrMany<std::shared_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix>>&
             unitary_transformation_matrix);
 };
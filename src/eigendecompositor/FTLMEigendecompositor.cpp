@@ -1,8 +1,10 @@
 #include "FTLMEigendecompositor.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <functional>
+#include <iterator>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -10,6 +12,7 @@
 #include "src/common/Quantity.h"
 #include "src/eigendecompositor/ExactEigendecompositor.h"
 #include "src/entities/data_structures/AbstractDiagonalizableMatrix.h"
+#include "src/entities/matrix/MatrixFreeSubmatrix.h"
 #include "src/entities/spectrum/Subspectrum.h"
 
 namespace eigendecompositor {
@@ -19,13 +22,24 @@ FTLMEigendecompositor::FTLMEigendecompositor(
     quantum::linear_algebra::FactoriesList factories_list,
     size_t krylov_subspace_size,
     size_t exact_decomposition_threshold,
-    size_t number_of_seeds) :
+    size_t number_of_seeds,
+    size_t matrix_free_threshold,
+    size_t max_number_of_seeds,
+    std::optional<quantum::linear_algebra::KrylovConvergence> krylov_convergence,
+    bool two_pass_lanczos,
+    std::optional<LinearHamiltonianCache> sparse_hamiltonian_cache) :
     ExactEigendecompositor(converter, factories_list),
     converter_(converter),
     factories_list_(std::move(factories_list)),
     krylov_subspace_size_(krylov_subspace_size),
     exact_decomposition_threshold_(exact_decomposition_threshold),
-    number_of_seeds_(number_of_seeds) {}
+    number_of_seeds_(number_of_seeds),
+    matrix_free_threshold_(matrix_free_threshold),
+    seeds_batch_size_(number_of_seeds),
+    max_number_of_seeds_(std::max(max_number_of_seeds, number_of_seeds)),
+    krylov_convergence_(krylov_convergence),
+    two_pass_lanczos_(two_pass_lanczos),
+    sparse_hamiltonian_cache_(std::move(sparse_hamiltonian_cache)) {}
     
 std::optional<OneOrMany<std::shared_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix>>>
 FTLMEigendecompositor::BuildSubspectra(
@@ -37,66 +51,89 @@ FTLMEigendecompositor::BuildSubspectra(
         return ExactEigendecompositor::BuildSubspectra(number_of_block, subspace);
     }
 
-    if (!first_iteration_has_been_done_) {
-        seed_vectors_[number_of_block] = factories_list_.createRandomUnitVectors(size_of_subspace, number_of_seeds_);
+    // seed vectors are reused between iterations, only the added seeds are generated:
+    auto& seed_vectors = seed_vectors_[number_of_block];
+    if (seed_vectors.size() < number_of_seeds_) {
+        auto new_seed_vectors =
+            factories_list_.createRandomUnitVectors(size_of_subspace, number_of_seeds_ - seed_vectors.size());
+        std::move(new_seed_vectors.begin(), new_seed_vectors.end(), std::back_inserter(seed_vectors));
     }
 
     std::optional<std::vector<std::shared_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix>>>
         mb_unitary_transformation_matrix;
 
-    // return_sparse_if_possible is true, because krylov eigendecomposition of sparse matrix is faster
-    auto hamiltonian_submatrix = Submatrix(subspace, *energy_operator_, converter_, factories_list_, true);
+    Submatrix hamiltonian_submatrix;
+    if (size_of_subspace > matrix_free_threshold_) {
+        // the block is too large to store its Hamiltonian, so it is applied to Krylov vectors on the fly:
+        hamiltonian_submatrix = Submatrix(
+            factories_list_.createMatrixFreeDiagonalizableMatrix(
+                std::make_shared<MatrixFreeSubmatrix>(subspace, energy_operator_)),
+            subspace.properties);
+    } else if (sparse_hamiltonian_cache_.has_value()) {
+        hamiltonian_submatrix = sparse_hamiltonian_cache_->construct(number_of_block, subspace, *energy_operator_);
+    } else {
+        // return_sparse_if_possible is true, because krylov eigendecomposition of sparse matrix is faster
+        hamiltonian_submatrix = Submatrix(subspace, *energy_operator_, converter_, factories_list_, true);
+    }
+
+    double degeneracy = hamiltonian_submatrix.properties.degeneracy * (double)size_of_subspace;
+    std::vector<std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>> weights_of_all_seeds_;
+    weights_of_all_seeds_.resize(number_of_seeds_);
 
+    // all seeds are advanced together, so the Hamiltonian is read from memory once per Krylov step,
+    // the spectrum of a seed can be smaller than krylov_subspace_size, if it has converged earlier:
     if (!do_we_need_eigenvectors_) {
-        std::vector<std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>> weights_of_all_seeds_;
-        weights_of_all_seeds_.resize(number_of_seeds_);
         // if we need to explicitly calculate _only_ energy, we do not need eigenvectors:
-#pragma omp taskloop default(shared)
-        for (int seed = 0; seed < number_of_seeds_; ++seed) {
-            auto krylov_couple = 
-                hamiltonian_submatrix.raw_data->krylovDiagonalizeValues(
-                    seed_vectors_[number_of_block][seed], 
-                    krylov_subspace_size_);
-        
+        auto krylov_couples =
+            hamiltonian_submatrix.raw_data->krylovDiagonalizeValues(
+                seed_vectors_[number_of_block],
+                krylov_subspace_size_,
+                krylov_convergence_);
+        for (size_t seed = 0; seed < number_of_seeds_; ++seed) {
             Subspectrum energy_subspectrum;
-            energy_subspectrum.raw_data = std::move(krylov_couple.eigenvalues);
+            energy_subspectrum.raw_data = std::move(krylov_couples[seed].eigenvalues);
             energy_subspectrum.properties = hamiltonian_submatrix.properties;
             energy_subspectrum.properties.degeneracy *= (double)size_of_subspace;
-    
-            double degeneracy = hamiltonian_submatrix.properties.degeneracy * (double)size_of_subspace;
 
             energy_spectra_[number_of_block][seed] = std::move(energy_subspectrum);
-            weights_of_all_seeds_[seed] = std::move(krylov_couple.ftlm_weights_of_states->multiply_by(degeneracy));
+            weights_of_all_seeds_[seed] = krylov_couples[seed].ftlm_weights_of_states->multiply_by(degeneracy);
             // todo: in-place multiplication
         }
-        weights_[number_of_block] = std::move(weights_of_all_seeds_);
     } else {
         mb_unitary_transformation_matrix = 
             std::vector<std::shared_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix>>(number_of_seeds_);
-    
-        std::vector<std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>> weights_of_all_seeds_;
-        weights_of_all_seeds_.resize(number_of_seeds_);
-#pragma omp taskloop default(shared)
-        for (int seed = 0; seed < number_of_seeds_; ++seed) {
-            auto krylov_triple = 
-                hamiltonian_submatrix.raw_data->krylovDiagonalizeValuesVectors(
-                    seed_vectors_[number_of_block][seed], 
-                    krylov_subspace_size_);
-        
+
+        std::vector<quantum::linear_algebra::KrylovTriple> krylov_triples;
+        if (two_pass_lanczos_) {
+            // eigenvectors share the ownership of the Hamiltonian to regenerate Krylov vectors:
+            std::shared_ptr<const quantum::linear_algebra::AbstractDiagonalizableMatrix> hamiltonian =
+                std::move(hamiltonian_submatrix.raw_data);
+            krylov_triples = hamiltonian->krylovDiagonalizeValuesVectorsTwoPass(
+                seed_vectors_[number_of_block],
+                krylov_subspace_size_,
+                krylov_convergence_);
+#ifndef NDEBUG
+            hamiltonian_submatrix.raw_data = hamiltonian->multiply_by(1);
+#endif
+        } else {
+            krylov_triples = hamiltonian_submatrix.raw_data->krylovDiagonalizeValuesVectors(
+                seed_vectors_[number_of_block],
+                krylov_subspace_size_,
+                krylov_convergence_);
+        }
+        for (size_t seed = 0; seed < number_of_seeds_; ++seed) {
             Subspectrum energy_subspectrum;
-            energy_subspectrum.raw_data = std::move(krylov_triple.eigenvalues);
+            energy_subspectrum.raw_data = std::move(krylov_triples[seed].eigenvalues);
             energy_subspectrum.properties = hamiltonian_submatrix.properties;
             energy_subspectrum.properties.degeneracy *= (double)size_of_subspace;
 
             energy_spectra_[number_of_block][seed] = std::move(energy_subspectrum);
-            mb_unitary_transformation_matrix.value()[seed] = std::move(krylov_triple.eigenvectors);
-            
-            double degeneracy = hamiltonian_submatrix.properties.degeneracy * (double)size_of_subspace;
-            weights_of_all_seeds_[seed] = std::move(krylov_triple.ftlm_weights_of_states->multiply_by(degeneracy));
+            mb_unitary_transformation_matrix.value()[seed] = std::move(krylov_triples[seed].eigenvectors);
+            weights_of_all_seeds_[seed] = krylov_triples[seed].ftlm_weights_of_states->multiply_by(degeneracy);
             // todo: in-place multiplication
         }
-        weights_[number_of_block] = std::move(weights_of_all_seeds_);
-}
+    }
+    weights_[number_of_block] = std::move(weights_of_all_seeds_);
 #ifndef NDEBUG
     energy_matrix_[number_of_block] = std::move(hamiltonian_submatrix);
 #endif
@@ -193,13 +230,17 @@ void FTLMEigendecompositor::initialize(
     energy_matrix_.clear();
     energy_matrix_.resize(number_of_subspaces);
 
+    if (sparse_hamiltonian_cache_.has_value()) {
+        sparse_hamiltonian_cache_->initialize(number_of_subspaces);
+    }
+
     if (!first_iteration_has_been_done_) {
         seed_vectors_.resize(number_of_subspaces);
         weights_.resize(number_of_subspaces);
-        for (int i = 0; i < number_of_subspaces; ++i) {
-            weights_[i].clear();
-            weights_[i].resize(number_of_seeds_);
-        }
+    }
+    // the number of seeds can be increased between iterations:
+    for (int i = 0; i < number_of_subspaces; ++i) {
+        weights_[i].resize(number_of_seeds_);
     }
 
     energy_operator_ = operators_to_calculate.at(common::Energy);
@@ -211,6 +252,15 @@ void FTLMEigendecompositor::initialize(
     ExactEigendecompositor::initialize(operators_to_calculate, derivatives_operators_to_calculate, number_of_subspaces);
 }
 
+bool FTLMEigendecompositor::increaseNumberOfSeeds() {
+    size_t new_number_of_seeds = std::min(number_of_seeds_ + seeds_batch_size_, max_number_of_seeds_);
+    if (new_number_of_seeds == number_of_seeds_) {
+        return false;
+    }
+    number_of_seeds_ = new_number_of_seeds;
+    return true;
+}
+
 void FTLMEigendecompositor::finalize() {
     ExactEigendecompositor::finalize();
     first_iteration_has_been_done_ = true;
@@ -5,6 +5,7 @@
 #include "src/common/Quantity.h"
 #include "src/eigendecompositor/ExactEigendecompositor.h"
 #include "src/entities/data_structures/AbstractDenseVector.h"
+#include "src/entities/data_structures/AbstractDiagonalizableMatrix.h"
 
 namespace eigendecompositor {
 
@@ -15,7 +16,12 @@ class FTLMEigendecompositor : public ExactEigendecompositor {
         quantum::linear_algebra::FactoriesList factories_list,
         size_t krylov_subspace_size,
         size_t exact_decomposition_threshold,
-        size_t number_of_seeds
+        size_t number_of_seeds,
+        size_t matrix_free_threshold,
+        size_t max_number_of_seeds,
+        std::optional<quantum::linear_algebra::KrylovConvergence> krylov_convergence = std::nullopt,
+        bool two_pass_lanczos = false,
+        std::optional<LinearHamiltonianCache> sparse_hamiltonian_cache = std::nullopt
     );
 
     std::optional<OneOrMany<std::shared_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix>>>
@@ -38,6 +44,7 @@ class FTLMEigendecompositor : public ExactEigendecompositor {
             std::shared_ptr<const model::operators::Operator>>& derivatives_operators_to_calculate,
         uint32_t number_of_subspaces) override;
     void finalize() override;
+    bool increaseNumberOfSeeds() override;
 
   private:
     std::shared_ptr<const index_converter::AbstractIndexConverter> converter_;
@@ -47,6 +54,15 @@ class FTLMEigendecompositor : public ExactEigendecompositor {
     size_t krylov_subspace_size_;
     size_t exact_decomposition_threshold_;
     size_t number_of_seeds_;
+    size_t matrix_free_threshold_;
+    // seeds are added by batches of the initial number of seeds:
+    size_t seeds_batch_size_;
+    size_t max_number_of_seeds_;
+    std::optional<quantum::linear_algebra::KrylovConvergence> krylov_convergence_;
+    // Krylov vectors are not stored, but regenerated in every unitary transformation:
+    bool two_pass_lanczos_;
+    // sparsity pattern of Hamiltonian of stored (not matrix-free) large blocks is kept between iterations:
+    std::optional<LinearHamiltonianCache> sparse_hamiltonian_cache_;
 
     // The first vector over blocks, the second vector over seeds.
     std::vector<std::vector<Subspectrum>> energy_spectra_;
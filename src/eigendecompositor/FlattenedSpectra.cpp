@@ -1,7 +1,9 @@
 #include "FlattenedSpectra.h"
 
+#include <algorithm>
 #include <functional>
 #include <memory>
+#include <numeric>
 #include <optional>
 
 #include "magic_enum.hpp"
@@ -25,6 +27,76 @@ OneOrMany<std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>> flatten
         }), 
         spectrum));
     }
+
+std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>& get_mutable_element(
+    OneOrMany<std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>& one_or_many,
+    size_t i) {
+    if (holdsOne(one_or_many)) {
+        return std::get<std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>(one_or_many);
+    } else {
+        return std::get<std::vector<std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>>(one_or_many).at(i);
+    }
+}
+
+std::unique_ptr<quantum::linear_algebra::AbstractDenseVector> create_vector(
+    const std::vector<double>& values,
+    const quantum::linear_algebra::FactoriesList& factories) {
+    auto vector = factories.createVector();
+    vector->assign_values(values.data(), values.size());
+    return vector;
+}
+
+// States are sorted by energy, every level consists of states,
+// which energies are less than tolerance above the lowest energy of level.
+struct Levels {
+    std::vector<uint32_t> level_of_state;
+    std::vector<double> energies;
+    std::vector<double> weights;
+    std::vector<double> weights_of_states;
+
+    Levels(
+        const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>& energy_vector,
+        const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>& weights_vector,
+        double tolerance) {
+        uint32_t number_of_states = energy_vector->size();
+        std::vector<double> energies_of_states(number_of_states);
+        weights_of_states.resize(number_of_states);
+        for (uint32_t i = 0; i < number_of_states; ++i) {
+            energies_of_states[i] = energy_vector->at(i);
+            weights_of_states[i] = weights_vector->at(i);
+        }
+        std::vector<uint32_t> order(number_of_states);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&energies_of_states](uint32_t a, uint32_t b) {
+            return energies_of_states[a] < energies_of_states[b];
+        });
+
+        level_of_state.resize(number_of_states);
+        for (uint32_t state : order) {
+            if (energies.empty() || energies_of_states[state] - energies.back() >= tolerance) {
+                energies.push_back(energies_of_states[state]);
+                weights.push_back(0);
+            }
+            level_of_state[state] = energies.size() - 1;
+            weights.back() += weights_of_states[state];
+        }
+    }
+
+    // weighted means of values of states of every level:
+    std::unique_ptr<quantum::linear_algebra::AbstractDenseVector> compress(
+        const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>& values_of_states,
+        const quantum::linear_algebra::FactoriesList& factories) const {
+        std::vector<double> values(energies.size(), 0);
+        for (uint32_t i = 0; i < level_of_state.size(); ++i) {
+            values[level_of_state[i]] += weights_of_states[i] * values_of_states->at(i);
+        }
+        for (size_t level = 0; level < values.size(); ++level) {
+            // the level with zero weight does not contribute to averages:
+            values[level] = weights[level] == 0 ? 0 : values[level] / weights[level];
+        }
+        return create_vector(values, factories);
+    }
+};
 } // namespace
 
 namespace eigendecompositor {
@@ -95,6 +167,33 @@ void FlattenedSpectra::updateDerivativeValues(const AllQuantitiesGetter& allQuan
     }
 }
 
+void FlattenedSpectra::compressDegeneracies(double tolerance,
+    const quantum::linear_algebra::FactoriesList& factories) {
+    auto& energy_spectrum = flattenedSpectra_.at(common::Energy);
+    size_t number_of_spectra = get_size(energy_spectrum).value_or(1);
+    for (size_t i = 0; i < number_of_spectra; ++i) {
+        auto& energy_vector = get_mutable_element(energy_spectrum, i);
+        auto& weights_vector = get_mutable_element(flattenedWeights_, i);
+        Levels levels(energy_vector, weights_vector, tolerance);
+        for (auto& [quantity_enum, spectrum] : flattenedSpectra_) {
+            if (quantity_enum != common::Energy) {
+                auto& vector = get_mutable_element(spectrum, i);
+                vector = levels.compress(vector, factories);
+            }
+        }
+        for (auto& [_, spectrum] : flattenedDerivativeSpectra_) {
+            auto& vector = get_mutable_element(spectrum, i);
+            vector = levels.compress(vector, factories);
+        }
+        for (auto& [_, spectrum] : flattenedDerivativeProductSpectra_) {
+            auto& vector = get_mutable_element(spectrum, i);
+            vector = levels.compress(vector, factories);
+        }
+        energy_vector = create_vector(levels.energies, factories);
+        weights_vector = create_vector(levels.weights, factories);
+    }
+}
+
 std::optional<OneOrMany<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>>> 
 FlattenedSpectra::getFlattenSpectrum(common::QuantityEnum quantity_enum) const {
     if (flattenedSpectra_.contains(quantity_enum)) {
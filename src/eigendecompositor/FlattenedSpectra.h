@@ -19,6 +19,10 @@ class FlattenedSpectra {
     void updateDerivativeValues(const AllQuantitiesGetter& allQuantitiesGetter,
         const std::vector<model::symbols::SymbolName>& symbol_names,
         const quantum::linear_algebra::FactoriesList& factories);
+    // Merges states, which energies differ by less than tolerance, into levels with the summed weight.
+    // Other values of level are weighted means of values of its states, so ensemble averages do not change.
+    // It has to be called after updateValues and updateDerivativeValues:
+    void compressDegeneracies(double tolerance, const quantum::linear_algebra::FactoriesList& factories);
   
     std::optional<OneOrMany<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>>> 
         getFlattenSpectrum(common::QuantityEnum quantity_enum) const;
@@ -32,6 +36,9 @@ class FlattenedSpectra {
     OneOrMany<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>> getWeights() const;
 
   private:
+    // SpectrumCache writes and reads all flattened vectors:
+    friend class SpectrumCache;
+
     std::map<common::QuantityEnum, 
         OneOrMany<std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>> flattenedSpectra_;
     std::map<std::pair<common::QuantityEnum, model::symbols::SymbolName>, 
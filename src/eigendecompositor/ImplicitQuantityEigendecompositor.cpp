@@ -1,5 +1,6 @@
 #include "ImplicitQuantityEigendecompositor.h"
 
+#include <functional>
 #include <sstream>
 #include <stdexcept>
 #include <utility>
@@ -25,7 +26,6 @@ ImplicitQuantityEigendecompositor::ImplicitQuantityEigendecompositor(
         os << " quantity\n";
         throw std::invalid_argument(os.str());
     }
-    quantity_implicit_spectrum_ = Spectrum();
 }
 
 std::optional<OneOrMany<std::shared_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix>>>
@@ -37,16 +37,19 @@ ImplicitQuantityEigendecompositor::BuildSubspectra(
         number_of_block,
         subspace);
 
-    if (!first_iteration_has_been_done_) {
-        double value = calculate_value(subspace.properties);
-
-        size_t size_of_subspectrum = getSubspectrumSize(common::Energy, number_of_block);
-
-        auto raw_data = factories_list_.createVector();
-        raw_data->add_identical_values(size_of_subspectrum, value);
-        quantity_implicit_spectrum_.blocks[number_of_block] =
-            Subspectrum(std::move(raw_data), subspace.properties);
-    }
+    // the number of states in the block can change between iterations,
+    // if only the low-lying eigenpairs are calculated or if Krylov procedures have converged earlier,
+    // so the subspectrum is sized by the energy subspectrum of every seed:
+    double value = calculate_value(subspace.properties);
+    std::function<Subspectrum(std::reference_wrapper<const Subspectrum>)> construct_subspectrum =
+        [this, value, &subspace](std::reference_wrapper<const Subspectrum> energy_subspectrum) {
+            auto raw_data = factories_list_.createVector();
+            raw_data->add_identical_values(energy_subspectrum.get().raw_data->size(), value);
+            return Subspectrum(std::move(raw_data), subspace.properties);
+        };
+    quantity_implicit_spectra_[number_of_block] = transform_one_or_many(
+        construct_subspectrum,
+        eigendecompositor_->getSubspectrum(common::Energy, number_of_block).value());
 
     return mb_unitary_transformation_matrix;
 }
@@ -54,7 +57,8 @@ ImplicitQuantityEigendecompositor::BuildSubspectra(
 std::optional<OneOrMany<std::reference_wrapper<const Subspectrum>>>
 ImplicitQuantityEigendecompositor::getSubspectrum(common::QuantityEnum quantity_enum, size_t number_of_block) const {
     if (quantity_enum == quantity_implicit_enum_) {
-        return quantity_implicit_spectrum_.blocks[number_of_block];
+        return copyRef<Subspectrum, std::reference_wrapper<const Subspectrum>>(
+            quantity_implicit_spectra_[number_of_block]);
     }
     return eigendecompositor_->getSubspectrum(quantity_enum, number_of_block);
 }
@@ -104,7 +108,7 @@ void ImplicitQuantityEigendecompositor::initialize(
             "Explicit M^2 operator passed to ImplicitSSquareEigendecompositor");
     }
     if (!first_iteration_has_been_done_) {
-        quantity_implicit_spectrum_.blocks.resize(number_of_subspaces);
+        quantity_implicit_spectra_.resize(number_of_subspaces);
     }
     eigendecompositor_->initialize(
         operators_to_calculate,
@@ -112,6 +116,10 @@ void ImplicitQuantityEigendecompositor::initialize(
         number_of_subspaces);
 }
 
+bool ImplicitQuantityEigendecompositor::increaseNumberOfSeeds() {
+    return eigendecompositor_->increaseNumberOfSeeds();
+}
+
 void ImplicitQuantityEigendecompositor::finalize() {
     eigendecompositor_->finalize();
     first_iteration_has_been_done_ = true;
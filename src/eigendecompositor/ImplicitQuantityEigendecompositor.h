@@ -39,11 +39,14 @@ class ImplicitQuantityEigendecompositor: public AbstractEigendecompositor {
             std::shared_ptr<const model::operators::Operator>>& derivatives_operators_to_calculate,
         uint32_t number_of_subspaces) override;
     void finalize() override;
+    bool increaseNumberOfSeeds() override;
 
   private:
     std::unique_ptr<AbstractEigendecompositor> eigendecompositor_;
     uint32_t max_ntz_proj_;
-    Spectrum quantity_implicit_spectrum_;
+    // the same vector over blocks, but one subspectrum per seed,
+    // because sizes of FTLM energy subspectra of seeds can be different:
+    std::vector<OneOrMany<Subspectrum>> quantity_implicit_spectra_;
     common::QuantityEnum quantity_implicit_enum_;
     quantum::linear_algebra::FactoriesList factories_list_;
     bool first_iteration_has_been_done_ = false;
@@ -0,0 +1,81 @@
+#include "LinearHamiltonianCache.h"
+
+#include <utility>
+
+namespace eigendecompositor {
+
+LinearHamiltonianCache::LinearHamiltonianCache(
+    std::vector<SymbolPart> symbol_parts,
+    std::shared_ptr<const index_converter::AbstractIndexConverter> converter,
+    quantum::linear_algebra::FactoriesList factories_list,
+    bool return_sparse_if_possible) :
+    symbol_parts_(std::move(symbol_parts)),
+    converter_(std::move(converter)),
+    factories_list_(std::move(factories_list)),
+    return_sparse_if_possible_(return_sparse_if_possible) {}
+
+void LinearHamiltonianCache::initialize(uint32_t number_of_subspaces) {
+    // the space does not change between iterations, so cached submatrices stay valid:
+    if (pattern_submatrices_.size() != number_of_subspaces) {
+        pattern_submatrices_.clear();
+        constant_values_.clear();
+        symbol_values_.clear();
+        pattern_submatrices_.resize(number_of_subspaces);
+        constant_values_.resize(number_of_subspaces);
+        symbol_values_.resize(number_of_subspaces);
+    }
+}
+
+Submatrix LinearHamiltonianCache::construct(
+    size_t number_of_block,
+    const space::Subspace& subspace,
+    const model::operators::Operator& energy_operator) {
+    auto& pattern_submatrix = pattern_submatrices_[number_of_block];
+    auto& constant_values = constant_values_[number_of_block];
+    auto& symbol_values = symbol_values_[number_of_block];
+
+    if (pattern_submatrix.raw_data == nullptr) {
+        auto hamiltonian_submatrix =
+            Submatrix(subspace, energy_operator, converter_, factories_list_, return_sparse_if_possible_);
+        auto pattern_raw_data = hamiltonian_submatrix.raw_data->multiply_by(1);
+        std::vector<Submatrix> symbol_submatrices;
+        symbol_submatrices.reserve(symbol_parts_.size());
+        for (const auto& symbol_part : symbol_parts_) {
+            auto symbol_submatrix = Submatrix(
+                subspace,
+                *symbol_part.operator_derivative,
+                converter_,
+                factories_list_,
+                return_sparse_if_possible_);
+            pattern_raw_data->add_sparsity_pattern(*symbol_submatrix.raw_data);
+            symbol_submatrices.emplace_back(std::move(symbol_submatrix));
+        }
+        // H_0 = H - \sum_k p_k H_k
+        constant_values = pattern_raw_data->stored_values_of(*hamiltonian_submatrix.raw_data);
+        symbol_values.clear();
+        symbol_values.reserve(symbol_parts_.size());
+        for (size_t k = 0; k < symbol_parts_.size(); ++k) {
+            symbol_values.push_back(pattern_raw_data->stored_values_of(*symbol_submatrices[k].raw_data));
+            double value_of_symbol = symbol_parts_[k].currentValueGetter();
+            for (size_t i = 0; i < constant_values.size(); ++i) {
+                constant_values[i] -= value_of_symbol * symbol_values[k][i];
+            }
+        }
+        pattern_submatrix = Submatrix(std::move(pattern_raw_data), hamiltonian_submatrix.properties);
+        return hamiltonian_submatrix;
+    }
+
+    // H = H_0 + \sum_k p_k H_k, it is a single pass over the stored elements per symbol:
+    std::vector<double> values = constant_values;
+    for (size_t k = 0; k < symbol_parts_.size(); ++k) {
+        double value_of_symbol = symbol_parts_[k].currentValueGetter();
+        for (size_t i = 0; i < values.size(); ++i) {
+            values[i] += value_of_symbol * symbol_values[k][i];
+        }
+    }
+    auto hamiltonian_raw_data = pattern_submatrix.raw_data->multiply_by(1);
+    hamiltonian_raw_data->assign_stored_values(values);
+    return Submatrix(std::move(hamiltonian_raw_data), pattern_submatrix.properties);
+}
+
+}  // namespace eigendecompositor
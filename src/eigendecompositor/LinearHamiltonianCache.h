@@ -0,0 +1,56 @@
+#ifndef SPINNER_LINEARHAMILTONIANCACHE_H
+#define SPINNER_LINEARHAMILTONIANCACHE_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "src/entities/matrix/Submatrix.h"
+#include "src/model/symbols/SymbolName.h"
+
+namespace eigendecompositor {
+
+// Hamiltonian is linear in J and D symbols: H = H_0 + \sum_k p_k H_k,
+// where H_k is the derivative of the Hamiltonian with respect to the changeable symbol p_k.
+// LinearHamiltonianCache constructs H_0 and H_k of every block only once and keeps
+// the union of their sparsity patterns and their values at the stored elements of the pattern.
+// Then the Hamiltonian submatrix for the current values of symbols is assembled
+// by writing \sum_k p_k H_k values into a copy of the pattern,
+// without construction of terms and of the sparsity pattern.
+class LinearHamiltonianCache {
+  public:
+    struct SymbolPart {
+        model::symbols::SymbolName symbol_name;
+        std::shared_ptr<const model::operators::Operator> operator_derivative;
+        std::function<double()> currentValueGetter;
+    };
+
+    LinearHamiltonianCache(
+        std::vector<SymbolPart> symbol_parts,
+        std::shared_ptr<const index_converter::AbstractIndexConverter> converter,
+        quantum::linear_algebra::FactoriesList factories_list,
+        bool return_sparse_if_possible = false);
+
+    void initialize(uint32_t number_of_subspaces);
+    // thread-safe for different blocks
+    Submatrix construct(
+        size_t number_of_block,
+        const space::Subspace& subspace,
+        const model::operators::Operator& energy_operator);
+
+  private:
+    std::vector<SymbolPart> symbol_parts_;
+    std::shared_ptr<const index_converter::AbstractIndexConverter> converter_;
+    quantum::linear_algebra::FactoriesList factories_list_;
+    bool return_sparse_if_possible_;
+    // sparsity pattern of every block, raw_data is nullptr until the first construction of the block:
+    std::vector<Submatrix> pattern_submatrices_;
+    // values of H_0 of every block at the stored elements of the pattern:
+    std::vector<std::vector<double>> constant_values_;
+    // values of H_k of every block at the stored elements of the pattern, in the order of symbol_parts_:
+    std::vector<std::vector<std::vector<double>>> symbol_values_;
+};
+
+}  // namespace eigendecompositor
+
+#endif  //SPINNER_LINEARHAMILTONIANCACHE_H
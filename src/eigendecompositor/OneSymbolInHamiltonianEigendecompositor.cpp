@@ -7,8 +7,10 @@ namespace eigendecompositor {
 
 OneSymbolInHamiltonianEigendecompositor::OneSymbolInHamiltonianEigendecompositor(
     std::unique_ptr<AbstractEigendecompositor> eigendecompositor,
-    std::function<double()> currentValueGetter) :
+    std::function<double()> currentValueGetter,
+    bool keep_eigenvectors) :
     eigendecompositor_(std::move(eigendecompositor)),
+    keep_eigenvectors_(keep_eigenvectors),
     currentValueGetter_(std::move(currentValueGetter)) {
     initial_value_of_symbol_ = currentValueGetter_();
     if (std::abs(initial_value_of_symbol_) < 1e-9) {
@@ -27,7 +29,9 @@ OneSymbolInHamiltonianEigendecompositor::BuildSubspectra(
             number_of_block,
             subspace);
 
-        eigenvectors_[number_of_block] = mb_unitary_transformation_matrix;
+        if (keep_eigenvectors_) {
+            eigenvectors_[number_of_block] = mb_unitary_transformation_matrix;
+        }
 
         const auto energy_subspectrum = eigendecompositor_->getSubspectrum(common::Energy, number_of_block).value();
 
@@ -53,6 +57,7 @@ OneSymbolInHamiltonianEigendecompositor::BuildSubspectra(
                 return Submatrix(std::move(raw_matrix), energy_submatrix.get().properties);    
         }), energy_submatrix);
 #endif
+        return mb_unitary_transformation_matrix;
     } else {
         double current_value_of_symbol = currentValueGetter_();
         double multiplier = current_value_of_symbol / initial_value_of_symbol_;
@@ -139,6 +144,25 @@ void OneSymbolInHamiltonianEigendecompositor::initialize(
             "More than two energy derivatives passed to OneParameterEigendecompositor");
     }
 
+    bool do_we_need_eigenvectors =
+        operators_to_calculate.size() > 1 || !derivatives_operators_to_calculate.empty();
+    bool are_eigenvectors_released = !keep_eigenvectors_ && do_we_need_eigenvectors;
+    if (first_iteration_has_been_done_ && (are_eigenvectors_released || number_of_seeds_has_been_increased_)) {
+        // spectra are calculated again at the current value of the symbol:
+        double current_value_of_symbol = currentValueGetter_();
+        if (std::abs(current_value_of_symbol) >= 1e-9) {
+            initial_value_of_symbol_ = current_value_of_symbol;
+            first_iteration_has_been_done_ = false;
+            number_of_seeds_has_been_increased_ = false;
+        } else if (are_eigenvectors_released) {
+            throw std::invalid_argument(
+                "Current value of the symbol is too small to rebuild eigenvectors "
+                "inside OneSymbolInHamiltonianEigendecompositor");
+        }
+        // otherwise spectra with new seeds are built at the first non-zero value of the symbol,
+        // until then the previous ones are rescaled
+    }
+
     if (!first_iteration_has_been_done_) {
         eigendecompositor_->initialize(
             operators_to_calculate,
@@ -157,6 +181,16 @@ void OneSymbolInHamiltonianEigendecompositor::initialize(
     }
 }
 
+bool OneSymbolInHamiltonianEigendecompositor::increaseNumberOfSeeds() {
+    if (!eigendecompositor_->increaseNumberOfSeeds()) {
+        return false;
+    }
+    // spectra are rebuilt with new seeds at the next iteration and rescaled from it then,
+    // but they cannot be rebuilt at the zero value of the symbol, so the new seeds wait for the non-zero one:
+    number_of_seeds_has_been_increased_ = true;
+    return std::abs(currentValueGetter_()) >= 1e-9;
+}
+
 void OneSymbolInHamiltonianEigendecompositor::finalize() {
     if (!first_iteration_has_been_done_) {
         eigendecompositor_->finalize();
@@ -10,7 +10,8 @@ class OneSymbolInHamiltonianEigendecompositor: public AbstractEigendecompositor
   public:
     OneSymbolInHamiltonianEigendecompositor(
         std::unique_ptr<AbstractEigendecompositor> eigendecompositor,
-        std::function<double()> currentValueGetter);
+        std::function<double()> currentValueGetter,
+        bool keep_eigenvectors = true);
     std::optional<OneOrMany<std::shared_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix>>>
     BuildSubspectra(
         size_t number_of_block,
@@ -36,6 +37,7 @@ class OneSymbolInHamiltonianEigendecompositor: public AbstractEigendecompositor
             std::shared_ptr<const model::operators::Operator>>& derivatives_operators_to_calculate,
         uint32_t number_of_subspaces) override;
     void finalize() override;
+    bool increaseNumberOfSeeds() override;
 
   private:
     std::unique_ptr<AbstractEigendecompositor> eigendecompositor_;
@@ -44,11 +46,16 @@ class OneSymbolInHamiltonianEigendecompositor: public AbstractEigendecompositor
     std::vector<
         std::optional<OneOrMany<std::shared_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix>>>>
         eigenvectors_;
+    // if false, eigenvectors are not kept between iterations. If they are required by other quantities,
+    // the spectra are rebuilt at the current value of the symbol instead of rescaling:
+    bool keep_eigenvectors_;
 #ifndef NDEBUG
     std::vector<OneOrMany<Submatrix>> current_energy_matrix_;
 #endif
     double initial_value_of_symbol_;
     bool first_iteration_has_been_done_ = false;
+    // the inner eigendecompositor has got new seeds, but spectra have not been rebuilt with them yet:
+    bool number_of_seeds_has_been_increased_ = false;
     std::function<double()> currentValueGetter_;
 };
 
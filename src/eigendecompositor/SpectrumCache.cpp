@@ -0,0 +1,335 @@
+#include "SpectrumCache.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <typeinfo>
+#include <vector>
+
+#include "magic_enum.hpp"
+#include "src/common/CacheFile.h"
+#include "src/common/Logger.h"
+#include "src/space/SpaceCache.h"
+
+namespace {
+const char MAGIC[8] = {'S', 'P', 'I', 'N', 'N', 'E', 'R', '1'};
+const std::string EXTENSION = ".spectra";
+
+enum VectorKind : uint32_t { SPECTRUM, DERIVATIVE_SPECTRUM, DERIVATIVE_PRODUCT_SPECTRUM, WEIGHTS };
+
+// All offsets are counted from the beginning of the file.
+// Layout: Header | key | Records | symbol names | values (aligned to 8 bytes).
+struct Header {
+    char magic[8];
+    uint64_t file_size;
+    uint64_t key_size;
+    uint64_t number_of_records;
+};
+
+struct Record {
+    uint32_t kind;
+    uint32_t quantity_enum;
+    uint32_t quantity_enum_derivative;
+    uint32_t symbol_name_size;
+    uint64_t symbol_name_offset;
+    uint64_t values_offset;
+    uint64_t number_of_values;
+};
+
+// exact (hexadecimal) representation of double:
+std::string exactString(double value) {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%a", value);
+    return buffer;
+}
+
+struct VectorToStore {
+    Record record;
+    std::string symbol_name;
+    const quantum::linear_algebra::AbstractDenseVector* vector;
+};
+
+bool holdsOneVector(const OneOrMany<std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>& one_or_many) {
+    return holdsOne(one_or_many) && getOneRef(one_or_many) != nullptr;
+}
+
+}  // namespace
+
+namespace eigendecompositor {
+
+void SpectrumCache::setDirectory(std::filesystem::path directory) {
+    std::error_code error_code;
+    std::filesystem::create_directories(directory, error_code);
+    if (error_code || !std::filesystem::is_directory(directory)) {
+        throw std::invalid_argument(
+            "Cannot create directory of spectrum cache: " + directory.string());
+    }
+    directory_ = std::move(directory);
+}
+
+void SpectrumCache::setSizeLimit(size_t size_limit) {
+    if (size_limit == 0) {
+        throw std::invalid_argument("Size limit of spectrum cache must be positive");
+    }
+    size_limit_ = size_limit;
+}
+
+bool SpectrumCache::isEnabled() {
+    return directory_.has_value();
+}
+
+void SpectrumCache::disable() {
+    directory_ = std::nullopt;
+    size_limit_ = std::numeric_limits<size_t>::max();
+}
+
+std::string SpectrumCache::constructKey(
+    const runner::ConsistentModelOptimizationList& consistentModelOptimizationList,
+    const quantum::linear_algebra::FactoriesList& factories) {
+    std::ostringstream key;
+    // Space depends on multiplicities and optimizations, so its key is the beginning of this key:
+    key << space::SpaceCache::constructKey(consistentModelOptimizationList);
+
+    const auto& mults = consistentModelOptimizationList.getIndexConverter()->get_mults();
+    const auto& symbolic_worker = consistentModelOptimizationList.getModel().getSymbolicWorker();
+    key << "\nsymbols:";
+    for (const auto& symbol_name : symbolic_worker.getAllNames()) {
+        auto property = symbolic_worker.getSymbolProperty(symbol_name);
+        key << ' ' << symbol_name.get_name() << '=' << exactString(symbolic_worker.getValueOfName(symbol_name))
+            << (property.is_changeable ? ",changeable" : ",fixed");
+        if (property.type_enum.has_value()) {
+            key << ',' << magic_enum::enum_name(property.type_enum.value());
+        }
+    }
+    if (symbolic_worker.isIsotropicExchangeInitialized()) {
+        key << "\nJ:";
+        for (size_t i = 0; i < mults.size(); ++i) {
+            for (size_t j = i + 1; j < mults.size(); ++j) {
+                auto mb_symbol_name = symbolic_worker.getIsotropicExchangeSymbolName(i, j);
+                if (mb_symbol_name.has_value()) {
+                    key << ' ' << i << '-' << j << '=' << mb_symbol_name->get_name();
+                }
+            }
+        }
+    }
+    if (symbolic_worker.isGFactorInitialized()) {
+        key << "\ng:";
+        for (size_t i = 0; i < mults.size(); ++i) {
+            key << ' ' << symbolic_worker.getGFactorSymbolName(i).get_name();
+        }
+    }
+    if (symbolic_worker.isThetaInitialized()) {
+        key << "\nTheta: " << symbolic_worker.getThetaSymbolName()->get_name();
+    }
+    if (symbolic_worker.isZFSInitialized()) {
+        key << "\nZFS:";
+        for (size_t i = 0; i < mults.size(); ++i) {
+            auto mb_zfs_symbols = symbolic_worker.getZFSSymbolNames(i);
+            if (mb_zfs_symbols.has_value()) {
+                key << ' ' << i << '=' << mb_zfs_symbols->D.get_name();
+                if (mb_zfs_symbols->E.has_value()) {
+                    key << ',' << mb_zfs_symbols->E->get_name();
+                }
+            }
+        }
+    }
+
+    key << "\noperators:";
+    for (const auto& [quantity_enum, _] : consistentModelOptimizationList.getOperatorsForExplicitConstruction()) {
+        key << ' ' << magic_enum::enum_name(quantity_enum);
+    }
+    key << "\nderivatives:";
+    for (const auto& [derivative_key, _] :
+         consistentModelOptimizationList.getDerivativeOperatorsForExplicitConstruction()) {
+        key << ' ' << magic_enum::enum_name(derivative_key.first) << '/' << derivative_key.second.get_name();
+    }
+
+    const auto& optimization_list = consistentModelOptimizationList.getOptimizationList();
+    key << "\nspectrum optimizations:";
+    if (optimization_list.isBoltzmannWindowed()) {
+        const auto& settings = optimization_list.getBoltzmannWindowSettings();
+        key << " boltzmann_window=" << exactString(settings.max_temperature) << ','
+            << exactString(settings.number_of_kT);
+    }
+    if (optimization_list.isWarmStarted()) {
+        const auto& settings = optimization_list.getWarmStartSettings();
+        key << " warm_start=" << exactString(settings.tolerance) << ',' << settings.max_iterations;
+    }
+    if (optimization_list.isDegeneracyCompressed()) {
+        key << " degeneracy_compression=" << exactString(optimization_list.getDegeneracyCompressionSettings().tolerance);
+    }
+
+    const auto& dense_factory = *factories.getDenseFactory();
+    key << "\nbackend: " << typeid(dense_factory).name() << ','
+        << magic_enum::enum_name(dense_factory.getPrecision());
+
+    return key.str();
+}
+
+bool SpectrumCache::load(
+    const std::string& key,
+    FlattenedSpectra& flattenedSpectra,
+    const quantum::linear_algebra::FactoriesList& factories) {
+    if (!isEnabled()) {
+        return false;
+    }
+    auto path = common::cache::pathOfEntry(directory_.value(), key, EXTENSION);
+    if (!std::filesystem::exists(path)) {
+        return false;
+    }
+    common::cache::MappedFile file(path);
+    if (!file.contains(0, sizeof(Header))) {
+        return false;
+    }
+    Header header;
+    std::memcpy(&header, file.data(), sizeof(Header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.file_size != file.size()
+        || !file.contains(sizeof(Header), header.key_size)
+        || std::string_view(file.data() + sizeof(Header), header.key_size) != key) {
+        // the file is corrupted or it is a hash collision:
+        return false;
+    }
+    uint64_t records_offset = common::cache::alignTo8(sizeof(Header) + header.key_size);
+    if (!file.containsArray<Record>(records_offset, header.number_of_records)) {
+        return false;
+    }
+
+    FlattenedSpectra loaded;
+    for (uint64_t i = 0; i < header.number_of_records; ++i) {
+        Record record;
+        std::memcpy(&record, file.data() + records_offset + i * sizeof(Record), sizeof(Record));
+        if (!file.contains(record.symbol_name_offset, record.symbol_name_size)
+            || !file.containsArray<double>(record.values_offset, record.number_of_values)) {
+            return false;
+        }
+        auto mb_quantity_enum = magic_enum::enum_cast<common::QuantityEnum>(record.quantity_enum);
+        auto mb_quantity_enum_derivative =
+            magic_enum::enum_cast<common::QuantityEnum>(record.quantity_enum_derivative);
+        if (!mb_quantity_enum.has_value() || !mb_quantity_enum_derivative.has_value()) {
+            return false;
+        }
+        model::symbols::SymbolName symbol_name(
+            std::string(file.data() + record.symbol_name_offset, record.symbol_name_size));
+
+        auto vector = factories.createVector();
+        vector->assign_values(
+            reinterpret_cast<const double*>(file.data() + record.values_offset),
+            record.number_of_values);
+        if (record.kind == SPECTRUM) {
+            loaded.flattenedSpectra_[mb_quantity_enum.value()] = std::move(vector);
+        } else if (record.kind == DERIVATIVE_SPECTRUM) {
+            loaded.flattenedDerivativeSpectra_[{mb_quantity_enum.value(), symbol_name}] = std::move(vector);
+        } else if (record.kind == DERIVATIVE_PRODUCT_SPECTRUM) {
+            loaded.flattenedDerivativeProductSpectra_
+                [{mb_quantity_enum.value(), {mb_quantity_enum_derivative.value(), symbol_name}}] =
+                std::move(vector);
+        } else if (record.kind == WEIGHTS) {
+            loaded.flattenedWeights_ = std::move(vector);
+        } else {
+            return false;
+        }
+    }
+
+    flattenedSpectra.flattenedSpectra_ = std::move(loaded.flattenedSpectra_);
+    flattenedSpectra.flattenedDerivativeSpectra_ = std::move(loaded.flattenedDerivativeSpectra_);
+    flattenedSpectra.flattenedDerivativeProductSpectra_ = std::move(loaded.flattenedDerivativeProductSpectra_);
+    flattenedSpectra.flattenedWeights_ = std::move(loaded.flattenedWeights_);
+
+    common::cache::markAsRecentlyUsed(path);
+    return true;
+}
+
+void SpectrumCache::store(const std::string& key, const FlattenedSpectra& flattenedSpectra) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    std::vector<VectorToStore> vectors;
+    auto add_vector = [&vectors](
+        VectorKind kind,
+        common::QuantityEnum quantity_enum,
+        common::QuantityEnum quantity_enum_derivative,
+        const model::symbols::SymbolName& symbol_name,
+        const OneOrMany<std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>& one_or_many) {
+        if (!holdsOneVector(one_or_many)) {
+            return false;
+        }
+        Record record{};
+        record.kind = kind;
+        record.quantity_enum = quantity_enum;
+        record.quantity_enum_derivative = quantity_enum_derivative;
+        vectors.push_back({record, symbol_name.get_name(), getOneRef(one_or_many).get()});
+        return true;
+    };
+    // only the exact spectra (one vector per quantity) are stored:
+    bool can_be_stored = add_vector(WEIGHTS, common::Energy, common::Energy, {}, flattenedSpectra.flattenedWeights_);
+    for (const auto& [quantity_enum, spectrum] : flattenedSpectra.flattenedSpectra_) {
+        can_be_stored = can_be_stored && add_vector(SPECTRUM, quantity_enum, quantity_enum, {}, spectrum);
+    }
+    for (const auto& [derivative_key, spectrum] : flattenedSpectra.flattenedDerivativeSpectra_) {
+        const auto& [quantity_enum, symbol_name] = derivative_key;
+        can_be_stored = can_be_stored
+            && add_vector(DERIVATIVE_SPECTRUM, quantity_enum, quantity_enum, symbol_name, spectrum);
+    }
+    for (const auto& [derivative_product_key, spectrum] : flattenedSpectra.flattenedDerivativeProductSpectra_) {
+        const auto& [quantity_enum, derivative_key] = derivative_product_key;
+        const auto& [quantity_enum_derivative, symbol_name] = derivative_key;
+        can_be_stored = can_be_stored
+            && add_vector(DERIVATIVE_PRODUCT_SPECTRUM, quantity_enum, quantity_enum_derivative, symbol_name, spectrum);
+    }
+    if (!can_be_stored) {
+        return;
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.key_size = key.size();
+    header.number_of_records = vectors.size();
+    uint64_t records_offset = common::cache::alignTo8(sizeof(Header) + key.size());
+    uint64_t offset = records_offset + vectors.size() * sizeof(Record);
+    for (auto& vector : vectors) {
+        vector.record.symbol_name_offset = offset;
+        vector.record.symbol_name_size = vector.symbol_name.size();
+        offset += vector.symbol_name.size();
+    }
+    for (auto& vector : vectors) {
+        offset = common::cache::alignTo8(offset);
+        vector.record.values_offset = offset;
+        vector.record.number_of_values = vector.vector->size();
+        offset += vector.record.number_of_values * sizeof(double);
+    }
+    header.file_size = offset;
+
+    auto path = common::cache::pathOfEntry(directory_.value(), key, EXTENSION);
+    bool is_written = common::cache::writeEntry(path, [&](std::ofstream& stream) {
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        stream.write(key.data(), key.size());
+        common::cache::writePaddingTo8(stream);
+        for (const auto& vector : vectors) {
+            stream.write(reinterpret_cast<const char*>(&vector.record), sizeof(Record));
+        }
+        for (const auto& vector : vectors) {
+            stream.write(vector.symbol_name.data(), vector.symbol_name.size());
+        }
+        std::vector<double> values;
+        for (const auto& vector : vectors) {
+            common::cache::writePaddingTo8(stream);
+            values.resize(vector.record.number_of_values);
+            for (size_t i = 0; i < values.size(); ++i) {
+                values[i] = vector.vector->at(i);
+            }
+            stream.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+        }
+    });
+    if (!is_written) {
+        common::Logger::detailed("Spectra cannot be written to the cache: {}", path.string());
+        return;
+    }
+
+    common::cache::removeLeastRecentlyUsedEntries(directory_.value(), EXTENSION, size_limit_);
+}
+
+}  // namespace eigendecompositor
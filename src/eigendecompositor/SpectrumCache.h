@@ -0,0 +1,45 @@
+#ifndef SPINNER_SPECTRUMCACHE_H
+#define SPINNER_SPECTRUMCACHE_H
+
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <string>
+
+#include "src/common/runner/ConsistentModelOptimizationList.h"
+#include "src/eigendecompositor/FlattenedSpectra.h"
+#include "src/entities/data_structures/FactoriesList.h"
+
+namespace eigendecompositor {
+// Content-addressed on-disk cache of FlattenedSpectra.
+// The key describes everything the flattened spectra depend on: multiplicities, symbols and their values,
+// operators and derivatives to calculate, optimizations and linear algebra package. Every entry is one file,
+// whose name is the hash of the key. The file contains the key itself (to reject hash collisions)
+// and all flattened vectors as raw doubles, so it is read by memory mapping.
+// If the total size of the entries exceeds the size limit, the least recently used entries are removed.
+class SpectrumCache {
+  public:
+    // the cache is disabled, until the directory is set:
+    static void setDirectory(std::filesystem::path directory);
+    static void setSizeLimit(size_t size_limit);
+    static bool isEnabled();
+    // disables the cache and removes the size limit, entries on disk are kept:
+    static void disable();
+
+    static std::string constructKey(
+        const runner::ConsistentModelOptimizationList& consistentModelOptimizationList,
+        const quantum::linear_algebra::FactoriesList& factories);
+    // Returns true and replaces the content of flattenedSpectra, if the key is in the cache:
+    static bool load(
+        const std::string& key,
+        FlattenedSpectra& flattenedSpectra,
+        const quantum::linear_algebra::FactoriesList& factories);
+    static void store(const std::string& key, const FlattenedSpectra& flattenedSpectra);
+
+  private:
+    inline static std::optional<std::filesystem::path> directory_;
+    inline static size_t size_limit_ = std::numeric_limits<size_t>::max();
+};
+}  // namespace eigendecompositor
+
+#endif  //SPINNER_SPECTRUMCACHE_H
@@ -3,9 +3,11 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
+
+#include "AbstractDenseVector.h"
 
 namespace quantum::linear_algebra {
-class AbstractDenseVector;
 class AbstractDiagonalizableMatrix;
 
 // This class calculates UAU* main diagonals:
@@ -13,8 +15,19 @@ class AbstractDenseSemiunitaryTransformer {
 public:
     virtual std::unique_ptr<AbstractDenseVector> calculateUnitaryTransformationOfMatrix(
         std::reference_wrapper<const std::unique_ptr<AbstractDiagonalizableMatrix>> matrix) const = 0;
+    // answer[i] is the main diagonal of U matrices[i] U*.
+    // Matrices are transformed one by one, if the transformer cannot share work between them.
+    virtual std::vector<std::unique_ptr<AbstractDenseVector>> calculateUnitaryTransformationOfMatrices(
+        const std::vector<std::reference_wrapper<const std::unique_ptr<AbstractDiagonalizableMatrix>>>& matrices) const {
+        std::vector<std::unique_ptr<AbstractDenseVector>> answer;
+        answer.reserve(matrices.size());
+        for (const auto& matrix : matrices) {
+            answer.push_back(calculateUnitaryTransformationOfMatrix(matrix));
+        }
+        return answer;
+    }
     virtual ~AbstractDenseSemiunitaryTransformer() = default;
 };
 } // namespace quantum::linear_algebra
 
-#endif  //SPINNER_ABSTRACTDENSESEMIUNITARYTRANSFORMER_H
\ No newline at end of file
+#endif  //SPINNER_ABSTRACTDENSESEMIUNITARYTRANSFORMER_H
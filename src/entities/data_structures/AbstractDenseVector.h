@@ -2,13 +2,18 @@
 #define SPINNER_ABSTRACTDENSEVECTOR_H
 
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace quantum::linear_algebra {
 class AbstractDenseVector {
   public:
     virtual void concatenate_with(const std::unique_ptr<AbstractDenseVector>& rhs) = 0;
     virtual void add_identical_values(size_t number, double value) = 0;
+    // replaces the content of vector by the first size elements of values:
+    virtual void assign_values(const double* values, size_t size) = 0;
     virtual void subtract_minimum() = 0;
     virtual void wise_exp() = 0;
 
@@ -19,6 +24,14 @@ class AbstractDenseVector {
       const std::unique_ptr<AbstractDenseVector>& third) const = 0;
     virtual std::unique_ptr<AbstractDenseVector>
     element_wise_multiplication(const std::unique_ptr<AbstractDenseVector>& rhs) const = 0;
+    // The vector is treated as energies E_i. For every temperature T_j calculates
+    // partition function Z_j = sum_i w_i exp(-E_i/T_j) and numerators sum_i v_i w_i exp(-E_i/T_j)
+    // of every value vector v in one pass over energies, weights and values.
+    // Returns {numerators[value][temperature], partition_functions[temperature]}:
+    virtual std::pair<std::vector<std::vector<double>>, std::vector<double>> boltzmann_sums(
+        const std::unique_ptr<AbstractDenseVector>& weights,
+        const std::vector<std::reference_wrapper<const std::unique_ptr<AbstractDenseVector>>>& values,
+        const std::vector<double>& temperatures) const = 0;
 
     virtual uint32_t size() const = 0;
     virtual double at(uint32_t i) const = 0;
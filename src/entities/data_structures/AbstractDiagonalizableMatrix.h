@@ -1,6 +1,10 @@
 #ifndef SPINNER_ABSTRACTDIAGONALIZABLESYMMETRICMATRIX_H
 #define SPINNER_ABSTRACTDIAGONALIZABLESYMMETRICMATRIX_H
 
+#include <memory>
+#include <optional>
+#include <vector>
+
 #include "AbstractDenseVector.h"
 #include "AbstractSymmetricMatrix.h"
 
@@ -22,10 +26,31 @@ struct KrylovTriple {
   std::unique_ptr<AbstractDenseVector> ftlm_weights_of_states;
 };
 
-class AbstractDiagonalizableMatrix: public AbstractSymmetricMatrix {
+// Krylov procedure of a seed is stopped before krylov_subspace_size steps,
+// if Ritz values within energy_window above the lowest one have changed
+// less than tolerance * (spectral radius of Krylov matrix) between consecutive checks.
+struct KrylovConvergence {
+    double tolerance;
+    double energy_window;
+};
+
+class AbstractDiagonalizableMatrix:
+    public AbstractSymmetricMatrix,
+    public std::enable_shared_from_this<AbstractDiagonalizableMatrix> {
   public:
     virtual EigenCouple diagonalizeValuesVectors() const = 0;
     virtual std::unique_ptr<AbstractDenseVector> diagonalizeValues() const = 0;
+    // only eigenpairs with eigenvalues not greater than (the lowest eigenvalue + energy_window):
+    virtual EigenCouple diagonalizeValuesVectorsInWindow(double energy_window) const = 0;
+    // Rayleigh-Ritz refinement of approximate eigenvectors (e.g. from the previous iteration),
+    // returns std::nullopt, if the relative residuals have not converged within max_iterations.
+    // If energy_window is set, initial eigenvectors are the lowest ones within the window,
+    // and std::nullopt is also returned, if other states could have come into the window:
+    virtual std::optional<EigenCouple> refineDiagonalizeValuesVectors(
+      const AbstractDenseSemiunitaryMatrix& initial_eigenvectors,
+      double tolerance,
+      size_t max_iterations,
+      std::optional<double> energy_window) const = 0;
 
     virtual KrylovCouple krylovDiagonalizeValues(
       const std::unique_ptr<AbstractDenseVector>& seed_vector,
@@ -33,8 +58,38 @@ class AbstractDiagonalizableMatrix: public AbstractSymmetricMatrix {
     virtual KrylovTriple krylovDiagonalizeValuesVectors(
       const std::unique_ptr<AbstractDenseVector>& seed_vector,
       size_t krylov_subspace_size) const = 0;
+    // the same for several seeds: all seeds are advanced together,
+    // so the matrix is read from memory once per Krylov step.
+    // Spectrum of a seed is smaller than krylov_subspace_size, if its Krylov subspace is invariant
+    // or if convergence is set and the seed has converged earlier.
+    virtual std::vector<KrylovCouple> krylovDiagonalizeValues(
+      const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+      size_t krylov_subspace_size,
+      const std::optional<KrylovConvergence>& convergence) const = 0;
+    virtual std::vector<KrylovTriple> krylovDiagonalizeValuesVectors(
+      const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+      size_t krylov_subspace_size,
+      const std::optional<KrylovConvergence>& convergence) const = 0;
+    // two-pass Lanczos procedure: Krylov vectors are not stored, but regenerated from Krylov matrices
+    // in every unitary transformation, so O(size) memory is used per seed
+    // at the cost of krylov_subspace_size more matrix products per transformation.
+    // Eigenvectors share the ownership of this matrix, so it has to be owned by std::shared_ptr.
+    virtual std::vector<KrylovTriple> krylovDiagonalizeValuesVectorsTwoPass(
+      const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+      size_t krylov_subspace_size,
+      const std::optional<KrylovConvergence>& convergence) const = 0;
 
     virtual std::unique_ptr<AbstractDiagonalizableMatrix> multiply_by(double multiplier) const = 0;
+    // this += multiplier * rhs, rhs must have the same type and size
+    virtual void add_scaled(double multiplier, const AbstractDiagonalizableMatrix& rhs) = 0;
+    // Stored elements of rhs are added to stored elements of this matrix as explicit zeros,
+    // rhs must have the same type and size. All elements of dense matrices are stored.
+    virtual void add_sparsity_pattern(const AbstractDiagonalizableMatrix& rhs) = 0;
+    // values of rhs at stored elements of this matrix in the order of storage,
+    // stored elements of rhs must be a subset of stored elements of this matrix:
+    virtual std::vector<double> stored_values_of(const AbstractDiagonalizableMatrix& rhs) const = 0;
+    // overwrites stored values (e.g. returned by stored_values_of) without changing the sparsity pattern:
+    virtual void assign_stored_values(const std::vector<double>& values) = 0;
     ~AbstractDiagonalizableMatrix() override = default;
 };
 }  // namespace quantum::linear_algebra
@@ -5,12 +5,15 @@
 #include "AbstractDenseSemiunitaryMatrix.h"
 #include "AbstractDenseVector.h"
 #include "AbstractDiagonalizableMatrix.h"
+#include "AbstractMatrixFreeOperator.h"
 #include "AbstractSparseSemiunitaryMatrix.h"
 #include "AbstractSymmetricMatrix.h"
 
 namespace quantum::linear_algebra {
 
-enum Precision { SINGLE, DOUBLE };
+// MIXED: dense matrices are diagonalized in single precision, then eigenpairs are refined
+// to double precision; all other data structures are in double precision.
+enum Precision { SINGLE, DOUBLE, MIXED };
 
 class AbstractDenseTransformAndDiagonalizeFactory {
   public:
@@ -19,6 +22,9 @@ class AbstractDenseTransformAndDiagonalizeFactory {
     createDenseDiagonalizableMatrix(uint32_t size) = 0;
     virtual std::unique_ptr<AbstractDiagonalizableMatrix>
     createSparseDiagonalizableMatrix(uint32_t size) = 0;
+    // matrix, which is applied to vectors on the fly, can be used only in Krylov procedures:
+    virtual std::unique_ptr<AbstractDiagonalizableMatrix>
+    createMatrixFreeDiagonalizableMatrix(std::shared_ptr<const AbstractMatrixFreeOperator> matrix_free_operator) = 0;
     virtual std::unique_ptr<AbstractDenseSemiunitaryMatrix>
     createDenseSemiunitaryMatrix(uint32_t cols, uint32_t rows) = 0;
     virtual std::vector<std::unique_ptr<AbstractDenseVector>> createRandomUnitVectors(uint32_t size_of_vector, uint32_t number_of_vectors) = 0;
@@ -42,6 +48,9 @@ class AbstractSparseTransformFactory {
     virtual std::unique_ptr<AbstractSparseSemiunitaryMatrix>
     createSparseSemiunitaryMatrix(uint32_t cols, uint32_t rows) = 0;
     virtual std::unique_ptr<AbstractSymmetricMatrix> createSparseSymmetricMatrix(uint32_t size) = 0;
+    // matrix, which stores only rows and columns of the given vectors:
+    virtual std::unique_ptr<AbstractSymmetricMatrix>
+    createLocalSparseSymmetricMatrix(std::vector<uint32_t> indexes_of_vectors) = 0;
 
     ~AbstractSparseTransformFactory() = default;
 };
@@ -0,0 +1,19 @@
+#ifndef SPINNER_ABSTRACTMATRIXFREEOPERATOR_H
+#define SPINNER_ABSTRACTMATRIXFREEOPERATOR_H
+
+#include <cstdint>
+
+namespace quantum::linear_algebra {
+// Symmetric matrix, which is not stored, but applied to vectors on the fly.
+class AbstractMatrixFreeOperator {
+  public:
+    virtual uint32_t size() const = 0;
+    // y = A * x for number_of_vectors column-major vectors of size(), x and y must not overlap:
+    virtual void apply(const double* x, double* y, uint32_t number_of_vectors) const = 0;
+    virtual void apply(const float* x, float* y, uint32_t number_of_vectors) const = 0;
+
+    virtual ~AbstractMatrixFreeOperator() = default;
+};
+}  // namespace quantum::linear_algebra
+
+#endif  //SPINNER_ABSTRACTMATRIXFREEOPERATOR_H
@@ -13,6 +13,12 @@ FactoriesList::createSparseDiagonalizableMatrix(uint32_t size) const {
     return denseFactory_->createSparseDiagonalizableMatrix(size);
 }
 
+std::unique_ptr<AbstractDiagonalizableMatrix>
+FactoriesList::createMatrixFreeDiagonalizableMatrix(
+    std::shared_ptr<const AbstractMatrixFreeOperator> matrix_free_operator) const {
+    return denseFactory_->createMatrixFreeDiagonalizableMatrix(std::move(matrix_free_operator));
+}
+
 std::unique_ptr<AbstractDenseSemiunitaryMatrix>
 FactoriesList::createDenseSemiunitaryMatrix(uint32_t cols, uint32_t rows) const {
     return denseFactory_->createDenseSemiunitaryMatrix(cols, rows);
@@ -37,10 +43,20 @@ FactoriesList::createSparseSymmetricMatrix(uint32_t size) const {
     return sparseFactory_->createSparseSymmetricMatrix(size);
 }
 
+std::unique_ptr<AbstractSymmetricMatrix>
+FactoriesList::createLocalSparseSymmetricMatrix(std::vector<uint32_t> indexes_of_vectors) const {
+    return sparseFactory_->createLocalSparseSymmetricMatrix(std::move(indexes_of_vectors));
+}
+
 FactoriesList::FactoriesList(
     std::shared_ptr<AbstractDenseTransformAndDiagonalizeFactory> symmetricMatrixFactory,
     std::shared_ptr<AbstractSparseTransformFactory> sparseMatrix) {
     denseFactory_ = symmetricMatrixFactory;
     sparseFactory_ = sparseMatrix;
 }
+
+const std::shared_ptr<AbstractDenseTransformAndDiagonalizeFactory>& FactoriesList::getDenseFactory() const {
+    return denseFactory_;
+}
+
 }  // namespace quantum::linear_algebra
\ No newline at end of file
@@ -22,6 +22,8 @@ class FactoriesList {
     createDenseDiagonalizableMatrix(uint32_t size) const;
     std::unique_ptr<AbstractDiagonalizableMatrix>
     createSparseDiagonalizableMatrix(uint32_t size) const;
+    std::unique_ptr<AbstractDiagonalizableMatrix>
+    createMatrixFreeDiagonalizableMatrix(std::shared_ptr<const AbstractMatrixFreeOperator> matrix_free_operator) const;
     std::unique_ptr<AbstractDenseSemiunitaryMatrix>
     createDenseSemiunitaryMatrix(uint32_t cols, uint32_t rows) const;
     std::vector<std::unique_ptr<AbstractDenseVector>> createRandomUnitVectors(uint32_t size_of_vector, uint32_t number_of_vectors) const;
@@ -29,6 +31,10 @@ class FactoriesList {
     std::unique_ptr<AbstractSparseSemiunitaryMatrix>
     createSparseSemiunitaryMatrix(uint32_t cols, uint32_t rows) const;
     std::unique_ptr<AbstractSymmetricMatrix> createSparseSymmetricMatrix(uint32_t size) const;
+    std::unique_ptr<AbstractSymmetricMatrix>
+    createLocalSparseSymmetricMatrix(std::vector<uint32_t> indexes_of_vectors) const;
+
+    const std::shared_ptr<AbstractDenseTransformAndDiagonalizeFactory>& getDenseFactory() const;
 
   private:
     std::shared_ptr<AbstractDenseTransformAndDiagonalizeFactory> denseFactory_;
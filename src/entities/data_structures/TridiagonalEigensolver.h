@@ -0,0 +1,120 @@
+#ifndef SPINNER_TRIDIAGONALEIGENSOLVER_H
+#define SPINNER_TRIDIAGONALEIGENSOLVER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace quantum::linear_algebra {
+
+// Symmetric tridiagonal matrix, for example, Krylov matrix of Lanczos procedure.
+// subdiagonal[i] is the element (i, i+1) and (i+1, i).
+struct SymmetricTridiagonalMatrix {
+    std::vector<double> diagonal;
+    std::vector<double> subdiagonal;
+};
+
+// Implicit QL algorithm with Wilkinson shifts (tql2 of EISPACK) for symmetric tridiagonal matrix.
+// Returns eigenvalues in ascending order. Givens rotations are applied only to the first
+// number_of_rows rows of eigenvectors, so the first components of eigenvectors (number_of_rows = 1)
+// cost O(n^2) operations instead of O(n^3), while number_of_rows = n gives all eigenvectors.
+// eigenvectors_rows is (number_of_rows x n) column-major matrix, its k-th column
+// is the beginning of the k-th eigenvector.
+inline std::vector<double> diagonalizeSymmetricTridiagonal(
+    const SymmetricTridiagonalMatrix& matrix,
+    size_t number_of_rows,
+    std::vector<double>& eigenvectors_rows) {
+    const size_t max_iterations_per_eigenvalue = 30;
+    const int n = matrix.diagonal.size();
+    if (matrix.subdiagonal.size() + 1 != matrix.diagonal.size() && n != 0) {
+        throw std::length_error("Sizes of diagonal and subdiagonal of tridiagonal matrix do not match");
+    }
+    if (number_of_rows > (size_t)n) {
+        throw std::length_error("Number of rows of eigenvectors bigger than size of matrix");
+    }
+    const size_t m = number_of_rows;
+
+    std::vector<double> d = matrix.diagonal;
+    std::vector<double> e = matrix.subdiagonal;
+    e.push_back(0);
+    std::vector<double> z(m * n, 0);
+    for (size_t k = 0; k < m; ++k) {
+        z[k + k * m] = 1;
+    }
+
+    for (int l = 0; l < n; ++l) {
+        size_t iteration = 0;
+        int j;
+        do {
+            // looking for small subdiagonal element to split the matrix:
+            for (j = l; j < n - 1; ++j) {
+                double dd = std::abs(d[j]) + std::abs(d[j + 1]);
+                if (std::abs(e[j]) <= std::numeric_limits<double>::epsilon() * dd) {
+                    break;
+                }
+            }
+            if (j == l) {
+                break;
+            }
+            if (iteration++ == max_iterations_per_eigenvalue) {
+                throw std::logic_error("QL algorithm for tridiagonal matrix has not converged");
+            }
+            double g = (d[l + 1] - d[l]) / (2 * e[l]);
+            double r = std::hypot(g, 1.0);
+            g = d[j] - d[l] + e[l] / (g + std::copysign(r, g));
+            double s = 1, c = 1, p = 0;
+            int i;
+            for (i = j - 1; i >= l; --i) {
+                double f = s * e[i];
+                double b = c * e[i];
+                r = std::hypot(f, g);
+                e[i + 1] = r;
+                if (r == 0) {
+                    // underflow, the matrix splits:
+                    d[i + 1] -= p;
+                    e[j] = 0;
+                    break;
+                }
+                s = f / r;
+                c = g / r;
+                g = d[i + 1] - p;
+                r = (d[i] - g) * s + 2 * c * b;
+                p = s * r;
+                d[i + 1] = g + p;
+                g = c * r - b;
+                for (size_t k = 0; k < m; ++k) {
+                    double& z_k_i = z[k + i * m];
+                    double& z_k_next = z[k + (i + 1) * m];
+                    f = z_k_next;
+                    z_k_next = s * z_k_i + c * f;
+                    z_k_i = c * z_k_i - s * f;
+                }
+            }
+            if (r == 0 && i >= l) {
+                continue;
+            }
+            d[l] -= p;
+            e[l] = g;
+            e[j] = 0;
+        } while (j != l);
+    }
+
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&d](size_t a, size_t b) { return d[a] < d[b]; });
+    std::vector<double> eigenvalues(n);
+    eigenvectors_rows.resize(m * n);
+    for (int i = 0; i < n; ++i) {
+        eigenvalues[i] = d[order[i]];
+        std::copy_n(z.begin() + order[i] * m, m, eigenvectors_rows.begin() + i * m);
+    }
+    return eigenvalues;
+}
+
+}  // namespace quantum::linear_algebra
+
+#endif  //SPINNER_TRIDIAGONALEIGENSOLVER_H
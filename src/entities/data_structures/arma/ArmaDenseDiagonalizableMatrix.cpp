@@ -1,5 +1,10 @@
 #include "ArmaDenseDiagonalizableMatrix.h"
 
+#include <algorithm>
+#include <stdexcept>
+#include <typeinfo>
+#include <vector>
+
 #include "ArmaLogic.h"
 
 namespace quantum::linear_algebra {
@@ -26,6 +31,29 @@ std::unique_ptr<AbstractDenseVector> ArmaDenseDiagonalizableMatrix<T>::diagonali
     return logic.diagonalizeValues(*this);
 }
 
+template <typename T>
+EigenCouple ArmaDenseDiagonalizableMatrix<T>::diagonalizeValuesVectorsInWindow(double energy_window) const {
+    ArmaLogic<T> logic;
+
+    return logic.diagonalizeValuesVectorsInWindow(*this, energy_window);
+}
+
+template <typename T>
+std::optional<EigenCouple> ArmaDenseDiagonalizableMatrix<T>::refineDiagonalizeValuesVectors(
+    const AbstractDenseSemiunitaryMatrix& initial_eigenvectors,
+    double tolerance,
+    size_t max_iterations,
+    std::optional<double> energy_window) const {
+    ArmaLogic<T> logic;
+
+    return logic.refineDiagonalizeValuesVectors(
+        *this,
+        initial_eigenvectors,
+        tolerance,
+        max_iterations,
+        energy_window);
+}
+
 template <typename T>
 KrylovCouple ArmaDenseDiagonalizableMatrix<T>::krylovDiagonalizeValues(
     const std::unique_ptr<AbstractDenseVector>& seed_vector,
@@ -50,15 +78,90 @@ KrylovTriple ArmaDenseDiagonalizableMatrix<T>::krylovDiagonalizeValuesVectors(
         krylov_subspace_size);
 }
 
+template <typename T>
+std::vector<KrylovCouple> ArmaDenseDiagonalizableMatrix<T>::krylovDiagonalizeValues(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    ArmaLogic<T> logic;
+    return logic.krylovDiagonalizeValues(*this, seed_vectors, krylov_subspace_size, convergence);
+}
+
+template <typename T>
+std::vector<KrylovTriple> ArmaDenseDiagonalizableMatrix<T>::krylovDiagonalizeValuesVectors(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    ArmaLogic<T> logic;
+    return logic.krylovDiagonalizeValuesVectors(*this, seed_vectors, krylov_subspace_size, convergence);
+}
+
+template <typename T>
+std::vector<KrylovTriple> ArmaDenseDiagonalizableMatrix<T>::krylovDiagonalizeValuesVectorsTwoPass(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    ArmaLogic<T> logic;
+    return logic.krylovDiagonalizeValuesVectorsTwoPass(*this, seed_vectors, krylov_subspace_size, convergence);
+}
+
 template <typename T>
 std::unique_ptr<AbstractDiagonalizableMatrix>
 ArmaDenseDiagonalizableMatrix<T>::multiply_by(double multiplier) const {
     auto answer = std::make_unique<ArmaDenseDiagonalizableMatrix>();
     answer->resize(size());
     answer->denseDiagonalizableMatrix_ = denseDiagonalizableMatrix_ * multiplier;
+    answer->mixed_precision_ = mixed_precision_;
     return answer;
 }
 
+template <typename T>
+void ArmaDenseDiagonalizableMatrix<T>::add_scaled(
+    double multiplier,
+    const AbstractDiagonalizableMatrix& rhs) {
+    auto maybe_rhs = dynamic_cast<const ArmaDenseDiagonalizableMatrix*>(&rhs);
+    if (maybe_rhs == nullptr) {
+        throw std::bad_cast();
+    }
+    if (maybe_rhs->size() != size()) {
+        throw std::length_error("Sizes of summed matrices are different");
+    }
+    denseDiagonalizableMatrix_ += (T)multiplier * maybe_rhs->denseDiagonalizableMatrix_;
+}
+
+template <typename T>
+void ArmaDenseDiagonalizableMatrix<T>::add_sparsity_pattern(const AbstractDiagonalizableMatrix& rhs) {
+    auto maybe_rhs = dynamic_cast<const ArmaDenseDiagonalizableMatrix*>(&rhs);
+    if (maybe_rhs == nullptr) {
+        throw std::bad_cast();
+    }
+    if (maybe_rhs->size() != size()) {
+        throw std::length_error("Sizes of matrices are different");
+    }
+    // all elements are already stored
+}
+
+template <typename T>
+std::vector<double> ArmaDenseDiagonalizableMatrix<T>::stored_values_of(const AbstractDiagonalizableMatrix& rhs) const {
+    auto maybe_rhs = dynamic_cast<const ArmaDenseDiagonalizableMatrix*>(&rhs);
+    if (maybe_rhs == nullptr) {
+        throw std::bad_cast();
+    }
+    if (maybe_rhs->size() != size()) {
+        throw std::length_error("Sizes of matrices are different");
+    }
+    const auto& rhs_matrix = maybe_rhs->denseDiagonalizableMatrix_;
+    return std::vector<double>(rhs_matrix.memptr(), rhs_matrix.memptr() + rhs_matrix.n_elem);
+}
+
+template <typename T>
+void ArmaDenseDiagonalizableMatrix<T>::assign_stored_values(const std::vector<double>& values) {
+    if (values.size() != denseDiagonalizableMatrix_.n_elem) {
+        throw std::length_error("Number of values is not equal to number of stored elements");
+    }
+    std::copy(values.cbegin(), values.cend(), denseDiagonalizableMatrix_.memptr());
+}
+
 template <typename T>
 uint32_t ArmaDenseDiagonalizableMatrix<T>::size() const {
     return denseDiagonalizableMatrix_.n_rows;
@@ -89,6 +192,16 @@ arma::Mat<T>& ArmaDenseDiagonalizableMatrix<T>::modifyDenseDiagonalizableMatrix(
     return denseDiagonalizableMatrix_;
 }
 
+template <typename T>
+void ArmaDenseDiagonalizableMatrix<T>::setMixedPrecision(bool mixed_precision) {
+    mixed_precision_ = mixed_precision;
+}
+
+template <typename T>
+bool ArmaDenseDiagonalizableMatrix<T>::isMixedPrecision() const {
+    return mixed_precision_;
+}
+
 template class ArmaDenseDiagonalizableMatrix<double>;
 template class ArmaDenseDiagonalizableMatrix<float>;
 }  // namespace quantum::linear_algebra
\ No newline at end of file
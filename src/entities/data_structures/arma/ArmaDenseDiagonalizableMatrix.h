@@ -12,6 +12,12 @@ class ArmaDenseDiagonalizableMatrix: public AbstractDiagonalizableMatrix {
     void add_to_position(double value, uint32_t i, uint32_t j) override;
     EigenCouple diagonalizeValuesVectors() const override;
     std::unique_ptr<AbstractDenseVector> diagonalizeValues() const override;
+    EigenCouple diagonalizeValuesVectorsInWindow(double energy_window) const override;
+    std::optional<EigenCouple> refineDiagonalizeValuesVectors(
+      const AbstractDenseSemiunitaryMatrix& initial_eigenvectors,
+      double tolerance,
+      size_t max_iterations,
+      std::optional<double> energy_window) const override;
 
     KrylovCouple krylovDiagonalizeValues(
       const std::unique_ptr<AbstractDenseVector>& seed_vector,
@@ -19,8 +25,24 @@ class ArmaDenseDiagonalizableMatrix: public AbstractDiagonalizableMatrix {
     KrylovTriple krylovDiagonalizeValuesVectors(
       const std::unique_ptr<AbstractDenseVector>& seed_vector,
       size_t krylov_subspace_size) const override;
+    std::vector<KrylovCouple> krylovDiagonalizeValues(
+      const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+      size_t krylov_subspace_size,
+      const std::optional<KrylovConvergence>& convergence) const override;
+    std::vector<KrylovTriple> krylovDiagonalizeValuesVectors(
+      const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+      size_t krylov_subspace_size,
+      const std::optional<KrylovConvergence>& convergence) const override;
+    std::vector<KrylovTriple> krylovDiagonalizeValuesVectorsTwoPass(
+      const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+      size_t krylov_subspace_size,
+      const std::optional<KrylovConvergence>& convergence) const override;
 
     std::unique_ptr<AbstractDiagonalizableMatrix> multiply_by(double multiplier) const override;
+    void add_scaled(double multiplier, const AbstractDiagonalizableMatrix& rhs) override;
+    void add_sparsity_pattern(const AbstractDiagonalizableMatrix& rhs) override;
+    std::vector<double> stored_values_of(const AbstractDiagonalizableMatrix& rhs) const override;
+    void assign_stored_values(const std::vector<double>& values) override;
     uint32_t size() const override;
     double at(uint32_t i, uint32_t j) const override;
     void print(std::ostream& os) const override;
@@ -28,8 +50,13 @@ class ArmaDenseDiagonalizableMatrix: public AbstractDiagonalizableMatrix {
     const arma::Mat<T>& getDenseDiagonalizableMatrix() const;
     arma::Mat<T>& modifyDenseDiagonalizableMatrix();
 
+    // matrix is diagonalized in single precision, then eigenpairs are refined to the precision of T:
+    void setMixedPrecision(bool mixed_precision);
+    bool isMixedPrecision() const;
+
   private:
     arma::Mat<T> denseDiagonalizableMatrix_;
+    bool mixed_precision_ = false;
 };
 }  // namespace quantum::linear_algebra
 #endif  //SPINNER_ARMADENSEDIAGONALIZABLEMATRIX_H
@@ -8,7 +8,8 @@ template <typename T, typename M>
 inline arma::Mat<T> first_multiplication_(
     const M& symmetric_matrix,
     const ArmaDenseSemiunitaryMatrix<T>& denseSemiunitaryMatrix) {
-    return denseSemiunitaryMatrix.getDenseSemiunitaryMatrix().t() * symmetric_matrix;
+    // A is symmetric, so A U is calculated instead of U^T A:
+    return symmetric_matrix * denseSemiunitaryMatrix.getDenseSemiunitaryMatrix();
 }
 
 template <typename T>
@@ -20,7 +21,7 @@ std::unique_ptr<AbstractDenseVector> ArmaDenseSemiunitaryTransformer<T>::calcula
     std::reference_wrapper<const std::unique_ptr<AbstractDiagonalizableMatrix>> matrix) const {
     const auto& first_multiplication_result = getFirstMultiplicationResult(matrix.get().get());
     auto main_diagonal = std::make_unique<ArmaDenseVector<T>>();
-    main_diagonal->modifyDenseVector() = std::move(multiplyAndReturnMainDiagonal(first_multiplication_result, unitary_matrix_->getDenseSemiunitaryMatrix()));
+    main_diagonal->modifyDenseVector() = std::move(mainDiagonalOfTransposedProduct(first_multiplication_result, unitary_matrix_->getDenseSemiunitaryMatrix()));
     return std::move(main_diagonal);
 }
 
@@ -44,8 +45,14 @@ arma::Mat<T> ArmaDenseSemiunitaryTransformer<T>::getFirstMultiplicationResult(co
 }
 
 template <typename T>
-arma::Col<T> ArmaDenseSemiunitaryTransformer<T>::multiplyAndReturnMainDiagonal(const arma::Mat<T>& left, const arma::Mat<T>& right) const {
-    return arma::diagvec(left * right);
+arma::Col<T> ArmaDenseSemiunitaryTransformer<T>::mainDiagonalOfTransposedProduct(const arma::Mat<T>& left, const arma::Mat<T>& right) const {
+    // (left^T right)_{ii} = left_i \cdot right_i, so the full product is not calculated:
+    arma::Col<T> main_diagonal(left.n_cols);
+#pragma omp parallel for shared(main_diagonal, left, right) default(none)
+    for (arma::uword i = 0; i < main_diagonal.n_elem; ++i) {
+        main_diagonal[i] = arma::dot(left.col(i), right.col(i));
+    }
+    return main_diagonal;
 }
 
 template class ArmaDenseSemiunitaryTransformer<double>;
@@ -17,8 +17,10 @@ public:
 private:
     const ArmaDenseSemiunitaryMatrix<T>* unitary_matrix_;
 
+    // returns A U
     arma::Mat<T> getFirstMultiplicationResult(const AbstractDiagonalizableMatrix*) const;
-    arma::Col<T> multiplyAndReturnMainDiagonal(const arma::Mat<T>& left, const arma::Mat<T>& right) const;
+    // returns main diagonal of left^T right without calculation of the full product
+    arma::Col<T> mainDiagonalOfTransposedProduct(const arma::Mat<T>& left, const arma::Mat<T>& right) const;
 };
     
 }  // namespace quantum::linear_algebra
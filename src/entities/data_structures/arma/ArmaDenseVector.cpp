@@ -1,8 +1,12 @@
 #include "ArmaDenseVector.h"
+#include <algorithm>
 #include <stdexcept>
 
 namespace quantum::linear_algebra {
 
+// 3 * 1024 doubles fit into L1 cache:
+const arma::uword BOLTZMANN_CHUNK_SIZE = 1024;
+
 template <typename T>
 void ArmaDenseVector<T>::resize(uint32_t new_size) {
     vector_.resize(new_size);
@@ -45,6 +49,11 @@ void ArmaDenseVector<T>::add_identical_values(size_t number, double value) {
     vector_ = std::move(tmp);
 }
 
+template <typename T>
+void ArmaDenseVector<T>::assign_values(const double* values, size_t size) {
+    vector_ = arma::conv_to<arma::Col<T>>::from(arma::vec(values, size));
+}
+
 template <typename T>
 void ArmaDenseVector<T>::subtract_minimum() {
     double minimum = arma::min(vector_);
@@ -91,6 +100,40 @@ std::unique_ptr<AbstractDenseVector> ArmaDenseVector<T>::element_wise_multiplica
     return answer;
 }
 
+template <typename T>
+std::pair<std::vector<std::vector<double>>, std::vector<double>> ArmaDenseVector<T>::boltzmann_sums(
+    const std::unique_ptr<AbstractDenseVector>& weights,
+    const std::vector<std::reference_wrapper<const std::unique_ptr<AbstractDenseVector>>>& values,
+    const std::vector<double>& temperatures) const {
+    auto weights_ = downcast_ptr(weights);
+    std::vector<const ArmaDenseVector*> values_;
+    values_.reserve(values.size());
+    for (const auto& value : values) {
+        values_.push_back(downcast_ptr(value.get()));
+    }
+
+    std::vector<std::vector<double>> numerators(values.size(), std::vector<double>(temperatures.size(), 0));
+    std::vector<double> partition_functions(temperatures.size(), 0);
+
+    // Vectors are processed by chunks, so every chunk is read from memory once for all temperatures.
+    arma::Col<T> chunk_factors;
+    for (arma::uword begin = 0; begin < vector_.n_elem; begin += BOLTZMANN_CHUNK_SIZE) {
+        arma::uword end = std::min(begin + BOLTZMANN_CHUNK_SIZE, (arma::uword)vector_.n_elem) - 1;
+        const auto energies = vector_.subvec(begin, end);
+        const auto chunk_weights = weights_->vector_.subvec(begin, end);
+        for (size_t j = 0; j < temperatures.size(); ++j) {
+            T minus_inverse_temperature = -1.0 / temperatures[j];
+            chunk_factors = chunk_weights % arma::exp(energies * minus_inverse_temperature);
+            partition_functions[j] += arma::accu(chunk_factors);
+            for (size_t k = 0; k < values_.size(); ++k) {
+                numerators[k][j] += arma::dot(values_[k]->vector_.subvec(begin, end), chunk_factors);
+            }
+        }
+    }
+
+    return {std::move(numerators), std::move(partition_functions)};
+}
+
 template <typename T>
 uint32_t ArmaDenseVector<T>::size() const {
     return vector_.size();
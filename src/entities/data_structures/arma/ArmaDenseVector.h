@@ -14,6 +14,7 @@ class ArmaDenseVector: public AbstractDenseVector {
     void resize(uint32_t new_size);
     void concatenate_with(const std::unique_ptr<AbstractDenseVector>& rhs) override;
     void add_identical_values(size_t number, double value) override;
+    void assign_values(const double* values, size_t size) override;
     void subtract_minimum() override;
     void wise_exp() override;
     void makeRandomUnitVector(uint32_t size);
@@ -24,6 +25,10 @@ class ArmaDenseVector: public AbstractDenseVector {
       const std::unique_ptr<AbstractDenseVector>& third) const override;
     std::unique_ptr<AbstractDenseVector>
     element_wise_multiplication(const std::unique_ptr<AbstractDenseVector>& rhs) const override;
+    std::pair<std::vector<std::vector<double>>, std::vector<double>> boltzmann_sums(
+        const std::unique_ptr<AbstractDenseVector>& weights,
+        const std::vector<std::reference_wrapper<const std::unique_ptr<AbstractDenseVector>>>& values,
+        const std::vector<double>& temperatures) const override;
     uint32_t size() const override;
     double at(uint32_t i) const override;
     void print(std::ostream& os) const override;
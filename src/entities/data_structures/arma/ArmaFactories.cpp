@@ -1,9 +1,12 @@
 #include "ArmaFactories.h"
+#include <stdexcept>
 #include <vector>
 
 #include "ArmaDenseDiagonalizableMatrix.h"
 #include "ArmaDenseSemiunitaryMatrix.h"
 #include "ArmaDenseVector.h"
+#include "ArmaLocalSparseSymmetricMatrix.h"
+#include "ArmaMatrixFreeDiagonalizableMatrix.h"
 #include "ArmaSparseDiagonalizableMatrix.h"
 #include "ArmaSparseSemiunitaryMatrix.h"
 
@@ -18,6 +21,7 @@ ArmaDenseTransformAndDiagonalizeFactory::createDenseDiagonalizableMatrix(uint32_
     } else {
         auto matrix = std::make_unique<ArmaDenseDiagonalizableMatrix<double>>();
         matrix->resize(size);
+        matrix->setMixedPrecision(getPrecision() == Precision::MIXED);
         return matrix;
     }
 }
@@ -35,6 +39,16 @@ ArmaDenseTransformAndDiagonalizeFactory::createSparseDiagonalizableMatrix(uint32
     }
 }
 
+std::unique_ptr<AbstractDiagonalizableMatrix>
+ArmaDenseTransformAndDiagonalizeFactory::createMatrixFreeDiagonalizableMatrix(
+    std::shared_ptr<const AbstractMatrixFreeOperator> matrix_free_operator) {
+    if (getPrecision() == Precision::SINGLE) {
+        return std::make_unique<ArmaMatrixFreeDiagonalizableMatrix<float>>(std::move(matrix_free_operator));
+    } else {
+        return std::make_unique<ArmaMatrixFreeDiagonalizableMatrix<double>>(std::move(matrix_free_operator));
+    }
+}
+
 std::unique_ptr<AbstractDenseSemiunitaryMatrix>
 ArmaDenseTransformAndDiagonalizeFactory::createDenseSemiunitaryMatrix(
     uint32_t cols,
@@ -91,4 +105,9 @@ ArmaSparseTransformFactory::createSparseSymmetricMatrix(uint32_t size) {
     matrix->resize(size);
     return matrix;
 }
+
+std::unique_ptr<AbstractSymmetricMatrix>
+ArmaSparseTransformFactory::createLocalSparseSymmetricMatrix(std::vector<uint32_t> indexes_of_vectors) {
+    return std::make_unique<ArmaLocalSparseSymmetricMatrix>(std::move(indexes_of_vectors));
+}
 }  // namespace quantum::linear_algebra
\ No newline at end of file
@@ -10,6 +10,8 @@ class ArmaDenseTransformAndDiagonalizeFactory: public AbstractDenseTransformAndD
     createDenseDiagonalizableMatrix(uint32_t size) override;
     std::unique_ptr<AbstractDiagonalizableMatrix>
     createSparseDiagonalizableMatrix(uint32_t size) override;
+    std::unique_ptr<AbstractDiagonalizableMatrix>
+    createMatrixFreeDiagonalizableMatrix(std::shared_ptr<const AbstractMatrixFreeOperator> matrix_free_operator) override;
     std::unique_ptr<AbstractDenseSemiunitaryMatrix>
     createDenseSemiunitaryMatrix(uint32_t cols, uint32_t rows) override;
     std::vector<std::unique_ptr<AbstractDenseVector>> createRandomUnitVectors(uint32_t size_of_vector, uint32_t number_of_vectors) override;
@@ -21,6 +23,8 @@ class ArmaSparseTransformFactory: public AbstractSparseTransformFactory {
     std::unique_ptr<AbstractSparseSemiunitaryMatrix>
     createSparseSemiunitaryMatrix(uint32_t rows, uint32_t cols) override;
     std::unique_ptr<AbstractSymmetricMatrix> createSparseSymmetricMatrix(uint32_t size) override;
+    std::unique_ptr<AbstractSymmetricMatrix>
+    createLocalSparseSymmetricMatrix(std::vector<uint32_t> indexes_of_vectors) override;
 };
 
 }  // namespace quantum::linear_algebra
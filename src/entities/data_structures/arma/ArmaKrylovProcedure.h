@@ -0,0 +1,239 @@
+#ifndef SPINNER_ARMAKRYLOVPROCEDURE_H
+#define SPINNER_ARMAKRYLOVPROCEDURE_H
+
+#include <algorithm>
+#include <armadillo>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ArmaMatrixFreeDiagonalizableMatrix.h"
+#include "src/entities/data_structures/AbstractDiagonalizableMatrix.h"
+#include "src/entities/data_structures/TridiagonalEigensolver.h"
+
+// Lanczos procedure of the first pass and the regeneration of Krylov vectors in the second pass,
+// so both passes use the same block products and the same recurrence.
+namespace quantum::linear_algebra::arma_lanczos {
+
+template <typename T>
+using KrylovVectorsVisitor = std::function<void(
+    size_t k,
+    const std::vector<arma::uword>& active_seeds,
+    const arma::Mat<T>& current_vectors)>;
+
+template <typename T, typename M>
+void multiplyByBlock(const M& matrix, const arma::Mat<T>& in, arma::Mat<T>& out) {
+    out = matrix * in;
+}
+
+// Armadillo multiplies sparse matrix and dense block by one thread, so all seeds would wait for it.
+// The matrix is symmetric, so its (compressed) column j is the row j of the product:
+// columns of the matrix are split between threads (the threads of the block, if it is run by a task)
+// and every thread writes its own rows of the product for all seeds.
+template <typename T>
+void multiplyByBlock(const arma::SpMat<T>& matrix, const arma::Mat<T>& in, arma::Mat<T>& out) {
+    matrix.sync();
+    out.set_size(matrix.n_cols, in.n_cols);
+    const arma::uword number_of_columns = matrix.n_cols;
+    const arma::uword number_of_vectors = in.n_cols;
+    const arma::uword* column_pointers = matrix.col_ptrs;
+    const arma::uword* row_indices = matrix.row_indices;
+    const T* values = matrix.values;
+#pragma omp parallel for schedule(static) default(none) \
+    shared(in, out, number_of_columns, number_of_vectors, column_pointers, row_indices, values)
+    for (arma::uword j = 0; j < number_of_columns; ++j) {
+        for (arma::uword vector = 0; vector < number_of_vectors; ++vector) {
+            const T* in_column = in.colptr(vector);
+            T sum = 0;
+            for (arma::uword position = column_pointers[j]; position < column_pointers[j + 1]; ++position) {
+                sum += values[position] * in_column[row_indices[position]];
+            }
+            out.at(j, vector) = sum;
+        }
+    }
+}
+
+template <typename T>
+void multiplyByBlock(
+    const ArmaMatrixFreeDiagonalizableMatrix<T>& matrix,
+    const arma::Mat<T>& in,
+    arma::Mat<T>& out) {
+    matrix.multiply(in, out);
+}
+
+template <typename M>
+arma::uword sizeOfMatrix(const M& matrix) {
+    return matrix.n_cols;
+}
+
+template <typename T>
+arma::uword sizeOfMatrix(const ArmaMatrixFreeDiagonalizableMatrix<T>& matrix) {
+    return matrix.size();
+}
+
+// Returns true, if the Ritz values within convergence.energy_window above the lowest one
+// have changed less than convergence.tolerance * (spectral radius of Krylov matrix) since the previous check
+// and no new Ritz values have appeared in the window.
+// previous_ritz_values is updated by the current low-lying Ritz values.
+inline bool lowLyingRitzValuesHaveConverged(
+    const std::vector<double>& diagonal,
+    const std::vector<double>& subdiagonal,
+    const KrylovConvergence& convergence,
+    std::vector<double>& previous_ritz_values) {
+    // eigenvectors are not needed:
+    std::vector<double> no_eigenvectors;
+    arma::vec ritz_values = arma::vec(diagonalizeSymmetricTridiagonal(
+        {diagonal, subdiagonal}, 0, no_eigenvectors));
+
+    double scale = std::max(std::abs(ritz_values(0)), std::abs(ritz_values(ritz_values.n_elem - 1)));
+    std::vector<double> low_lying_ritz_values;
+    for (arma::uword i = 0; i < ritz_values.n_elem; ++i) {
+        if (ritz_values(i) > ritz_values(0) + convergence.energy_window) {
+            break;
+        }
+        low_lying_ritz_values.push_back(ritz_values(i));
+    }
+
+    // every low-lying Ritz value has to be close to some previous one,
+    // so the copies of converged values (due to the loss of orthogonality) do not prevent the convergence:
+    bool has_converged = !previous_ritz_values.empty();
+    for (size_t i = 0; i < low_lying_ritz_values.size() && has_converged; ++i) {
+        auto it = std::lower_bound(previous_ritz_values.begin(), previous_ritz_values.end(), low_lying_ritz_values[i]);
+        double distance = std::numeric_limits<double>::infinity();
+        if (it != previous_ritz_values.end()) {
+            distance = std::min(distance, *it - low_lying_ritz_values[i]);
+        }
+        if (it != previous_ritz_values.begin()) {
+            distance = std::min(distance, low_lying_ritz_values[i] - *std::prev(it));
+        }
+        has_converged = distance <= convergence.tolerance * scale;
+    }
+    previous_ritz_values = std::move(low_lying_ritz_values);
+    return has_converged;
+}
+
+// Lanczos procedure, all seeds (columns of seed_vectors) are advanced together:
+// every Krylov step is one product of the matrix and (size x number_of_active_seeds) block of vectors,
+// so the matrix is read from memory once per step instead of once per step per seed.
+// The procedure of a seed is stopped before krylov_subspace_size steps, if its Krylov subspace
+// is invariant (breakdown) or if convergence is set and its low-lying Ritz values have converged,
+// then the seed is removed from the block.
+// Returns tridiagonal Krylov matrices of all seeds (their sizes can be different).
+// If on_krylov_vectors is set, it is called with the k-th Krylov vectors of active seeds
+// (columns of current_vectors, active_seeds[column] is the seed of the column) before the k-th product.
+template <typename T, typename M>
+std::vector<SymmetricTridiagonalMatrix> krylovProcedureOfSeeds(
+    const M& matrix,
+    const arma::Mat<T>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence,
+    const KrylovVectorsVisitor<T>& on_krylov_vectors) {
+    if (krylov_subspace_size > sizeOfMatrix(matrix)) {
+        throw std::invalid_argument("krylov_subspace_size bigger than size of matrix!");
+    }
+    const size_t convergence_check_period = 5;
+    // without reorthogonalization the rounding noise of the next Krylov vector grows with steps,
+    // so the Krylov subspace is considered as invariant, if its norm is below breakdown_tolerance * |T_k|,
+    // then Ritz values are accurate up to this relative error:
+    const T breakdown_tolerance = std::sqrt(std::numeric_limits<T>::epsilon());
+
+    const arma::uword number_of_seeds = seed_vectors.n_cols;
+    std::vector<std::vector<double>> diagonals(number_of_seeds);
+    std::vector<std::vector<double>> subdiagonals(number_of_seeds);
+    std::vector<std::vector<double>> previous_ritz_values(number_of_seeds);
+
+    arma::Mat<T> current_vectors = seed_vectors;
+    arma::Row<T> vec_norms = arma::sqrt(arma::sum(arma::square(current_vectors), 0));
+    if (number_of_seeds > 0 && vec_norms.min() < std::numeric_limits<double>::epsilon()) {
+        throw std::invalid_argument("Extremely small value of vector norm in Krylov procedure: " + std::to_string(vec_norms.min()));
+    }
+    current_vectors.each_row() /= vec_norms;
+
+
+    // active_seeds[column] is the seed of the column of current_vectors:
+    std::vector<arma::uword> active_seeds(number_of_seeds);
+    std::iota(active_seeds.begin(), active_seeds.end(), 0);
+
+    arma::Mat<T> previous_vectors(seed_vectors.n_rows, number_of_seeds, arma::fill::zeros);
+    arma::Mat<T> next_vectors(seed_vectors.n_rows, number_of_seeds, arma::fill::zeros);
+    arma::Row<T> diag_elements, non_diag_elements;
+
+    for (size_t k = 0; k < krylov_subspace_size && !active_seeds.empty(); ++k) {
+        if (on_krylov_vectors) {
+            on_krylov_vectors(k, active_seeds, current_vectors);
+        }
+        multiplyByBlock(matrix, current_vectors, next_vectors);
+        diag_elements = arma::sum(current_vectors % next_vectors, 0);
+        if (k > 0) {
+            non_diag_elements = arma::sum(previous_vectors % next_vectors, 0);
+        }
+
+        for (size_t column = 0; column < active_seeds.size(); ++column) {
+            arma::uword seed = active_seeds[column];
+            diagonals[seed].push_back(diag_elements(column));
+            if (k > 0) {
+                subdiagonals[seed].push_back(non_diag_elements(column));
+            }
+        }
+        if (k + 1 == krylov_subspace_size) {
+            // the next Krylov vectors are not needed:
+            break;
+        }
+
+        next_vectors -= current_vectors.each_row() % diag_elements;
+        if (k > 0) {
+            next_vectors -= previous_vectors.each_row() % non_diag_elements;
+        }
+        vec_norms = arma::sqrt(arma::sum(arma::square(next_vectors), 0));
+
+        std::vector<arma::uword> continuing_columns;
+        for (size_t column = 0; column < active_seeds.size(); ++column) {
+            arma::uword seed = active_seeds[column];
+            double scale = std::abs(diag_elements(column)) + (k > 0 ? std::abs(non_diag_elements(column)) : 0);
+            // Krylov subspace of the seed is invariant:
+            bool breakdown = vec_norms(column) <= breakdown_tolerance * scale;
+            bool converged = !breakdown && convergence.has_value()
+                && (k + 1) % convergence_check_period == 0
+                && lowLyingRitzValuesHaveConverged(
+                    diagonals[seed],
+                    subdiagonals[seed],
+                    convergence.value(),
+                    previous_ritz_values[seed]);
+            if (!breakdown && !converged) {
+                continuing_columns.push_back(column);
+            }
+        }
+
+        if (continuing_columns.size() < active_seeds.size()) {
+            // the stopped seeds are removed from the block, so they do not cost matrix products:
+            arma::uvec continuing_columns_indices(continuing_columns);
+            current_vectors = current_vectors.cols(continuing_columns_indices);
+            next_vectors = next_vectors.cols(continuing_columns_indices);
+            vec_norms = vec_norms.cols(continuing_columns_indices);
+            std::vector<arma::uword> continuing_seeds(continuing_columns.size());
+            for (size_t j = 0; j < continuing_columns.size(); ++j) {
+                continuing_seeds[j] = active_seeds[continuing_columns[j]];
+            }
+            active_seeds.swap(continuing_seeds);
+        }
+        next_vectors.each_row() /= vec_norms;
+
+        arma::swap(previous_vectors, current_vectors);
+        arma::swap(current_vectors, next_vectors);
+    }
+
+    std::vector<SymmetricTridiagonalMatrix> krylov_matrices(number_of_seeds);
+    for (arma::uword seed = 0; seed < number_of_seeds; ++seed) {
+        krylov_matrices[seed].diagonal = std::move(diagonals[seed]);
+        krylov_matrices[seed].subdiagonal = std::move(subdiagonals[seed]);
+    }
+    return krylov_matrices;
+}
+}  // namespace quantum::linear_algebra::arma_lanczos
+#endif  //SPINNER_ARMAKRYLOVPROCEDURE_H
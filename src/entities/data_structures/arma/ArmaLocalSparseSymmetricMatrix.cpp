@@ -0,0 +1,75 @@
+#include "ArmaLocalSparseSymmetricMatrix.h"
+
+#include <algorithm>
+#include <ostream>
+
+namespace quantum::linear_algebra {
+
+ArmaLocalSparseSymmetricMatrix::ArmaLocalSparseSymmetricMatrix(
+    std::vector<uint32_t> lexicographic_indexes) :
+    lexicographic_indexes_(std::move(lexicographic_indexes)) {
+    std::sort(lexicographic_indexes_.begin(), lexicographic_indexes_.end());
+    lexicographic_indexes_.erase(
+        std::unique(lexicographic_indexes_.begin(), lexicographic_indexes_.end()),
+        lexicographic_indexes_.end());
+    local_indexes_.reserve(lexicographic_indexes_.size());
+    for (uint32_t local_index = 0; local_index < lexicographic_indexes_.size(); ++local_index) {
+        local_indexes_.emplace(lexicographic_indexes_[local_index], local_index);
+    }
+    localSparseSymmetricMatrix_.resize(lexicographic_indexes_.size(), lexicographic_indexes_.size());
+}
+
+void ArmaLocalSparseSymmetricMatrix::add_to_position(double value, uint32_t i, uint32_t j) {
+    auto mb_local_i = to_local_index(i);
+    auto mb_local_j = to_local_index(j);
+    // such elements do not contribute to the block:
+    if (!mb_local_i.has_value() || !mb_local_j.has_value()) {
+        return;
+    }
+    uint32_t local_i = mb_local_i.value();
+    uint32_t local_j = mb_local_j.value();
+    localSparseSymmetricMatrix_.at(local_i, local_j) += value;
+    if (local_i != local_j) {
+        localSparseSymmetricMatrix_.at(local_j, local_i) += value;
+    }
+}
+
+uint32_t ArmaLocalSparseSymmetricMatrix::size() const {
+    return lexicographic_indexes_.size();
+}
+
+double ArmaLocalSparseSymmetricMatrix::at(uint32_t i, uint32_t j) const noexcept {
+    auto mb_local_i = to_local_index(i);
+    auto mb_local_j = to_local_index(j);
+    if (!mb_local_i.has_value() || !mb_local_j.has_value()) {
+        return 0;
+    }
+    return localSparseSymmetricMatrix_(mb_local_i.value(), mb_local_j.value());
+}
+
+void ArmaLocalSparseSymmetricMatrix::print(std::ostream& os) const {
+    for (auto it = localSparseSymmetricMatrix_.begin(); it != localSparseSymmetricMatrix_.end(); ++it) {
+        auto i = lexicographic_indexes_[it.row()];
+        auto j = lexicographic_indexes_[it.col()];
+        os << "(" << i << ", " << j << ") :" << *it << std::endl;
+    }
+}
+
+std::optional<uint32_t>
+ArmaLocalSparseSymmetricMatrix::to_local_index(uint32_t lexicographic_index) const noexcept {
+    auto it = local_indexes_.find(lexicographic_index);
+    if (it == local_indexes_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+const std::vector<uint32_t>& ArmaLocalSparseSymmetricMatrix::getLexicographicIndexes() const {
+    return lexicographic_indexes_;
+}
+
+const arma::sp_mat& ArmaLocalSparseSymmetricMatrix::getLocalSparseSymmetricMatrix() const {
+    return localSparseSymmetricMatrix_;
+}
+
+}  // namespace quantum::linear_algebra
@@ -1,142 +1,327 @@
 #include "ArmaLogic.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <random>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 #include "ArmaDenseDiagonalizableMatrix.h"
 #include "ArmaDenseSemiunitaryMatrix.h"
 #include "ArmaDenseVector.h"
 #include "ArmaKrylovDenseSemiunitaryMatrix.h"
+#include "ArmaKrylovProcedure.h"
+#include "ArmaMatrixFreeDiagonalizableMatrix.h"
 #include "ArmaSparseDiagonalizableMatrix.h"
+#include "ArmaTwoPassKrylovDenseSemiunitaryMatrix.h"
+#include "src/entities/data_structures/TridiagonalEigensolver.h"
+
+// Range-restricted symmetric eigensolver (MRRR) of LAPACK, Armadillo does not wrap it:
+extern "C" {
+void ssyevr_(
+    const char* jobz, const char* range, const char* uplo, const arma::blas_int* n,
+    float* a, const arma::blas_int* lda, const float* vl, const float* vu,
+    const arma::blas_int* il, const arma::blas_int* iu, const float* abstol, arma::blas_int* m,
+    float* w, float* z, const arma::blas_int* ldz, arma::blas_int* isuppz,
+    float* work, const arma::blas_int* lwork, arma::blas_int* iwork, const arma::blas_int* liwork,
+    arma::blas_int* info);
+void dsyevr_(
+    const char* jobz, const char* range, const char* uplo, const arma::blas_int* n,
+    double* a, const arma::blas_int* lda, const double* vl, const double* vu,
+    const arma::blas_int* il, const arma::blas_int* iu, const double* abstol, arma::blas_int* m,
+    double* w, double* z, const arma::blas_int* ldz, arma::blas_int* isuppz,
+    double* work, const arma::blas_int* lwork, arma::blas_int* iwork, const arma::blas_int* liwork,
+    arma::blas_int* info);
+}
 
 namespace {
 
-template <typename T, typename M>
-std::pair<arma::Col<T>, arma::Col<T>> krylovProcedureDiagonalizeValues_(
-    const M& matrix,
-    const arma::Col<T>& seed_vector,
-    size_t krylov_subspace_size) {
-    arma::Mat<T> krylov_matrix(krylov_subspace_size, krylov_subspace_size);
-        
-    if (krylov_subspace_size > matrix.n_cols) {
-        throw std::invalid_argument("krylov_subspace_size bigger than size of matrix!");
+template <typename T>
+void syevr_(
+    char jobz, char range, arma::blas_int n, T* a, T vl, T vu, arma::blas_int il, arma::blas_int iu,
+    arma::blas_int* m, T* w, T* z, arma::blas_int ldz, arma::blas_int* isuppz,
+    T* work, arma::blas_int lwork, arma::blas_int* iwork, arma::blas_int liwork, arma::blas_int* info) {
+    char uplo = 'L';
+    arma::blas_int lda = std::max<arma::blas_int>(1, n);
+    // the most accurate eigenvalues are calculated with the default absolute tolerance:
+    T abstol = 0;
+    if constexpr (std::is_same_v<T, float>) {
+        ssyevr_(&jobz, &range, &uplo, &n, a, &lda, &vl, &vu, &il, &iu, &abstol, m, w, z, &ldz, isuppz,
+                work, &lwork, iwork, &liwork, info);
+    } else {
+        dsyevr_(&jobz, &range, &uplo, &n, a, &lda, &vl, &vu, &il, &iu, &abstol, m, w, z, &ldz, isuppz,
+                work, &lwork, iwork, &liwork, info);
     }
+}
 
-    auto current_vector = arma::Col<T>(seed_vector);
-    double vec_norm = arma::vecnorm(current_vector);
-    if (vec_norm < std::numeric_limits<double>::epsilon()) {
-        throw std::invalid_argument("Extremely small value of vector norm in Krylov procedure: " + std::to_string(vec_norm));
+// Calls ?syevr with workspace query, matrix is destroyed.
+// eigenvectors must have at least as many columns as the number of found eigenvalues.
+template <typename T>
+arma::blas_int rangeRestrictedDiagonalize_(
+    arma::Mat<T>& matrix,
+    char jobz,
+    char range,
+    T vl,
+    T vu,
+    arma::blas_int il,
+    arma::blas_int iu,
+    arma::Col<T>& eigenvalues,
+    arma::Mat<T>& eigenvectors) {
+    arma::blas_int n = matrix.n_rows;
+    arma::blas_int ldz = jobz == 'V' ? std::max<arma::blas_int>(1, n) : 1;
+    arma::blas_int m = 0;
+    arma::blas_int info = 0;
+    eigenvalues.set_size(n);
+    arma::Col<arma::blas_int> isuppz(2 * std::max<arma::blas_int>(1, eigenvectors.n_cols));
+    T* z = jobz == 'V' ? eigenvectors.memptr() : nullptr;
+
+    T work_query = 0;
+    arma::blas_int iwork_query = 0;
+    syevr_<T>(jobz, range, n, matrix.memptr(), vl, vu, il, iu, &m, eigenvalues.memptr(), z, ldz,
+              isuppz.memptr(), &work_query, -1, &iwork_query, -1, &info);
+    if (info != 0) {
+        throw std::runtime_error("Workspace query of ?syevr failed");
     }
-    current_vector /= vec_norm;
-
-    auto previous_vector = arma::Col<T>(current_vector.size(), arma::fill::zeros);
-    auto next_vector = arma::Col<T>(current_vector.size(), arma::fill::zeros);
+    arma::blas_int lwork = static_cast<arma::blas_int>(work_query);
+    arma::blas_int liwork = iwork_query;
+    arma::Col<T> work(lwork);
+    arma::Col<arma::blas_int> iwork(liwork);
+    syevr_<T>(jobz, range, n, matrix.memptr(), vl, vu, il, iu, &m, eigenvalues.memptr(), z, ldz,
+              isuppz.memptr(), work.memptr(), lwork, iwork.memptr(), liwork, &info);
+    if (info != 0) {
+        throw std::runtime_error("Range-restricted eigendecomposition (?syevr) failed");
+    }
+    eigenvalues.resize(m);
+    return m;
+}
 
-    double diag_element, non_diag_element;
+// Eigenpairs within energy_window above the lowest eigenvalue:
+// the lowest eigenvalue is found by bisection (RANGE='I', IL=IU=1), then
+// the eigenpairs in (E0 - margin, E0 + energy_window] are found by MRRR (RANGE='V'),
+// so only the required eigenvectors are calculated and back-transformed.
+template <typename T>
+void windowDiagonalizeValuesVectors_(
+    const arma::Mat<T>& matrix,
+    double energy_window,
+    arma::Col<T>& eigenvalues,
+    arma::Mat<T>& eigenvectors) {
+    arma::blas_int n = matrix.n_rows;
+    if (n == 0) {
+        eigenvalues.reset();
+        eigenvectors.reset();
+        return;
+    }
+    arma::Mat<T> workspace = matrix;
+    arma::Mat<T> no_eigenvectors;
+    arma::Col<T> lowest_eigenvalue;
+    rangeRestrictedDiagonalize_<T>(workspace, 'N', 'I', 0, 0, 1, 1, lowest_eigenvalue, no_eigenvectors);
+    T lowest = lowest_eigenvalue(0);
+
+    // the interval of RANGE='V' is half-open, the margin keeps the lowest eigenvalue inside it:
+    T norm_of_matrix = std::max<T>(arma::norm(matrix, "inf"), std::numeric_limits<T>::min());
+    T margin = 100 * std::numeric_limits<T>::epsilon() * norm_of_matrix;
+    workspace = matrix;
+    // the number of eigenvalues in the window is not known in advance, so Z has n columns:
+    eigenvectors.set_size(n, n);
+    arma::blas_int m = rangeRestrictedDiagonalize_<T>(
+        workspace,
+        'V',
+        'V',
+        lowest - margin,
+        lowest + static_cast<T>(energy_window),
+        0,
+        0,
+        eigenvalues,
+        eigenvectors);
+    eigenvectors.resize(n, m);
+}
 
-    for (size_t k = 0; k < krylov_subspace_size; ++k) {
-        next_vector = matrix * current_vector;
-        diag_element = arma::dot(current_vector, next_vector);
-        if (k > 0) {
-            non_diag_element = arma::dot(previous_vector, next_vector);
+// Block Rayleigh-Ritz refinement of approximate eigenvectors (LOBPCG without preconditioner):
+// every iteration diagonalizes the matrix projected onto the span of current Ritz vectors X,
+// their residuals R and the previous search directions P, and keeps the lowest Ritz pairs.
+// If energy_window is set, initial vectors are the lowest ones within the window, so one guard vector
+// (started from a pseudo-random vector orthogonal to them) is kept in addition to them. The guard Ritz value
+// is an upper bound of the next eigenvalue, so std::nullopt is returned as soon as it comes into the window;
+// the refinement is accepted only when the guard has converged and its Ritz value minus its residual
+// is above the window edge.
+template <typename T, typename M>
+std::optional<std::pair<arma::Col<T>, arma::Mat<T>>> refineDiagonalizeValuesVectors_(
+    const M& matrix,
+    const arma::Mat<T>& initial_eigenvectors,
+    double tolerance,
+    size_t max_iterations,
+    std::optional<double> energy_window) {
+    arma::uword size = initial_eigenvectors.n_rows;
+    arma::uword number_of_eigenpairs = initial_eigenvectors.n_cols;
+    if (number_of_eigenpairs == 0) {
+        return std::make_pair(arma::Col<T>(), initial_eigenvectors);
+    }
+    // residuals cannot be smaller than the rounding errors:
+    tolerance = std::max(
+        tolerance,
+        10 * std::sqrt((double)size) * (double)std::numeric_limits<T>::epsilon());
+    // there are no states above the initial ones, if they span the full space:
+    bool has_guard = energy_window.has_value() && number_of_eigenpairs < size;
+
+    // Ritz pairs in the span of initial vectors:
+    arma::Mat<T> ritz_vectors = initial_eigenvectors;
+    if (has_guard) {
+        // the guard has to overlap with all states above the initial ones:
+        std::mt19937 rng(size);
+        std::uniform_real_distribution<double> dist(-1, +1);
+        arma::Col<T> guard(size);
+        for (arma::uword i = 0; i < size; ++i) {
+            guard(i) = (T)dist(rng);
         }
-
-        krylov_matrix.at(k, k) = diag_element;
-        if (k > 0) {
-            krylov_matrix.at(k-1, k) = non_diag_element;
-            krylov_matrix.at(k, k-1) = non_diag_element;
+        for (size_t pass = 0; pass < 2; ++pass) {
+            guard -= initial_eigenvectors * (initial_eigenvectors.t() * guard);
         }
-
-        next_vector -= current_vector * diag_element;
-        if (k > 0) {
-            next_vector -= previous_vector * non_diag_element;
+        ritz_vectors = arma::join_rows(ritz_vectors, arma::normalise(guard));
+    }
+    arma::Mat<T> product = matrix * ritz_vectors;
+    arma::Col<T> ritz_values;
+    {
+        arma::Mat<T> projected = ritz_vectors.t() * product;
+        arma::Mat<T> rotation;
+        arma::eig_sym(ritz_values, rotation, arma::Mat<T>((projected + projected.t()) / 2));
+        ritz_vectors = ritz_vectors * rotation;
+        product = product * rotation;
+    }
+    arma::Mat<T> directions(size, 0);
+
+    for (size_t iteration = 0; iteration < max_iterations; ++iteration) {
+        arma::Mat<T> residuals = product - ritz_vectors * arma::diagmat(ritz_values);
+        double scale = std::max(
+            (double)arma::abs(ritz_values).max(),
+            (double)std::numeric_limits<float>::min());
+        // the guard has to converge too, otherwise it is not the lowest state above the initial ones:
+        bool has_converged = true;
+        for (arma::uword i = 0; i < ritz_vectors.n_cols && has_converged; ++i) {
+            has_converged = arma::norm(residuals.col(i)) <= tolerance * scale;
         }
-
-        double vec_norm = arma::vecnorm(next_vector);
-        if (vec_norm < std::numeric_limits<double>::epsilon()) {
-            throw std::invalid_argument("Extremely small value of vector norm in Krylov procedure: " + std::to_string(vec_norm));
+        if (has_guard && ritz_values(number_of_eigenpairs) <= ritz_values(0) + energy_window.value()) {
+            return std::nullopt;
+        }
+        bool is_window_edge_resolved = !has_guard
+            || ritz_values(number_of_eigenpairs) - arma::norm(residuals.col(number_of_eigenpairs))
+                > ritz_values(0) + energy_window.value();
+        if (has_converged && is_window_edge_resolved) {
+            return std::make_pair(
+                arma::Col<T>(ritz_values.head(number_of_eigenpairs)),
+                arma::Mat<T>(ritz_vectors.head_cols(number_of_eigenpairs)));
         }
-        next_vector /= vec_norm;
 
-        arma::swap(previous_vector, current_vector);
-        arma::swap(current_vector, next_vector);
+        // orthonormal basis of span(X, R, P), it cannot be larger than the full space:
+        arma::Mat<T> extended = arma::join_rows(ritz_vectors, residuals, directions);
+        arma::uword number_of_columns = std::min<arma::uword>(extended.n_cols, size);
+        arma::Mat<T> basis;
+        arma::Mat<T> r;
+        arma::qr_econ(basis, r, arma::Mat<T>(extended.head_cols(number_of_columns)));
+
+        arma::Mat<T> basis_product = matrix * basis;
+        arma::Mat<T> projected = basis.t() * basis_product;
+        arma::Col<T> projected_values;
+        arma::Mat<T> projected_vectors;
+        arma::eig_sym(projected_values, projected_vectors, arma::Mat<T>((projected + projected.t()) / 2));
+
+        arma::uword number_of_kept = ritz_vectors.n_cols;
+        arma::Mat<T> new_ritz_vectors = basis * projected_vectors.head_cols(number_of_kept);
+        // the search directions span(X_new, X) = span(X_new, P):
+        arma::Mat<T> overlap = ritz_vectors.t() * new_ritz_vectors;
+        directions = new_ritz_vectors - ritz_vectors * overlap;
+        ritz_vectors = std::move(new_ritz_vectors);
+        product = basis_product * projected_vectors.head_cols(number_of_kept);
+        ritz_values = projected_values.head(number_of_kept);
     }
-
-    arma::Col<T> eigenvalues;
-    arma::Mat<T> eigenvectors;
-    arma::eig_sym(
-        eigenvalues,
-        eigenvectors,
-        krylov_matrix);
-    
-    arma::Col<T> back_projection = eigenvectors.row(0).t();
-
-    return {std::move(eigenvalues), std::move(back_projection)};
+    return std::nullopt;
 }
 
-template <typename T, typename M>
-std::tuple<arma::Col<T>, arma::Mat<T>, arma::Col<T>> krylovProcedureDiagonalizeValuesVectors_(
-    const M& matrix,
-    const arma::Col<T>& seed_vector,
-    size_t krylov_subspace_size) {
-    arma::Mat<T> krylov_matrix(krylov_subspace_size, krylov_subspace_size);
-        
-    if (krylov_subspace_size > matrix.n_cols) {
-        throw std::invalid_argument("krylov_subspace_size bigger than size of matrix!");
+// Eigendecomposition in single precision refined to the precision of T by iterative refinement
+// of Ogita and Aishima, see EigenLogic.cpp for details.
+// Returns false, if the refinement has not converged within max_sweeps.
+template <typename T>
+bool mixedPrecisionDiagonalizeValuesVectors_(
+    arma::Col<T>& eigenvalues,
+    arma::Mat<T>& eigenvectors,
+    const arma::Mat<T>& matrix) {
+    const size_t max_sweeps = 5;
+    arma::uword size = matrix.n_rows;
+
+    arma::fvec single_eigenvalues;
+    arma::fmat single_eigenvectors;
+    if (!arma::eig_sym(single_eigenvalues, single_eigenvectors, arma::conv_to<arma::fmat>::from(matrix))) {
+        return false;
     }
-
-    arma::Mat<T> krylov_vectors(seed_vector.size(), krylov_subspace_size, arma::fill::zeros);
-    krylov_vectors.col(0) = seed_vector;
-
-    double vec_norm = arma::vecnorm(krylov_vectors.col(0));
-    if (vec_norm < std::numeric_limits<double>::epsilon()) {
-        throw std::invalid_argument("Extremely small value of vector norm in Krylov procedure: " + std::to_string(vec_norm));
+    eigenvalues = arma::conv_to<arma::Col<T>>::from(single_eigenvalues);
+    eigenvectors = arma::conv_to<arma::Mat<T>>::from(single_eigenvectors);
+    if (size == 0) {
+        return true;
     }
-    krylov_vectors.col(0) /= vec_norm;
-
-    auto next_vector = arma::Col<T>(seed_vector.size(), arma::fill::zeros);
-
-    double diag_element, non_diag_element;
-
-    for (size_t k = 0; k < krylov_subspace_size; ++k) {
-        next_vector = matrix * krylov_vectors.col(k);
-        diag_element = arma::dot(krylov_vectors.col(k), next_vector);
-        if (k > 0) {
-            non_diag_element = arma::dot(krylov_vectors.col(k-1), next_vector);
-        }
-
-        krylov_matrix.at(k, k) = diag_element;
-        if (k > 0) {
-            krylov_matrix.at(k-1, k) = non_diag_element;
-            krylov_matrix.at(k, k-1) = non_diag_element;
+    const double tolerance = 10 * (double)size * (double)std::numeric_limits<T>::epsilon();
+
+    for (size_t sweep = 0; sweep <= max_sweeps; ++sweep) {
+        arma::Mat<T> product = matrix * eigenvectors;
+        arma::Mat<T> projected = eigenvectors.t() * product;
+        arma::Mat<T> orthogonality_defect = -eigenvectors.t() * eigenvectors;
+        orthogonality_defect.diag() += 1;
+        eigenvalues = projected.diag() / (1 - orthogonality_defect.diag());
+
+        double scale = std::max(
+            (double)arma::abs(eigenvalues).max(),
+            (double)std::numeric_limits<float>::min());
+        arma::Mat<T> off_diagonal = projected;
+        off_diagonal.diag() -= eigenvalues;
+        double off_diagonal_norm = arma::norm(off_diagonal, "fro");
+        double orthogonality_defect_norm = arma::norm(orthogonality_defect, "fro");
+
+        // eigenvalues are sorted, up to the rounding errors of single precision:
+        arma::uvec order = arma::sort_index(eigenvalues);
+        if (off_diagonal_norm <= tolerance * scale && orthogonality_defect_norm <= tolerance) {
+            arma::Col<T> sorted_eigenvalues = eigenvalues(order);
+            arma::Mat<T> sorted_eigenvectors = eigenvectors.cols(order);
+            eigenvalues = std::move(sorted_eigenvalues);
+            eigenvectors = std::move(sorted_eigenvectors);
+            return true;
         }
-
-        next_vector -= krylov_vectors.col(k) * diag_element;
-        if (k > 0) {
-            next_vector -= krylov_vectors.col(k-1) * non_diag_element;
+        if (sweep == max_sweeps) {
+            break;
         }
 
-        double vec_norm = arma::vecnorm(next_vector);
-        if (vec_norm < std::numeric_limits<double>::epsilon()) {
-            throw std::invalid_argument("Extremely small value of vector norm in Krylov procedure: " + std::to_string(vec_norm));
+        // eigenvalues closer than delta cannot be separated by the first-order correction:
+        double delta = 2 * (off_diagonal_norm + scale * orthogonality_defect_norm);
+        arma::Mat<T> correction(size, size);
+        for (arma::uword j = 0; j < size; ++j) {
+            for (arma::uword i = 0; i < size; ++i) {
+                T gap = eigenvalues(j) - eigenvalues(i);
+                correction(i, j) = std::abs(gap) > delta
+                    ? (projected(i, j) + eigenvalues(j) * orthogonality_defect(i, j)) / gap
+                    : orthogonality_defect(i, j) / 2;
+            }
         }
-        next_vector /= vec_norm;
-
-        if (k + 1 < krylov_subspace_size) {
-            krylov_vectors.col(k+1) = next_vector;
+        eigenvectors += eigenvectors * correction;
+
+        for (arma::uword begin = 0; begin < size;) {
+            arma::uword end = begin + 1;
+            while (end < size && eigenvalues(order(end)) - eigenvalues(order(end - 1)) <= delta) {
+                ++end;
+            }
+            if (end - begin > 1) {
+                arma::uvec cluster = order.subvec(begin, end - 1);
+                arma::Mat<T> projected_cluster = projected(cluster, cluster);
+                projected_cluster = (projected_cluster + projected_cluster.t()) / 2;
+                arma::Col<T> cluster_eigenvalues;
+                arma::Mat<T> cluster_eigenvectors;
+                arma::eig_sym(cluster_eigenvalues, cluster_eigenvectors, projected_cluster);
+                eigenvectors.cols(cluster) = arma::Mat<T>(eigenvectors.cols(cluster) * cluster_eigenvectors);
+            }
+            begin = end;
         }
     }
-
-    arma::Col<T> eigenvalues;
-    arma::Mat<T> eigenvectors;
-    arma::eig_sym(
-        eigenvalues,
-        eigenvectors,
-        krylov_matrix);
-    
-    arma::Col<T> back_projection = eigenvectors.row(0).t();
-
-    arma::Mat<T> total_eigenvectors = krylov_vectors * eigenvectors;
-
-    return {std::move(eigenvalues), std::move(total_eigenvectors), std::move(back_projection)};
+    return false;
 }
 
 } // namespace
@@ -150,6 +335,16 @@ ArmaLogic<T>::diagonalizeValues(const AbstractDiagonalizableMatrix& diagonalizab
 
     if (auto maybeDenseSymmetricMatrix =
             dynamic_cast<const ArmaDenseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        if (maybeDenseSymmetricMatrix->isMixedPrecision()) {
+            // eigenvectors are needed for the refinement of eigenvalues:
+            arma::Mat<T> eigenvectors;
+            if (mixedPrecisionDiagonalizeValuesVectors_<T>(
+                    eigenvalues_->modifyDenseVector(),
+                    eigenvectors,
+                    maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix())) {
+                return eigenvalues_;
+            }
+        }
         arma::eig_sym(
             eigenvalues_->modifyDenseVector(),
             maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix());
@@ -173,10 +368,18 @@ EigenCouple ArmaLogic<T>::diagonalizeValuesVectors(
 
     if (auto maybeDenseSymmetricMatrix =
             dynamic_cast<const ArmaDenseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
-        arma::eig_sym(
-            eigenvalues_->modifyDenseVector(),
-            eigenvectors_->modifyDenseSemiunitaryMatrix(),
-            maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix());
+        // if the refinement has not converged, the eigendecomposition is done in the precision of T:
+        bool is_refined = maybeDenseSymmetricMatrix->isMixedPrecision()
+            && mixedPrecisionDiagonalizeValuesVectors_<T>(
+                eigenvalues_->modifyDenseVector(),
+                eigenvectors_->modifyDenseSemiunitaryMatrix(),
+                maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix());
+        if (!is_refined) {
+            arma::eig_sym(
+                eigenvalues_->modifyDenseVector(),
+                eigenvectors_->modifyDenseSemiunitaryMatrix(),
+                maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix());
+        }
     } else if (
         auto maybeSparseSymmetricMatrix =
             dynamic_cast<const ArmaSparseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
@@ -195,25 +398,229 @@ EigenCouple ArmaLogic<T>::diagonalizeValuesVectors(
     return answer;
 }
 
-template <typename T, typename M>
-inline KrylovCouple krylovDiagonalizeValues_(
-    const M& diagonalizableMatrix,
-    const ArmaDenseVector<T>& seed_vector,
-    size_t krylov_subspace_size) {
+template <typename T>
+EigenCouple ArmaLogic<T>::diagonalizeValuesVectorsInWindow(
+    const AbstractDiagonalizableMatrix& diagonalizableMatrix,
+    double energy_window) const {
     auto eigenvalues_ = std::make_unique<ArmaDenseVector<T>>();
-    auto ftlm_weights_of_states_ = std::make_unique<ArmaDenseVector<T>>();
+    auto eigenvectors_ = std::make_unique<ArmaDenseSemiunitaryMatrix<T>>();
 
-    auto pair = krylovProcedureDiagonalizeValues_(
-        diagonalizableMatrix,
-        seed_vector.getDenseVector(),
-        krylov_subspace_size);
+    if (auto maybeDenseSymmetricMatrix =
+            dynamic_cast<const ArmaDenseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        windowDiagonalizeValuesVectors_<T>(
+            maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix(),
+            energy_window,
+            eigenvalues_->modifyDenseVector(),
+            eigenvectors_->modifyDenseSemiunitaryMatrix());
+    } else if (
+        auto maybeSparseSymmetricMatrix =
+            dynamic_cast<const ArmaSparseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        auto sparseToDenseCopy = arma::Mat<T>(maybeSparseSymmetricMatrix->getSparseSymmetricMatrix());
+        windowDiagonalizeValuesVectors_<T>(
+            sparseToDenseCopy,
+            energy_window,
+            eigenvalues_->modifyDenseVector(),
+            eigenvectors_->modifyDenseSemiunitaryMatrix());
+    } else {
+        throw std::bad_cast();
+    }
+
+    EigenCouple answer;
+    answer.eigenvalues = std::move(eigenvalues_);
+    answer.eigenvectors = std::move(eigenvectors_);
+    return answer;
+}
 
-    eigenvalues_->modifyDenseVector() = std::move(pair.first);
-    ftlm_weights_of_states_->modifyDenseVector() = std::move(arma::square(pair.second));
+template <typename T>
+std::optional<EigenCouple> ArmaLogic<T>::refineDiagonalizeValuesVectors(
+    const AbstractDiagonalizableMatrix& diagonalizableMatrix,
+    const AbstractDenseSemiunitaryMatrix& initial_eigenvectors,
+    double tolerance,
+    size_t max_iterations,
+    std::optional<double> energy_window) const {
+    auto maybeDenseSemiunitaryMatrix =
+        dynamic_cast<const ArmaDenseSemiunitaryMatrix<T>*>(&initial_eigenvectors);
+    if (maybeDenseSemiunitaryMatrix == nullptr) {
+        throw std::bad_cast();
+    }
+    const auto& initial = maybeDenseSemiunitaryMatrix->getDenseSemiunitaryMatrix();
+    if (initial.n_rows != diagonalizableMatrix.size()) {
+        throw std::length_error("Sizes of matrix and initial eigenvectors are different");
+    }
 
-    KrylovCouple answer;
+    std::optional<std::pair<arma::Col<T>, arma::Mat<T>>> mb_pair;
+    if (auto maybeDenseSymmetricMatrix =
+            dynamic_cast<const ArmaDenseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        mb_pair = refineDiagonalizeValuesVectors_<T>(
+            maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix(),
+            initial,
+            tolerance,
+            max_iterations,
+            energy_window);
+    } else if (
+        auto maybeSparseSymmetricMatrix =
+            dynamic_cast<const ArmaSparseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        mb_pair = refineDiagonalizeValuesVectors_<T>(
+            maybeSparseSymmetricMatrix->getSparseSymmetricMatrix(),
+            initial,
+            tolerance,
+            max_iterations,
+            energy_window);
+    } else {
+        throw std::bad_cast();
+    }
+    if (!mb_pair.has_value()) {
+        return std::nullopt;
+    }
+
+    auto eigenvalues_ = std::make_unique<ArmaDenseVector<T>>();
+    auto eigenvectors_ = std::make_unique<ArmaDenseSemiunitaryMatrix<T>>();
+    eigenvalues_->modifyDenseVector() = std::move(mb_pair->first);
+    eigenvectors_->modifyDenseSemiunitaryMatrix() = std::move(mb_pair->second);
+
+    EigenCouple answer;
     answer.eigenvalues = std::move(eigenvalues_);
-    answer.ftlm_weights_of_states = std::move(ftlm_weights_of_states_);
+    answer.eigenvectors = std::move(eigenvectors_);
+    return answer;
+}
+
+template <typename T, typename M>
+inline std::vector<KrylovCouple> krylovDiagonalizeValuesOfSeeds_(
+    const M& diagonalizableMatrix,
+    const arma::Mat<T>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) {
+    auto krylov_matrices = arma_lanczos::krylovProcedureOfSeeds<T>(
+        diagonalizableMatrix,
+        seed_vectors,
+        krylov_subspace_size,
+        convergence,
+        nullptr);
+
+    std::vector<KrylovCouple> answer(krylov_matrices.size());
+    for (size_t seed = 0; seed < krylov_matrices.size(); ++seed) {
+        // only the first components of eigenvectors are needed for the weights:
+        std::vector<double> first_components;
+        auto eigenvalues = diagonalizeSymmetricTridiagonal(krylov_matrices[seed], 1, first_components);
+
+        auto eigenvalues_ = std::make_unique<ArmaDenseVector<T>>();
+        auto ftlm_weights_of_states_ = std::make_unique<ArmaDenseVector<T>>();
+        eigenvalues_->modifyDenseVector() = arma::conv_to<arma::Col<T>>::from(eigenvalues);
+        ftlm_weights_of_states_->modifyDenseVector() =
+            arma::square(arma::conv_to<arma::Col<T>>::from(first_components));
+
+        answer[seed].eigenvalues = std::move(eigenvalues_);
+        answer[seed].ftlm_weights_of_states = std::move(ftlm_weights_of_states_);
+    }
+    return answer;
+}
+
+template <typename T, typename M>
+inline std::vector<KrylovTriple> krylovDiagonalizeValuesVectorsOfSeeds_(
+    const M& diagonalizableMatrix,
+    const arma::Mat<T>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) {
+    std::vector<arma::Mat<T>> krylov_vectors(
+        seed_vectors.n_cols,
+        arma::Mat<T>(seed_vectors.n_rows, krylov_subspace_size, arma::fill::zeros));
+    auto krylov_matrices = arma_lanczos::krylovProcedureOfSeeds<T>(
+        diagonalizableMatrix,
+        seed_vectors,
+        krylov_subspace_size,
+        convergence,
+        [&krylov_vectors](
+            size_t k,
+            const std::vector<arma::uword>& active_seeds,
+            const arma::Mat<T>& current_vectors) {
+            for (size_t column = 0; column < active_seeds.size(); ++column) {
+                krylov_vectors[active_seeds[column]].col(k) = current_vectors.col(column);
+            }
+        });
+
+    std::vector<KrylovTriple> answer(krylov_matrices.size());
+    for (size_t seed = 0; seed < krylov_matrices.size(); ++seed) {
+        arma::uword size = krylov_matrices[seed].diagonal.size();
+        std::vector<double> eigenvectors_elements;
+        arma::Col<T> eigenvalues = arma::conv_to<arma::Col<T>>::from(
+            diagonalizeSymmetricTridiagonal(krylov_matrices[seed], size, eigenvectors_elements));
+        arma::Mat<T> eigenvectors = arma::conv_to<arma::Mat<T>>::from(
+            arma::mat(eigenvectors_elements.data(), size, size));
+
+        auto eigenvalues_ = std::make_unique<ArmaDenseVector<T>>();
+        auto eigenvectors_ = std::make_unique<ArmaKrylovDenseSemiunitaryMatrix<T>>();
+        auto ftlm_weights_of_states_ = std::make_unique<ArmaDenseVector<T>>();
+
+        arma::Col<T> back_projection = eigenvectors.row(0).t();
+        eigenvalues_->modifyDenseVector() = std::move(eigenvalues);
+        ftlm_weights_of_states_->modifyDenseVector() = arma::square(back_projection);
+        // the procedure of the seed can be stopped before krylov_subspace_size steps:
+        eigenvectors_->modifyKrylovDenseSemiunitaryMatrix() = krylov_vectors[seed].head_cols(size) * eigenvectors;
+        eigenvectors_->modifyBackProjectionVector() = std::move(back_projection);
+        eigenvectors_->modifySeedVector() = seed_vectors.col(seed);
+        // instead of <n|A|r><r|n>, here we are using <n|A|r>/<r|n>,
+        // putting |<r|n>|^2 in the weight of state
+        // in the case of small <r|n>, we substitute it with infinity
+        // to avoid numerical instabilities
+        const T EPSILON = 1e-14;
+        eigenvectors_->modifyBackProjectionVector().clean(EPSILON);
+        eigenvectors_->modifyBackProjectionVector().replace(0, arma::datum::inf);
+        // Krylov vectors of the seed are not needed anymore:
+        krylov_vectors[seed].reset();
+
+        answer[seed].eigenvalues = std::move(eigenvalues_);
+        answer[seed].eigenvectors = std::move(eigenvectors_);
+        answer[seed].ftlm_weights_of_states = std::move(ftlm_weights_of_states_);
+    }
+    return answer;
+}
+
+template <typename T, typename M>
+inline std::vector<KrylovTriple> krylovDiagonalizeValuesVectorsTwoPassOfSeeds_(
+    const M& diagonalizableMatrix,
+    const std::shared_ptr<const AbstractDiagonalizableMatrix>& hamiltonian,
+    const arma::Mat<T>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) {
+    // the first pass: only Krylov matrices are stored
+    auto krylov_matrices = arma_lanczos::krylovProcedureOfSeeds<T>(
+        diagonalizableMatrix,
+        seed_vectors,
+        krylov_subspace_size,
+        convergence,
+        nullptr);
+
+    std::vector<KrylovTriple> answer(krylov_matrices.size());
+    for (size_t seed = 0; seed < krylov_matrices.size(); ++seed) {
+        arma::uword size = krylov_matrices[seed].diagonal.size();
+        std::vector<double> eigenvectors_elements;
+        arma::Col<T> eigenvalues = arma::conv_to<arma::Col<T>>::from(
+            diagonalizeSymmetricTridiagonal(krylov_matrices[seed], size, eigenvectors_elements));
+        arma::Mat<T> eigenvectors = arma::conv_to<arma::Mat<T>>::from(
+            arma::mat(eigenvectors_elements.data(), size, size));
+
+        auto eigenvalues_ = std::make_unique<ArmaDenseVector<T>>();
+        auto eigenvectors_ = std::make_unique<ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>>(hamiltonian);
+        auto ftlm_weights_of_states_ = std::make_unique<ArmaDenseVector<T>>();
+
+        arma::Col<T> back_projection = eigenvectors.row(0).t();
+        eigenvalues_->modifyDenseVector() = std::move(eigenvalues);
+        ftlm_weights_of_states_->modifyDenseVector() = arma::square(back_projection);
+        // the second pass is done in every unitary transformation:
+        eigenvectors_->modifyKrylovDiagonal() = arma::conv_to<arma::Col<T>>::from(krylov_matrices[seed].diagonal);
+        eigenvectors_->modifyKrylovSubdiagonal() = arma::conv_to<arma::Col<T>>::from(krylov_matrices[seed].subdiagonal);
+        eigenvectors_->modifyRitzDenseSemiunitaryMatrix() = std::move(eigenvectors);
+        eigenvectors_->modifyBackProjectionVector() = std::move(back_projection);
+        eigenvectors_->modifySeedVector() = seed_vectors.col(seed);
+        // see krylovDiagonalizeValuesVectorsOfSeeds_ for details:
+        const T EPSILON = 1e-14;
+        eigenvectors_->modifyBackProjectionVector().clean(EPSILON);
+        eigenvectors_->modifyBackProjectionVector().replace(0, arma::datum::inf);
+
+        answer[seed].eigenvalues = std::move(eigenvalues_);
+        answer[seed].eigenvectors = std::move(eigenvectors_);
+        answer[seed].ftlm_weights_of_states = std::move(ftlm_weights_of_states_);
+    }
     return answer;
 }
 
@@ -224,86 +631,73 @@ KrylovCouple ArmaLogic<T>::krylovDiagonalizeValues(
     size_t krylov_subspace_size) const {
     if (auto maybeDenseVector =
         dynamic_cast<const ArmaDenseVector<T>*>(&seed_vector)) {
+        arma::Mat<T> seed_matrix = maybeDenseVector->getDenseVector();
         if (auto maybeDenseSymmetricMatrix =
             dynamic_cast<const ArmaDenseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
             // It is slow, avoid this branch.
-            return krylovDiagonalizeValues_(
+            return std::move(krylovDiagonalizeValuesOfSeeds_(
                 maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix(),
-                *maybeDenseVector,
-                krylov_subspace_size
-            );
+                seed_matrix,
+                krylov_subspace_size,
+                std::nullopt
+            )[0]);
         } else if (auto maybeSparseSymmetricMatrix =
             dynamic_cast<const ArmaSparseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
-            return krylovDiagonalizeValues_(
+            return std::move(krylovDiagonalizeValuesOfSeeds_(
                 maybeSparseSymmetricMatrix->getSparseSymmetricMatrix(),
-                *maybeDenseVector,
-                krylov_subspace_size
-            );
-       } else {
-           throw std::bad_cast();
-       }
-   } else {
-       throw std::bad_cast();
-   }
-}
-
-template <typename T, typename M>
-inline KrylovTriple krylovDiagonalizeValuesVectors_(
-    const M& diagonalizableMatrix,
-    const ArmaDenseVector<T>& seed_vector,
-    size_t krylov_subspace_size) {
-    auto eigenvalues_ = std::make_unique<ArmaDenseVector<T>>();
-    auto eigenvectors_ = std::make_unique<ArmaKrylovDenseSemiunitaryMatrix<T>>();
-    auto ftlm_weights_of_states_ = std::make_unique<ArmaDenseVector<T>>();
-
-    auto triple = krylovProcedureDiagonalizeValuesVectors_(
-        diagonalizableMatrix,
-        seed_vector.getDenseVector(),
-        krylov_subspace_size);
-
-    eigenvalues_->modifyDenseVector() = std::move(std::get<0>(triple));
-    ftlm_weights_of_states_->modifyDenseVector() = arma::square(std::get<2>(triple));
-    eigenvectors_->modifyKrylovDenseSemiunitaryMatrix() = std::move(std::get<1>(triple));
-    eigenvectors_->modifyBackProjectionVector() = std::move(std::get<2>(triple));
-    eigenvectors_->modifySeedVector() = seed_vector.getDenseVector();
-
-    // instead of <n|A|r><r|n>, here we are using <n|A|r>/<r|n>,
-    // putting |<r|n>|^2 in the weight of state
-    // in the case of small <r|n>, we substitute it with infinity 
-    // to avoid numerical instabilities
-    const T EPSILON = 1e-14;
-    eigenvectors_->modifyBackProjectionVector().clean(EPSILON);
-    eigenvectors_->modifyBackProjectionVector().replace(0, arma::datum::inf);
-
-    KrylovTriple answer;
-    answer.eigenvalues = std::move(eigenvalues_);
-    answer.eigenvectors = std::move(eigenvectors_);
-    answer.ftlm_weights_of_states = std::move(ftlm_weights_of_states_);
-    return answer;
+                seed_matrix,
+                krylov_subspace_size,
+                std::nullopt
+            )[0]);
+        } else if (auto maybeMatrixFreeMatrix =
+            dynamic_cast<const ArmaMatrixFreeDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+            return std::move(krylovDiagonalizeValuesOfSeeds_(
+                *maybeMatrixFreeMatrix,
+                seed_matrix,
+                krylov_subspace_size,
+                std::nullopt
+            )[0]);
+        } else {
+            throw std::bad_cast();
+        }
+    } else {
+        throw std::bad_cast();
+    }
 }
 
 template <typename T>
 KrylovTriple ArmaLogic<T>::krylovDiagonalizeValuesVectors(
     const AbstractDiagonalizableMatrix& diagonalizableMatrix,
     const AbstractDenseVector& seed_vector,
-    size_t krylov_subspace_size) const { 
+    size_t krylov_subspace_size) const {
     if (auto maybeDenseVector =
         dynamic_cast<const ArmaDenseVector<T>*>(&seed_vector)) {
+        arma::Mat<T> seed_matrix = maybeDenseVector->getDenseVector();
         if (auto maybeDenseSymmetricMatrix =
             dynamic_cast<const ArmaDenseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
             // It is slow, avoid this branch.
-            return krylovDiagonalizeValuesVectors_(
+            return std::move(krylovDiagonalizeValuesVectorsOfSeeds_(
                 maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix(),
-                *maybeDenseVector,
-                krylov_subspace_size
-            );
+                seed_matrix,
+                krylov_subspace_size,
+                std::nullopt
+            )[0]);
         } else if (auto maybeSparseSymmetricMatrix =
             dynamic_cast<const ArmaSparseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
-            return krylovDiagonalizeValuesVectors_(
+            return std::move(krylovDiagonalizeValuesVectorsOfSeeds_(
                 maybeSparseSymmetricMatrix->getSparseSymmetricMatrix(),
-                *maybeDenseVector,
-                krylov_subspace_size
-            );
+                seed_matrix,
+                krylov_subspace_size,
+                std::nullopt
+            )[0]);
+        } else if (auto maybeMatrixFreeMatrix =
+            dynamic_cast<const ArmaMatrixFreeDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+            return std::move(krylovDiagonalizeValuesVectorsOfSeeds_(
+                *maybeMatrixFreeMatrix,
+                seed_matrix,
+                krylov_subspace_size,
+                std::nullopt
+            )[0]);
         } else {
             throw std::bad_cast();
         }
@@ -312,6 +706,142 @@ KrylovTriple ArmaLogic<T>::krylovDiagonalizeValuesVectors(
     }
 }
 
+template <typename T>
+inline arma::Mat<T> seedVectorsToMatrix_(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors) {
+    arma::Mat<T> answer;
+    for (size_t seed = 0; seed < seed_vectors.size(); ++seed) {
+        auto maybeDenseVector = dynamic_cast<const ArmaDenseVector<T>*>(seed_vectors[seed].get());
+        if (maybeDenseVector == nullptr) {
+            throw std::bad_cast();
+        }
+        const auto& seed_vector = maybeDenseVector->getDenseVector();
+        if (seed == 0) {
+            answer.set_size(seed_vector.n_elem, seed_vectors.size());
+        } else if (seed_vector.n_elem != answer.n_rows) {
+            throw std::length_error("Seed vectors have different sizes");
+        }
+        answer.col(seed) = seed_vector;
+    }
+    return answer;
+}
+
+template <typename T>
+std::vector<KrylovCouple> ArmaLogic<T>::krylovDiagonalizeValues(
+    const AbstractDiagonalizableMatrix& diagonalizableMatrix,
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    auto seed_matrix = seedVectorsToMatrix_<T>(seed_vectors);
+    if (auto maybeDenseSymmetricMatrix =
+        dynamic_cast<const ArmaDenseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        // It is slow, avoid this branch.
+        return krylovDiagonalizeValuesOfSeeds_(
+            maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix(),
+            seed_matrix,
+            krylov_subspace_size,
+            convergence
+        );
+    } else if (auto maybeSparseSymmetricMatrix =
+        dynamic_cast<const ArmaSparseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        return krylovDiagonalizeValuesOfSeeds_(
+            maybeSparseSymmetricMatrix->getSparseSymmetricMatrix(),
+            seed_matrix,
+            krylov_subspace_size,
+            convergence
+        );
+    } else if (auto maybeMatrixFreeMatrix =
+        dynamic_cast<const ArmaMatrixFreeDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        return krylovDiagonalizeValuesOfSeeds_(
+            *maybeMatrixFreeMatrix,
+            seed_matrix,
+            krylov_subspace_size,
+            convergence
+        );
+    } else {
+        throw std::bad_cast();
+    }
+}
+
+template <typename T>
+std::vector<KrylovTriple> ArmaLogic<T>::krylovDiagonalizeValuesVectors(
+    const AbstractDiagonalizableMatrix& diagonalizableMatrix,
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    auto seed_matrix = seedVectorsToMatrix_<T>(seed_vectors);
+    if (auto maybeDenseSymmetricMatrix =
+        dynamic_cast<const ArmaDenseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        // It is slow, avoid this branch.
+        return krylovDiagonalizeValuesVectorsOfSeeds_(
+            maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix(),
+            seed_matrix,
+            krylov_subspace_size,
+            convergence
+        );
+    } else if (auto maybeSparseSymmetricMatrix =
+        dynamic_cast<const ArmaSparseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        return krylovDiagonalizeValuesVectorsOfSeeds_(
+            maybeSparseSymmetricMatrix->getSparseSymmetricMatrix(),
+            seed_matrix,
+            krylov_subspace_size,
+            convergence
+        );
+    } else if (auto maybeMatrixFreeMatrix =
+        dynamic_cast<const ArmaMatrixFreeDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        return krylovDiagonalizeValuesVectorsOfSeeds_(
+            *maybeMatrixFreeMatrix,
+            seed_matrix,
+            krylov_subspace_size,
+            convergence
+        );
+    } else {
+        throw std::bad_cast();
+    }
+}
+
+template <typename T>
+std::vector<KrylovTriple> ArmaLogic<T>::krylovDiagonalizeValuesVectorsTwoPass(
+    const AbstractDiagonalizableMatrix& diagonalizableMatrix,
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    auto seed_matrix = seedVectorsToMatrix_<T>(seed_vectors);
+    // eigenvectors share the ownership of the matrix to regenerate Krylov vectors:
+    auto hamiltonian = diagonalizableMatrix.shared_from_this();
+    if (auto maybeDenseSymmetricMatrix =
+        dynamic_cast<const ArmaDenseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        // It is slow, avoid this branch.
+        return krylovDiagonalizeValuesVectorsTwoPassOfSeeds_(
+            maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix(),
+            hamiltonian,
+            seed_matrix,
+            krylov_subspace_size,
+            convergence
+        );
+    } else if (auto maybeSparseSymmetricMatrix =
+        dynamic_cast<const ArmaSparseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        return krylovDiagonalizeValuesVectorsTwoPassOfSeeds_(
+            maybeSparseSymmetricMatrix->getSparseSymmetricMatrix(),
+            hamiltonian,
+            seed_matrix,
+            krylov_subspace_size,
+            convergence
+        );
+    } else if (auto maybeMatrixFreeMatrix =
+        dynamic_cast<const ArmaMatrixFreeDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        return krylovDiagonalizeValuesVectorsTwoPassOfSeeds_(
+            *maybeMatrixFreeMatrix,
+            hamiltonian,
+            seed_matrix,
+            krylov_subspace_size,
+            convergence
+        );
+    } else {
+        throw std::bad_cast();
+    }
+}
+
 template<typename T, typename M>
 inline std::unique_ptr<AbstractDiagonalizableMatrix> unitaryTransform_(
     const M& symmetric_matrix,
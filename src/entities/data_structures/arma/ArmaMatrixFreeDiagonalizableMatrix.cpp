@@ -0,0 +1,160 @@
+#include "ArmaMatrixFreeDiagonalizableMatrix.h"
+
+#include <ostream>
+#include <stdexcept>
+
+#include "ArmaLogic.h"
+
+namespace quantum::linear_algebra {
+
+template <typename T>
+ArmaMatrixFreeDiagonalizableMatrix<T>::ArmaMatrixFreeDiagonalizableMatrix(
+    std::shared_ptr<const AbstractMatrixFreeOperator> matrix_free_operator,
+    double multiplier) :
+    matrix_free_operator_(std::move(matrix_free_operator)),
+    multiplier_(multiplier) {}
+
+template <typename T>
+void ArmaMatrixFreeDiagonalizableMatrix<T>::add_to_position(double value, uint32_t i, uint32_t j) {
+    throw std::logic_error("Matrix-free matrix cannot be modified");
+}
+
+template <typename T>
+EigenCouple ArmaMatrixFreeDiagonalizableMatrix<T>::diagonalizeValuesVectors() const {
+    throw std::logic_error("Matrix-free matrix can be diagonalized only by Krylov procedure");
+}
+
+template <typename T>
+std::unique_ptr<AbstractDenseVector> ArmaMatrixFreeDiagonalizableMatrix<T>::diagonalizeValues() const {
+    throw std::logic_error("Matrix-free matrix can be diagonalized only by Krylov procedure");
+}
+
+template <typename T>
+EigenCouple ArmaMatrixFreeDiagonalizableMatrix<T>::diagonalizeValuesVectorsInWindow(double) const {
+    throw std::logic_error("Matrix-free matrix can be diagonalized only by Krylov procedure");
+}
+
+template <typename T>
+std::optional<EigenCouple> ArmaMatrixFreeDiagonalizableMatrix<T>::refineDiagonalizeValuesVectors(
+    const AbstractDenseSemiunitaryMatrix&,
+    double,
+    size_t,
+    std::optional<double>) const {
+    throw std::logic_error("Matrix-free matrix can be diagonalized only by Krylov procedure");
+}
+
+template <typename T>
+KrylovCouple ArmaMatrixFreeDiagonalizableMatrix<T>::krylovDiagonalizeValues(
+    const std::unique_ptr<AbstractDenseVector>& seed_vector,
+    size_t krylov_subspace_size) const {
+    ArmaLogic<T> logic;
+
+    return logic.krylovDiagonalizeValues(
+        *this,
+        *seed_vector,
+        krylov_subspace_size);
+}
+
+template <typename T>
+KrylovTriple ArmaMatrixFreeDiagonalizableMatrix<T>::krylovDiagonalizeValuesVectors(
+    const std::unique_ptr<AbstractDenseVector>& seed_vector,
+    size_t krylov_subspace_size) const {
+    ArmaLogic<T> logic;
+
+    return logic.krylovDiagonalizeValuesVectors(
+        *this,
+        *seed_vector,
+        krylov_subspace_size);
+}
+
+template <typename T>
+std::vector<KrylovCouple> ArmaMatrixFreeDiagonalizableMatrix<T>::krylovDiagonalizeValues(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    ArmaLogic<T> logic;
+    return logic.krylovDiagonalizeValues(*this, seed_vectors, krylov_subspace_size, convergence);
+}
+
+template <typename T>
+std::vector<KrylovTriple> ArmaMatrixFreeDiagonalizableMatrix<T>::krylovDiagonalizeValuesVectors(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    ArmaLogic<T> logic;
+    return logic.krylovDiagonalizeValuesVectors(*this, seed_vectors, krylov_subspace_size, convergence);
+}
+
+template <typename T>
+std::vector<KrylovTriple> ArmaMatrixFreeDiagonalizableMatrix<T>::krylovDiagonalizeValuesVectorsTwoPass(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    ArmaLogic<T> logic;
+    return logic.krylovDiagonalizeValuesVectorsTwoPass(*this, seed_vectors, krylov_subspace_size, convergence);
+}
+
+template <typename T>
+std::unique_ptr<AbstractDiagonalizableMatrix>
+ArmaMatrixFreeDiagonalizableMatrix<T>::multiply_by(double multiplier) const {
+    return std::make_unique<ArmaMatrixFreeDiagonalizableMatrix>(
+        matrix_free_operator_,
+        multiplier_ * multiplier);
+}
+
+template <typename T>
+void ArmaMatrixFreeDiagonalizableMatrix<T>::add_scaled(double, const AbstractDiagonalizableMatrix&) {
+    throw std::logic_error("Matrix-free matrix cannot be modified");
+}
+
+template <typename T>
+void ArmaMatrixFreeDiagonalizableMatrix<T>::add_sparsity_pattern(const AbstractDiagonalizableMatrix&) {
+    throw std::logic_error("Matrix-free matrix cannot be modified");
+}
+
+template <typename T>
+std::vector<double> ArmaMatrixFreeDiagonalizableMatrix<T>::stored_values_of(const AbstractDiagonalizableMatrix&) const {
+    throw std::logic_error("Matrix-free matrix does not store its elements");
+}
+
+template <typename T>
+void ArmaMatrixFreeDiagonalizableMatrix<T>::assign_stored_values(const std::vector<double>&) {
+    throw std::logic_error("Matrix-free matrix cannot be modified");
+}
+
+template <typename T>
+uint32_t ArmaMatrixFreeDiagonalizableMatrix<T>::size() const {
+    return matrix_free_operator_->size();
+}
+
+template <typename T>
+double ArmaMatrixFreeDiagonalizableMatrix<T>::at(uint32_t i, uint32_t j) const {
+    arma::Mat<T> unit_vector(size(), 1, arma::fill::zeros);
+    unit_vector.at(j, 0) = 1;
+    arma::Mat<T> column;
+    multiply(unit_vector, column);
+    return column.at(i, 0);
+}
+
+template <typename T>
+void ArmaMatrixFreeDiagonalizableMatrix<T>::print(std::ostream& os) const {
+    os << "Matrix-free matrix of size " << size() << std::endl;
+}
+
+template <typename T>
+void ArmaMatrixFreeDiagonalizableMatrix<T>::multiply(
+    const arma::Mat<T>& in,
+    arma::Mat<T>& out) const {
+    if (in.n_rows != size()) {
+        throw std::length_error("Size of vectors is not equal to size of matrix-free matrix");
+    }
+    out.set_size(in.n_rows, in.n_cols);
+    matrix_free_operator_->apply(in.memptr(), out.memptr(), in.n_cols);
+    if (multiplier_ != 1) {
+        out *= (T)multiplier_;
+    }
+}
+
+template class ArmaMatrixFreeDiagonalizableMatrix<double>;
+template class ArmaMatrixFreeDiagonalizableMatrix<float>;
+}  // namespace quantum::linear_algebra
@@ -1,5 +1,10 @@
 #include "ArmaSparseDiagonalizableMatrix.h"
 
+#include <algorithm>
+#include <stdexcept>
+#include <typeinfo>
+#include <vector>
+
 #include "ArmaLogic.h"
 
 namespace quantum::linear_algebra {
@@ -31,6 +36,29 @@ std::unique_ptr<AbstractDenseVector> ArmaSparseDiagonalizableMatrix<T>::diagonal
     return logic.diagonalizeValues(*this);
 }
 
+template <typename T>
+EigenCouple ArmaSparseDiagonalizableMatrix<T>::diagonalizeValuesVectorsInWindow(double energy_window) const {
+    ArmaLogic<T> logic;
+
+    return logic.diagonalizeValuesVectorsInWindow(*this, energy_window);
+}
+
+template <typename T>
+std::optional<EigenCouple> ArmaSparseDiagonalizableMatrix<T>::refineDiagonalizeValuesVectors(
+    const AbstractDenseSemiunitaryMatrix& initial_eigenvectors,
+    double tolerance,
+    size_t max_iterations,
+    std::optional<double> energy_window) const {
+    ArmaLogic<T> logic;
+
+    return logic.refineDiagonalizeValuesVectors(
+        *this,
+        initial_eigenvectors,
+        tolerance,
+        max_iterations,
+        energy_window);
+}
+
 template <typename T>
 KrylovCouple ArmaSparseDiagonalizableMatrix<T>::krylovDiagonalizeValues(
     const std::unique_ptr<AbstractDenseVector>& seed_vector,
@@ -55,15 +83,156 @@ KrylovTriple ArmaSparseDiagonalizableMatrix<T>::krylovDiagonalizeValuesVectors(
         krylov_subspace_size);
 }
 
+template <typename T>
+std::vector<KrylovCouple> ArmaSparseDiagonalizableMatrix<T>::krylovDiagonalizeValues(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    ArmaLogic<T> logic;
+    return logic.krylovDiagonalizeValues(*this, seed_vectors, krylov_subspace_size, convergence);
+}
+
+template <typename T>
+std::vector<KrylovTriple> ArmaSparseDiagonalizableMatrix<T>::krylovDiagonalizeValuesVectors(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    ArmaLogic<T> logic;
+    return logic.krylovDiagonalizeValuesVectors(*this, seed_vectors, krylov_subspace_size, convergence);
+}
+
+template <typename T>
+std::vector<KrylovTriple> ArmaSparseDiagonalizableMatrix<T>::krylovDiagonalizeValuesVectorsTwoPass(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    ArmaLogic<T> logic;
+    return logic.krylovDiagonalizeValuesVectorsTwoPass(*this, seed_vectors, krylov_subspace_size, convergence);
+}
+
 template <typename T>
 std::unique_ptr<AbstractDiagonalizableMatrix>
 ArmaSparseDiagonalizableMatrix<T>::multiply_by(double multiplier) const {
     auto answer = std::make_unique<ArmaSparseDiagonalizableMatrix>();
     answer->resize(size());
-    answer->sparseDiagonalizableMatrix_ = sparseDiagonalizableMatrix_ * multiplier;
+    // the copy keeps explicitly stored zeros of the sparsity pattern:
+    answer->sparseDiagonalizableMatrix_ = sparseDiagonalizableMatrix_;
+    if (multiplier != 1) {
+        answer->sparseDiagonalizableMatrix_ *= (T)multiplier;
+    }
     return answer;
 }
 
+template <typename T>
+void ArmaSparseDiagonalizableMatrix<T>::add_scaled(
+    double multiplier,
+    const AbstractDiagonalizableMatrix& rhs) {
+    auto maybe_rhs = dynamic_cast<const ArmaSparseDiagonalizableMatrix*>(&rhs);
+    if (maybe_rhs == nullptr) {
+        throw std::bad_cast();
+    }
+    if (maybe_rhs->size() != size()) {
+        throw std::length_error("Sizes of summed matrices are different");
+    }
+    sparseDiagonalizableMatrix_ += (T)multiplier * maybe_rhs->sparseDiagonalizableMatrix_;
+}
+
+template <typename T>
+void ArmaSparseDiagonalizableMatrix<T>::add_sparsity_pattern(const AbstractDiagonalizableMatrix& rhs) {
+    auto maybe_rhs = dynamic_cast<const ArmaSparseDiagonalizableMatrix*>(&rhs);
+    if (maybe_rhs == nullptr) {
+        throw std::bad_cast();
+    }
+    if (maybe_rhs->size() != size()) {
+        throw std::length_error("Sizes of matrices are different");
+    }
+    const auto& lhs_matrix = sparseDiagonalizableMatrix_;
+    const auto& rhs_matrix = maybe_rhs->sparseDiagonalizableMatrix_;
+    lhs_matrix.sync();
+    rhs_matrix.sync();
+    // armadillo removes zeros in arithmetic operations,
+    // so the union of stored elements is constructed from locations explicitly:
+    std::vector<arma::uword> rows;
+    std::vector<arma::uword> cols;
+    std::vector<T> values;
+    for (arma::uword col = 0; col < lhs_matrix.n_cols; ++col) {
+        arma::uword i = lhs_matrix.col_ptrs[col];
+        arma::uword j = rhs_matrix.col_ptrs[col];
+        while (i < lhs_matrix.col_ptrs[col + 1] || j < rhs_matrix.col_ptrs[col + 1]) {
+            bool from_lhs = i < lhs_matrix.col_ptrs[col + 1]
+                && (j == rhs_matrix.col_ptrs[col + 1] || lhs_matrix.row_indices[i] <= rhs_matrix.row_indices[j]);
+            if (from_lhs) {
+                if (j < rhs_matrix.col_ptrs[col + 1] && lhs_matrix.row_indices[i] == rhs_matrix.row_indices[j]) {
+                    ++j;
+                }
+                rows.push_back(lhs_matrix.row_indices[i]);
+                values.push_back(lhs_matrix.values[i]);
+                ++i;
+            } else {
+                rows.push_back(rhs_matrix.row_indices[j]);
+                values.push_back(0);
+                ++j;
+            }
+            cols.push_back(col);
+        }
+    }
+    arma::umat locations(2, rows.size());
+    locations.row(0) = arma::urowvec(rows);
+    locations.row(1) = arma::urowvec(cols);
+    // locations are already sorted, zeros are kept:
+    sparseDiagonalizableMatrix_ = arma::SpMat<T>(
+        locations, arma::Col<T>(values), lhs_matrix.n_rows, lhs_matrix.n_cols, false, false);
+}
+
+template <typename T>
+std::vector<double> ArmaSparseDiagonalizableMatrix<T>::stored_values_of(const AbstractDiagonalizableMatrix& rhs) const {
+    auto maybe_rhs = dynamic_cast<const ArmaSparseDiagonalizableMatrix*>(&rhs);
+    if (maybe_rhs == nullptr) {
+        throw std::bad_cast();
+    }
+    if (maybe_rhs->size() != size()) {
+        throw std::length_error("Sizes of matrices are different");
+    }
+    const auto& lhs_matrix = sparseDiagonalizableMatrix_;
+    const auto& rhs_matrix = maybe_rhs->sparseDiagonalizableMatrix_;
+    lhs_matrix.sync();
+    rhs_matrix.sync();
+    std::vector<double> answer;
+    answer.reserve(lhs_matrix.n_nonzero);
+    for (arma::uword col = 0; col < lhs_matrix.n_cols; ++col) {
+        arma::uword j = rhs_matrix.col_ptrs[col];
+        for (arma::uword i = lhs_matrix.col_ptrs[col]; i < lhs_matrix.col_ptrs[col + 1]; ++i) {
+            if (j < rhs_matrix.col_ptrs[col + 1] && rhs_matrix.row_indices[j] < lhs_matrix.row_indices[i]) {
+                break;
+            }
+            if (j < rhs_matrix.col_ptrs[col + 1] && rhs_matrix.row_indices[j] == lhs_matrix.row_indices[i]) {
+                answer.push_back(rhs_matrix.values[j]);
+                ++j;
+            } else {
+                answer.push_back(0);
+            }
+        }
+        if (j < rhs_matrix.col_ptrs[col + 1]) {
+            throw std::invalid_argument("Stored elements of matrix are not in the sparsity pattern");
+        }
+    }
+    return answer;
+}
+
+template <typename T>
+void ArmaSparseDiagonalizableMatrix<T>::assign_stored_values(const std::vector<double>& values) {
+    auto& matrix = sparseDiagonalizableMatrix_;
+    matrix.sync();
+    if (values.size() != matrix.n_nonzero) {
+        throw std::length_error("Number of values is not equal to number of stored elements");
+    }
+    // compressed sparse column structure is reused, zeros are kept:
+    arma::uvec row_indices(matrix.row_indices, matrix.n_nonzero);
+    arma::uvec col_ptrs(matrix.col_ptrs, matrix.n_cols + 1);
+    matrix = arma::SpMat<T>(
+        row_indices, col_ptrs, arma::conv_to<arma::Col<T>>::from(values), matrix.n_rows, matrix.n_cols, false);
+}
+
 template <typename T>
 uint32_t ArmaSparseDiagonalizableMatrix<T>::size() const {
     return sparseDiagonalizableMatrix_.n_rows;
@@ -13,6 +13,12 @@ class ArmaSparseDiagonalizableMatrix: public AbstractDiagonalizableMatrix {
     void resize(uint32_t matrix_in_space_basis_size_i);
     EigenCouple diagonalizeValuesVectors() const override;
     std::unique_ptr<AbstractDenseVector> diagonalizeValues() const override;
+    EigenCouple diagonalizeValuesVectorsInWindow(double energy_window) const override;
+    std::optional<EigenCouple> refineDiagonalizeValuesVectors(
+      const AbstractDenseSemiunitaryMatrix& initial_eigenvectors,
+      double tolerance,
+      size_t max_iterations,
+      std::optional<double> energy_window) const override;
 
     KrylovCouple krylovDiagonalizeValues(
       const std::unique_ptr<AbstractDenseVector>& seed_vector,
@@ -21,8 +27,24 @@ class ArmaSparseDiagonalizableMatrix: public AbstractDiagonalizableMatrix {
     KrylovTriple krylovDiagonalizeValuesVectors(
       const std::unique_ptr<AbstractDenseVector>& seed_vector,
       size_t krylov_subspace_size) const override;
+    std::vector<KrylovCouple> krylovDiagonalizeValues(
+      const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+      size_t krylov_subspace_size,
+      const std::optional<KrylovConvergence>& convergence) const override;
+    std::vector<KrylovTriple> krylovDiagonalizeValuesVectors(
+      const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+      size_t krylov_subspace_size,
+      const std::optional<KrylovConvergence>& convergence) const override;
+    std::vector<KrylovTriple> krylovDiagonalizeValuesVectorsTwoPass(
+      const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+      size_t krylov_subspace_size,
+      const std::optional<KrylovConvergence>& convergence) const override;
 
     std::unique_ptr<AbstractDiagonalizableMatrix> multiply_by(double multiplier) const override;
+    void add_scaled(double multiplier, const AbstractDiagonalizableMatrix& rhs) override;
+    void add_sparsity_pattern(const AbstractDiagonalizableMatrix& rhs) override;
+    std::vector<double> stored_values_of(const AbstractDiagonalizableMatrix& rhs) const override;
+    void assign_stored_values(const std::vector<double>& values) override;
     uint32_t size() const override;
     double at(uint32_t i, uint32_t j) const override;
     void print(std::ostream& os) const override;
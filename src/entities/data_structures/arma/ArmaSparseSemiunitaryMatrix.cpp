@@ -1,5 +1,8 @@
 #include "ArmaSparseSemiunitaryMatrix.h"
 
+#include "ArmaLocalSparseSymmetricMatrix.h"
+#include "ArmaSparseDiagonalizableMatrix.h"
+
 namespace quantum::linear_algebra {
 
 struct IteratorImpl: public AbstractSparseSemiunitaryMatrix::Iterator {
@@ -112,6 +115,47 @@ const arma::sp_mat& ArmaSparseSemiunitaryMatrix::getSparseSemiunitaryMatrix() co
 void ArmaSparseSemiunitaryMatrix::unitaryTransform(
     const std::unique_ptr<AbstractSymmetricMatrix>& symmetricMatrixToTransform,
     std::unique_ptr<AbstractDiagonalizableMatrix>& symmetricMatrixToAdd) const {
-    throw std::invalid_argument("unitaryTransform not implemented in ArmaSparseSemiunitaryMatrix");
+    arma::sp_mat transformed;
+    auto maybeLocalSymmetricMatrix =
+        dynamic_cast<const ArmaLocalSparseSymmetricMatrix*>(symmetricMatrixToTransform.get());
+    if (maybeLocalSymmetricMatrix != nullptr) {
+        // rows of the semiunitary matrix are renumbered to local indexes:
+        arma::umat locations(2, sparseSemiunitaryMatrix_.n_nonzero);
+        arma::vec values(sparseSemiunitaryMatrix_.n_nonzero);
+        size_t position = 0;
+        for (auto it = sparseSemiunitaryMatrix_.begin(); it != sparseSemiunitaryMatrix_.end(); ++it) {
+            auto mb_local_index = maybeLocalSymmetricMatrix->to_local_index(it.row());
+            if (!mb_local_index.has_value()) {
+                throw std::invalid_argument(
+                    "Lexicographic vector of the block is absent in the local symmetric matrix");
+            }
+            locations(0, position) = mb_local_index.value();
+            locations(1, position) = it.col();
+            values(position) = *it;
+            ++position;
+        }
+        arma::sp_mat local_semiunitary_matrix(
+            locations,
+            values,
+            maybeLocalSymmetricMatrix->size(),
+            sparseSemiunitaryMatrix_.n_cols);
+        transformed = local_semiunitary_matrix.t()
+            * maybeLocalSymmetricMatrix->getLocalSparseSymmetricMatrix() * local_semiunitary_matrix;
+    } else {
+        auto maybeSymmetricMatrix =
+            dynamic_cast<const ArmaSparseSymmetricMatrix<double>*>(symmetricMatrixToTransform.get());
+        if (maybeSymmetricMatrix == nullptr) {
+            throw std::bad_cast();
+        }
+        transformed = sparseSemiunitaryMatrix_.t()
+            * maybeSymmetricMatrix->getSparseSymmetricMatrix() * sparseSemiunitaryMatrix_;
+    }
+
+    // add_to_position fills both triangles, so only the lower one is added:
+    for (auto it = transformed.begin(); it != transformed.end(); ++it) {
+        if (it.row() >= it.col()) {
+            symmetricMatrixToAdd->add_to_position(*it, it.row(), it.col());
+        }
+    }
 }
 }  // namespace quantum::linear_algebra
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "ArmaTwoPassKrylovDenseSemiunitaryMatrix.h"
+
+#include <optional>
+#include <stdexcept>
+#include <typeinfo>
+#include <vector>
+
+#include "ArmaDenseDiagonalizableMatrix.h"
+#include "ArmaKrylovProcedure.h"
+#include "ArmaMatrixFreeDiagonalizableMatrix.h"
+#include "ArmaSparseDiagonalizableMatrix.h"
+#include "ArmaTwoPassKrylovDenseSemiunitaryTransformer.h"
+
+namespace {
+// Krylov vectors are regenerated by the same Lanczos procedure (and the same block product) as in the first pass,
+// so they are the same vectors, whose Krylov matrix was diagonalized:
+template <typename T, typename M>
+arma::Mat<T> projectOnKrylovVectorsOfSeed_(
+    const M& matrix,
+    const arma::Col<T>& seed_vector,
+    arma::uword krylov_subspace_size,
+    const arma::Mat<T>& projections) {
+    arma::Mat<T> answer(krylov_subspace_size, projections.n_cols, arma::fill::zeros);
+    arma::Mat<T> seed_vectors = seed_vector;
+    quantum::linear_algebra::arma_lanczos::krylovProcedureOfSeeds<T>(
+        matrix,
+        seed_vectors,
+        krylov_subspace_size,
+        std::nullopt,
+        [&answer, &projections](
+            size_t k,
+            const std::vector<arma::uword>& active_seeds,
+            const arma::Mat<T>& current_vectors) {
+            answer.row(k) = current_vectors.col(0).t() * projections;
+        });
+    return answer;
+}
+}  // namespace
+
+namespace quantum::linear_algebra {
+
+template <typename T>
+ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>::ArmaTwoPassKrylovDenseSemiunitaryMatrix(
+    std::shared_ptr<const AbstractDiagonalizableMatrix> hamiltonian) :
+    hamiltonian_(std::move(hamiltonian)) {
+    transformer_ = std::make_unique<ArmaTwoPassKrylovDenseSemiunitaryTransformer<T>>(this);
+}
+
+template <typename T>
+const std::unique_ptr<AbstractDenseSemiunitaryTransformer>& ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>::getUnitaryTransformer() const {
+    return transformer_;
+}
+
+template <typename T>
+uint32_t ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>::size_rows() const {
+    return seed_vector_.n_elem;
+}
+
+template <typename T>
+uint32_t ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>::size_cols() const {
+    return ritzDenseSemiunitaryMatrix_.n_cols;
+}
+
+template <typename T>
+double ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>::at(uint32_t i, uint32_t j) const {
+    arma::Mat<T> unit_vector(size_rows(), 1, arma::fill::zeros);
+    unit_vector.at(j, 0) = 1;
+    return arma::dot(ritzDenseSemiunitaryMatrix_.col(i), projectOnKrylovVectors(unit_vector).col(0));
+}
+
+template <typename T>
+void ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>::print(std::ostream& os) const {
+    os << "KrylovDiagonal:\n" << krylov_diagonal_ << std::endl;
+    os << "KrylovSubdiagonal:\n" << krylov_subdiagonal_ << std::endl;
+    os << "RitzDenseSemiunitaryMatrix:\n" << ritzDenseSemiunitaryMatrix_ << std::endl;
+}
+
+template <typename T>
+arma::Mat<T> ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>::projectOnKrylovVectors(
+    const arma::Mat<T>& projections) const {
+    arma::uword krylov_subspace_size = krylov_diagonal_.n_elem;
+    if (auto maybeDenseSymmetricMatrix =
+        dynamic_cast<const ArmaDenseDiagonalizableMatrix<T>*>(hamiltonian_.get())) {
+        return projectOnKrylovVectorsOfSeed_(
+            maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix(),
+            seed_vector_,
+            krylov_subspace_size,
+            projections);
+    } else if (auto maybeSparseSymmetricMatrix =
+        dynamic_cast<const ArmaSparseDiagonalizableMatrix<T>*>(hamiltonian_.get())) {
+        return projectOnKrylovVectorsOfSeed_(
+            maybeSparseSymmetricMatrix->getSparseSymmetricMatrix(),
+            seed_vector_,
+            krylov_subspace_size,
+            projections);
+    } else if (auto maybeMatrixFreeMatrix =
+        dynamic_cast<const ArmaMatrixFreeDiagonalizableMatrix<T>*>(hamiltonian_.get())) {
+        return projectOnKrylovVectorsOfSeed_(
+            *maybeMatrixFreeMatrix,
+            seed_vector_,
+            krylov_subspace_size,
+            projections);
+    } else {
+        throw std::bad_cast();
+    }
+}
+
+template <typename T>
+const std::shared_ptr<const AbstractDiagonalizableMatrix>& ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>::getHamiltonian() const {
+    return hamiltonian_;
+}
+
+template <typename T>
+const arma::Col<T>& ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>::getKrylovDiagonal() const {
+    return krylov_diagonal_;
+}
+
+template <typename T>
+arma::Col<T>& ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>::modifyKrylovDiagonal() {
+    return krylov_diagonal_;
+}
+
+template <typename T>
+const arma::Col<T>& ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>::getKrylovSubdiagonal() const {
+    return krylov_subdiagonal_;
+}
+
+template <typename T>
+arma::Col<T>& ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>::modifyKrylovSubdiagonal() {
+    return krylov_subdiagonal_;
+}
+
+template <typename T>
+const arma::Mat<T>& ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>::getRitzDenseSemiunitaryMatrix() const {
+    return ritzDenseSemiunitaryMatrix_;
+}
+
+template <typename T>
+arma::Mat<T>& ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>::modifyRitzDenseSemiunitaryMatrix() {
+    return ritzDenseSemiunitaryMatrix_;
+}
+
+template <typename T>
+const arma::Col<T>& ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>::getBackProjectionVector() const {
+    return backProjectionVector_;
+}
+
+template <typename T>
+arma::Col<T>& ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>::modifyBackProjectionVector() {
+    return backProjectionVector_;
+}
+
+template <typename T>
+const arma::Col<T>& ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>::getSeedVector() const {
+    return seed_vector_;
+}
+
+template <typename T>
+arma::Col<T>& ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>::modifySeedVector() {
+    return seed_vector_;
+}
+
+template class ArmaTwoPassKrylovDenseSemiunitaryMatrix<double>;
+template class ArmaTwoPassKrylovDenseSemiunitaryMatrix<float>;
+}  // namespace quantum::linear_algebra
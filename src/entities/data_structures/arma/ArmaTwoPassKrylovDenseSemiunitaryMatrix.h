@@ -0,0 +1,59 @@
+#ifndef SPINNER_ARMATWOPASSKRYLOVDENSESEMIUNITARYMATRIX_H
+#define SPINNER_ARMATWOPASSKRYLOVDENSESEMIUNITARYMATRIX_H
+
+#include <armadillo>
+#include <memory>
+
+#include "src/entities/data_structures/AbstractDenseSemiunitaryMatrix.h"
+#include "src/entities/data_structures/AbstractDenseSemiunitaryTransformer.h"
+#include "src/entities/data_structures/AbstractDiagonalizableMatrix.h"
+
+namespace quantum::linear_algebra {
+// Eigenvectors of two-pass Lanczos procedure: Krylov vectors are not stored,
+// but regenerated from the seed vector by the same Lanczos procedure as in the first pass
+// in every unitary transformation, so only O(size) memory is used per seed.
+template <typename T>
+class ArmaTwoPassKrylovDenseSemiunitaryMatrix: public AbstractDenseSemiunitaryMatrix {
+  public:
+    explicit ArmaTwoPassKrylovDenseSemiunitaryMatrix(
+        std::shared_ptr<const AbstractDiagonalizableMatrix> hamiltonian);
+
+    uint32_t size_rows() const override;
+    uint32_t size_cols() const override;
+    // it is slow: Krylov vectors are regenerated
+    double at(uint32_t i, uint32_t j) const override;
+
+    void print(std::ostream& os) const override;
+
+    const std::shared_ptr<const AbstractDiagonalizableMatrix>& getHamiltonian() const;
+    // diagonal and subdiagonal of the Krylov matrix:
+    const arma::Col<T>& getKrylovDiagonal() const;
+    arma::Col<T>& modifyKrylovDiagonal();
+    const arma::Col<T>& getKrylovSubdiagonal() const;
+    arma::Col<T>& modifyKrylovSubdiagonal();
+    // eigenvectors of the Krylov matrix:
+    const arma::Mat<T>& getRitzDenseSemiunitaryMatrix() const;
+    arma::Mat<T>& modifyRitzDenseSemiunitaryMatrix();
+    const arma::Col<T>& getBackProjectionVector() const;
+    arma::Col<T>& modifyBackProjectionVector();
+    const arma::Col<T>& getSeedVector() const;
+    arma::Col<T>& modifySeedVector();
+
+    // Krylov vectors are regenerated once, every column of projections is multiplied by them:
+    // answer(k, j) = <v_k|projections(:, j)>, so all columns should be passed in one call
+    arma::Mat<T> projectOnKrylovVectors(const arma::Mat<T>& projections) const;
+
+    const std::unique_ptr<AbstractDenseSemiunitaryTransformer>& getUnitaryTransformer() const override;
+
+  private:
+    std::shared_ptr<const AbstractDiagonalizableMatrix> hamiltonian_;
+    arma::Col<T> krylov_diagonal_;
+    arma::Col<T> krylov_subdiagonal_;
+    arma::Mat<T> ritzDenseSemiunitaryMatrix_;
+    arma::Col<T> backProjectionVector_;
+    arma::Col<T> seed_vector_;
+
+    std::unique_ptr<AbstractDenseSemiunitaryTransformer> transformer_;
+};
+}  // namespace quantum::linear_algebra
+#endif  //SPINNER_ARMATWOPASSKRYLOVDENSESEMIUNITARYMATRIX_H
@@ -0,0 +1,61 @@
+#include "ArmaTwoPassKrylovDenseSemiunitaryTransformer.h"
+#include "ArmaDenseDiagonalizableMatrix.h"
+#include "ArmaSparseDiagonalizableMatrix.h"
+#include "ArmaDenseVector.h"
+
+namespace quantum::linear_algebra {
+
+template <typename T>
+inline arma::Col<T> multiplySeedVector_(
+    const AbstractDiagonalizableMatrix& matrix,
+    const arma::Col<T>& seed_vector) {
+    if (auto maybeSparseSymmetricMatrix =
+        dynamic_cast<const ArmaSparseDiagonalizableMatrix<T>*>(&matrix)) {
+        return maybeSparseSymmetricMatrix->getSparseSymmetricMatrix() * seed_vector;
+    }
+    if (auto maybeDenseSymmetricMatrix =
+        dynamic_cast<const ArmaDenseDiagonalizableMatrix<T>*>(&matrix)) {
+        return maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix() * seed_vector;
+    }
+    throw std::bad_cast();
+}
+
+template <typename T>
+ArmaTwoPassKrylovDenseSemiunitaryTransformer<T>::ArmaTwoPassKrylovDenseSemiunitaryTransformer(const ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>* unitary_matrix) 
+: unitary_matrix_(unitary_matrix){};
+
+template <typename T>
+std::unique_ptr<AbstractDenseVector> ArmaTwoPassKrylovDenseSemiunitaryTransformer<T>::calculateUnitaryTransformationOfMatrix(
+    std::reference_wrapper<const std::unique_ptr<AbstractDiagonalizableMatrix>> matrix) const {
+    return std::move(calculateUnitaryTransformationOfMatrices({matrix})[0]);
+}
+
+template <typename T>
+std::vector<std::unique_ptr<AbstractDenseVector>> ArmaTwoPassKrylovDenseSemiunitaryTransformer<T>::calculateUnitaryTransformationOfMatrices(
+    const std::vector<std::reference_wrapper<const std::unique_ptr<AbstractDiagonalizableMatrix>>>& matrices) const {
+    const auto& seed_vector = unitary_matrix_->getSeedVector();
+    // A|r> of all matrices are projected on Krylov vectors in one pass:
+    arma::Mat<T> firstMultiplicationResults(seed_vector.n_elem, matrices.size());
+    for (size_t j = 0; j < matrices.size(); ++j) {
+        firstMultiplicationResults.col(j) = multiplySeedVector_<T>(*matrices[j].get(), seed_vector);
+    }
+    arma::Mat<T> main_diagonals =
+        unitary_matrix_->getRitzDenseSemiunitaryMatrix().t()
+        * unitary_matrix_->projectOnKrylovVectors(firstMultiplicationResults);
+
+    std::vector<std::unique_ptr<AbstractDenseVector>> answer;
+    answer.reserve(matrices.size());
+    for (size_t j = 0; j < matrices.size(); ++j) {
+        auto main_diagonal = std::make_unique<ArmaDenseVector<T>>();
+        // instead of <n|A|r><r|n>, here we are using <n|A|r>/<r|n>,
+        // putting |<r|n>|^2 in the weight of state
+        main_diagonal->modifyDenseVector() =
+            main_diagonals.col(j) / unitary_matrix_->getBackProjectionVector();
+        answer.push_back(std::move(main_diagonal));
+    }
+    return answer;
+}
+
+template class ArmaTwoPassKrylovDenseSemiunitaryTransformer<double>;
+template class ArmaTwoPassKrylovDenseSemiunitaryTransformer<float>;
+} // namespace quantum::linear_algebra
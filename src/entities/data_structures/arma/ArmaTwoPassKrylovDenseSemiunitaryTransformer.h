@@ -0,0 +1,27 @@
+#ifndef SPINNER_ARMATWOPASSKRYLOVDENSESEMIUNITARYTRANSFORMER_H
+#define SPINNER_ARMATWOPASSKRYLOVDENSESEMIUNITARYTRANSFORMER_H
+
+#include <memory>
+#include <vector>
+
+#include "src/entities/data_structures/AbstractDenseSemiunitaryTransformer.h"
+#include "ArmaTwoPassKrylovDenseSemiunitaryMatrix.h"
+
+namespace quantum::linear_algebra {
+template <typename T>
+class ArmaTwoPassKrylovDenseSemiunitaryTransformer: public AbstractDenseSemiunitaryTransformer {
+public:
+    explicit ArmaTwoPassKrylovDenseSemiunitaryTransformer(const ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>* unitary_matrix);
+
+    std::unique_ptr<AbstractDenseVector> calculateUnitaryTransformationOfMatrix(
+        std::reference_wrapper<const std::unique_ptr<AbstractDiagonalizableMatrix>> matrix) const override;
+    // Krylov vectors are regenerated once for all matrices:
+    std::vector<std::unique_ptr<AbstractDenseVector>> calculateUnitaryTransformationOfMatrices(
+        const std::vector<std::reference_wrapper<const std::unique_ptr<AbstractDiagonalizableMatrix>>>& matrices) const override;
+
+private:
+    const ArmaTwoPassKrylovDenseSemiunitaryMatrix<T>* unitary_matrix_;
+};
+    
+}  // namespace quantum::linear_algebra
+#endif  //SPINNER_ARMATWOPASSKRYLOVDENSESEMIUNITARYTRANSFORMER_H
@@ -1,5 +1,10 @@
 #include "EigenDenseDiagonalizableMatrix.h"
 
+#include <algorithm>
+#include <stdexcept>
+#include <typeinfo>
+#include <vector>
+
 #include "EigenLogic.h"
 
 namespace quantum::linear_algebra {
@@ -26,6 +31,29 @@ std::unique_ptr<AbstractDenseVector> EigenDenseDiagonalizableMatrix<T>::diagonal
     return eigenLogic.diagonalizeValues(*this);
 }
 
+template <typename T>
+EigenCouple EigenDenseDiagonalizableMatrix<T>::diagonalizeValuesVectorsInWindow(double energy_window) const {
+    EigenLogic<T> eigenLogic;
+
+    return eigenLogic.diagonalizeValuesVectorsInWindow(*this, energy_window);
+}
+
+template <typename T>
+std::optional<EigenCouple> EigenDenseDiagonalizableMatrix<T>::refineDiagonalizeValuesVectors(
+    const AbstractDenseSemiunitaryMatrix& initial_eigenvectors,
+    double tolerance,
+    size_t max_iterations,
+    std::optional<double> energy_window) const {
+    EigenLogic<T> eigenLogic;
+
+    return eigenLogic.refineDiagonalizeValuesVectors(
+        *this,
+        initial_eigenvectors,
+        tolerance,
+        max_iterations,
+        energy_window);
+}
+
 template <typename T>
 KrylovCouple EigenDenseDiagonalizableMatrix<T>::krylovDiagonalizeValues(
     const std::unique_ptr<AbstractDenseVector>& seed_vector,
@@ -50,6 +78,33 @@ KrylovTriple EigenDenseDiagonalizableMatrix<T>::krylovDiagonalizeValuesVectors(
         krylov_subspace_size);
 }
 
+template <typename T>
+std::vector<KrylovCouple> EigenDenseDiagonalizableMatrix<T>::krylovDiagonalizeValues(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    EigenLogic<T> logic;
+    return logic.krylovDiagonalizeValues(*this, seed_vectors, krylov_subspace_size, convergence);
+}
+
+template <typename T>
+std::vector<KrylovTriple> EigenDenseDiagonalizableMatrix<T>::krylovDiagonalizeValuesVectors(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    EigenLogic<T> logic;
+    return logic.krylovDiagonalizeValuesVectors(*this, seed_vectors, krylov_subspace_size, convergence);
+}
+
+template <typename T>
+std::vector<KrylovTriple> EigenDenseDiagonalizableMatrix<T>::krylovDiagonalizeValuesVectorsTwoPass(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    EigenLogic<T> logic;
+    return logic.krylovDiagonalizeValuesVectorsTwoPass(*this, seed_vectors, krylov_subspace_size, convergence);
+}
+
 template <typename T>
 std::unique_ptr<AbstractDiagonalizableMatrix>
 EigenDenseDiagonalizableMatrix<T>::multiply_by(double multiplier) const {
@@ -57,10 +112,58 @@ EigenDenseDiagonalizableMatrix<T>::multiply_by(double multiplier) const {
     answer->resize(size());
 
     answer->denseDiagonalizableMatrix_ = denseDiagonalizableMatrix_ * multiplier;
+    answer->mixed_precision_ = mixed_precision_;
 
     return answer;
 }
 
+template <typename T>
+void EigenDenseDiagonalizableMatrix<T>::add_scaled(
+    double multiplier,
+    const AbstractDiagonalizableMatrix& rhs) {
+    auto maybe_rhs = dynamic_cast<const EigenDenseDiagonalizableMatrix*>(&rhs);
+    if (maybe_rhs == nullptr) {
+        throw std::bad_cast();
+    }
+    if (maybe_rhs->size() != size()) {
+        throw std::length_error("Sizes of summed matrices are different");
+    }
+    denseDiagonalizableMatrix_ += (T)multiplier * maybe_rhs->denseDiagonalizableMatrix_;
+}
+
+template <typename T>
+void EigenDenseDiagonalizableMatrix<T>::add_sparsity_pattern(const AbstractDiagonalizableMatrix& rhs) {
+    auto maybe_rhs = dynamic_cast<const EigenDenseDiagonalizableMatrix*>(&rhs);
+    if (maybe_rhs == nullptr) {
+        throw std::bad_cast();
+    }
+    if (maybe_rhs->size() != size()) {
+        throw std::length_error("Sizes of matrices are different");
+    }
+    // all elements are already stored
+}
+
+template <typename T>
+std::vector<double> EigenDenseDiagonalizableMatrix<T>::stored_values_of(const AbstractDiagonalizableMatrix& rhs) const {
+    auto maybe_rhs = dynamic_cast<const EigenDenseDiagonalizableMatrix*>(&rhs);
+    if (maybe_rhs == nullptr) {
+        throw std::bad_cast();
+    }
+    if (maybe_rhs->size() != size()) {
+        throw std::length_error("Sizes of matrices are different");
+    }
+    const auto& rhs_matrix = maybe_rhs->denseDiagonalizableMatrix_;
+    return std::vector<double>(rhs_matrix.data(), rhs_matrix.data() + rhs_matrix.size());
+}
+
+template <typename T>
+void EigenDenseDiagonalizableMatrix<T>::assign_stored_values(const std::vector<double>& values) {
+    if (values.size() != denseDiagonalizableMatrix_.size()) {
+        throw std::length_error("Number of values is not equal to number of stored elements");
+    }
+    std::copy(values.cbegin(), values.cend(), denseDiagonalizableMatrix_.data());
+}
+
 template <typename T>
 uint32_t EigenDenseDiagonalizableMatrix<T>::size() const {
     return denseDiagonalizableMatrix_.cols();
@@ -92,6 +195,16 @@ Eigen::Matrix<T, -1, -1>& EigenDenseDiagonalizableMatrix<T>::modifyDenseDiagonal
     return denseDiagonalizableMatrix_;
 }
 
+template <typename T>
+void EigenDenseDiagonalizableMatrix<T>::setMixedPrecision(bool mixed_precision) {
+    mixed_precision_ = mixed_precision;
+}
+
+template <typename T>
+bool EigenDenseDiagonalizableMatrix<T>::isMixedPrecision() const {
+    return mixed_precision_;
+}
+
 template class EigenDenseDiagonalizableMatrix<double>;
 template class EigenDenseDiagonalizableMatrix<float>;
 }  // namespace quantum::linear_algebra
\ No newline at end of file
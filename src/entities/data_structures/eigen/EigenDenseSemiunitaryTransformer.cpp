@@ -10,19 +10,19 @@ inline std::unique_ptr<AbstractDenseVector> unitaryTransformAndReturnMainDiagona
     const M& symmetricMatrix,
     const EigenDenseSemiunitaryMatrix<T>& denseSemiunitaryMatrix) {
     auto main_diagonal = std::make_unique<EigenDenseVector<T>>();
+    const auto& unitaryMatrix = denseSemiunitaryMatrix.getDenseSemiunitaryMatrix();
 
-    Eigen::Matrix<T, -1, -1> firstMultiplicationResult =
-        denseSemiunitaryMatrix.getDenseSemiunitaryMatrix().transpose()
-        * symmetricMatrix;
-    main_diagonal->resize(symmetricMatrix.rows());
+    // A is symmetric, so (U^T A U)_{ii} = (A U)_i \cdot U_i:
+    // the second multiplication is reduced to the dot products of columns.
+    Eigen::Matrix<T, -1, -1> firstMultiplicationResult = symmetricMatrix * unitaryMatrix;
+    main_diagonal->resize(unitaryMatrix.cols());
 #pragma omp parallel for shared( \
     main_diagonal, \
     firstMultiplicationResult, \
-    denseSemiunitaryMatrix) default(none)
+    unitaryMatrix) default(none)
     for (size_t i = 0; i < main_diagonal->size(); ++i) {
-        auto value = firstMultiplicationResult.row(i)
-            * denseSemiunitaryMatrix.getDenseSemiunitaryMatrix().col(i);
-        main_diagonal->modifyDenseVector().coeffRef(i) = value;
+        main_diagonal->modifyDenseVector().coeffRef(i) =
+            firstMultiplicationResult.col(i).dot(unitaryMatrix.col(i));
     }
     return std::move(main_diagonal);
 }
@@ -37,7 +37,7 @@ std::unique_ptr<AbstractDenseVector> EigenDenseSemiunitaryTransformer<T>::calcul
     if (auto maybeSparseSymmetricMatrix =
             dynamic_cast<const EigenSparseDiagonalizableMatrix<T>*>(matrix.get().get())) {
         return unitaryTransformAndReturnMainDiagonal_(
-            maybeSparseSymmetricMatrix->getSparseDiagonalizableMatrix().transpose(),
+            maybeSparseSymmetricMatrix->getSparseDiagonalizableMatrix(),
             *unitary_matrix_
         );
     }
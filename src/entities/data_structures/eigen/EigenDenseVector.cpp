@@ -1,9 +1,13 @@
 #include "EigenDenseVector.h"
+#include <algorithm>
 #include <stdexcept>
 #include <random>
 
 namespace quantum::linear_algebra {
 
+// 3 * 1024 doubles fit into L1 cache:
+const Eigen::Index BOLTZMANN_CHUNK_SIZE = 1024;
+
 template <typename T>
 void EigenDenseVector<T>::resize(uint32_t new_size) {
     vector_.resize(new_size);
@@ -47,6 +51,11 @@ void EigenDenseVector<T>::add_identical_values(size_t number, double value) {
     vector_ = tmptmp;
 }
 
+template <typename T>
+void EigenDenseVector<T>::assign_values(const double* values, size_t size) {
+    vector_ = Eigen::Map<const Eigen::VectorXd>(values, size).template cast<T>();
+}
+
 template <typename T>
 void EigenDenseVector<T>::subtract_minimum() {
     double minimum = vector_.minCoeff();
@@ -97,6 +106,42 @@ std::unique_ptr<AbstractDenseVector> EigenDenseVector<T>::element_wise_multiplic
     return answer;
 }
 
+template <typename T>
+std::pair<std::vector<std::vector<double>>, std::vector<double>> EigenDenseVector<T>::boltzmann_sums(
+    const std::unique_ptr<AbstractDenseVector>& weights,
+    const std::vector<std::reference_wrapper<const std::unique_ptr<AbstractDenseVector>>>& values,
+    const std::vector<double>& temperatures) const {
+    auto weights_ = downcast_ptr(weights);
+    std::vector<const EigenDenseVector*> values_;
+    values_.reserve(values.size());
+    for (const auto& value : values) {
+        values_.push_back(downcast_ptr(value.get()));
+    }
+
+    std::vector<std::vector<double>> numerators(values.size(), std::vector<double>(temperatures.size(), 0));
+    std::vector<double> partition_functions(temperatures.size(), 0);
+
+    // Vectors are processed by chunks, so every chunk is read from memory once for all temperatures.
+    // Eigen evaluates exp and sums of chunks using SIMD instructions.
+    Eigen::Array<T, -1, 1> boltzmann_factors(std::min(BOLTZMANN_CHUNK_SIZE, vector_.size()));
+    for (Eigen::Index begin = 0; begin < vector_.size(); begin += BOLTZMANN_CHUNK_SIZE) {
+        Eigen::Index length = std::min(BOLTZMANN_CHUNK_SIZE, vector_.size() - begin);
+        auto energies = vector_.segment(begin, length).array();
+        auto chunk_weights = weights_->vector_.segment(begin, length).array();
+        auto chunk_factors = boltzmann_factors.head(length);
+        for (size_t j = 0; j < temperatures.size(); ++j) {
+            T minus_inverse_temperature = -1.0 / temperatures[j];
+            chunk_factors = chunk_weights * (energies * minus_inverse_temperature).exp();
+            partition_functions[j] += chunk_factors.sum();
+            for (size_t k = 0; k < values_.size(); ++k) {
+                numerators[k][j] += (values_[k]->vector_.segment(begin, length).array() * chunk_factors).sum();
+            }
+        }
+    }
+
+    return {std::move(numerators), std::move(partition_functions)};
+}
+
 template <typename T>
 uint32_t EigenDenseVector<T>::size() const {
     return vector_.size();
@@ -3,6 +3,7 @@
 #include "EigenDenseDiagonalizableMatrix.h"
 #include "EigenDenseSemiunitaryMatrix.h"
 #include "EigenDenseVector.h"
+#include "EigenMatrixFreeDiagonalizableMatrix.h"
 #include "EigenSparseDiagonalizableMatrix.h"
 
 namespace quantum::linear_algebra {
@@ -16,6 +17,7 @@ EigenDenseTransformAndDiagonalizeFactory::createDenseDiagonalizableMatrix(uint32
     } else {
         auto matrix = std::make_unique<EigenDenseDiagonalizableMatrix<double>>();
         matrix->resize(size);
+        matrix->setMixedPrecision(getPrecision() == Precision::MIXED);
         return matrix;
     }
 }
@@ -33,6 +35,16 @@ EigenDenseTransformAndDiagonalizeFactory::createSparseDiagonalizableMatrix(uint3
     }
 }
 
+std::unique_ptr<AbstractDiagonalizableMatrix>
+EigenDenseTransformAndDiagonalizeFactory::createMatrixFreeDiagonalizableMatrix(
+    std::shared_ptr<const AbstractMatrixFreeOperator> matrix_free_operator) {
+    if (getPrecision() == Precision::SINGLE) {
+        return std::make_unique<EigenMatrixFreeDiagonalizableMatrix<float>>(std::move(matrix_free_operator));
+    } else {
+        return std::make_unique<EigenMatrixFreeDiagonalizableMatrix<double>>(std::move(matrix_free_operator));
+    }
+}
+
 std::unique_ptr<AbstractDenseSemiunitaryMatrix>
 EigenDenseTransformAndDiagonalizeFactory::createDenseSemiunitaryMatrix(
     uint32_t cols,
@@ -11,6 +11,8 @@ class EigenDenseTransformAndDiagonalizeFactory: public AbstractDenseTransformAnd
     createDenseDiagonalizableMatrix(uint32_t matrix_in_space_basis_size_i) override;
     std::unique_ptr<AbstractDiagonalizableMatrix>
     createSparseDiagonalizableMatrix(uint32_t size) override;
+    std::unique_ptr<AbstractDiagonalizableMatrix>
+    createMatrixFreeDiagonalizableMatrix(std::shared_ptr<const AbstractMatrixFreeOperator> matrix_free_operator) override;
     std::unique_ptr<AbstractDenseSemiunitaryMatrix>
     createDenseSemiunitaryMatrix(uint32_t cols, uint32_t rows) override;
     std::vector<std::unique_ptr<AbstractDenseVector>> createRandomUnitVectors(uint32_t size_of_vector, uint32_t number_of_vectors) override;
@@ -0,0 +1,227 @@
+#ifndef SPINNER_EIGENKRYLOVPROCEDURE_H
+#define SPINNER_EIGENKRYLOVPROCEDURE_H
+
+#include <Eigen/Core>
+#include <Eigen/Eigenvalues>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "EigenMatrixFreeDiagonalizableMatrix.h"
+#include "src/entities/data_structures/AbstractDiagonalizableMatrix.h"
+#include "src/entities/data_structures/TridiagonalEigensolver.h"
+
+// Lanczos procedure of the first pass and the regeneration of Krylov vectors in the second pass,
+// so both passes use the same block products and the same recurrence.
+namespace quantum::linear_algebra::eigen_lanczos {
+
+template <typename T>
+using KrylovVectorsVisitor = std::function<void(
+    size_t k,
+    const std::vector<Eigen::Index>& active_seeds,
+    const Eigen::Matrix<T, -1, -1>& current_vectors)>;
+
+// the matrix is symmetric, so its transpose is used:
+// the product of row-major sparse matrix and dense block is parallelized by Eigen
+template <typename T, typename M>
+void multiplyByBlock(
+    const M& matrix,
+    const Eigen::Matrix<T, -1, -1>& in,
+    Eigen::Matrix<T, -1, -1>& out) {
+    out.noalias() = matrix.transpose() * in;
+}
+
+template <typename T>
+void multiplyByBlock(
+    const EigenMatrixFreeDiagonalizableMatrix<T>& matrix,
+    const Eigen::Matrix<T, -1, -1>& in,
+    Eigen::Matrix<T, -1, -1>& out) {
+    matrix.multiply(in, out);
+}
+
+template <typename M>
+Eigen::Index sizeOfMatrix(const M& matrix) {
+    return matrix.cols();
+}
+
+template <typename T>
+Eigen::Index sizeOfMatrix(const EigenMatrixFreeDiagonalizableMatrix<T>& matrix) {
+    return matrix.size();
+}
+
+// Returns true, if the Ritz values within convergence.energy_window above the lowest one
+// have changed less than convergence.tolerance * (spectral radius of Krylov matrix) since the previous check
+// and no new Ritz values have appeared in the window.
+// previous_ritz_values is updated by the current low-lying Ritz values.
+inline bool lowLyingRitzValuesHaveConverged(
+    const std::vector<double>& diagonal,
+    const std::vector<double>& subdiagonal,
+    const KrylovConvergence& convergence,
+    std::vector<double>& previous_ritz_values) {
+    Eigen::VectorXd diagonal_vector = Eigen::Map<const Eigen::VectorXd>(diagonal.data(), diagonal.size());
+    Eigen::VectorXd subdiagonal_vector = Eigen::Map<const Eigen::VectorXd>(subdiagonal.data(), subdiagonal.size());
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es;
+    es.computeFromTridiagonal(diagonal_vector, subdiagonal_vector, Eigen::EigenvaluesOnly);
+    const Eigen::VectorXd& ritz_values = es.eigenvalues();
+
+    double scale = std::max(std::abs(ritz_values(0)), std::abs(ritz_values(ritz_values.size() - 1)));
+    std::vector<double> low_lying_ritz_values;
+    for (Eigen::Index i = 0; i < ritz_values.size(); ++i) {
+        if (ritz_values(i) > ritz_values(0) + convergence.energy_window) {
+            break;
+        }
+        low_lying_ritz_values.push_back(ritz_values(i));
+    }
+
+    // every low-lying Ritz value has to be close to some previous one,
+    // so the copies of converged values (due to the loss of orthogonality) do not prevent the convergence:
+    bool has_converged = !previous_ritz_values.empty();
+    for (size_t i = 0; i < low_lying_ritz_values.size() && has_converged; ++i) {
+        auto it = std::lower_bound(previous_ritz_values.begin(), previous_ritz_values.end(), low_lying_ritz_values[i]);
+        double distance = std::numeric_limits<double>::infinity();
+        if (it != previous_ritz_values.end()) {
+            distance = std::min(distance, *it - low_lying_ritz_values[i]);
+        }
+        if (it != previous_ritz_values.begin()) {
+            distance = std::min(distance, low_lying_ritz_values[i] - *std::prev(it));
+        }
+        has_converged = distance <= convergence.tolerance * scale;
+    }
+    previous_ritz_values = std::move(low_lying_ritz_values);
+    return has_converged;
+}
+
+// Lanczos procedure, all seeds (columns of seed_vectors) are advanced together:
+// every Krylov step is one product of the matrix and (size x number_of_active_seeds) block of vectors,
+// so the matrix is read from memory once per step instead of once per step per seed.
+// The procedure of a seed is stopped before krylov_subspace_size steps, if its Krylov subspace
+// is invariant (breakdown) or if convergence is set and its low-lying Ritz values have converged,
+// then the seed is removed from the block.
+// Returns tridiagonal Krylov matrices of all seeds (their sizes can be different).
+// If on_krylov_vectors is set, it is called with the k-th Krylov vectors of active seeds
+// (columns of current_vectors, active_seeds[column] is the seed of the column) before the k-th product.
+template <typename T, typename M>
+std::vector<SymmetricTridiagonalMatrix> krylovProcedureOfSeeds(
+    const M& matrix,
+    const Eigen::Matrix<T, -1, -1>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence,
+    const KrylovVectorsVisitor<T>& on_krylov_vectors) {
+    if (krylov_subspace_size > sizeOfMatrix(matrix)) {
+        throw std::invalid_argument("krylov_subspace_size bigger than size of matrix!");
+    }
+    const size_t convergence_check_period = 5;
+    // without reorthogonalization the rounding noise of the next Krylov vector grows with steps,
+    // so the Krylov subspace is considered as invariant, if its norm is below breakdown_tolerance * |T_k|,
+    // then Ritz values are accurate up to this relative error:
+    const T breakdown_tolerance = std::sqrt(std::numeric_limits<T>::epsilon());
+
+    const Eigen::Index number_of_seeds = seed_vectors.cols();
+    std::vector<std::vector<double>> diagonals(number_of_seeds);
+    std::vector<std::vector<double>> subdiagonals(number_of_seeds);
+    std::vector<std::vector<double>> previous_ritz_values(number_of_seeds);
+
+    Eigen::Matrix<T, -1, -1> current_vectors = seed_vectors;
+    Eigen::Vector<T, -1> vec_norms = current_vectors.colwise().norm().transpose();
+    if (number_of_seeds > 0 && vec_norms.minCoeff() < std::numeric_limits<double>::epsilon()) {
+        throw std::invalid_argument("Extremely small value of vector norm in Krylov procedure: " + std::to_string(vec_norms.minCoeff()));
+    }
+    current_vectors = current_vectors * vec_norms.cwiseInverse().asDiagonal();
+
+
+    // active_seeds[column] is the seed of the column of current_vectors:
+    std::vector<Eigen::Index> active_seeds(number_of_seeds);
+    std::iota(active_seeds.begin(), active_seeds.end(), 0);
+
+    Eigen::Matrix<T, -1, -1> previous_vectors = Eigen::Matrix<T, -1, -1>::Zero(seed_vectors.rows(), number_of_seeds);
+    Eigen::Matrix<T, -1, -1> next_vectors(seed_vectors.rows(), number_of_seeds);
+    Eigen::Vector<T, -1> diag_elements(number_of_seeds), non_diag_elements(number_of_seeds);
+
+    for (size_t k = 0; k < krylov_subspace_size && !active_seeds.empty(); ++k) {
+        if (on_krylov_vectors) {
+            on_krylov_vectors(k, active_seeds, current_vectors);
+        }
+        multiplyByBlock(matrix, current_vectors, next_vectors);
+        diag_elements = current_vectors.cwiseProduct(next_vectors).colwise().sum().transpose();
+        if (k > 0) {
+            non_diag_elements = previous_vectors.cwiseProduct(next_vectors).colwise().sum().transpose();
+        }
+
+        for (size_t column = 0; column < active_seeds.size(); ++column) {
+            Eigen::Index seed = active_seeds[column];
+            diagonals[seed].push_back(diag_elements(column));
+            if (k > 0) {
+                subdiagonals[seed].push_back(non_diag_elements(column));
+            }
+        }
+        if (k + 1 == krylov_subspace_size) {
+            // the next Krylov vectors are not needed:
+            break;
+        }
+
+        next_vectors -= current_vectors * diag_elements.asDiagonal();
+        if (k > 0) {
+            next_vectors -= previous_vectors * non_diag_elements.asDiagonal();
+        }
+        vec_norms = next_vectors.colwise().norm().transpose();
+
+        std::vector<Eigen::Index> continuing_columns;
+        for (size_t column = 0; column < active_seeds.size(); ++column) {
+            Eigen::Index seed = active_seeds[column];
+            double scale = std::abs(diag_elements(column)) + (k > 0 ? std::abs(non_diag_elements(column)) : 0);
+            // Krylov subspace of the seed is invariant:
+            bool breakdown = vec_norms(column) <= breakdown_tolerance * scale;
+            bool converged = !breakdown && convergence.has_value()
+                && (k + 1) % convergence_check_period == 0
+                && lowLyingRitzValuesHaveConverged(
+                    diagonals[seed],
+                    subdiagonals[seed],
+                    convergence.value(),
+                    previous_ritz_values[seed]);
+            if (!breakdown && !converged) {
+                continuing_columns.push_back(column);
+            }
+        }
+
+        if (continuing_columns.size() < active_seeds.size()) {
+            // the stopped seeds are removed from the block, so they do not cost matrix products:
+            Eigen::Index rows = seed_vectors.rows();
+            Eigen::Index number_of_continuing_seeds = continuing_columns.size();
+            Eigen::Matrix<T, -1, -1> continuing_current_vectors(rows, number_of_continuing_seeds);
+            Eigen::Matrix<T, -1, -1> continuing_next_vectors(rows, number_of_continuing_seeds);
+            Eigen::Vector<T, -1> continuing_vec_norms(number_of_continuing_seeds);
+            std::vector<Eigen::Index> continuing_seeds(number_of_continuing_seeds);
+            for (Eigen::Index j = 0; j < number_of_continuing_seeds; ++j) {
+                Eigen::Index column = continuing_columns[j];
+                continuing_current_vectors.col(j) = current_vectors.col(column);
+                continuing_next_vectors.col(j) = next_vectors.col(column);
+                continuing_vec_norms(j) = vec_norms(column);
+                continuing_seeds[j] = active_seeds[column];
+            }
+            current_vectors.swap(continuing_current_vectors);
+            next_vectors.swap(continuing_next_vectors);
+            vec_norms.swap(continuing_vec_norms);
+            active_seeds.swap(continuing_seeds);
+        }
+        next_vectors = next_vectors * vec_norms.cwiseInverse().asDiagonal();
+
+        previous_vectors.swap(current_vectors);
+        current_vectors.swap(next_vectors);
+    }
+
+    std::vector<SymmetricTridiagonalMatrix> krylov_matrices(number_of_seeds);
+    for (Eigen::Index seed = 0; seed < number_of_seeds; ++seed) {
+        krylov_matrices[seed].diagonal = std::move(diagonals[seed]);
+        krylov_matrices[seed].subdiagonal = std::move(subdiagonals[seed]);
+    }
+    return krylov_matrices;
+}
+}  // namespace quantum::linear_algebra::eigen_lanczos
+#endif  //SPINNER_EIGENKRYLOVPROCEDURE_H
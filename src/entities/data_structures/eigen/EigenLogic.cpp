@@ -1,154 +1,482 @@
 #include "EigenLogic.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <limits>
+#include <numeric>
+#include <optional>
+#include <random>
 #include <stdexcept>
+#include <vector>
 
 #include "EigenDenseDiagonalizableMatrix.h"
 #include "EigenDenseSemiunitaryMatrix.h"
 #include "EigenDenseVector.h"
 #include "EigenKrylovDenseSemiunitaryMatrix.h"
+#include "EigenKrylovProcedure.h"
+#include "EigenMatrixFreeDiagonalizableMatrix.h"
 #include "EigenSparseDiagonalizableMatrix.h"
+#include "EigenTwoPassKrylovDenseSemiunitaryMatrix.h"
+#include "src/entities/data_structures/TridiagonalEigensolver.h"
 
 namespace {
 
-template <typename T, typename M>
-std::pair<Eigen::Vector<T, -1>, Eigen::Vector<T, -1>> krylovProcedureDiagonalizeValues_(
-    const M& matrix,
-    const Eigen::Vector<T, -1>& seed_vector,
-    size_t krylov_subspace_size) {
-    Eigen::Matrix<T, -1, -1> krylov_matrix(krylov_subspace_size, krylov_subspace_size);
-    krylov_matrix.fill(0);
-    
-    if (krylov_subspace_size > matrix.cols()) {
-        throw std::invalid_argument("krylov_subspace_size bigger than size of matrix!");
+// LU decomposition with partial pivoting of the shifted tridiagonal matrix (T - shift * I),
+// the same as LAPACK dgttrf. U has two superdiagonals because of row interchanges.
+struct ShiftedTridiagonalLU {
+    Eigen::VectorXd lower;
+    Eigen::VectorXd diagonal;
+    Eigen::VectorXd upper;
+    Eigen::VectorXd second_upper;
+    std::vector<bool> interchanged;
+
+    ShiftedTridiagonalLU(
+        const Eigen::VectorXd& diagonal_of_tridiagonal,
+        const Eigen::VectorXd& subdiagonal_of_tridiagonal,
+        double shift,
+        double tiny_pivot) :
+        lower(subdiagonal_of_tridiagonal),
+        diagonal(diagonal_of_tridiagonal.array() - shift),
+        upper(subdiagonal_of_tridiagonal),
+        second_upper(Eigen::VectorXd::Zero(std::max<Eigen::Index>(0, diagonal_of_tridiagonal.size() - 2))),
+        interchanged(diagonal_of_tridiagonal.size(), false) {
+        Eigen::Index n = diagonal.size();
+        for (Eigen::Index i = 0; i + 1 < n; ++i) {
+            if (std::abs(diagonal(i)) >= std::abs(lower(i))) {
+                if (diagonal(i) != 0) {
+                    double factor = lower(i) / diagonal(i);
+                    lower(i) = factor;
+                    diagonal(i + 1) -= factor * upper(i);
+                }
+            } else {
+                double factor = diagonal(i) / lower(i);
+                diagonal(i) = lower(i);
+                lower(i) = factor;
+                double temp = upper(i);
+                upper(i) = diagonal(i + 1);
+                diagonal(i + 1) = temp - factor * diagonal(i + 1);
+                if (i + 2 < n) {
+                    second_upper(i) = upper(i + 1);
+                    upper(i + 1) = -factor * upper(i + 1);
+                }
+                interchanged[i] = true;
+            }
+        }
+        // the shift is an eigenvalue, so U is (almost) singular:
+        for (Eigen::Index i = 0; i < n; ++i) {
+            if (std::abs(diagonal(i)) < tiny_pivot) {
+                diagonal(i) = diagonal(i) < 0 ? -tiny_pivot : tiny_pivot;
+            }
+        }
     }
 
-    // use objects instead of pointers and use swap?
-    auto current_vector = std::make_unique<Eigen::Vector<T, -1>>(seed_vector);
-    double vec_norm = current_vector->norm();
-    if (vec_norm < std::numeric_limits<double>::epsilon()) {
-        throw std::invalid_argument("Extremely small value of vector norm in Krylov procedure: " + std::to_string(vec_norm));
+    void solveInPlace(Eigen::VectorXd& vector) const {
+        Eigen::Index n = diagonal.size();
+        for (Eigen::Index i = 0; i + 1 < n; ++i) {
+            if (!interchanged[i]) {
+                vector(i + 1) -= lower(i) * vector(i);
+            } else {
+                double temp = vector(i);
+                vector(i) = vector(i + 1);
+                vector(i + 1) = temp - lower(i) * vector(i);
+            }
+        }
+        for (Eigen::Index i = n - 1; i >= 0; --i) {
+            double value = vector(i);
+            if (i + 1 < n) {
+                value -= upper(i) * vector(i + 1);
+            }
+            if (i + 2 < n) {
+                value -= second_upper(i) * vector(i + 2);
+            }
+            vector(i) = value / diagonal(i);
+        }
     }
-    *current_vector /= vec_norm;
+};
+
+// Eigenvectors of the symmetric tridiagonal matrix corresponding to the first eigenvalues
+// (sorted in ascending order), calculated by inverse iteration like LAPACK dstein:
+// eigenvectors of close eigenvalues are orthogonalized against each other.
+Eigen::MatrixXd tridiagonalInverseIteration_(
+    const Eigen::VectorXd& diagonal,
+    const Eigen::VectorXd& subdiagonal,
+    const Eigen::VectorXd& eigenvalues) {
+    const size_t max_iterations = 5;
+    const double epsilon = std::numeric_limits<double>::epsilon();
+    Eigen::Index n = diagonal.size();
 
-    auto previous_vector = std::make_unique<Eigen::Vector<T, -1>>(current_vector->size());
-    previous_vector->fill(0);
-    auto next_vector = std::make_unique<Eigen::Vector<T, -1>>(current_vector->size());
-    next_vector->fill(0);
+    double norm_of_tridiagonal = 0;
+    for (Eigen::Index i = 0; i < n; ++i) {
+        double column_norm = std::abs(diagonal(i));
+        if (i > 0) {
+            column_norm += std::abs(subdiagonal(i - 1));
+        }
+        if (i + 1 < n) {
+            column_norm += std::abs(subdiagonal(i));
+        }
+        norm_of_tridiagonal = std::max(norm_of_tridiagonal, column_norm);
+    }
+    norm_of_tridiagonal = std::max(norm_of_tridiagonal, std::numeric_limits<double>::min());
+    const double cluster_tolerance = 1e-3 * norm_of_tridiagonal;
+    const double perturbation_tolerance = 10 * epsilon * norm_of_tridiagonal;
+    const double residual_tolerance = 10 * n * epsilon * norm_of_tridiagonal;
 
-    double diag_element, non_diag_element;
+    // fixed seed makes the result reproducible:
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
 
-    for (size_t k = 0; k < krylov_subspace_size; ++k) {
-        *next_vector = (matrix) * (*current_vector);
-        diag_element = current_vector->dot(*next_vector);
-        if (k > 0) {
-            non_diag_element = previous_vector->dot(*next_vector);
+    Eigen::MatrixXd eigenvectors(n, eigenvalues.size());
+    Eigen::Index first_in_cluster = 0;
+    double previous_shift = 0;
+    for (Eigen::Index j = 0; j < eigenvalues.size(); ++j) {
+        double shift = eigenvalues(j);
+        if (j > 0) {
+            if (eigenvalues(j) - eigenvalues(j - 1) > cluster_tolerance) {
+                first_in_cluster = j;
+            }
+            // identical shifts produce identical vectors:
+            if (shift - previous_shift < perturbation_tolerance) {
+                shift = previous_shift + perturbation_tolerance;
+            }
         }
+        previous_shift = shift;
 
-        krylov_matrix(k, k) = diag_element;
-        if (k > 0) {
-            krylov_matrix(k-1, k) = non_diag_element;
-            krylov_matrix(k, k-1) = non_diag_element;
+        ShiftedTridiagonalLU lu(diagonal, subdiagonal, shift, epsilon * norm_of_tridiagonal);
+        Eigen::VectorXd vector(n);
+        for (Eigen::Index i = 0; i < n; ++i) {
+            vector(i) = distribution(generator);
+        }
+        bool has_converged = false;
+        for (size_t iteration = 0; iteration < max_iterations; ++iteration) {
+            lu.solveInPlace(vector);
+            for (Eigen::Index k = first_in_cluster; k < j; ++k) {
+                vector -= eigenvectors.col(k).dot(vector) * eigenvectors.col(k);
+            }
+            vector.normalize();
+            if (has_converged) {
+                // one extra iteration after convergence, as in dstein
+                break;
+            }
+            Eigen::VectorXd residual = diagonal.cwiseProduct(vector) - eigenvalues(j) * vector;
+            residual.head(n - 1) += subdiagonal.cwiseProduct(vector.tail(n - 1));
+            residual.tail(n - 1) += subdiagonal.cwiseProduct(vector.head(n - 1));
+            has_converged = residual.norm() <= residual_tolerance;
         }
+        // the second pass of Gram-Schmidt keeps vectors of the cluster orthogonal to working precision
+        // even if the first one has suffered from cancellation:
+        if (j > first_in_cluster) {
+            for (Eigen::Index k = first_in_cluster; k < j; ++k) {
+                vector -= eigenvectors.col(k).dot(vector) * eigenvectors.col(k);
+            }
+            vector.normalize();
+        }
+        eigenvectors.col(j) = vector;
+    }
+    return eigenvectors;
+}
 
-        *next_vector -= *current_vector * diag_element;
-        if (k > 0) {
-            *next_vector -= *previous_vector * non_diag_element;
+// Symmetric tridiagonal matrix splits into independent unreduced blocks, where its subdiagonal
+// element is negligible (the same criterion as in LAPACK dstebz).
+// Returns the first indexes of blocks and the size of matrix as the last element.
+std::vector<Eigen::Index> splitTridiagonal_(
+    const Eigen::VectorXd& diagonal,
+    const Eigen::VectorXd& subdiagonal) {
+    const double epsilon = std::numeric_limits<double>::epsilon();
+    const double safe_minimum = std::numeric_limits<double>::min();
+    std::vector<Eigen::Index> borders = {0};
+    for (Eigen::Index i = 0; i < subdiagonal.size(); ++i) {
+        double squared_subdiagonal = subdiagonal(i) * subdiagonal(i);
+        if (std::abs(diagonal(i) * diagonal(i + 1)) * epsilon * epsilon + safe_minimum > squared_subdiagonal) {
+            borders.push_back(i + 1);
         }
+    }
+    borders.push_back(diagonal.size());
+    return borders;
+}
 
-        double vec_norm = next_vector->norm();
-        if (vec_norm < std::numeric_limits<double>::epsilon()) {
-            throw std::invalid_argument("Extremely small value of vector norm in Krylov procedure: " + std::to_string(vec_norm));
+// Range-restricted eigensolver (like LAPACK dsyevr with RANGE='V'):
+// all eigenvalues are calculated from the tridiagonal form, but only the eigenvectors
+// within energy window are calculated by inverse iteration and back-transformed.
+// The tridiagonal matrix is split into unreduced blocks first, so eigenvectors of (degenerate)
+// eigenvalues of different blocks have disjoint supports and are orthogonal by construction.
+template <typename T>
+std::pair<Eigen::Vector<T, -1>, Eigen::Matrix<T, -1, -1>> windowDiagonalizeValuesVectors_(
+    const Eigen::Matrix<T, -1, -1>& matrix,
+    double energy_window) {
+    if (matrix.rows() == 0) {
+        return {Eigen::Vector<T, -1>(), Eigen::Matrix<T, -1, -1>()};
+    }
+    Eigen::Tridiagonalization<Eigen::Matrix<T, -1, -1>> tridiagonalization(matrix);
+    Eigen::VectorXd diagonal = tridiagonalization.diagonal().template cast<double>();
+    Eigen::VectorXd subdiagonal = tridiagonalization.subDiagonal().template cast<double>();
+    Eigen::Index n = diagonal.size();
+
+    // eigenvalues of all unreduced blocks, every one is marked by the number of its block:
+    auto borders = splitTridiagonal_(diagonal, subdiagonal);
+    std::vector<std::pair<double, size_t>> all_eigenvalues;
+    all_eigenvalues.reserve(n);
+    for (size_t block = 0; block + 1 < borders.size(); ++block) {
+        Eigen::Index begin = borders[block];
+        Eigen::Index size = borders[block + 1] - begin;
+        if (size == 1) {
+            all_eigenvalues.emplace_back(diagonal(begin), block);
+            continue;
         }
-        *next_vector /= vec_norm;
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es;
+        es.computeFromTridiagonal(
+            diagonal.segment(begin, size),
+            subdiagonal.segment(begin, size - 1),
+            Eigen::EigenvaluesOnly);
+        for (Eigen::Index i = 0; i < size; ++i) {
+            all_eigenvalues.emplace_back(es.eigenvalues()(i), block);
+        }
+    }
+    std::stable_sort(all_eigenvalues.begin(), all_eigenvalues.end());
 
-        // use objects instead of pointers and use arma::swap?
-        std::swap(previous_vector, current_vector);
-        std::swap(current_vector, next_vector);
+    Eigen::Index number_of_eigenpairs = 1;
+    while (number_of_eigenpairs < n
+           && all_eigenvalues[number_of_eigenpairs].first <= all_eigenvalues[0].first + energy_window) {
+        ++number_of_eigenpairs;
     }
 
-    Eigen::SelfAdjointEigenSolver<Eigen::Matrix<T, -1, -1>> es;
-    es.compute(
-        krylov_matrix,
-        Eigen::ComputeEigenvectors);
-    auto eigenvalues = std::move(es.eigenvalues());
-    auto eigenvectors = std::move(es.eigenvectors());
-        
-    auto back_projection = eigenvectors.row(0);
+    if (2 * number_of_eigenpairs > n) {
+        // inverse iteration and back-transformation of many vectors are slower than full QL:
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix<T, -1, -1>> full_es;
+        full_es.compute(matrix, Eigen::ComputeEigenvectors);
+        return {
+            full_es.eigenvalues().head(number_of_eigenpairs),
+            full_es.eigenvectors().leftCols(number_of_eigenpairs)};
+    }
+
+    Eigen::VectorXd eigenvalues(number_of_eigenpairs);
+    // positions of the eigenvalues of each block in the (sorted) answer:
+    std::vector<std::vector<Eigen::Index>> positions_in_blocks(borders.size() - 1);
+    for (Eigen::Index i = 0; i < number_of_eigenpairs; ++i) {
+        eigenvalues(i) = all_eigenvalues[i].first;
+        positions_in_blocks[all_eigenvalues[i].second].push_back(i);
+    }
 
-    return {std::move(eigenvalues), std::move(back_projection)};
-}   
+    Eigen::MatrixXd tridiagonal_eigenvectors = Eigen::MatrixXd::Zero(n, number_of_eigenpairs);
+    for (size_t block = 0; block + 1 < borders.size(); ++block) {
+        const auto& positions = positions_in_blocks[block];
+        if (positions.empty()) {
+            continue;
+        }
+        Eigen::Index begin = borders[block];
+        Eigen::Index size = borders[block + 1] - begin;
+        if (size == 1) {
+            tridiagonal_eigenvectors(begin, positions[0]) = 1;
+            continue;
+        }
+        Eigen::VectorXd eigenvalues_of_block(positions.size());
+        for (size_t i = 0; i < positions.size(); ++i) {
+            eigenvalues_of_block(i) = eigenvalues(positions[i]);
+        }
+        Eigen::MatrixXd eigenvectors_of_block = tridiagonalInverseIteration_(
+            diagonal.segment(begin, size),
+            subdiagonal.segment(begin, size - 1),
+            eigenvalues_of_block);
+        for (size_t i = 0; i < positions.size(); ++i) {
+            tridiagonal_eigenvectors.col(positions[i]).segment(begin, size) = eigenvectors_of_block.col(i);
+        }
+    }
+    Eigen::Matrix<T, -1, -1> eigenvectors =
+        tridiagonalization.matrixQ() * tridiagonal_eigenvectors.cast<T>();
+
+    return {eigenvalues.cast<T>(), std::move(eigenvectors)};
+}
 
+// Block Rayleigh-Ritz refinement of approximate eigenvectors (LOBPCG without preconditioner):
+// every iteration diagonalizes the matrix projected onto the span of current Ritz vectors X,
+// their residuals R and the previous search directions P, and keeps the lowest Ritz pairs.
+// If energy_window is set, initial vectors are the lowest ones within the window, so one guard vector
+// (started from a pseudo-random vector orthogonal to them) is kept in addition to them. The guard Ritz value
+// is an upper bound of the next eigenvalue, so std::nullopt is returned as soon as it comes into the window;
+// the refinement is accepted only when the guard has converged and its Ritz value minus its residual
+// is above the window edge.
 template <typename T, typename M>
-std::tuple<Eigen::Vector<T, -1>, Eigen::Matrix<T, -1, -1>, Eigen::Vector<T, -1>> krylovProcedureDiagonalizeValuesVectors_(
+std::optional<std::pair<Eigen::Vector<T, -1>, Eigen::Matrix<T, -1, -1>>> refineDiagonalizeValuesVectors_(
     const M& matrix,
-    const Eigen::Vector<T, -1>& seed_vector,
-    size_t krylov_subspace_size) {
-    Eigen::Matrix<T, -1, -1> krylov_matrix(krylov_subspace_size, krylov_subspace_size);
-    krylov_matrix.fill(0);
-    
-    if (krylov_subspace_size > matrix.cols()) {
-        throw std::invalid_argument("krylov_subspace_size bigger than size of matrix!");
+    const Eigen::Matrix<T, -1, -1>& initial_eigenvectors,
+    double tolerance,
+    size_t max_iterations,
+    std::optional<double> energy_window) {
+    Eigen::Index size = initial_eigenvectors.rows();
+    Eigen::Index number_of_eigenpairs = initial_eigenvectors.cols();
+    if (number_of_eigenpairs == 0) {
+        return std::make_pair(Eigen::Vector<T, -1>(), initial_eigenvectors);
     }
+    // residuals cannot be smaller than the rounding errors:
+    tolerance = std::max(
+        tolerance,
+        10 * std::sqrt((double)size) * (double)std::numeric_limits<T>::epsilon());
+    // there are no states above the initial ones, if they span the full space:
+    bool has_guard = energy_window.has_value() && number_of_eigenpairs < size;
 
-    Eigen::Matrix<T, -1, -1> krylov_vectors(seed_vector.size(), krylov_subspace_size);
-    krylov_vectors.fill(0);
+    // Ritz pairs in the span of initial vectors:
+    Eigen::Matrix<T, -1, -1> ritz_vectors(size, number_of_eigenpairs + (has_guard ? 1 : 0));
+    ritz_vectors.leftCols(number_of_eigenpairs) = initial_eigenvectors;
+    if (has_guard) {
+        // the guard has to overlap with all states above the initial ones:
+        std::mt19937 rng(size);
+        std::uniform_real_distribution<double> dist(-1, +1);
+        Eigen::Vector<T, -1> guard(size);
+        for (Eigen::Index i = 0; i < size; ++i) {
+            guard(i) = (T)dist(rng);
+        }
+        for (size_t pass = 0; pass < 2; ++pass) {
+            guard -= initial_eigenvectors * (initial_eigenvectors.transpose() * guard);
+        }
+        ritz_vectors.col(number_of_eigenpairs) = guard.normalized();
+    }
+    Eigen::Matrix<T, -1, -1> product = matrix * ritz_vectors;
+    Eigen::Vector<T, -1> ritz_values;
+    {
+        Eigen::Matrix<T, -1, -1> projected = ritz_vectors.transpose() * product;
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix<T, -1, -1>> es;
+        es.compute((projected + projected.transpose()) / 2, Eigen::ComputeEigenvectors);
+        ritz_values = es.eigenvalues();
+        ritz_vectors = ritz_vectors * es.eigenvectors();
+        product = product * es.eigenvectors();
+    }
+    Eigen::Matrix<T, -1, -1> directions(size, 0);
 
-    krylov_vectors.col(0) = seed_vector;
+    for (size_t iteration = 0; iteration < max_iterations; ++iteration) {
+        Eigen::Matrix<T, -1, -1> residuals = product - ritz_vectors * ritz_values.asDiagonal();
+        double scale = std::max(
+            (double)ritz_values.cwiseAbs().maxCoeff(),
+            (double)std::numeric_limits<float>::min());
+        // the guard has to converge too, otherwise it is not the lowest state above the initial ones:
+        bool has_converged = true;
+        for (Eigen::Index i = 0; i < ritz_vectors.cols() && has_converged; ++i) {
+            has_converged = residuals.col(i).norm() <= tolerance * scale;
+        }
+        if (has_guard && ritz_values(number_of_eigenpairs) <= ritz_values(0) + energy_window.value()) {
+            return std::nullopt;
+        }
+        bool is_window_edge_resolved = !has_guard
+            || ritz_values(number_of_eigenpairs) - residuals.col(number_of_eigenpairs).norm()
+                > ritz_values(0) + energy_window.value();
+        if (has_converged && is_window_edge_resolved) {
+            return std::make_pair(
+                Eigen::Vector<T, -1>(ritz_values.head(number_of_eigenpairs)),
+                Eigen::Matrix<T, -1, -1>(ritz_vectors.leftCols(number_of_eigenpairs)));
+        }
+
+        // orthonormal basis of span(X, R, P), it cannot be larger than the full space:
+        Eigen::Index number_of_columns = ritz_vectors.cols() + residuals.cols() + directions.cols();
+        Eigen::Matrix<T, -1, -1> extended(size, number_of_columns);
+        extended << ritz_vectors, residuals, directions;
+        number_of_columns = std::min(number_of_columns, size);
+        Eigen::HouseholderQR<Eigen::Matrix<T, -1, -1>> qr(extended.leftCols(number_of_columns));
+        Eigen::Matrix<T, -1, -1> basis =
+            qr.householderQ() * Eigen::Matrix<T, -1, -1>::Identity(size, number_of_columns);
+
+        Eigen::Matrix<T, -1, -1> basis_product = matrix * basis;
+        Eigen::Matrix<T, -1, -1> projected = basis.transpose() * basis_product;
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix<T, -1, -1>> es;
+        es.compute((projected + projected.transpose()) / 2, Eigen::ComputeEigenvectors);
 
-    // use objects instead of pointers and use swap?
-    double vec_norm = krylov_vectors.col(0).norm();
-    if (vec_norm < std::numeric_limits<double>::epsilon()) {
-        throw std::invalid_argument("Extremely small value of vector norm in Krylov procedure: " + std::to_string(vec_norm));
+        Eigen::Index number_of_kept = ritz_vectors.cols();
+        Eigen::Matrix<T, -1, -1> new_ritz_vectors = basis * es.eigenvectors().leftCols(number_of_kept);
+        // the search directions span(X_new, X) = span(X_new, P):
+        Eigen::Matrix<T, -1, -1> overlap = ritz_vectors.transpose() * new_ritz_vectors;
+        directions = new_ritz_vectors - ritz_vectors * overlap;
+        ritz_vectors = std::move(new_ritz_vectors);
+        product = basis_product * es.eigenvectors().leftCols(number_of_kept);
+        ritz_values = es.eigenvalues().head(number_of_kept);
     }
-    krylov_vectors.col(0) /= vec_norm;
+    return std::nullopt;
+}
+
+// Eigendecomposition in single precision refined to the precision of T by iterative refinement
+// of Ogita and Aishima: every sweep consists of matrix products only, which are faster than
+// the eigendecomposition in the precision of T. Eigenvectors of clustered eigenvalues
+// are separated by Rayleigh-Ritz procedure within clusters.
+// Returns std::nullopt, if the refinement has not converged within max_sweeps.
+template <typename T>
+std::optional<std::pair<Eigen::Vector<T, -1>, Eigen::Matrix<T, -1, -1>>> mixedPrecisionDiagonalizeValuesVectors_(
+    const Eigen::Matrix<T, -1, -1>& matrix) {
+    const size_t max_sweeps = 5;
+    Eigen::Index size = matrix.rows();
 
-    auto next_vector = Eigen::Vector<T, -1>(krylov_vectors.col(0).size());
-    next_vector.fill(0);
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXf> es;
+    es.compute(matrix.template cast<float>(), Eigen::ComputeEigenvectors);
+    if (es.info() != Eigen::Success) {
+        return std::nullopt;
+    }
+    Eigen::Vector<T, -1> eigenvalues = es.eigenvalues().template cast<T>();
+    Eigen::Matrix<T, -1, -1> eigenvectors = es.eigenvectors().template cast<T>();
+    if (size == 0) {
+        return std::make_pair(std::move(eigenvalues), std::move(eigenvectors));
+    }
+    const double tolerance = 10 * (double)size * (double)std::numeric_limits<T>::epsilon();
 
-    double diag_element, non_diag_element;
+    for (size_t sweep = 0; sweep <= max_sweeps; ++sweep) {
+        Eigen::Matrix<T, -1, -1> product = matrix * eigenvectors;
+        Eigen::Matrix<T, -1, -1> projected = eigenvectors.transpose() * product;
+        Eigen::Matrix<T, -1, -1> orthogonality_defect = -eigenvectors.transpose() * eigenvectors;
+        orthogonality_defect.diagonal().array() += 1;
+        eigenvalues = projected.diagonal().array() / (1 - orthogonality_defect.diagonal().array());
 
-    for (size_t k = 0; k < krylov_subspace_size; ++k) {
-        next_vector = matrix * krylov_vectors.col(k);
-        diag_element = krylov_vectors.col(k).dot(next_vector);
-        if (k > 0) {
-            non_diag_element = krylov_vectors.col(k-1).dot(next_vector);
-        }
+        double scale = std::max(
+            (double)eigenvalues.cwiseAbs().maxCoeff(),
+            (double)std::numeric_limits<float>::min());
+        Eigen::Matrix<T, -1, -1> off_diagonal = projected;
+        off_diagonal.diagonal() -= eigenvalues;
+        double off_diagonal_norm = off_diagonal.norm();
+        double orthogonality_defect_norm = orthogonality_defect.norm();
 
-        krylov_matrix(k, k) = diag_element;
-        if (k > 0) {
-            krylov_matrix(k-1, k) = non_diag_element;
-            krylov_matrix(k, k-1) = non_diag_element;
+        // eigenvalues are sorted, up to the rounding errors of single precision:
+        std::vector<Eigen::Index> order(size);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&eigenvalues](Eigen::Index a, Eigen::Index b) {
+            return eigenvalues(a) < eigenvalues(b);
+        });
+        if (off_diagonal_norm <= tolerance * scale && orthogonality_defect_norm <= tolerance) {
+            Eigen::Vector<T, -1> sorted_eigenvalues(size);
+            Eigen::Matrix<T, -1, -1> sorted_eigenvectors(size, size);
+            for (Eigen::Index i = 0; i < size; ++i) {
+                sorted_eigenvalues(i) = eigenvalues(order[i]);
+                sorted_eigenvectors.col(i) = eigenvectors.col(order[i]);
+            }
+            return std::make_pair(std::move(sorted_eigenvalues), std::move(sorted_eigenvectors));
         }
-
-        next_vector -= krylov_vectors.col(k) * diag_element;
-        if (k > 0) {
-            next_vector -= krylov_vectors.col(k-1) * non_diag_element;
+        if (sweep == max_sweeps) {
+            break;
         }
 
-        double vec_norm = next_vector.norm();
-        if (vec_norm < std::numeric_limits<double>::epsilon()) {
-            throw std::invalid_argument("Extremely small value of vector norm in Krylov procedure: " + std::to_string(vec_norm));
+        // eigenvalues closer than delta cannot be separated by the first-order correction:
+        double delta = 2 * (off_diagonal_norm + scale * orthogonality_defect_norm);
+        Eigen::Matrix<T, -1, -1> correction(size, size);
+        for (Eigen::Index j = 0; j < size; ++j) {
+            for (Eigen::Index i = 0; i < size; ++i) {
+                T gap = eigenvalues(j) - eigenvalues(i);
+                correction(i, j) = std::abs(gap) > delta
+                    ? (projected(i, j) + eigenvalues(j) * orthogonality_defect(i, j)) / gap
+                    : orthogonality_defect(i, j) / 2;
+            }
         }
-        next_vector /= vec_norm;
+        eigenvectors += eigenvectors * correction;
 
-        if (k + 1 < krylov_subspace_size) {
-            krylov_vectors.col(k+1) = next_vector;
+        for (Eigen::Index begin = 0; begin < size;) {
+            Eigen::Index end = begin + 1;
+            while (end < size && eigenvalues(order[end]) - eigenvalues(order[end - 1]) <= delta) {
+                ++end;
+            }
+            if (end - begin > 1) {
+                std::vector<Eigen::Index> cluster(order.begin() + begin, order.begin() + end);
+                Eigen::Matrix<T, -1, -1> projected_cluster = projected(cluster, cluster);
+                projected_cluster = (projected_cluster + projected_cluster.transpose()) / 2;
+                Eigen::SelfAdjointEigenSolver<Eigen::Matrix<T, -1, -1>> cluster_es;
+                cluster_es.compute(projected_cluster, Eigen::ComputeEigenvectors);
+                Eigen::Matrix<T, -1, -1> rotated = eigenvectors(Eigen::all, cluster) * cluster_es.eigenvectors();
+                eigenvectors(Eigen::all, cluster) = rotated;
+            }
+            begin = end;
         }
     }
-
-    Eigen::SelfAdjointEigenSolver<Eigen::Matrix<T, -1, -1>> es;
-    es.compute(
-        krylov_matrix,
-        Eigen::ComputeEigenvectors);
-    auto eigenvalues = std::move(es.eigenvalues());
-    auto eigenvectors = std::move(es.eigenvectors());
-    
-    // arma::Col<T> back_projection = eigenvectors.row(0).t();
-    auto back_projection = eigenvectors.row(0).transpose();
-
-    Eigen::Matrix<T, -1, -1> total_eigenvectors = krylov_vectors * eigenvectors;
-
-    return {std::move(eigenvalues), std::move(total_eigenvectors), std::move(back_projection)};    
+    return std::nullopt;
 }
 
 } // namespace
@@ -178,22 +506,155 @@ inline std::unique_ptr<AbstractDenseVector> unitaryTransformAndReturnMainDiagona
 }
 
 template <typename T, typename M>
-inline KrylovCouple krylovDiagonalizeValues_(
+inline std::vector<KrylovCouple> krylovDiagonalizeValuesOfSeeds_(
     const M& diagonalizableMatrix,
-    const EigenDenseVector<T>& seed_vector,
-    size_t krylov_subspace_size) {
-    auto eigenvalues_ = std::make_unique<EigenDenseVector<T>>();
-    auto ftlm_weights_of_states_ = std::make_unique<EigenDenseVector<T>>();
-    auto pair = krylovProcedureDiagonalizeValues_(
+    const Eigen::Matrix<T, -1, -1>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) {
+    auto krylov_matrices = eigen_lanczos::krylovProcedureOfSeeds<T>(
         diagonalizableMatrix,
-        seed_vector.getDenseVector(),
-        krylov_subspace_size);
-    eigenvalues_->modifyDenseVector() = std::move(pair.first);
-    ftlm_weights_of_states_->modifyDenseVector() = std::move(pair.second.array().square());
+        seed_vectors,
+        krylov_subspace_size,
+        convergence,
+        nullptr);
 
-    KrylovCouple answer;
-    answer.eigenvalues = std::move(eigenvalues_);
-    answer.ftlm_weights_of_states = std::move(ftlm_weights_of_states_);
+    std::vector<KrylovCouple> answer(krylov_matrices.size());
+    for (size_t seed = 0; seed < krylov_matrices.size(); ++seed) {
+        // only the first components of eigenvectors are needed for the weights:
+        std::vector<double> first_components;
+        auto eigenvalues = diagonalizeSymmetricTridiagonal(krylov_matrices[seed], 1, first_components);
+
+        auto eigenvalues_ = std::make_unique<EigenDenseVector<T>>();
+        auto ftlm_weights_of_states_ = std::make_unique<EigenDenseVector<T>>();
+        eigenvalues_->modifyDenseVector() =
+            Eigen::Map<const Eigen::VectorXd>(eigenvalues.data(), eigenvalues.size()).template cast<T>();
+        ftlm_weights_of_states_->modifyDenseVector() =
+            Eigen::Map<const Eigen::VectorXd>(first_components.data(), first_components.size())
+                .array().square().template cast<T>();
+
+        answer[seed].eigenvalues = std::move(eigenvalues_);
+        answer[seed].ftlm_weights_of_states = std::move(ftlm_weights_of_states_);
+    }
+    return answer;
+}
+
+template <typename T, typename M>
+inline std::vector<KrylovTriple> krylovDiagonalizeValuesVectorsOfSeeds_(
+    const M& diagonalizableMatrix,
+    const Eigen::Matrix<T, -1, -1>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) {
+    std::vector<Eigen::Matrix<T, -1, -1>> krylov_vectors(
+        seed_vectors.cols(),
+        Eigen::Matrix<T, -1, -1>::Zero(seed_vectors.rows(), krylov_subspace_size));
+    auto krylov_matrices = eigen_lanczos::krylovProcedureOfSeeds<T>(
+        diagonalizableMatrix,
+        seed_vectors,
+        krylov_subspace_size,
+        convergence,
+        [&krylov_vectors](
+            size_t k,
+            const std::vector<Eigen::Index>& active_seeds,
+            const Eigen::Matrix<T, -1, -1>& current_vectors) {
+            for (size_t column = 0; column < active_seeds.size(); ++column) {
+                krylov_vectors[active_seeds[column]].col(k) = current_vectors.col(column);
+            }
+        });
+
+    std::vector<KrylovTriple> answer(krylov_matrices.size());
+    for (size_t seed = 0; seed < krylov_matrices.size(); ++seed) {
+        const auto& krylov_matrix = krylov_matrices[seed];
+        // Krylov matrix is small, so it is diagonalized in double precision
+        // as in krylovDiagonalizeValuesOfSeeds_:
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es;
+        es.computeFromTridiagonal(
+            Eigen::Map<const Eigen::VectorXd>(krylov_matrix.diagonal.data(), krylov_matrix.diagonal.size()),
+            Eigen::Map<const Eigen::VectorXd>(krylov_matrix.subdiagonal.data(), krylov_matrix.subdiagonal.size()),
+            Eigen::ComputeEigenvectors);
+        Eigen::Matrix<T, -1, -1> ritz_vectors = es.eigenvectors().template cast<T>();
+
+        auto eigenvalues_ = std::make_unique<EigenDenseVector<T>>();
+        auto eigenvectors_ = std::make_unique<EigenKrylovDenseSemiunitaryMatrix<T>>();
+        auto ftlm_weights_of_states_ = std::make_unique<EigenDenseVector<T>>();
+
+        Eigen::Vector<T, -1> back_projection = ritz_vectors.row(0).transpose();
+        eigenvalues_->modifyDenseVector() = es.eigenvalues().template cast<T>();
+        ftlm_weights_of_states_->modifyDenseVector() = back_projection.array().square();
+        // the procedure of the seed can be stopped before krylov_subspace_size steps:
+        eigenvectors_->modifyKrylovDenseSemiunitaryMatrix() =
+            krylov_vectors[seed].leftCols(ritz_vectors.rows()) * ritz_vectors;
+        eigenvectors_->modifySeedVector() = seed_vectors.col(seed);
+        // instead of <n|A|r><r|n>, here we are using <n|A|r>/<r|n>,
+        // putting |<r|n>|^2 in the weight of state
+        // in the case of small <r|n>, we substitute it with infinity
+        // to avoid numerical instabilities
+        const T EPSILON = 1e-14;
+        eigenvectors_->modifyBackProjectionVector() =
+            (back_projection.array().abs() < EPSILON)
+            .select(std::numeric_limits<T>::infinity(), back_projection);
+        // Krylov vectors of the seed are not needed anymore:
+        krylov_vectors[seed].resize(0, 0);
+
+        answer[seed].eigenvalues = std::move(eigenvalues_);
+        answer[seed].eigenvectors = std::move(eigenvectors_);
+        answer[seed].ftlm_weights_of_states = std::move(ftlm_weights_of_states_);
+    }
+    return answer;
+}
+
+template <typename T, typename M>
+inline std::vector<KrylovTriple> krylovDiagonalizeValuesVectorsTwoPassOfSeeds_(
+    const M& diagonalizableMatrix,
+    const std::shared_ptr<const AbstractDiagonalizableMatrix>& hamiltonian,
+    const Eigen::Matrix<T, -1, -1>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) {
+    // the first pass: only Krylov matrices are stored
+    auto krylov_matrices = eigen_lanczos::krylovProcedureOfSeeds<T>(
+        diagonalizableMatrix,
+        seed_vectors,
+        krylov_subspace_size,
+        convergence,
+        nullptr);
+
+    std::vector<KrylovTriple> answer(krylov_matrices.size());
+    for (size_t seed = 0; seed < krylov_matrices.size(); ++seed) {
+        const auto& krylov_matrix = krylov_matrices[seed];
+        // Krylov matrix is small, so it is diagonalized in double precision
+        // as in krylovDiagonalizeValuesOfSeeds_:
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es;
+        es.computeFromTridiagonal(
+            Eigen::Map<const Eigen::VectorXd>(krylov_matrix.diagonal.data(), krylov_matrix.diagonal.size()),
+            Eigen::Map<const Eigen::VectorXd>(krylov_matrix.subdiagonal.data(), krylov_matrix.subdiagonal.size()),
+            Eigen::ComputeEigenvectors);
+        Eigen::Matrix<T, -1, -1> ritz_vectors = es.eigenvectors().template cast<T>();
+
+        auto eigenvalues_ = std::make_unique<EigenDenseVector<T>>();
+        auto eigenvectors_ = std::make_unique<EigenTwoPassKrylovDenseSemiunitaryMatrix<T>>(hamiltonian);
+        auto ftlm_weights_of_states_ = std::make_unique<EigenDenseVector<T>>();
+
+        Eigen::Vector<T, -1> back_projection = ritz_vectors.row(0).transpose();
+        eigenvalues_->modifyDenseVector() = es.eigenvalues().template cast<T>();
+        ftlm_weights_of_states_->modifyDenseVector() = back_projection.array().square();
+        // the second pass is done in every unitary transformation:
+        eigenvectors_->modifyKrylovDiagonal() =
+            Eigen::Map<const Eigen::VectorXd>(krylov_matrix.diagonal.data(), krylov_matrix.diagonal.size())
+                .template cast<T>();
+        eigenvectors_->modifyKrylovSubdiagonal() =
+            Eigen::Map<const Eigen::VectorXd>(krylov_matrix.subdiagonal.data(), krylov_matrix.subdiagonal.size())
+                .template cast<T>();
+        eigenvectors_->modifyRitzDenseSemiunitaryMatrix() = std::move(ritz_vectors);
+        eigenvectors_->modifySeedVector() = seed_vectors.col(seed);
+        // see krylovDiagonalizeValuesVectorsOfSeeds_ for details:
+        const T EPSILON = 1e-14;
+        eigenvectors_->modifyBackProjectionVector() =
+            (back_projection.array().abs() < EPSILON)
+            .select(std::numeric_limits<T>::infinity(), back_projection);
+
+        answer[seed].eigenvalues = std::move(eigenvalues_);
+        answer[seed].eigenvectors = std::move(eigenvectors_);
+        answer[seed].ftlm_weights_of_states = std::move(ftlm_weights_of_states_);
+    }
     return answer;
 }
 
@@ -201,23 +662,34 @@ template <typename T>
 KrylovCouple EigenLogic<T>::krylovDiagonalizeValues(
     const AbstractDiagonalizableMatrix& diagonalizableMatrix,
     const AbstractDenseVector& seed_vector,
-    size_t krylov_subspace_size) const {    
+    size_t krylov_subspace_size) const {
     if (auto maybeDenseVector =
         dynamic_cast<const EigenDenseVector<T>*>(&seed_vector)) {
+        Eigen::Matrix<T, -1, -1> seed_matrix = maybeDenseVector->getDenseVector();
         if (auto maybeDenseSymmetricMatrix =
             dynamic_cast<const EigenDenseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
-            return krylovDiagonalizeValues_(
+            return std::move(krylovDiagonalizeValuesOfSeeds_(
                 maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix(),
-                *maybeDenseVector,
-                krylov_subspace_size
-            );
+                seed_matrix,
+                krylov_subspace_size,
+                std::nullopt
+            )[0]);
         } else if (auto maybeSparseSymmetricMatrix =
             dynamic_cast<const EigenSparseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
-            return krylovDiagonalizeValues_(
+            return std::move(krylovDiagonalizeValuesOfSeeds_(
                 maybeSparseSymmetricMatrix->getSparseDiagonalizableMatrix(),
-                *maybeDenseVector,
-                krylov_subspace_size
-            );
+                seed_matrix,
+                krylov_subspace_size,
+                std::nullopt
+            )[0]);
+        } else if (auto maybeMatrixFreeMatrix =
+            dynamic_cast<const EigenMatrixFreeDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+            return std::move(krylovDiagonalizeValuesOfSeeds_(
+                *maybeMatrixFreeMatrix,
+                seed_matrix,
+                krylov_subspace_size,
+                std::nullopt
+            )[0]);
         } else {
             throw std::bad_cast();
         }
@@ -226,42 +698,6 @@ KrylovCouple EigenLogic<T>::krylovDiagonalizeValues(
     }
 }
 
-template <typename T, typename M>
-inline KrylovTriple krylovDiagonalizeValuesVectors_(
-    const M& diagonalizableMatrix,
-    const EigenDenseVector<T>& seed_vector,
-    size_t krylov_subspace_size) {
-    auto eigenvalues_ = std::make_unique<EigenDenseVector<T>>();
-    auto eigenvectors_ = std::make_unique<EigenKrylovDenseSemiunitaryMatrix<T>>();
-    auto ftlm_weights_of_states_ = std::make_unique<EigenDenseVector<T>>();
-
-    auto triple = krylovProcedureDiagonalizeValuesVectors_(
-        diagonalizableMatrix,
-        seed_vector.getDenseVector(),
-        krylov_subspace_size);
-
-    eigenvalues_->modifyDenseVector() = std::move(std::get<0>(triple));
-    ftlm_weights_of_states_->modifyDenseVector() = std::get<2>(triple).array().square();
-    eigenvectors_->modifyKrylovDenseSemiunitaryMatrix() = std::move(std::get<1>(triple));
-    eigenvectors_->modifyBackProjectionVector() = std::move(std::get<2>(triple));
-    eigenvectors_->modifySeedVector() = seed_vector.getDenseVector();
-
-    // instead of <n|A|r><r|n>, here we are using <n|A|r>/<r|n>,
-    // putting |<r|n>|^2 in the weight of state
-    // in the case of small <r|n>, we substitute it with infinity 
-    // to avoid numerical instabilities
-    const T EPSILON = 1e-14;
-    eigenvectors_->modifyBackProjectionVector() = 
-        (eigenvectors_->modifyBackProjectionVector().array().abs() < EPSILON)
-        .select(std::numeric_limits<T>::infinity(), eigenvectors_->modifyBackProjectionVector());
-
-    KrylovTriple answer;
-    answer.eigenvalues = std::move(eigenvalues_);
-    answer.eigenvectors = std::move(eigenvectors_);
-    answer.ftlm_weights_of_states = std::move(ftlm_weights_of_states_);
-    return answer;
-}
-
 template <typename T>
 KrylovTriple EigenLogic<T>::krylovDiagonalizeValuesVectors(
     const AbstractDiagonalizableMatrix& diagonalizableMatrix,
@@ -269,21 +705,32 @@ KrylovTriple EigenLogic<T>::krylovDiagonalizeValuesVectors(
     size_t krylov_subspace_size) const {
     if (auto maybeDenseVector =
         dynamic_cast<const EigenDenseVector<T>*>(&seed_vector)) {
+        Eigen::Matrix<T, -1, -1> seed_matrix = maybeDenseVector->getDenseVector();
         if (auto maybeDenseSymmetricMatrix =
             dynamic_cast<const EigenDenseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
             // It is slow, avoid this branch.
-            return krylovDiagonalizeValuesVectors_(
+            return std::move(krylovDiagonalizeValuesVectorsOfSeeds_(
                 maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix(),
-                *maybeDenseVector,
-                krylov_subspace_size
-            );
+                seed_matrix,
+                krylov_subspace_size,
+                std::nullopt
+            )[0]);
         } else if (auto maybeSparseSymmetricMatrix =
             dynamic_cast<const EigenSparseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
-            return krylovDiagonalizeValuesVectors_(
+            return std::move(krylovDiagonalizeValuesVectorsOfSeeds_(
                 maybeSparseSymmetricMatrix->getSparseDiagonalizableMatrix(),
-                *maybeDenseVector,
-                krylov_subspace_size
-            );
+                seed_matrix,
+                krylov_subspace_size,
+                std::nullopt
+            )[0]);
+        } else if (auto maybeMatrixFreeMatrix =
+            dynamic_cast<const EigenMatrixFreeDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+            return std::move(krylovDiagonalizeValuesVectorsOfSeeds_(
+                *maybeMatrixFreeMatrix,
+                seed_matrix,
+                krylov_subspace_size,
+                std::nullopt
+            )[0]);
         } else {
             throw std::bad_cast();
         }
@@ -292,6 +739,141 @@ KrylovTriple EigenLogic<T>::krylovDiagonalizeValuesVectors(
     }
 }
 
+template <typename T>
+inline Eigen::Matrix<T, -1, -1> seedVectorsToMatrix_(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors) {
+    Eigen::Matrix<T, -1, -1> answer;
+    for (size_t seed = 0; seed < seed_vectors.size(); ++seed) {
+        auto maybeDenseVector = dynamic_cast<const EigenDenseVector<T>*>(seed_vectors[seed].get());
+        if (maybeDenseVector == nullptr) {
+            throw std::bad_cast();
+        }
+        const auto& seed_vector = maybeDenseVector->getDenseVector();
+        if (seed == 0) {
+            answer.resize(seed_vector.size(), seed_vectors.size());
+        } else if (seed_vector.size() != answer.rows()) {
+            throw std::length_error("Seed vectors have different sizes");
+        }
+        answer.col(seed) = seed_vector;
+    }
+    return answer;
+}
+
+template <typename T>
+std::vector<KrylovCouple> EigenLogic<T>::krylovDiagonalizeValues(
+    const AbstractDiagonalizableMatrix& diagonalizableMatrix,
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    auto seed_matrix = seedVectorsToMatrix_<T>(seed_vectors);
+    if (auto maybeDenseSymmetricMatrix =
+        dynamic_cast<const EigenDenseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        return krylovDiagonalizeValuesOfSeeds_(
+            maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix(),
+            seed_matrix,
+            krylov_subspace_size,
+            convergence
+        );
+    } else if (auto maybeSparseSymmetricMatrix =
+        dynamic_cast<const EigenSparseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        return krylovDiagonalizeValuesOfSeeds_(
+            maybeSparseSymmetricMatrix->getSparseDiagonalizableMatrix(),
+            seed_matrix,
+            krylov_subspace_size,
+            convergence
+        );
+    } else if (auto maybeMatrixFreeMatrix =
+        dynamic_cast<const EigenMatrixFreeDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        return krylovDiagonalizeValuesOfSeeds_(
+            *maybeMatrixFreeMatrix,
+            seed_matrix,
+            krylov_subspace_size,
+            convergence
+        );
+    } else {
+        throw std::bad_cast();
+    }
+}
+
+template <typename T>
+std::vector<KrylovTriple> EigenLogic<T>::krylovDiagonalizeValuesVectors(
+    const AbstractDiagonalizableMatrix& diagonalizableMatrix,
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    auto seed_matrix = seedVectorsToMatrix_<T>(seed_vectors);
+    if (auto maybeDenseSymmetricMatrix =
+        dynamic_cast<const EigenDenseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        // It is slow, avoid this branch.
+        return krylovDiagonalizeValuesVectorsOfSeeds_(
+            maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix(),
+            seed_matrix,
+            krylov_subspace_size,
+            convergence
+        );
+    } else if (auto maybeSparseSymmetricMatrix =
+        dynamic_cast<const EigenSparseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        return krylovDiagonalizeValuesVectorsOfSeeds_(
+            maybeSparseSymmetricMatrix->getSparseDiagonalizableMatrix(),
+            seed_matrix,
+            krylov_subspace_size,
+            convergence
+        );
+    } else if (auto maybeMatrixFreeMatrix =
+        dynamic_cast<const EigenMatrixFreeDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        return krylovDiagonalizeValuesVectorsOfSeeds_(
+            *maybeMatrixFreeMatrix,
+            seed_matrix,
+            krylov_subspace_size,
+            convergence
+        );
+    } else {
+        throw std::bad_cast();
+    }
+}
+
+template <typename T>
+std::vector<KrylovTriple> EigenLogic<T>::krylovDiagonalizeValuesVectorsTwoPass(
+    const AbstractDiagonalizableMatrix& diagonalizableMatrix,
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    auto seed_matrix = seedVectorsToMatrix_<T>(seed_vectors);
+    // eigenvectors share the ownership of the matrix to regenerate Krylov vectors:
+    auto hamiltonian = diagonalizableMatrix.shared_from_this();
+    if (auto maybeDenseSymmetricMatrix =
+        dynamic_cast<const EigenDenseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        // It is slow, avoid this branch.
+        return krylovDiagonalizeValuesVectorsTwoPassOfSeeds_(
+            maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix(),
+            hamiltonian,
+            seed_matrix,
+            krylov_subspace_size,
+            convergence
+        );
+    } else if (auto maybeSparseSymmetricMatrix =
+        dynamic_cast<const EigenSparseDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        return krylovDiagonalizeValuesVectorsTwoPassOfSeeds_(
+            maybeSparseSymmetricMatrix->getSparseDiagonalizableMatrix(),
+            hamiltonian,
+            seed_matrix,
+            krylov_subspace_size,
+            convergence
+        );
+    } else if (auto maybeMatrixFreeMatrix =
+        dynamic_cast<const EigenMatrixFreeDiagonalizableMatrix<T>*>(&diagonalizableMatrix)) {
+        return krylovDiagonalizeValuesVectorsTwoPassOfSeeds_(
+            *maybeMatrixFreeMatrix,
+            hamiltonian,
+            seed_matrix,
+            krylov_subspace_size,
+            convergence
+        );
+    } else {
+        throw std::bad_cast();
+    }
+}
+
 template <typename T>
 std::unique_ptr<AbstractDenseVector>
 EigenLogic<T>::diagonalizeValues(const AbstractDiagonalizableMatrix& symmetricMatrix) const {
@@ -299,6 +881,16 @@ EigenLogic<T>::diagonalizeValues(const AbstractDiagonalizableMatrix& symmetricMa
 
     if (auto maybeDenseSymmetricMatrix =
             dynamic_cast<const EigenDenseDiagonalizableMatrix<T>*>(&symmetricMatrix)) {
+        if (maybeDenseSymmetricMatrix->isMixedPrecision()) {
+            // eigenvectors are needed for the refinement of eigenvalues:
+            auto mb_pair = mixedPrecisionDiagonalizeValuesVectors_<T>(
+                maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix());
+            if (mb_pair.has_value()) {
+                auto eigenvalues_ = std::make_unique<EigenDenseVector<T>>();
+                eigenvalues_->modifyDenseVector() = std::move(mb_pair->first);
+                return eigenvalues_;
+            }
+        }
         es.compute(
             maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix(),
             Eigen::EigenvaluesOnly);
@@ -325,6 +917,22 @@ EigenLogic<T>::diagonalizeValuesVectors(const AbstractDiagonalizableMatrix& symm
 
     if (auto maybeDenseSymmetricMatrix =
             dynamic_cast<const EigenDenseDiagonalizableMatrix<T>*>(&symmetricMatrix)) {
+        if (maybeDenseSymmetricMatrix->isMixedPrecision()) {
+            auto mb_pair = mixedPrecisionDiagonalizeValuesVectors_<T>(
+                maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix());
+            // if the refinement has not converged, the eigendecomposition is done in the precision of T:
+            if (mb_pair.has_value()) {
+                auto eigenvalues_ = std::make_unique<EigenDenseVector<T>>();
+                auto eigenvectors_ = std::make_unique<EigenDenseSemiunitaryMatrix<T>>();
+                eigenvalues_->modifyDenseVector() = std::move(mb_pair->first);
+                eigenvectors_->modifyDenseSemiunitaryMatrix() = std::move(mb_pair->second);
+
+                EigenCouple answer;
+                answer.eigenvalues = std::move(eigenvalues_);
+                answer.eigenvectors = std::move(eigenvectors_);
+                return answer;
+            }
+        }
         es.compute(
             maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix(),
             Eigen::ComputeEigenvectors);
@@ -349,6 +957,91 @@ EigenLogic<T>::diagonalizeValuesVectors(const AbstractDiagonalizableMatrix& symm
     return answer;
 }
 
+template <typename T>
+EigenCouple EigenLogic<T>::diagonalizeValuesVectorsInWindow(
+    const AbstractDiagonalizableMatrix& symmetricMatrix,
+    double energy_window) const {
+    std::pair<Eigen::Vector<T, -1>, Eigen::Matrix<T, -1, -1>> pair;
+
+    if (auto maybeDenseSymmetricMatrix =
+            dynamic_cast<const EigenDenseDiagonalizableMatrix<T>*>(&symmetricMatrix)) {
+        pair = windowDiagonalizeValuesVectors_<T>(
+            maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix(),
+            energy_window);
+    } else if (
+        auto maybeSparseSymmetricMatrix =
+            dynamic_cast<const EigenSparseDiagonalizableMatrix<T>*>(&symmetricMatrix)) {
+        Eigen::Matrix<T, -1, -1> sparseToDenseCopy =
+            maybeSparseSymmetricMatrix->getSparseDiagonalizableMatrix();
+        pair = windowDiagonalizeValuesVectors_<T>(sparseToDenseCopy, energy_window);
+    } else {
+        throw std::bad_cast();
+    }
+
+    auto eigenvalues_ = std::make_unique<EigenDenseVector<T>>();
+    auto eigenvectors_ = std::make_unique<EigenDenseSemiunitaryMatrix<T>>();
+    eigenvalues_->modifyDenseVector() = std::move(pair.first);
+    eigenvectors_->modifyDenseSemiunitaryMatrix() = std::move(pair.second);
+
+    EigenCouple answer;
+    answer.eigenvalues = std::move(eigenvalues_);
+    answer.eigenvectors = std::move(eigenvectors_);
+    return answer;
+}
+
+template <typename T>
+std::optional<EigenCouple> EigenLogic<T>::refineDiagonalizeValuesVectors(
+    const AbstractDiagonalizableMatrix& symmetricMatrix,
+    const AbstractDenseSemiunitaryMatrix& initial_eigenvectors,
+    double tolerance,
+    size_t max_iterations,
+    std::optional<double> energy_window) const {
+    auto maybeDenseSemiunitaryMatrix =
+        dynamic_cast<const EigenDenseSemiunitaryMatrix<T>*>(&initial_eigenvectors);
+    if (maybeDenseSemiunitaryMatrix == nullptr) {
+        throw std::bad_cast();
+    }
+    const auto& initial = maybeDenseSemiunitaryMatrix->getDenseSemiunitaryMatrix();
+    if (initial.rows() != symmetricMatrix.size()) {
+        throw std::length_error("Sizes of matrix and initial eigenvectors are different");
+    }
+
+    std::optional<std::pair<Eigen::Vector<T, -1>, Eigen::Matrix<T, -1, -1>>> mb_pair;
+    if (auto maybeDenseSymmetricMatrix =
+            dynamic_cast<const EigenDenseDiagonalizableMatrix<T>*>(&symmetricMatrix)) {
+        mb_pair = refineDiagonalizeValuesVectors_<T>(
+            maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix(),
+            initial,
+            tolerance,
+            max_iterations,
+            energy_window);
+    } else if (
+        auto maybeSparseSymmetricMatrix =
+            dynamic_cast<const EigenSparseDiagonalizableMatrix<T>*>(&symmetricMatrix)) {
+        mb_pair = refineDiagonalizeValuesVectors_<T>(
+            maybeSparseSymmetricMatrix->getSparseDiagonalizableMatrix(),
+            initial,
+            tolerance,
+            max_iterations,
+            energy_window);
+    } else {
+        throw std::bad_cast();
+    }
+    if (!mb_pair.has_value()) {
+        return std::nullopt;
+    }
+
+    auto eigenvalues_ = std::make_unique<EigenDenseVector<T>>();
+    auto eigenvectors_ = std::make_unique<EigenDenseSemiunitaryMatrix<T>>();
+    eigenvalues_->modifyDenseVector() = std::move(mb_pair->first);
+    eigenvectors_->modifyDenseSemiunitaryMatrix() = std::move(mb_pair->second);
+
+    EigenCouple answer;
+    answer.eigenvalues = std::move(eigenvalues_);
+    answer.eigenvectors = std::move(eigenvectors_);
+    return answer;
+}
+
 template class EigenLogic<double>;
 template class EigenLogic<float>;
 }  // namespace quantum::linear_algebra
\ No newline at end of file
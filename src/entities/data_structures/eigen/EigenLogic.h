@@ -2,6 +2,8 @@
 #define SPINNER_EIGENLOGIC_H
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "src/entities/data_structures/AbstractDenseSemiunitaryMatrix.h"
 #include "src/entities/data_structures/AbstractDenseVector.h"
@@ -15,6 +17,15 @@ class EigenLogic {
     diagonalizeValues(const AbstractDiagonalizableMatrix& symmetricMatrix) const;
 
     EigenCouple diagonalizeValuesVectors(const AbstractDiagonalizableMatrix& symmetricMatrix) const;
+    EigenCouple diagonalizeValuesVectorsInWindow(
+      const AbstractDiagonalizableMatrix& symmetricMatrix,
+      double energy_window) const;
+    std::optional<EigenCouple> refineDiagonalizeValuesVectors(
+      const AbstractDiagonalizableMatrix& symmetricMatrix,
+      const AbstractDenseSemiunitaryMatrix& initial_eigenvectors,
+      double tolerance,
+      size_t max_iterations,
+      std::optional<double> energy_window) const;
 
     KrylovCouple krylovDiagonalizeValues(
       const AbstractDiagonalizableMatrix& diagonalizableMatrix,
@@ -24,6 +35,21 @@ class EigenLogic {
       const AbstractDiagonalizableMatrix& diagonalizableMatrix,
       const AbstractDenseVector& seed_vector,
       size_t krylov_subspace_size) const;
+    std::vector<KrylovCouple> krylovDiagonalizeValues(
+      const AbstractDiagonalizableMatrix& diagonalizableMatrix,
+      const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+      size_t krylov_subspace_size,
+      const std::optional<KrylovConvergence>& convergence) const;
+    std::vector<KrylovTriple> krylovDiagonalizeValuesVectors(
+      const AbstractDiagonalizableMatrix& diagonalizableMatrix,
+      const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+      size_t krylov_subspace_size,
+      const std::optional<KrylovConvergence>& convergence) const;
+    std::vector<KrylovTriple> krylovDiagonalizeValuesVectorsTwoPass(
+      const AbstractDiagonalizableMatrix& diagonalizableMatrix,
+      const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+      size_t krylov_subspace_size,
+      const std::optional<KrylovConvergence>& convergence) const;
 };
 
 }  // namespace quantum::linear_algebra
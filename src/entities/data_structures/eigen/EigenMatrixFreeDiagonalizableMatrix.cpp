@@ -0,0 +1,160 @@
+#include "EigenMatrixFreeDiagonalizableMatrix.h"
+
+#include <ostream>
+#include <stdexcept>
+
+#include "EigenLogic.h"
+
+namespace quantum::linear_algebra {
+
+template <typename T>
+EigenMatrixFreeDiagonalizableMatrix<T>::EigenMatrixFreeDiagonalizableMatrix(
+    std::shared_ptr<const AbstractMatrixFreeOperator> matrix_free_operator,
+    double multiplier) :
+    matrix_free_operator_(std::move(matrix_free_operator)),
+    multiplier_(multiplier) {}
+
+template <typename T>
+void EigenMatrixFreeDiagonalizableMatrix<T>::add_to_position(double value, uint32_t i, uint32_t j) {
+    throw std::logic_error("Matrix-free matrix cannot be modified");
+}
+
+template <typename T>
+EigenCouple EigenMatrixFreeDiagonalizableMatrix<T>::diagonalizeValuesVectors() const {
+    throw std::logic_error("Matrix-free matrix can be diagonalized only by Krylov procedure");
+}
+
+template <typename T>
+std::unique_ptr<AbstractDenseVector> EigenMatrixFreeDiagonalizableMatrix<T>::diagonalizeValues() const {
+    throw std::logic_error("Matrix-free matrix can be diagonalized only by Krylov procedure");
+}
+
+template <typename T>
+EigenCouple EigenMatrixFreeDiagonalizableMatrix<T>::diagonalizeValuesVectorsInWindow(double) const {
+    throw std::logic_error("Matrix-free matrix can be diagonalized only by Krylov procedure");
+}
+
+template <typename T>
+std::optional<EigenCouple> EigenMatrixFreeDiagonalizableMatrix<T>::refineDiagonalizeValuesVectors(
+    const AbstractDenseSemiunitaryMatrix&,
+    double,
+    size_t,
+    std::optional<double>) const {
+    throw std::logic_error("Matrix-free matrix can be diagonalized only by Krylov procedure");
+}
+
+template <typename T>
+KrylovCouple EigenMatrixFreeDiagonalizableMatrix<T>::krylovDiagonalizeValues(
+    const std::unique_ptr<AbstractDenseVector>& seed_vector,
+    size_t krylov_subspace_size) const {
+    EigenLogic<T> logic;
+
+    return logic.krylovDiagonalizeValues(
+        *this,
+        *seed_vector,
+        krylov_subspace_size);
+}
+
+template <typename T>
+KrylovTriple EigenMatrixFreeDiagonalizableMatrix<T>::krylovDiagonalizeValuesVectors(
+    const std::unique_ptr<AbstractDenseVector>& seed_vector,
+    size_t krylov_subspace_size) const {
+    EigenLogic<T> logic;
+
+    return logic.krylovDiagonalizeValuesVectors(
+        *this,
+        *seed_vector,
+        krylov_subspace_size);
+}
+
+template <typename T>
+std::vector<KrylovCouple> EigenMatrixFreeDiagonalizableMatrix<T>::krylovDiagonalizeValues(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    EigenLogic<T> logic;
+    return logic.krylovDiagonalizeValues(*this, seed_vectors, krylov_subspace_size, convergence);
+}
+
+template <typename T>
+std::vector<KrylovTriple> EigenMatrixFreeDiagonalizableMatrix<T>::krylovDiagonalizeValuesVectors(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    EigenLogic<T> logic;
+    return logic.krylovDiagonalizeValuesVectors(*this, seed_vectors, krylov_subspace_size, convergence);
+}
+
+template <typename T>
+std::vector<KrylovTriple> EigenMatrixFreeDiagonalizableMatrix<T>::krylovDiagonalizeValuesVectorsTwoPass(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    EigenLogic<T> logic;
+    return logic.krylovDiagonalizeValuesVectorsTwoPass(*this, seed_vectors, krylov_subspace_size, convergence);
+}
+
+template <typename T>
+std::unique_ptr<AbstractDiagonalizableMatrix>
+EigenMatrixFreeDiagonalizableMatrix<T>::multiply_by(double multiplier) const {
+    return std::make_unique<EigenMatrixFreeDiagonalizableMatrix>(
+        matrix_free_operator_,
+        multiplier_ * multiplier);
+}
+
+template <typename T>
+void EigenMatrixFreeDiagonalizableMatrix<T>::add_scaled(double, const AbstractDiagonalizableMatrix&) {
+    throw std::logic_error("Matrix-free matrix cannot be modified");
+}
+
+template <typename T>
+void EigenMatrixFreeDiagonalizableMatrix<T>::add_sparsity_pattern(const AbstractDiagonalizableMatrix&) {
+    throw std::logic_error("Matrix-free matrix cannot be modified");
+}
+
+template <typename T>
+std::vector<double> EigenMatrixFreeDiagonalizableMatrix<T>::stored_values_of(const AbstractDiagonalizableMatrix&) const {
+    throw std::logic_error("Matrix-free matrix does not store its elements");
+}
+
+template <typename T>
+void EigenMatrixFreeDiagonalizableMatrix<T>::assign_stored_values(const std::vector<double>&) {
+    throw std::logic_error("Matrix-free matrix cannot be modified");
+}
+
+template <typename T>
+uint32_t EigenMatrixFreeDiagonalizableMatrix<T>::size() const {
+    return matrix_free_operator_->size();
+}
+
+template <typename T>
+double EigenMatrixFreeDiagonalizableMatrix<T>::at(uint32_t i, uint32_t j) const {
+    Eigen::Matrix<T, -1, -1> unit_vector = Eigen::Matrix<T, -1, -1>::Zero(size(), 1);
+    unit_vector(j, 0) = 1;
+    Eigen::Matrix<T, -1, -1> column;
+    multiply(unit_vector, column);
+    return column(i, 0);
+}
+
+template <typename T>
+void EigenMatrixFreeDiagonalizableMatrix<T>::print(std::ostream& os) const {
+    os << "Matrix-free matrix of size " << size() << std::endl;
+}
+
+template <typename T>
+void EigenMatrixFreeDiagonalizableMatrix<T>::multiply(
+    const Eigen::Matrix<T, -1, -1>& in,
+    Eigen::Matrix<T, -1, -1>& out) const {
+    if (in.rows() != size()) {
+        throw std::length_error("Size of vectors is not equal to size of matrix-free matrix");
+    }
+    out.resize(in.rows(), in.cols());
+    matrix_free_operator_->apply(in.data(), out.data(), in.cols());
+    if (multiplier_ != 1) {
+        out *= (T)multiplier_;
+    }
+}
+
+template class EigenMatrixFreeDiagonalizableMatrix<double>;
+template class EigenMatrixFreeDiagonalizableMatrix<float>;
+}  // namespace quantum::linear_algebra
@@ -0,0 +1,68 @@
+#ifndef SPINNER_EIGENMATRIXFREEDIAGONALIZABLEMATRIX_H
+#define SPINNER_EIGENMATRIXFREEDIAGONALIZABLEMATRIX_H
+
+#include <Eigen/Core>
+#include <memory>
+
+#include "src/entities/data_structures/AbstractDiagonalizableMatrix.h"
+#include "src/entities/data_structures/AbstractMatrixFreeOperator.h"
+
+namespace quantum::linear_algebra {
+// multiplier * A, where A is not stored, but applied to vectors on the fly.
+// Only Krylov procedures and multiply_by are supported.
+template <typename T>
+class EigenMatrixFreeDiagonalizableMatrix: public AbstractDiagonalizableMatrix {
+  public:
+    explicit EigenMatrixFreeDiagonalizableMatrix(
+        std::shared_ptr<const AbstractMatrixFreeOperator> matrix_free_operator,
+        double multiplier = 1);
+
+    void add_to_position(double value, uint32_t i, uint32_t j) override;
+    EigenCouple diagonalizeValuesVectors() const override;
+    std::unique_ptr<AbstractDenseVector> diagonalizeValues() const override;
+    EigenCouple diagonalizeValuesVectorsInWindow(double energy_window) const override;
+    std::optional<EigenCouple> refineDiagonalizeValuesVectors(
+      const AbstractDenseSemiunitaryMatrix& initial_eigenvectors,
+      double tolerance,
+      size_t max_iterations,
+      std::optional<double> energy_window) const override;
+
+    KrylovCouple krylovDiagonalizeValues(
+      const std::unique_ptr<AbstractDenseVector>& seed_vector,
+      size_t krylov_subspace_size) const override;
+    KrylovTriple krylovDiagonalizeValuesVectors(
+      const std::unique_ptr<AbstractDenseVector>& seed_vector,
+      size_t krylov_subspace_size) const override;
+    std::vector<KrylovCouple> krylovDiagonalizeValues(
+      const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+      size_t krylov_subspace_size,
+      const std::optional<KrylovConvergence>& convergence) const override;
+    std::vector<KrylovTriple> krylovDiagonalizeValuesVectors(
+      const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+      size_t krylov_subspace_size,
+      const std::optional<KrylovConvergence>& convergence) const override;
+    std::vector<KrylovTriple> krylovDiagonalizeValuesVectorsTwoPass(
+      const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+      size_t krylov_subspace_size,
+      const std::optional<KrylovConvergence>& convergence) const override;
+
+    std::unique_ptr<AbstractDiagonalizableMatrix> multiply_by(double multiplier) const override;
+    void add_scaled(double multiplier, const AbstractDiagonalizableMatrix& rhs) override;
+    void add_sparsity_pattern(const AbstractDiagonalizableMatrix& rhs) override;
+    std::vector<double> stored_values_of(const AbstractDiagonalizableMatrix& rhs) const override;
+    void assign_stored_values(const std::vector<double>& values) override;
+    uint32_t size() const override;
+    // it is slow: the whole column is calculated
+    double at(uint32_t i, uint32_t j) const override;
+    void print(std::ostream& os) const override;
+    ~EigenMatrixFreeDiagonalizableMatrix() override = default;
+
+    // out = multiplier * A * in
+    void multiply(const Eigen::Matrix<T, -1, -1>& in, Eigen::Matrix<T, -1, -1>& out) const;
+
+  private:
+    std::shared_ptr<const AbstractMatrixFreeOperator> matrix_free_operator_;
+    double multiplier_;
+};
+}  // namespace quantum::linear_algebra
+#endif  //SPINNER_EIGENMATRIXFREEDIAGONALIZABLEMATRIX_H
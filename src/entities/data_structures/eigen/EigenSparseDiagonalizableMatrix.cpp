@@ -1,5 +1,10 @@
 #include "EigenSparseDiagonalizableMatrix.h"
 
+#include <algorithm>
+#include <stdexcept>
+#include <typeinfo>
+#include <vector>
+
 #include "EigenLogic.h"
 
 namespace quantum::linear_algebra {
@@ -26,6 +31,29 @@ std::unique_ptr<AbstractDenseVector> EigenSparseDiagonalizableMatrix<T>::diagona
     return eigenLogic.diagonalizeValues(*this);
 }
 
+template <typename T>
+EigenCouple EigenSparseDiagonalizableMatrix<T>::diagonalizeValuesVectorsInWindow(double energy_window) const {
+    EigenLogic<T> eigenLogic;
+
+    return eigenLogic.diagonalizeValuesVectorsInWindow(*this, energy_window);
+}
+
+template <typename T>
+std::optional<EigenCouple> EigenSparseDiagonalizableMatrix<T>::refineDiagonalizeValuesVectors(
+    const AbstractDenseSemiunitaryMatrix& initial_eigenvectors,
+    double tolerance,
+    size_t max_iterations,
+    std::optional<double> energy_window) const {
+    EigenLogic<T> eigenLogic;
+
+    return eigenLogic.refineDiagonalizeValuesVectors(
+        *this,
+        initial_eigenvectors,
+        tolerance,
+        max_iterations,
+        energy_window);
+}
+
 template <typename T>
 KrylovCouple EigenSparseDiagonalizableMatrix<T>::krylovDiagonalizeValues(
     const std::unique_ptr<AbstractDenseVector>& seed_vector,
@@ -50,6 +78,33 @@ KrylovTriple EigenSparseDiagonalizableMatrix<T>::krylovDiagonalizeValuesVectors(
         krylov_subspace_size);
 }
 
+template <typename T>
+std::vector<KrylovCouple> EigenSparseDiagonalizableMatrix<T>::krylovDiagonalizeValues(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    EigenLogic<T> logic;
+    return logic.krylovDiagonalizeValues(*this, seed_vectors, krylov_subspace_size, convergence);
+}
+
+template <typename T>
+std::vector<KrylovTriple> EigenSparseDiagonalizableMatrix<T>::krylovDiagonalizeValuesVectors(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    EigenLogic<T> logic;
+    return logic.krylovDiagonalizeValuesVectors(*this, seed_vectors, krylov_subspace_size, convergence);
+}
+
+template <typename T>
+std::vector<KrylovTriple> EigenSparseDiagonalizableMatrix<T>::krylovDiagonalizeValuesVectorsTwoPass(
+    const std::vector<std::unique_ptr<AbstractDenseVector>>& seed_vectors,
+    size_t krylov_subspace_size,
+    const std::optional<KrylovConvergence>& convergence) const {
+    EigenLogic<T> logic;
+    return logic.krylovDiagonalizeValuesVectorsTwoPass(*this, seed_vectors, krylov_subspace_size, convergence);
+}
+
 template <typename T>
 std::unique_ptr<AbstractDiagonalizableMatrix>
 EigenSparseDiagonalizableMatrix<T>::multiply_by(double multiplier) const {
@@ -61,6 +116,78 @@ EigenSparseDiagonalizableMatrix<T>::multiply_by(double multiplier) const {
     return answer;
 }
 
+template <typename T>
+void EigenSparseDiagonalizableMatrix<T>::add_scaled(
+    double multiplier,
+    const AbstractDiagonalizableMatrix& rhs) {
+    auto maybe_rhs = dynamic_cast<const EigenSparseDiagonalizableMatrix*>(&rhs);
+    if (maybe_rhs == nullptr) {
+        throw std::bad_cast();
+    }
+    if (maybe_rhs->size() != size()) {
+        throw std::length_error("Sizes of summed matrices are different");
+    }
+    sparseDiagonalizableMatrix_ += (T)multiplier * maybe_rhs->sparseDiagonalizableMatrix_;
+}
+
+template <typename T>
+void EigenSparseDiagonalizableMatrix<T>::add_sparsity_pattern(const AbstractDiagonalizableMatrix& rhs) {
+    auto maybe_rhs = dynamic_cast<const EigenSparseDiagonalizableMatrix*>(&rhs);
+    if (maybe_rhs == nullptr) {
+        throw std::bad_cast();
+    }
+    if (maybe_rhs->size() != size()) {
+        throw std::length_error("Sizes of matrices are different");
+    }
+    Eigen::SparseMatrix<T> explicit_zeros = maybe_rhs->sparseDiagonalizableMatrix_;
+    explicit_zeros.makeCompressed();
+    explicit_zeros.coeffs().setZero();
+    // the sum of sparse matrices is stored on the union of their stored elements, zeros are not pruned:
+    sparseDiagonalizableMatrix_ = sparseDiagonalizableMatrix_ + explicit_zeros;
+}
+
+template <typename T>
+std::vector<double> EigenSparseDiagonalizableMatrix<T>::stored_values_of(const AbstractDiagonalizableMatrix& rhs) const {
+    auto maybe_rhs = dynamic_cast<const EigenSparseDiagonalizableMatrix*>(&rhs);
+    if (maybe_rhs == nullptr) {
+        throw std::bad_cast();
+    }
+    if (maybe_rhs->size() != size()) {
+        throw std::length_error("Sizes of matrices are different");
+    }
+    const auto& rhs_matrix = maybe_rhs->sparseDiagonalizableMatrix_;
+    std::vector<double> answer;
+    answer.reserve(sparseDiagonalizableMatrix_.nonZeros());
+    // both inner iterators go in increasing order of inner indices:
+    for (Eigen::Index k = 0; k < sparseDiagonalizableMatrix_.outerSize(); ++k) {
+        typename Eigen::SparseMatrix<T>::InnerIterator rhs_it(rhs_matrix, k);
+        for (typename Eigen::SparseMatrix<T>::InnerIterator it(sparseDiagonalizableMatrix_, k); it; ++it) {
+            if (rhs_it && rhs_it.index() < it.index()) {
+                break;
+            }
+            if (rhs_it && rhs_it.index() == it.index()) {
+                answer.push_back(rhs_it.value());
+                ++rhs_it;
+            } else {
+                answer.push_back(0);
+            }
+        }
+        if (rhs_it) {
+            throw std::invalid_argument("Stored elements of matrix are not in the sparsity pattern");
+        }
+    }
+    return answer;
+}
+
+template <typename T>
+void EigenSparseDiagonalizableMatrix<T>::assign_stored_values(const std::vector<double>& values) {
+    sparseDiagonalizableMatrix_.makeCompressed();
+    if (values.size() != (size_t)sparseDiagonalizableMatrix_.nonZeros()) {
+        throw std::length_error("Number of values is not equal to number of stored elements");
+    }
+    std::copy(values.cbegin(), values.cend(), sparseDiagonalizableMatrix_.valuePtr());
+}
+
 template <typename T>
 uint32_t EigenSparseDiagonalizableMatrix<T>::size() const {
     return sparseDiagonalizableMatrix_.innerSize();
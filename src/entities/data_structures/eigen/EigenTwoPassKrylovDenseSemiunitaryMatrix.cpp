@@ -0,0 +1,165 @@
+#include "EigenTwoPassKrylovDenseSemiunitaryMatrix.h"
+
+#include <optional>
+#include <stdexcept>
+#include <typeinfo>
+#include <vector>
+
+#include "EigenDenseDiagonalizableMatrix.h"
+#include "EigenKrylovProcedure.h"
+#include "EigenMatrixFreeDiagonalizableMatrix.h"
+#include "EigenSparseDiagonalizableMatrix.h"
+#include "EigenTwoPassKrylovDenseSemiunitaryTransformer.h"
+
+namespace {
+// Krylov vectors are regenerated by the same Lanczos procedure (and the same block product) as in the first pass,
+// so they are the same vectors, whose Krylov matrix was diagonalized:
+template <typename T, typename M>
+Eigen::Matrix<T, -1, -1> projectOnKrylovVectorsOfSeed_(
+    const M& matrix,
+    const Eigen::Vector<T, -1>& seed_vector,
+    Eigen::Index krylov_subspace_size,
+    const Eigen::Matrix<T, -1, -1>& projections) {
+    Eigen::Matrix<T, -1, -1> answer = Eigen::Matrix<T, -1, -1>::Zero(krylov_subspace_size, projections.cols());
+    Eigen::Matrix<T, -1, -1> seed_vectors = seed_vector;
+    quantum::linear_algebra::eigen_lanczos::krylovProcedureOfSeeds<T>(
+        matrix,
+        seed_vectors,
+        krylov_subspace_size,
+        std::nullopt,
+        [&answer, &projections](
+            size_t k,
+            const std::vector<Eigen::Index>& active_seeds,
+            const Eigen::Matrix<T, -1, -1>& current_vectors) {
+            answer.row(k).noalias() = current_vectors.col(0).transpose() * projections;
+        });
+    return answer;
+}
+}  // namespace
+
+namespace quantum::linear_algebra {
+
+template <typename T>
+EigenTwoPassKrylovDenseSemiunitaryMatrix<T>::EigenTwoPassKrylovDenseSemiunitaryMatrix(
+    std::shared_ptr<const AbstractDiagonalizableMatrix> hamiltonian) :
+    hamiltonian_(std::move(hamiltonian)) {
+    transformer_ = std::make_unique<EigenTwoPassKrylovDenseSemiunitaryTransformer<T>>(this);
+}
+
+template <typename T>
+const std::unique_ptr<AbstractDenseSemiunitaryTransformer>& EigenTwoPassKrylovDenseSemiunitaryMatrix<T>::getUnitaryTransformer() const {
+    return transformer_;
+}
+
+template <typename T>
+uint32_t EigenTwoPassKrylovDenseSemiunitaryMatrix<T>::size_rows() const {
+    return seed_vector_.size();
+}
+
+template <typename T>
+uint32_t EigenTwoPassKrylovDenseSemiunitaryMatrix<T>::size_cols() const {
+    return ritzDenseSemiunitaryMatrix_.cols();
+}
+
+template <typename T>
+double EigenTwoPassKrylovDenseSemiunitaryMatrix<T>::at(uint32_t i, uint32_t j) const {
+    Eigen::Matrix<T, -1, -1> unit_vector = Eigen::Matrix<T, -1, -1>::Zero(size_rows(), 1);
+    unit_vector(j, 0) = 1;
+    return ritzDenseSemiunitaryMatrix_.col(i).dot(projectOnKrylovVectors(unit_vector).col(0));
+}
+
+template <typename T>
+void EigenTwoPassKrylovDenseSemiunitaryMatrix<T>::print(std::ostream& os) const {
+    os << "KrylovDiagonal:\n" << krylov_diagonal_ << std::endl;
+    os << "KrylovSubdiagonal:\n" << krylov_subdiagonal_ << std::endl;
+    os << "RitzDenseSemiunitaryMatrix:\n" << ritzDenseSemiunitaryMatrix_ << std::endl;
+}
+
+template <typename T>
+Eigen::Matrix<T, -1, -1> EigenTwoPassKrylovDenseSemiunitaryMatrix<T>::projectOnKrylovVectors(
+    const Eigen::Matrix<T, -1, -1>& projections) const {
+    Eigen::Index krylov_subspace_size = krylov_diagonal_.size();
+    if (auto maybeDenseSymmetricMatrix =
+        dynamic_cast<const EigenDenseDiagonalizableMatrix<T>*>(hamiltonian_.get())) {
+        return projectOnKrylovVectorsOfSeed_(
+            maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix(),
+            seed_vector_,
+            krylov_subspace_size,
+            projections);
+    } else if (auto maybeSparseSymmetricMatrix =
+        dynamic_cast<const EigenSparseDiagonalizableMatrix<T>*>(hamiltonian_.get())) {
+        return projectOnKrylovVectorsOfSeed_(
+            maybeSparseSymmetricMatrix->getSparseDiagonalizableMatrix(),
+            seed_vector_,
+            krylov_subspace_size,
+            projections);
+    } else if (auto maybeMatrixFreeMatrix =
+        dynamic_cast<const EigenMatrixFreeDiagonalizableMatrix<T>*>(hamiltonian_.get())) {
+        return projectOnKrylovVectorsOfSeed_(
+            *maybeMatrixFreeMatrix,
+            seed_vector_,
+            krylov_subspace_size,
+            projections);
+    } else {
+        throw std::bad_cast();
+    }
+}
+
+template <typename T>
+const std::shared_ptr<const AbstractDiagonalizableMatrix>& EigenTwoPassKrylovDenseSemiunitaryMatrix<T>::getHamiltonian() const {
+    return hamiltonian_;
+}
+
+template <typename T>
+const Eigen::Vector<T, -1>& EigenTwoPassKrylovDenseSemiunitaryMatrix<T>::getKrylovDiagonal() const {
+    return krylov_diagonal_;
+}
+
+template <typename T>
+Eigen::Vector<T, -1>& EigenTwoPassKrylovDenseSemiunitaryMatrix<T>::modifyKrylovDiagonal() {
+    return krylov_diagonal_;
+}
+
+template <typename T>
+const Eigen::Vector<T, -1>& EigenTwoPassKrylovDenseSemiunitaryMatrix<T>::getKrylovSubdiagonal() const {
+    return krylov_subdiagonal_;
+}
+
+template <typename T>
+Eigen::Vector<T, -1>& EigenTwoPassKrylovDenseSemiunitaryMatrix<T>::modifyKrylovSubdiagonal() {
+    return krylov_subdiagonal_;
+}
+
+template <typename T>
+const Eigen::Matrix<T, -1, -1>& EigenTwoPassKrylovDenseSemiunitaryMatrix<T>::getRitzDenseSemiunitaryMatrix() const {
+    return ritzDenseSemiunitaryMatrix_;
+}
+
+template <typename T>
+Eigen::Matrix<T, -1, -1>& EigenTwoPassKrylovDenseSemiunitaryMatrix<T>::modifyRitzDenseSemiunitaryMatrix() {
+    return ritzDenseSemiunitaryMatrix_;
+}
+
+template <typename T>
+const Eigen::Vector<T, -1>& EigenTwoPassKrylovDenseSemiunitaryMatrix<T>::getBackProjectionVector() const {
+    return backProjectionVector_;
+}
+
+template <typename T>
+Eigen::Vector<T, -1>& EigenTwoPassKrylovDenseSemiunitaryMatrix<T>::modifyBackProjectionVector() {
+    return backProjectionVector_;
+}
+
+template <typename T>
+const Eigen::Vector<T, -1>& EigenTwoPassKrylovDenseSemiunitaryMatrix<T>::getSeedVector() const {
+    return seed_vector_;
+}
+
+template <typename T>
+Eigen::Vector<T, -1>& EigenTwoPassKrylovDenseSemiunitaryMatrix<T>::modifySeedVector() {
+    return seed_vector_;
+}
+
+template class EigenTwoPassKrylovDenseSemiunitaryMatrix<double>;
+template class EigenTwoPassKrylovDenseSemiunitaryMatrix<float>;
+}  // namespace quantum::linear_algebra
@@ -0,0 +1,59 @@
+#ifndef SPINNER_EIGENTWOPASSKRYLOVDENSESEMIUNITARYMATRIX_H
+#define SPINNER_EIGENTWOPASSKRYLOVDENSESEMIUNITARYMATRIX_H
+
+#include <Eigen/Core>
+#include <memory>
+
+#include "src/entities/data_structures/AbstractDenseSemiunitaryMatrix.h"
+#include "src/entities/data_structures/AbstractDenseSemiunitaryTransformer.h"
+#include "src/entities/data_structures/AbstractDiagonalizableMatrix.h"
+
+namespace quantum::linear_algebra {
+// Eigenvectors of two-pass Lanczos procedure: Krylov vectors are not stored,
+// but regenerated from the seed vector by the same Lanczos procedure as in the first pass
+// in every unitary transformation, so only O(size) memory is used per seed.
+template <typename T>
+class EigenTwoPassKrylovDenseSemiunitaryMatrix: public AbstractDenseSemiunitaryMatrix {
+  public:
+    explicit EigenTwoPassKrylovDenseSemiunitaryMatrix(
+        std::shared_ptr<const AbstractDiagonalizableMatrix> hamiltonian);
+
+    uint32_t size_rows() const override;
+    uint32_t size_cols() const override;
+    // it is slow: Krylov vectors are regenerated
+    double at(uint32_t i, uint32_t j) const override;
+
+    void print(std::ostream& os) const override;
+
+    const std::shared_ptr<const AbstractDiagonalizableMatrix>& getHamiltonian() const;
+    // diagonal and subdiagonal of the Krylov matrix:
+    const Eigen::Vector<T, -1>& getKrylovDiagonal() const;
+    Eigen::Vector<T, -1>& modifyKrylovDiagonal();
+    const Eigen::Vector<T, -1>& getKrylovSubdiagonal() const;
+    Eigen::Vector<T, -1>& modifyKrylovSubdiagonal();
+    // eigenvectors of the Krylov matrix:
+    const Eigen::Matrix<T, -1, -1>& getRitzDenseSemiunitaryMatrix() const;
+    Eigen::Matrix<T, -1, -1>& modifyRitzDenseSemiunitaryMatrix();
+    const Eigen::Vector<T, -1>& getBackProjectionVector() const;
+    Eigen::Vector<T, -1>& modifyBackProjectionVector();
+    const Eigen::Vector<T, -1>& getSeedVector() const;
+    Eigen::Vector<T, -1>& modifySeedVector();
+
+    // Krylov vectors are regenerated once, every column of projections is multiplied by them:
+    // answer(k, j) = <v_k|projections(:, j)>, so all columns should be passed in one call
+    Eigen::Matrix<T, -1, -1> projectOnKrylovVectors(const Eigen::Matrix<T, -1, -1>& projections) const;
+
+    const std::unique_ptr<AbstractDenseSemiunitaryTransformer>& getUnitaryTransformer() const override;
+
+  private:
+    std::shared_ptr<const AbstractDiagonalizableMatrix> hamiltonian_;
+    Eigen::Vector<T, -1> krylov_diagonal_;
+    Eigen::Vector<T, -1> krylov_subdiagonal_;
+    Eigen::Matrix<T, -1, -1> ritzDenseSemiunitaryMatrix_;
+    Eigen::Vector<T, -1> backProjectionVector_;
+    Eigen::Vector<T, -1> seed_vector_;
+
+    std::unique_ptr<AbstractDenseSemiunitaryTransformer> transformer_;
+};
+}  // namespace quantum::linear_algebra
+#endif  //SPINNER_EIGENTWOPASSKRYLOVDENSESEMIUNITARYMATRIX_H
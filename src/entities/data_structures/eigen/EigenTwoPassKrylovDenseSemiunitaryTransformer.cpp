@@ -0,0 +1,64 @@
+#include "EigenTwoPassKrylovDenseSemiunitaryTransformer.h"
+#include "EigenDenseDiagonalizableMatrix.h"
+#include "EigenSparseDiagonalizableMatrix.h"
+#include "EigenDenseVector.h"
+
+namespace quantum::linear_algebra {
+
+template <typename T>
+inline void multiplySeedVector_(
+    const AbstractDiagonalizableMatrix& matrix,
+    const Eigen::Vector<T, -1>& seed_vector,
+    Eigen::Ref<Eigen::Vector<T, -1>> out) {
+    if (auto maybeSparseSymmetricMatrix =
+        dynamic_cast<const EigenSparseDiagonalizableMatrix<T>*>(&matrix)) {
+        out.noalias() = maybeSparseSymmetricMatrix->getSparseDiagonalizableMatrix() * seed_vector;
+        return;
+    }
+    if (auto maybeDenseSymmetricMatrix =
+        dynamic_cast<const EigenDenseDiagonalizableMatrix<T>*>(&matrix)) {
+        out.noalias() = maybeDenseSymmetricMatrix->getDenseDiagonalizableMatrix() * seed_vector;
+        return;
+    }
+    throw std::bad_cast();
+}
+
+template <typename T>
+EigenTwoPassKrylovDenseSemiunitaryTransformer<T>::EigenTwoPassKrylovDenseSemiunitaryTransformer(const EigenTwoPassKrylovDenseSemiunitaryMatrix<T>* unitary_matrix) 
+: unitary_matrix_(unitary_matrix){};
+
+template <typename T>
+std::unique_ptr<AbstractDenseVector> EigenTwoPassKrylovDenseSemiunitaryTransformer<T>::calculateUnitaryTransformationOfMatrix(
+    std::reference_wrapper<const std::unique_ptr<AbstractDiagonalizableMatrix>> matrix) const {
+    return std::move(calculateUnitaryTransformationOfMatrices({matrix})[0]);
+}
+
+template <typename T>
+std::vector<std::unique_ptr<AbstractDenseVector>> EigenTwoPassKrylovDenseSemiunitaryTransformer<T>::calculateUnitaryTransformationOfMatrices(
+    const std::vector<std::reference_wrapper<const std::unique_ptr<AbstractDiagonalizableMatrix>>>& matrices) const {
+    const auto& seed_vector = unitary_matrix_->getSeedVector();
+    // A|r> of all matrices are projected on Krylov vectors in one pass:
+    Eigen::Matrix<T, -1, -1> firstMultiplicationResults(seed_vector.size(), matrices.size());
+    for (size_t j = 0; j < matrices.size(); ++j) {
+        multiplySeedVector_<T>(*matrices[j].get(), seed_vector, firstMultiplicationResults.col(j));
+    }
+    Eigen::Matrix<T, -1, -1> main_diagonals =
+        unitary_matrix_->getRitzDenseSemiunitaryMatrix().transpose()
+        * unitary_matrix_->projectOnKrylovVectors(firstMultiplicationResults);
+
+    std::vector<std::unique_ptr<AbstractDenseVector>> answer;
+    answer.reserve(matrices.size());
+    for (size_t j = 0; j < matrices.size(); ++j) {
+        auto main_diagonal = std::make_unique<EigenDenseVector<T>>();
+        // instead of <n|A|r><r|n>, here we are using <n|A|r>/<r|n>,
+        // putting |<r|n>|^2 in the weight of state
+        main_diagonal->modifyDenseVector() =
+            main_diagonals.col(j).array() / unitary_matrix_->getBackProjectionVector().array();
+        answer.push_back(std::move(main_diagonal));
+    }
+    return answer;
+}
+
+template class EigenTwoPassKrylovDenseSemiunitaryTransformer<double>;
+template class EigenTwoPassKrylovDenseSemiunitaryTransformer<float>;
+} // namespace quantum::linear_algebra
@@ -0,0 +1,84 @@
+#include "EmhashLocalSparseSymmetricMatrix.h"
+
+#include <algorithm>
+#include <ostream>
+
+namespace quantum::linear_algebra {
+
+EmhashLocalSparseSymmetricMatrix::EmhashLocalSparseSymmetricMatrix(
+    std::vector<uint32_t> lexicographic_indexes) :
+    lexicographic_indexes_(std::move(lexicographic_indexes)) {
+    std::sort(lexicographic_indexes_.begin(), lexicographic_indexes_.end());
+    lexicographic_indexes_.erase(
+        std::unique(lexicographic_indexes_.begin(), lexicographic_indexes_.end()),
+        lexicographic_indexes_.end());
+    local_indexes_.reserve(lexicographic_indexes_.size());
+    for (uint32_t local_index = 0; local_index < lexicographic_indexes_.size(); ++local_index) {
+        local_indexes_.emplace(lexicographic_indexes_[local_index], local_index);
+    }
+    rows_.resize(lexicographic_indexes_.size());
+}
+
+void EmhashLocalSparseSymmetricMatrix::add_to_position(double value, uint32_t i, uint32_t j) {
+    auto mb_local_i = to_local_index(i);
+    auto mb_local_j = to_local_index(j);
+    // such elements do not contribute to the block:
+    if (!mb_local_i.has_value() || !mb_local_j.has_value()) {
+        return;
+    }
+    uint32_t local_i = mb_local_i.value();
+    uint32_t local_j = mb_local_j.value();
+    rows_[local_i][local_j] += value;
+    if (local_i != local_j) {
+        rows_[local_j][local_i] += value;
+    }
+}
+
+uint32_t EmhashLocalSparseSymmetricMatrix::size() const {
+    return lexicographic_indexes_.size();
+}
+
+double EmhashLocalSparseSymmetricMatrix::at(uint32_t i, uint32_t j) const noexcept {
+    auto mb_local_i = to_local_index(i);
+    auto mb_local_j = to_local_index(j);
+    if (!mb_local_i.has_value() || !mb_local_j.has_value()) {
+        return 0;
+    }
+    const auto& row = rows_[mb_local_i.value()];
+    auto it = row.find(mb_local_j.value());
+    if (it == row.end()) {
+        return 0;
+    }
+    return it->second;
+}
+
+void EmhashLocalSparseSymmetricMatrix::print(std::ostream& os) const {
+    for (uint32_t local_i = 0; local_i < rows_.size(); ++local_i) {
+        auto i = lexicographic_indexes_[local_i];
+        for (const auto& pp : rows_[local_i]) {
+            auto j = lexicographic_indexes_[pp.first];
+            auto value = pp.second;
+            os << "(" << i << ", " << j << ") :" << value << std::endl;
+        }
+    }
+}
+
+std::optional<uint32_t>
+EmhashLocalSparseSymmetricMatrix::to_local_index(uint32_t lexicographic_index) const noexcept {
+    auto it = local_indexes_.find(lexicographic_index);
+    if (it == local_indexes_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+const std::vector<uint32_t>& EmhashLocalSparseSymmetricMatrix::getLexicographicIndexes() const {
+    return lexicographic_indexes_;
+}
+
+const std::vector<EmhashLocalSparseSymmetricMatrix::Map>&
+EmhashLocalSparseSymmetricMatrix::getLocalSparseSymmetricMatrix() const {
+    return rows_;
+}
+
+}  // namespace quantum::linear_algebra
@@ -0,0 +1,38 @@
+#ifndef SPINNER_EMHASHLOCALSPARSESYMMETRICMATRIX_H
+#define SPINNER_EMHASHLOCALSPARSESYMMETRICMATRIX_H
+
+#include <optional>
+#include <vector>
+
+#include "hash_table8.hpp"
+#include "src/entities/data_structures/AbstractSymmetricMatrix.h"
+
+namespace quantum::linear_algebra {
+
+// EmhashLocalSparseSymmetricMatrix stores only rows and columns of the given lexicographic vectors,
+// which are renumbered to compact local indexes. add_to_position accepts lexicographic indexes
+// and silently skips elements with (at least one) index outside of the given vectors.
+class EmhashLocalSparseSymmetricMatrix: public AbstractSymmetricMatrix {
+  public:
+    using Map = emhash8::HashMap<uint32_t, double>;
+
+    explicit EmhashLocalSparseSymmetricMatrix(std::vector<uint32_t> lexicographic_indexes);
+
+    void add_to_position(double value, uint32_t i, uint32_t j) override;
+    uint32_t size() const override;
+    double at(uint32_t i, uint32_t j) const noexcept override;
+    void print(std::ostream& os) const override;
+    ~EmhashLocalSparseSymmetricMatrix() override = default;
+
+    std::optional<uint32_t> to_local_index(uint32_t lexicographic_index) const noexcept;
+    const std::vector<uint32_t>& getLexicographicIndexes() const;
+    // rows and columns of this matrix are local indexes
+    const std::vector<Map>& getLocalSparseSymmetricMatrix() const;
+
+  private:
+    std::vector<uint32_t> lexicographic_indexes_;
+    emhash8::HashMap<uint32_t, uint32_t> local_indexes_;
+    std::vector<Map> rows_;
+};
+}  // namespace quantum::linear_algebra
+#endif  //SPINNER_EMHASHLOCALSPARSESYMMETRICMATRIX_H
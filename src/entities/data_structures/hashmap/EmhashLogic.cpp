@@ -1,6 +1,8 @@
 #include "EmhashLogic.h"
 
 #include <hash_table8.hpp>
+#include <stdexcept>
+#include <vector>
 
 namespace quantum::linear_algebra {
 void EmhashLogic::unitaryTransform(
@@ -12,15 +14,29 @@ void EmhashLogic::unitaryTransform(
     if (maybeSemiunitaryMatrix == nullptr) {
         throw std::bad_cast();
     }
-    const auto& semiunitaryMatrixData = maybeSemiunitaryMatrix->getSparseSemiunitaryMatrix();
-    size_t matrix_in_space_basis_size = maybeSemiunitaryMatrix->size_cols();
+
+    auto maybeLocalSymmetricMatrix =
+        dynamic_cast<const EmhashLocalSparseSymmetricMatrix*>(symmetricMatrixToTransform.get());
+    if (maybeLocalSymmetricMatrix != nullptr) {
+        unitaryTransform(*maybeLocalSymmetricMatrix, symmetricMatrixToAdd, *maybeSemiunitaryMatrix);
+        return;
+    }
 
     auto maybeSymmetricMatrix =
         dynamic_cast<const EmhashSparseSymmetricMatrix*>(symmetricMatrixToTransform.get());
     if (maybeSymmetricMatrix == nullptr) {
         throw std::bad_cast();
     }
-    const auto& symmetricMatrixData = maybeSymmetricMatrix->getSparseSymmetricMatrix();
+    unitaryTransform(*maybeSymmetricMatrix, symmetricMatrixToAdd, *maybeSemiunitaryMatrix);
+}
+
+void EmhashLogic::unitaryTransform(
+    const EmhashSparseSymmetricMatrix& symmetricMatrixToTransform,
+    std::unique_ptr<AbstractDiagonalizableMatrix>& symmetricMatrixToAdd,
+    const EmhashSparseSemiunitaryMatrix& unitaryMatrix) const {
+    const auto& semiunitaryMatrixData = unitaryMatrix.getSparseSemiunitaryMatrix();
+    size_t matrix_in_space_basis_size = unitaryMatrix.size_cols();
+    const auto& symmetricMatrixData = symmetricMatrixToTransform.getSparseSymmetricMatrix();
 
     emhash8::HashMap<uint32_t, EmhashSparseSemiunitaryMatrix::Map> first_mult;
 
@@ -74,4 +90,105 @@ void EmhashLogic::unitaryTransform(
         }
     }
 }
+
+void EmhashLogic::unitaryTransform(
+    const EmhashLocalSparseSymmetricMatrix& symmetricMatrixToTransform,
+    std::unique_ptr<AbstractDiagonalizableMatrix>& symmetricMatrixToAdd,
+    const EmhashSparseSemiunitaryMatrix& unitaryMatrix) const {
+    const auto& semiunitaryMatrixData = unitaryMatrix.getSparseSemiunitaryMatrix();
+    uint32_t matrix_in_space_basis_size = unitaryMatrix.size_cols();
+    const auto& localMatrixData = symmetricMatrixToTransform.getLocalSparseSymmetricMatrix();
+    uint32_t local_size = symmetricMatrixToTransform.size();
+
+    // U_{kj} in local indexes, grouped by k:
+    std::vector<std::vector<std::pair<uint32_t, double>>> transposed_unitary_matrix(local_size);
+    for (uint32_t index_of_space_vector_j = 0; index_of_space_vector_j < matrix_in_space_basis_size;
+         ++index_of_space_vector_j) {
+        for (const auto& j_iter : semiunitaryMatrixData[index_of_space_vector_j]) {
+            auto mb_local_index = symmetricMatrixToTransform.to_local_index(j_iter.first);
+            if (!mb_local_index.has_value()) {
+                throw std::invalid_argument(
+                    "Lexicographic vector of the block is absent in the local symmetric matrix");
+            }
+            transposed_unitary_matrix[mb_local_index.value()].emplace_back(
+                index_of_space_vector_j,
+                j_iter.second);
+        }
+    }
+
+    // rows of the result are independent, so they can be calculated in parallel:
+    std::vector<std::vector<std::pair<uint32_t, double>>> lower_triangle(matrix_in_space_basis_size);
+#pragma omp parallel shared( \
+        matrix_in_space_basis_size, \
+            local_size, \
+            localMatrixData, \
+            semiunitaryMatrixData, \
+            symmetricMatrixToTransform, \
+            transposed_unitary_matrix, \
+            lower_triangle) default(none)
+    {
+        // dense accumulators with lists of touched positions, one per thread:
+        std::vector<double> first_mult(local_size, 0);
+        std::vector<bool> first_mult_is_touched(local_size, false);
+        std::vector<uint32_t> first_mult_touched;
+        std::vector<double> final_mult(matrix_in_space_basis_size, 0);
+        std::vector<bool> final_mult_is_touched(matrix_in_space_basis_size, false);
+        std::vector<uint32_t> final_mult_touched;
+
+#pragma omp for schedule(dynamic)
+        for (uint32_t index_of_space_vector_i = 0;
+             index_of_space_vector_i < matrix_in_space_basis_size;
+             ++index_of_space_vector_i) {
+            for (const auto& i_iter : semiunitaryMatrixData[index_of_space_vector_i]) {
+                uint32_t local_index_k =
+                    symmetricMatrixToTransform.to_local_index(i_iter.first).value();
+                double coefficient_in_unitary_matrix = i_iter.second;
+                for (const auto& k_iter : localMatrixData[local_index_k]) {
+                    uint32_t local_index_l = k_iter.first;
+                    // \Delta X_{il} = \sum_{k} U_{ki} * \Delta A_{kl}
+                    first_mult[local_index_l] += k_iter.second * coefficient_in_unitary_matrix;
+                    if (!first_mult_is_touched[local_index_l]) {
+                        first_mult_is_touched[local_index_l] = true;
+                        first_mult_touched.push_back(local_index_l);
+                    }
+                }
+            }
+            for (uint32_t local_index_l : first_mult_touched) {
+                double value_in_matrix_of_first_mult = first_mult[local_index_l];
+                for (const auto& [index_of_space_vector_j, coefficient_in_unitary_matrix] :
+                     transposed_unitary_matrix[local_index_l]) {
+                    if (index_of_space_vector_i >= index_of_space_vector_j) {
+                        // \Delta B_{ij} = \sum_{l} \Delta X_{il} * U_{lj}
+                        final_mult[index_of_space_vector_j] +=
+                            value_in_matrix_of_first_mult * coefficient_in_unitary_matrix;
+                        if (!final_mult_is_touched[index_of_space_vector_j]) {
+                            final_mult_is_touched[index_of_space_vector_j] = true;
+                            final_mult_touched.push_back(index_of_space_vector_j);
+                        }
+                    }
+                }
+                first_mult[local_index_l] = 0;
+                first_mult_is_touched[local_index_l] = false;
+            }
+            first_mult_touched.clear();
+
+            auto& row = lower_triangle[index_of_space_vector_i];
+            row.reserve(final_mult_touched.size());
+            for (uint32_t index_of_space_vector_j : final_mult_touched) {
+                row.emplace_back(index_of_space_vector_j, final_mult[index_of_space_vector_j]);
+                final_mult[index_of_space_vector_j] = 0;
+                final_mult_is_touched[index_of_space_vector_j] = false;
+            }
+            final_mult_touched.clear();
+        }
+    }
+
+    // add_to_position of sparse matrices is not thread-safe:
+    for (uint32_t index_of_space_vector_i = 0; index_of_space_vector_i < matrix_in_space_basis_size;
+         ++index_of_space_vector_i) {
+        for (const auto& [index_of_space_vector_j, value] : lower_triangle[index_of_space_vector_i]) {
+            symmetricMatrixToAdd->add_to_position(value, index_of_space_vector_i, index_of_space_vector_j);
+        }
+    }
+}
 }  // namespace quantum::linear_algebra
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef SPINNER_EMHASHLOGIC_H
 #define SPINNER_EMHASHLOGIC_H
 
+#include "EmhashLocalSparseSymmetricMatrix.h"
 #include "EmhashSparseSemiunitaryMatrix.h"
 #include "EmhashSparseSymmetricMatrix.h"
 
@@ -12,6 +13,16 @@ class EmhashLogic {
         const std::unique_ptr<AbstractSymmetricMatrix>& symmetricMatrixToTransform,
         std::unique_ptr<AbstractDiagonalizableMatrix>& symmetricMatrixToAdd,
         const AbstractSparseSemiunitaryMatrix& unitaryMatrix) const;
+
+  private:
+    void unitaryTransform(
+        const EmhashSparseSymmetricMatrix& symmetricMatrixToTransform,
+        std::unique_ptr<AbstractDiagonalizableMatrix>& symmetricMatrixToAdd,
+        const EmhashSparseSemiunitaryMatrix& unitaryMatrix) const;
+    void unitaryTransform(
+        const EmhashLocalSparseSymmetricMatrix& symmetricMatrixToTransform,
+        std::unique_ptr<AbstractDiagonalizableMatrix>& symmetricMatrixToAdd,
+        const EmhashSparseSemiunitaryMatrix& unitaryMatrix) const;
 };
 
 }  // namespace quantum::linear_algebra
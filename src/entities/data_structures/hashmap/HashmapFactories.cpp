@@ -1,5 +1,6 @@
 #include "HashmapFactories.h"
 
+#include "EmhashLocalSparseSymmetricMatrix.h"
 #include "EmhashSparseSemiunitaryMatrix.h"
 #include "EmhashSparseSymmetricMatrix.h"
 
@@ -17,4 +18,9 @@ EmhashSparseTransformFactory::createSparseSymmetricMatrix(uint32_t size) {
     answer->resize(size);
     return answer;
 }
+
+std::unique_ptr<AbstractSymmetricMatrix>
+EmhashSparseTransformFactory::createLocalSparseSymmetricMatrix(std::vector<uint32_t> indexes_of_vectors) {
+    return std::make_unique<EmhashLocalSparseSymmetricMatrix>(std::move(indexes_of_vectors));
+}
 }  // namespace quantum::linear_algebra
\ No newline at end of file
@@ -9,6 +9,8 @@ class EmhashSparseTransformFactory: public AbstractSparseTransformFactory {
     std::unique_ptr<AbstractSparseSemiunitaryMatrix>
     createSparseSemiunitaryMatrix(uint32_t cols, uint32_t rows) override;
     std::unique_ptr<AbstractSymmetricMatrix> createSparseSymmetricMatrix(uint32_t size) override;
+    std::unique_ptr<AbstractSymmetricMatrix>
+    createLocalSparseSymmetricMatrix(std::vector<uint32_t> indexes_of_vectors) override;
 };
 }  // namespace quantum::linear_algebra
 #endif  //SPINNER_HASHMAPFACTORIES_H
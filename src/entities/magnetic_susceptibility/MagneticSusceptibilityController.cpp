@@ -40,11 +40,10 @@ void MagneticSusceptibilityController::initializeExperimentalValues(
     const std::shared_ptr<ExperimentalValuesWorker>& experimental_values_worker) {
     worker_->setExperimentalValuesWorker(experimental_values_worker);
     std::vector<double> temperatures = worker_->getExperimentalValuesWorker()->getTemperatures();
+    std::vector<common::UncertainValue> mu_squared = worker_->calculateTheoreticalMuSquared(temperatures);
     std::vector<ValueAtTemperature> theoretical_mu_squared_values(temperatures.size());
     for (size_t i = 0; i < temperatures.size(); ++i) {
-        theoretical_mu_squared_values[i] = {
-            temperatures[i],
-            worker_->calculateTheoreticalMuSquared(temperatures[i])};
+        theoretical_mu_squared_values[i] = {temperatures[i], mu_squared[i]};
     }
     worker_->getExperimentalValuesWorker()->setTheoreticalMuSquared(theoretical_mu_squared_values);
 }
@@ -53,6 +52,11 @@ common::UncertainValue MagneticSusceptibilityController::calculateTheoreticalMuS
     return worker_->calculateTheoreticalMuSquared(temperature);
 }
 
+std::vector<common::UncertainValue>
+MagneticSusceptibilityController::calculateTheoreticalMuSquared(const std::vector<double>& temperatures) const {
+    return worker_->calculateTheoreticalMuSquared(temperatures);
+}
+
 common::UncertainValue MagneticSusceptibilityController::calculateTotalDerivative(
     model::symbols::SymbolTypeEnum symbol_type,
     model::symbols::SymbolName symbol_name) const {
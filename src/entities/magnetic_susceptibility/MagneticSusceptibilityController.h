@@ -18,6 +18,8 @@ class MagneticSusceptibilityController {
         const std::shared_ptr<ExperimentalValuesWorker>& experimental_values_worker);
     std::vector<ValueAtTemperature> getTheoreticalValues() const;
     common::UncertainValue calculateTheoreticalMuSquared(double temperature) const;
+    std::vector<common::UncertainValue>
+    calculateTheoreticalMuSquared(const std::vector<double>& temperatures) const;
     common::UncertainValue calculateResidualError() const;
     // These functions just call suitable virtual function calculateDerivative.
     // Calculates dR^2/dsymbol.
@@ -7,10 +7,21 @@ std::pair<double, double> AbstractEnsembleAverager::calculate_averaged_value_and
     const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>& energy_vector, 
     const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>& weights_vector, 
     const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>& value_vector) const {
-    auto divided_and_wise_exped_energy = energy_vector->multiply_by(-1.0 / temperature);
-    divided_and_wise_exped_energy->wise_exp();
-    double partition_function = divided_and_wise_exped_energy->dot(weights_vector);
-    double value_numerator = value_vector.get()->triple_dot(weights_vector, divided_and_wise_exped_energy);
+    auto [value_numerators, partition_functions] = calculate_averaged_values_and_partition_functions(
+        {temperature},
+        energy_vector,
+        weights_vector,
+        {value_vector});
+    double partition_function = partition_functions[0];
+    double value_numerator = value_numerators[0][0];
     return std::pair{value_numerator, partition_function};   
 }
+
+std::pair<std::vector<std::vector<double>>, std::vector<double>> AbstractEnsembleAverager::calculate_averaged_values_and_partition_functions(
+    const std::vector<double>& temperatures,
+    const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>& energy_vector, 
+    const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>& weights_vector, 
+    const std::vector<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>>& value_vectors) const {
+    return energy_vector->boltzmann_sums(weights_vector, value_vectors, temperatures);
+}
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define SPINNER_ABSTRACTENSEMBLEAVERAGER_H
 
 #include <memory>
+#include <vector>
 
 #include "src/common/OneOrMany.h"
 #include "src/common/UncertainValue.h"
@@ -13,12 +14,23 @@ class AbstractEnsembleAverager {
     virtual common::UncertainValue ensemble_average(
         OneOrMany<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>> value,
         double temperature) const = 0;
+    // Averages of every value at every temperature, answer[value][temperature].
+    // The spectrum is read once for all values and temperatures:
+    virtual std::vector<std::vector<common::UncertainValue>> ensemble_average(
+        const std::vector<OneOrMany<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>>>& values,
+        const std::vector<double>& temperatures) const = 0;
   protected:
       std::pair<double, double> calculate_averaged_value_and_partition_function(
         double temperature,
         const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>& energy_vector, 
         const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>& weights_vector, 
         const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>& value_vector) const;
+      // Returns {numerators[value][temperature], partition_functions[temperature]}:
+      std::pair<std::vector<std::vector<double>>, std::vector<double>> calculate_averaged_values_and_partition_functions(
+        const std::vector<double>& temperatures,
+        const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>& energy_vector, 
+        const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>& weights_vector, 
+        const std::vector<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>>& value_vectors) const;
 };
 }
 
@@ -18,6 +18,31 @@ common::UncertainValue CommonEnsembleAverager::ensemble_average(
     return common::UncertainValue(value_numerator / partition_function);
 }
 
+std::vector<std::vector<common::UncertainValue>> CommonEnsembleAverager::ensemble_average(
+    const std::vector<OneOrMany<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>>>& values,
+    const std::vector<double>& temperatures) const {
+    const auto& energy_vector = getOneRef(flattenedSpectra_->getFlattenSpectrum(common::Energy).value()).get();
+    const auto& weights_vector = getOneRef(flattenedSpectra_->getWeights());
+    std::vector<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>> value_vectors;
+    for (const auto& value : values) {
+        value_vectors.push_back(getOneRef(value));
+    }
+    auto [value_numerators, partition_functions] = calculate_averaged_values_and_partition_functions(
+        temperatures,
+        energy_vector,
+        weights_vector,
+        value_vectors);
+
+    std::vector<std::vector<common::UncertainValue>> averages(values.size());
+    for (size_t k = 0; k < values.size(); ++k) {
+        averages[k].reserve(temperatures.size());
+        for (size_t j = 0; j < temperatures.size(); ++j) {
+            averages[k].emplace_back(value_numerators[k][j] / partition_functions[j]);
+        }
+    }
+    return averages;
+}
+
 std::pair<double, double> CommonEnsembleAverager::ensemble_average_numerator_denominator(
     std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>> value,
     double temperature) const {
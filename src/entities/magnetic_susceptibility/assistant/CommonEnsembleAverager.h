@@ -15,6 +15,9 @@ class CommonEnsembleAverager : public AbstractEnsembleAverager {
     common::UncertainValue ensemble_average(
         OneOrMany<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>> value,
         double temperature) const override;
+    std::vector<std::vector<common::UncertainValue>> ensemble_average(
+        const std::vector<OneOrMany<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>>>& values,
+        const std::vector<double>& temperatures) const override;
     std::pair<double, double> ensemble_average_numerator_denominator(std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>> value,
         double temperature) const;
   private:
@@ -33,6 +33,47 @@ common::UncertainValue FTLMEnsembleAverager::ensemble_average(
     return common::UncertainValue(value, uncertainty, common::UncertaintySources::FTLM);
 }
 
+std::vector<std::vector<common::UncertainValue>> FTLMEnsembleAverager::ensemble_average(
+    const std::vector<OneOrMany<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>>>& values,
+    const std::vector<double>& temperatures) const {
+    auto energy_vectors = flattenedSpectra_->getFlattenSpectrum(common::Energy).value();
+    auto weights_vectors = flattenedSpectra_->getWeights();
+    size_t number_of_seeds = getManyRef(energy_vectors).size();
+
+    // sums over seeds, numerators[value][temperature] and partition_functions[temperature]:
+    std::vector<std::vector<double>> numerators(values.size(), std::vector<double>(temperatures.size(), 0));
+    std::vector<double> partition_functions(temperatures.size(), 0);
+    for (size_t seed = 0; seed < number_of_seeds; ++seed) {
+        std::vector<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>> value_vectors;
+        for (const auto& value : values) {
+            value_vectors.push_back(get_element(value, seed));
+        }
+        auto [seed_numerators, seed_partition_functions] = calculate_averaged_values_and_partition_functions(
+            temperatures,
+            get_element(energy_vectors, seed).get(),
+            get_element(weights_vectors, seed).get(),
+            value_vectors);
+        for (size_t j = 0; j < temperatures.size(); ++j) {
+            partition_functions[j] += seed_partition_functions[j];
+            for (size_t k = 0; k < values.size(); ++k) {
+                numerators[k][j] += seed_numerators[k][j];
+            }
+        }
+    }
+
+    std::vector<std::vector<common::UncertainValue>> averages(values.size());
+    for (size_t k = 0; k < values.size(); ++k) {
+        averages[k].reserve(temperatures.size());
+        for (size_t j = 0; j < temperatures.size(); ++j) {
+            double averaged_partition_function = partition_functions[j] / (double)number_of_seeds;
+            double value = numerators[k][j] / partition_functions[j];
+            double uncertainty = std::abs(value) / std::sqrt(averaged_partition_function * number_of_seeds);
+            averages[k].emplace_back(value, uncertainty, common::UncertaintySources::FTLM);
+        }
+    }
+    return averages;
+}
+
 std::pair<std::vector<double>, std::vector<double>> FTLMEnsembleAverager::ensemble_average_numerator_denominator(
     const OneOrMany<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>>& values,
     double temperature) const {
@@ -16,6 +16,9 @@ class FTLMEnsembleAverager : public AbstractEnsembleAverager {
     common::UncertainValue ensemble_average(
         OneOrMany<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>> values,
         double temperature) const override;
+    std::vector<std::vector<common::UncertainValue>> ensemble_average(
+        const std::vector<OneOrMany<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>>>& values,
+        const std::vector<double>& temperatures) const override;
     std::pair<std::vector<double>, std::vector<double>> ensemble_average_numerator_denominator(
         const OneOrMany<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>>& values,
         double temperature) const;  
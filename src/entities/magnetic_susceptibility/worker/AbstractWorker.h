@@ -12,6 +12,9 @@ class AbstractWorker {
   public:
     // Different cases lead to different approaches of calculating <S2>.
     virtual common::UncertainValue calculateTheoreticalMuSquared(double temperature) const = 0;
+    // The same for all temperatures at once:
+    virtual std::vector<common::UncertainValue>
+    calculateTheoreticalMuSquared(const std::vector<double>& temperatures) const = 0;
     virtual std::shared_ptr<ExperimentalValuesWorker> getExperimentalValuesWorker() = 0;
     virtual std::shared_ptr<const ExperimentalValuesWorker> getExperimentalValuesWorker() const = 0;
     virtual void setExperimentalValuesWorker(
@@ -18,6 +18,15 @@ common::UncertainValue CurieWeissWorker::calculateTheoreticalMuSquared(double te
     return theoreticalMuSquared;
 }
 
+std::vector<common::UncertainValue>
+CurieWeissWorker::calculateTheoreticalMuSquared(const std::vector<double>& temperatures) const {
+    auto theoreticalMuSquared = worker_->calculateTheoreticalMuSquared(temperatures);
+    for (size_t i = 0; i < temperatures.size(); ++i) {
+        theoreticalMuSquared[i] = temperatures[i] * theoreticalMuSquared[i] / (temperatures[i] - *Theta_);
+    }
+    return theoreticalMuSquared;
+}
+
 std::shared_ptr<ExperimentalValuesWorker> CurieWeissWorker::getExperimentalValuesWorker() {
     return worker_->getExperimentalValuesWorker();
 }
@@ -38,8 +47,9 @@ std::vector<ValueAtTemperature> CurieWeissWorker::calculateDerivative(
     if (symbol_type == model::symbols::Theta) {
         std::vector<double> temperatures = getExperimentalValuesWorker()->getTemperatures();
         std::vector<ValueAtTemperature> theoretical_mu_squared_values(temperatures.size());
+        auto mu_squared = worker_->calculateTheoreticalMuSquared(temperatures);
         for (size_t i = 0; i < temperatures.size(); ++i) {
-            auto value = temperatures[i] * worker_->calculateTheoreticalMuSquared(temperatures[i])
+            auto value = temperatures[i] * mu_squared[i]
                 / ((temperatures[i] - *Theta_) * (temperatures[i] - *Theta_));
             theoretical_mu_squared_values[i] = {temperatures[i], value};
         }
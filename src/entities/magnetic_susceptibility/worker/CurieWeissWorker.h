@@ -15,6 +15,8 @@ class CurieWeissWorker: public AbstractWorker {
         std::unique_ptr<AbstractWorker>&& muSquaredWorker,
         std::shared_ptr<const double> Theta);
     common::UncertainValue calculateTheoreticalMuSquared(double temperature) const override;
+    std::vector<common::UncertainValue>
+    calculateTheoreticalMuSquared(const std::vector<double>& temperatures) const override;
 
     std::shared_ptr<ExperimentalValuesWorker> getExperimentalValuesWorker() override;
     std::shared_ptr<const ExperimentalValuesWorker> getExperimentalValuesWorker() const override;
@@ -20,6 +20,16 @@ common::UncertainValue DifferentGWorker::calculateTheoreticalMuSquared(double te
     return quantity_averaged;
 }
 
+std::vector<common::UncertainValue>
+DifferentGWorker::calculateTheoreticalMuSquared(const std::vector<double>& temperatures) const {
+    auto quantity = flattenedSpectra_->getFlattenSpectrum(quantity_enum_for_averaging_).value();
+    auto quantity_averaged = ensemble_averager_->ensemble_average({quantity}, temperatures)[0];
+    for (auto& value : quantity_averaged) {
+        value = quantity_factor_ * value;
+    }
+    return quantity_averaged;
+}
+
 std::vector<ValueAtTemperature> DifferentGWorker::calculateDerivative(
     model::symbols::SymbolTypeEnum symbol_type,
     model::symbols::SymbolName symbol_name) const {
@@ -32,20 +42,22 @@ std::vector<ValueAtTemperature> DifferentGWorker::calculateDerivative(
         // d(mu_squared)/dg = d<A>/dg = <dA/dg>
         auto quantity_derivative = 
             flattenedSpectra_->getFlattenDerivativeSpectrum(quantity_enum_for_averaging_, symbol_name).value();
+        auto quantity_derivative_averaged =
+            ensemble_averager_->ensemble_average({quantity_derivative}, temperatures)[0];
         for (size_t i = 0; i < temperatures.size(); ++i) {
-            auto value =
-                quantity_factor_ * ensemble_averager_->ensemble_average(quantity_derivative, temperatures[i]);
+            auto value = quantity_factor_ * quantity_derivative_averaged[i];
             derivatives[i] = {temperatures[i], value};
         }
     } else {
         // d(mu_squared)/da = d(<A>)/da = (<A>*<dE/da>-<A*dE/da>)/T
         auto energy_derivative =
             flattenedSpectra_->getFlattenDerivativeSpectrum(common::Energy, symbol_name).value();
+        auto quantity_derivative_product = flattenedSpectra_->getFlattenDerivativeProductSpectrum(quantity_enum_for_averaging_, common::Energy, symbol_name).value();
+        auto averaged = ensemble_averager_->ensemble_average(
+            {quantity, energy_derivative, quantity_derivative_product}, temperatures);
         for (size_t i = 0; i < temperatures.size(); ++i) {
-            auto first_term = ensemble_averager_->ensemble_average(quantity, temperatures[i])
-                * ensemble_averager_->ensemble_average(energy_derivative, temperatures[i]);
-            auto quantity_derivative_product = flattenedSpectra_->getFlattenDerivativeProductSpectrum(quantity_enum_for_averaging_, common::Energy, symbol_name).value();
-            auto second_term = ensemble_averager_->ensemble_average(quantity_derivative_product, temperatures[i]);
+            auto first_term = averaged[0][i] * averaged[1][i];
+            auto second_term = averaged[2][i];
             auto value = quantity_factor_ * (first_term - second_term) / temperatures[i];
             derivatives[i] = {temperatures[i], value};
         }
@@ -16,6 +16,8 @@ class DifferentGWorker: public BasicWorker {
       double quantity_factor);
 
     common::UncertainValue calculateTheoreticalMuSquared(double temperature) const override;
+    std::vector<common::UncertainValue>
+    calculateTheoreticalMuSquared(const std::vector<double>& temperatures) const override;
     
     std::vector<ValueAtTemperature> calculateDerivative(
         model::symbols::SymbolTypeEnum symbol_type,
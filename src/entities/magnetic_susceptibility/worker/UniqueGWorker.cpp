@@ -21,6 +21,18 @@ common::UncertainValue UniqueGWorker::calculateTheoreticalMuSquared(double tempe
     return g_unique_getter_() * g_unique_getter_() * quantity_averaged * quantity_factor_;
 }
 
+std::vector<common::UncertainValue>
+UniqueGWorker::calculateTheoreticalMuSquared(const std::vector<double>& temperatures) const {
+    auto quantity = flattenedSpectra_->getFlattenSpectrum(quantity_enum_for_averaging_).value();
+    auto quantity_averaged = ensemble_averager_->ensemble_average({quantity}, temperatures)[0];
+    std::vector<common::UncertainValue> theoretical_mu_squared;
+    theoretical_mu_squared.reserve(temperatures.size());
+    for (const auto& value : quantity_averaged) {
+        theoretical_mu_squared.push_back(g_unique_getter_() * g_unique_getter_() * value * quantity_factor_);
+    }
+    return theoretical_mu_squared;
+}
+
 std::vector<ValueAtTemperature> UniqueGWorker::calculateDerivative(
     model::symbols::SymbolTypeEnum symbol_type,
     model::symbols::SymbolName symbol_name) const {
@@ -29,20 +41,21 @@ std::vector<ValueAtTemperature> UniqueGWorker::calculateDerivative(
     std::vector<ValueAtTemperature> derivatives(temperatures.size());
     if (symbol_type == model::symbols::SymbolTypeEnum::g_factor) {
         // d(mu_squared)/dg = d(g^2*<S^2>)/dg = d(g^2)/dg*<S^2> + g^2*d(<S^2>)/dg = 2g*<S^2>
+        auto quantity_averaged = ensemble_averager_->ensemble_average({quantity}, temperatures)[0];
         for (size_t i = 0; i < temperatures.size(); ++i) {
-            auto quantity_averaged = ensemble_averager_->ensemble_average(quantity, temperatures[i]);
-            auto value = 2 * g_unique_getter_() * quantity_averaged * quantity_factor_;
+            auto value = 2 * g_unique_getter_() * quantity_averaged[i] * quantity_factor_;
             derivatives[i] = {temperatures[i], value};
         }
     } else {
         // d(mu_squared)/da = d(g^2*<S^2>)/da = g^2*d(<S^2>)/da = g^2*(<S^2>*<dE/da>-<S^2*dE/da>)/T
         auto energy_derivative =
             flattenedSpectra_->getFlattenDerivativeSpectrum(common::Energy, symbol_name).value();
+        auto quantity_derivative_product = flattenedSpectra_->getFlattenDerivativeProductSpectrum(quantity_enum_for_averaging_, common::Energy, symbol_name).value();
+        auto averaged = ensemble_averager_->ensemble_average(
+            {quantity, energy_derivative, quantity_derivative_product}, temperatures);
         for (size_t i = 0; i < temperatures.size(); ++i) {
-            auto first_term = ensemble_averager_->ensemble_average(quantity, temperatures[i])
-                * ensemble_averager_->ensemble_average(energy_derivative, temperatures[i]);
-            auto quantity_derivative_product = flattenedSpectra_->getFlattenDerivativeProductSpectrum(quantity_enum_for_averaging_, common::Energy, symbol_name).value();
-            auto second_term = ensemble_averager_->ensemble_average(quantity_derivative_product, temperatures[i]);
+            auto first_term = averaged[0][i] * averaged[1][i];
+            auto second_term = averaged[2][i];
             auto value = g_unique_getter_() * g_unique_getter_() * quantity_factor_ * 
                 (first_term - second_term) / temperatures[i];
             derivatives[i] = {temperatures[i], value};
@@ -18,6 +18,8 @@ class UniqueGWorker: public BasicWorker {
         double quantity_factor);
 
     common::UncertainValue calculateTheoreticalMuSquared(double temperature) const override;
+    std::vector<common::UncertainValue>
+    calculateTheoreticalMuSquared(const std::vector<double>& temperatures) const override;
     std::vector<ValueAtTemperature> calculateDerivative(
         model::symbols::SymbolTypeEnum symbol_type,
         model::symbols::SymbolName symbol_name) const override;
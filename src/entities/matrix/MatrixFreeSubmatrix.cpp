@@ -0,0 +1,210 @@
+#include "MatrixFreeSubmatrix.h"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+
+namespace {
+// Instead of storing A, every added element is immediately multiplied by vectors:
+// y += A * x, where x and y are in the local lexicographic basis.
+// Rows [first_owned_row, last_owned_row) are updated only by this accumulator,
+// other rows can be updated by accumulators of other threads simultaneously.
+template <typename T>
+class AccumulatingSymmetricMatrix_: public quantum::linear_algebra::AbstractSymmetricMatrix {
+  public:
+    AccumulatingSymmetricMatrix_(
+        const emhash8::HashMap<uint32_t, uint32_t>& local_indexes,
+        uint32_t size,
+        uint32_t first_owned_row,
+        uint32_t last_owned_row,
+        const T* x,
+        T* y,
+        uint32_t number_of_vectors) :
+        local_indexes_(local_indexes),
+        size_(size),
+        first_owned_row_(first_owned_row),
+        last_owned_row_(last_owned_row),
+        x_(x),
+        y_(y),
+        number_of_vectors_(number_of_vectors) {}
+
+    void add_to_position(double value, uint32_t i, uint32_t j) override {
+        auto it_i = local_indexes_.find(i);
+        auto it_j = local_indexes_.find(j);
+        if (it_i == local_indexes_.end() || it_j == local_indexes_.end()) {
+            return;
+        }
+        uint32_t local_i = it_i->second;
+        uint32_t local_j = it_j->second;
+        add_to_row(value, local_i, local_j);
+        if (local_i != local_j) {
+            add_to_row(value, local_j, local_i);
+        }
+    }
+
+    uint32_t size() const override {
+        return size_;
+    }
+
+    double at(uint32_t i, uint32_t j) const override {
+        throw std::logic_error("Elements of matrix-free matrix are not stored");
+    }
+
+    void print(std::ostream& os) const override {
+        os << "Matrix-free matrix of size " << size() << std::endl;
+    }
+
+  private:
+    // y_row += value * x_column
+    void add_to_row(double value, uint32_t row, uint32_t column) {
+        T* y_row = y_ + (size_t)row * number_of_vectors_;
+        const T* x_column = x_ + (size_t)column * number_of_vectors_;
+        if (row >= first_owned_row_ && row < last_owned_row_) {
+            for (uint32_t vector = 0; vector < number_of_vectors_; ++vector) {
+                y_row[vector] += (T)value * x_column[vector];
+            }
+        } else {
+            for (uint32_t vector = 0; vector < number_of_vectors_; ++vector) {
+#pragma omp atomic
+                y_row[vector] += (T)value * x_column[vector];
+            }
+        }
+    }
+
+    const emhash8::HashMap<uint32_t, uint32_t>& local_indexes_;
+    uint32_t size_;
+    uint32_t first_owned_row_;
+    uint32_t last_owned_row_;
+    const T* x_;
+    T* y_;
+    uint32_t number_of_vectors_;
+};
+}  // namespace
+
+MatrixFreeSubmatrix::MatrixFreeSubmatrix(
+    const space::Subspace& subspace,
+    std::shared_ptr<const model::operators::Operator> new_operator) :
+    operator_(std::move(new_operator)) {
+    size_ = subspace.decomposition->size_cols();
+
+    for (uint32_t index_of_space_vector_i = 0; index_of_space_vector_i < size_;
+         ++index_of_space_vector_i) {
+        auto outer_iterator = subspace.decomposition->GetNewIterator(index_of_space_vector_i);
+        while (outer_iterator->hasNext()) {
+            auto outer_item = outer_iterator->getNext();
+            lexicografical_vectors_.push_back(outer_item.index);
+        }
+    }
+    std::sort(lexicografical_vectors_.begin(), lexicografical_vectors_.end());
+    lexicografical_vectors_.erase(
+        std::unique(lexicografical_vectors_.begin(), lexicografical_vectors_.end()),
+        lexicografical_vectors_.end());
+    local_indexes_.reserve(lexicografical_vectors_.size());
+    for (uint32_t k = 0; k < lexicografical_vectors_.size(); ++k) {
+        local_indexes_[lexicografical_vectors_[k]] = k;
+    }
+
+    // U^T is filled row by row, U is obtained from it by counting sort:
+    transposed_decomposition_offsets_.reserve(size_ + 1);
+    transposed_decomposition_offsets_.push_back(0);
+    std::vector<size_t> number_of_items_in_row(lexicografical_vectors_.size(), 0);
+    for (uint32_t index_of_space_vector_i = 0; index_of_space_vector_i < size_;
+         ++index_of_space_vector_i) {
+        auto outer_iterator = subspace.decomposition->GetNewIterator(index_of_space_vector_i);
+        while (outer_iterator->hasNext()) {
+            auto outer_item = outer_iterator->getNext();
+            uint32_t local_index = local_indexes_.at(outer_item.index);
+            transposed_decomposition_items_.emplace_back(local_index, outer_item.value);
+            ++number_of_items_in_row[local_index];
+        }
+        transposed_decomposition_offsets_.push_back(transposed_decomposition_items_.size());
+    }
+
+    decomposition_offsets_.resize(lexicografical_vectors_.size() + 1, 0);
+    for (size_t k = 0; k < lexicografical_vectors_.size(); ++k) {
+        decomposition_offsets_[k + 1] = decomposition_offsets_[k] + number_of_items_in_row[k];
+    }
+    decomposition_items_.resize(transposed_decomposition_items_.size());
+    std::vector<size_t> positions(decomposition_offsets_.cbegin(), decomposition_offsets_.cend() - 1);
+    for (uint32_t i = 0; i < size_; ++i) {
+        for (size_t item = transposed_decomposition_offsets_[i];
+             item < transposed_decomposition_offsets_[i + 1];
+             ++item) {
+            const auto& [k, value] = transposed_decomposition_items_[item];
+            decomposition_items_[positions[k]++] = {i, value};
+        }
+    }
+}
+
+uint32_t MatrixFreeSubmatrix::size() const {
+    return size_;
+}
+
+void MatrixFreeSubmatrix::apply(const double* x, double* y, uint32_t number_of_vectors) const {
+    apply_(x, y, number_of_vectors);
+}
+
+void MatrixFreeSubmatrix::apply(const float* x, float* y, uint32_t number_of_vectors) const {
+    apply_(x, y, number_of_vectors);
+}
+
+template <typename T>
+void MatrixFreeSubmatrix::apply_(const T* x, T* y, uint32_t number_of_vectors) const {
+    const size_t lexicografical_size = lexicografical_vectors_.size();
+    // vectors in lexicographic basis are stored row-major, so every term touches contiguous memory:
+    std::vector<T> x_lexicografical(lexicografical_size * number_of_vectors, 0);
+    std::vector<T> y_lexicografical(lexicografical_size * number_of_vectors, 0);
+
+    // x_lex = U * x
+#pragma omp parallel for
+    for (size_t k = 0; k < lexicografical_size; ++k) {
+        T* x_k = x_lexicografical.data() + k * number_of_vectors;
+        for (size_t item = decomposition_offsets_[k]; item < decomposition_offsets_[k + 1]; ++item) {
+            const auto& [i, value] = decomposition_items_[item];
+            for (uint32_t vector = 0; vector < number_of_vectors; ++vector) {
+                x_k[vector] += (T)value * x[i + (size_t)vector * size_];
+            }
+        }
+    }
+
+    // y_lex = A * x_lex, terms are replayed for chunks of rows in parallel:
+    const size_t number_of_chunks =
+        std::min(lexicografical_size, (size_t)omp_get_max_threads() * CHUNKS_PER_THREAD);
+#pragma omp parallel for schedule(dynamic)
+    for (size_t chunk = 0; chunk < number_of_chunks; ++chunk) {
+        uint32_t first_row = lexicografical_size * chunk / number_of_chunks;
+        uint32_t last_row = lexicografical_size * (chunk + 1) / number_of_chunks;
+        AccumulatingSymmetricMatrix_<T> accumulator(
+            local_indexes_,
+            lexicografical_size,
+            first_row,
+            last_row,
+            x_lexicografical.data(),
+            y_lexicografical.data(),
+            number_of_vectors);
+        std::span<const uint32_t> rows(lexicografical_vectors_.data() + first_row, last_row - first_row);
+        for (const auto& term : operator_->getTerms()) {
+            term->construct(accumulator, rows);
+        }
+    }
+
+    // y = U^T * y_lex
+#pragma omp parallel for
+    for (size_t i = 0; i < size_; ++i) {
+        for (uint32_t vector = 0; vector < number_of_vectors; ++vector) {
+            y[i + (size_t)vector * size_] = 0;
+        }
+        for (size_t item = transposed_decomposition_offsets_[i];
+             item < transposed_decomposition_offsets_[i + 1];
+             ++item) {
+            const auto& [k, value] = transposed_decomposition_items_[item];
+            const T* y_k = y_lexicografical.data() + k * number_of_vectors;
+            for (uint32_t vector = 0; vector < number_of_vectors; ++vector) {
+                y[i + (size_t)vector * size_] += (T)value * y_k[vector];
+            }
+        }
+    }
+}
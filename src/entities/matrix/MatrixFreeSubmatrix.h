@@ -0,0 +1,49 @@
+#ifndef SPINNER_MATRIXFREESUBMATRIX_H
+#define SPINNER_MATRIXFREESUBMATRIX_H
+
+#include <cstdint>
+#include <hash_table8.hpp>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "src/entities/data_structures/AbstractMatrixFreeOperator.h"
+#include "src/model/operators/Operator.h"
+#include "src/space/Subspace.h"
+
+// U^T * A * U for the block of the subspace, where A is the operator in lexicographic basis
+// and U is the decomposition of the subspace. Neither A nor U^T * A * U is stored:
+// terms of the operator are replayed against vectors on every application,
+// different chunks of rows are replayed by different threads.
+class MatrixFreeSubmatrix: public quantum::linear_algebra::AbstractMatrixFreeOperator {
+  public:
+    MatrixFreeSubmatrix(
+        const space::Subspace& subspace,
+        std::shared_ptr<const model::operators::Operator> new_operator);
+
+    uint32_t size() const override;
+    void apply(const double* x, double* y, uint32_t number_of_vectors) const override;
+    void apply(const float* x, float* y, uint32_t number_of_vectors) const override;
+
+  private:
+    template <typename T>
+    void apply_(const T* x, T* y, uint32_t number_of_vectors) const;
+
+    // more chunks than threads balance the load of rows with different numbers of elements:
+    static constexpr size_t CHUNKS_PER_THREAD = 8;
+
+    std::shared_ptr<const model::operators::Operator> operator_;
+    // sorted lexicographic indexes of the block for Term::construct:
+    std::vector<uint32_t> lexicografical_vectors_;
+    // local index of every lexicographic index of the block:
+    emhash8::HashMap<uint32_t, uint32_t> local_indexes_;
+    uint32_t size_;
+    // U in CSR format: the row is a local lexicographic index, the column is an index in block.
+    std::vector<size_t> decomposition_offsets_;
+    std::vector<std::pair<uint32_t, double>> decomposition_items_;
+    // U^T in CSR format: the row is an index in block, the column is a local lexicographic index.
+    std::vector<size_t> transposed_decomposition_offsets_;
+    std::vector<std::pair<uint32_t, double>> transposed_decomposition_items_;
+};
+
+#endif  //SPINNER_MATRIXFREESUBMATRIX_H
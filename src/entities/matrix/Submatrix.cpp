@@ -1,6 +1,7 @@
 #include "Submatrix.h"
 
-#include <set>
+#include <algorithm>
+#include <vector>
 
 Submatrix::Submatrix(
     std::unique_ptr<quantum::linear_algebra::AbstractDiagonalizableMatrix> raw_data_,
@@ -14,10 +15,7 @@ Submatrix::Submatrix(
     std::shared_ptr<const index_converter::AbstractIndexConverter> converter,
     const quantum::linear_algebra::FactoriesList& factories,
     bool return_sparse_if_possible) {
-    auto totalSpaceSize = converter->get_total_space_size();
-    auto matrix_in_lexicografical_basis = factories.createSparseSymmetricMatrix(totalSpaceSize);
-
-    std::set<unsigned int> lexicografical_vectors_to_built;
+    std::vector<uint32_t> lexicografical_vectors_to_built;
     size_t matrix_in_space_basis_size = subspace.decomposition->size_cols();
 
     for (uint32_t index_of_space_vector_i = 0; index_of_space_vector_i < matrix_in_space_basis_size;
@@ -25,9 +23,17 @@ Submatrix::Submatrix(
         auto outer_iterator = subspace.decomposition->GetNewIterator(index_of_space_vector_i);
         while (outer_iterator->hasNext()) {
             auto outer_item = outer_iterator->getNext();
-            lexicografical_vectors_to_built.insert(outer_item.index);
+            lexicografical_vectors_to_built.push_back(outer_item.index);
         }
     }
+    std::sort(lexicografical_vectors_to_built.begin(), lexicografical_vectors_to_built.end());
+    lexicografical_vectors_to_built.erase(
+        std::unique(lexicografical_vectors_to_built.begin(), lexicografical_vectors_to_built.end()),
+        lexicografical_vectors_to_built.end());
+
+    // matrix is built only on lexicographic vectors of this block, not on the total space:
+    auto matrix_in_lexicografical_basis =
+        factories.createLocalSparseSymmetricMatrix(lexicografical_vectors_to_built);
 
     for (auto& term : new_operator.getTerms()) {
         term->construct(*matrix_in_lexicografical_basis, lexicografical_vectors_to_built);
@@ -1,6 +1,8 @@
 #include "ControlParser.h"
 
 #include "Tools.h"
+#include "src/eigendecompositor/SpectrumCache.h"
+#include "src/space/SpaceCache.h"
 
 #ifdef _Eigen_BUILT
     #include "src/entities/data_structures/eigen/EigenFactories.h"
@@ -45,9 +47,57 @@ ControlParser::ControlParser(YAML::Node control_node, bool dry_run) {
 
     constructFactoriesList(control_node);
 
+    if (control_node["memory_budget"].IsDefined()) {
+        // memory budget is written in MiB:
+        auto memory_budget = extractValue<size_t>(control_node, "memory_budget");
+        if (memory_budget == 0) {
+            throw std::invalid_argument("control::memory_budget must be positive");
+        }
+        memory_budget_ = memory_budget * 1024 * 1024;
+    }
+
+    if (control_node["streaming"].IsDefined()) {
+        streaming_ = extractValue<bool>(control_node, "streaming");
+    }
+
+    // dry run does not create directories of caches:
+    if (control_node["space_cache"].IsDefined()) {
+        auto settings = cacheParser(extractValue<YAML::Node>(control_node, "space_cache"), "space_cache");
+        if (!dry_run) {
+            space::SpaceCache::setDirectory(settings.directory);
+            if (settings.size_limit.has_value()) {
+                space::SpaceCache::setSizeLimit(settings.size_limit.value());
+            }
+        }
+    }
+    if (control_node["spectrum_cache"].IsDefined()) {
+        auto settings = cacheParser(extractValue<YAML::Node>(control_node, "spectrum_cache"), "spectrum_cache");
+        if (!dry_run) {
+            eigendecompositor::SpectrumCache::setDirectory(settings.directory);
+            if (settings.size_limit.has_value()) {
+                eigendecompositor::SpectrumCache::setSizeLimit(settings.size_limit.value());
+            }
+        }
+    }
+
     throw_if_node_is_not_empty(control_node);
 }
 
+ControlParser::CacheSettings ControlParser::cacheParser(YAML::Node cache_node, const std::string& node_name) {
+    CacheSettings settings;
+    settings.directory = extractValue<std::string>(cache_node, "directory");
+    if (cache_node["size_limit"].IsDefined()) {
+        // size limit is written in MiB:
+        auto size_limit = extractValue<size_t>(cache_node, "size_limit");
+        if (size_limit == 0) {
+            throw std::invalid_argument("control::" + node_name + "::size_limit must be positive");
+        }
+        settings.size_limit = size_limit * 1024 * 1024;
+    }
+    throw_if_node_is_not_empty(cache_node);
+    return settings;
+}
+
 void ControlParser::constructFactoriesList(YAML::Node& control_node) {
     auto densePrecision =
         extractValue<quantum::linear_algebra::Precision>(control_node, "dense_precision");
@@ -70,4 +120,12 @@ common::PrintLevel ControlParser::getPrintLevel() const {
 const std::optional<quantum::linear_algebra::FactoriesList>& ControlParser::getFactoriesList() const {
     return factoriesList_;
 }
+
+const std::optional<size_t>& ControlParser::getMemoryBudget() const {
+    return memory_budget_;
+}
+
+bool ControlParser::isStreaming() const {
+    return streaming_;
+}
 }  // namespace input
\ No newline at end of file
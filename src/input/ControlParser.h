@@ -14,11 +14,20 @@ class ControlParser {
     ControlParser(YAML::Node control_node, bool dry_run);
     common::PrintLevel getPrintLevel() const;
     const std::optional<quantum::linear_algebra::FactoriesList>& getFactoriesList() const;
+    const std::optional<size_t>& getMemoryBudget() const;
+    bool isStreaming() const;
   private:
     void constructFactoriesList(YAML::Node& control_node);
+    struct CacheSettings {
+        std::string directory;
+        std::optional<size_t> size_limit;
+    };
+    CacheSettings cacheParser(YAML::Node cache_node, const std::string& node_name);
 
     std::optional<common::PrintLevel> print_level_;
     std::optional<quantum::linear_algebra::FactoriesList> factoriesList_;
+    std::optional<size_t> memory_budget_;
+    bool streaming_ = false;
 };
 
 }  // namespace input
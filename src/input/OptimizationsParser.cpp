@@ -5,13 +5,15 @@
 #include "src/common/physical_optimization/OptimizationList.h"
 
 namespace input {
-OptimizationsParser::OptimizationsParser(YAML::Node optimizations_node) {
+OptimizationsParser::OptimizationsParser(
+    YAML::Node optimizations_node,
+    std::optional<double> max_temperature_of_job) {
     auto mode_string = extractValue<std::string>(optimizations_node, "mode");
     if (mode_string == "none") {
         optimizations_list_ = common::physical_optimization::OptimizationList();
         // do nothing
     } else if (mode_string == "custom") {
-        customParser(extractValue<YAML::Node>(optimizations_node, "custom"));
+        customParser(extractValue<YAML::Node>(optimizations_node, "custom"), max_temperature_of_job);
     } else if (mode_string == "auto") {
         throw std::invalid_argument("optimizations::mode == auto is not implemented yet");
     } else {
@@ -25,7 +27,9 @@ OptimizationsParser::getOptimizationList() const {
     return optimizations_list_;
 }
 
-void OptimizationsParser::customParser(YAML::Node custom_node) {
+void OptimizationsParser::customParser(
+    YAML::Node custom_node,
+    std::optional<double> max_temperature_of_job) {
     auto basis_type_ = extractValue<common::physical_optimization::OptimizationList::BasisType>(custom_node, "basis");
     optimizations_list_ = common::physical_optimization::OptimizationList(basis_type_);
 
@@ -46,8 +50,16 @@ void OptimizationsParser::customParser(YAML::Node custom_node) {
     if (extractValue<YAML::Node>(custom_node, "non_abelian_simplifier").IsDefined()) {
         optimizations_list_->NonAbelianSimplify();
     }
+    if (extractValue<YAML::Node>(custom_node, "linear_hamiltonian_cache").IsDefined()) {
+        optimizations_list_->CacheLinearHamiltonian();
+    }
 
     ftlmParser(extractValue<YAML::Node>(custom_node, "ftlm"));
+    boltzmannWindowParser(
+        extractValue<YAML::Node>(custom_node, "boltzmann_window"),
+        max_temperature_of_job);
+    warmStartParser(extractValue<YAML::Node>(custom_node, "warm_start"));
+    degeneracyCompressionParser(extractValue<YAML::Node>(custom_node, "degeneracy_compression"));
 
     throw_if_node_is_not_empty(custom_node);
 }
@@ -87,9 +99,32 @@ void OptimizationsParser::ftlmParser(YAML::Node ftlm_node) {
     auto exact_decomposition_threshold = extractValue<size_t>(ftlm_node, "exact_decomposition_threshold");
     auto number_of_seeds = extractValue<size_t>(ftlm_node, "number_of_seeds");
 
+    common::physical_optimization::OptimizationList::FTLMSettings settings;
+    if (ftlm_node["matrix_free_threshold"].IsDefined()) {
+        settings.matrix_free_threshold = extractValue<size_t>(ftlm_node, "matrix_free_threshold");
+    }
+    if (ftlm_node["uncertainty_threshold"].IsDefined()) {
+        settings.uncertainty_threshold = extractValue<double>(ftlm_node, "uncertainty_threshold");
+    }
+    if (ftlm_node["max_number_of_seeds"].IsDefined()) {
+        settings.max_number_of_seeds = extractValue<size_t>(ftlm_node, "max_number_of_seeds");
+    }
+    if (ftlm_node["convergence_tolerance"].IsDefined()) {
+        settings.convergence_tolerance = extractValue<double>(ftlm_node, "convergence_tolerance");
+    }
+    if (ftlm_node["convergence_energy_window"].IsDefined()) {
+        settings.convergence_energy_window = extractValue<double>(ftlm_node, "convergence_energy_window");
+    }
+    if (ftlm_node["two_pass_lanczos"].IsDefined()) {
+        settings.two_pass_lanczos = extractValue<bool>(ftlm_node, "two_pass_lanczos");
+    }
+    if (settings.uncertainty_threshold.has_value() && settings.max_number_of_seeds < number_of_seeds) {
+        throw std::invalid_argument(
+            "optimizations::custom::ftlm::max_number_of_seeds is less than number_of_seeds");
+    }
+
     throw_if_node_is_not_empty(ftlm_node);
 
-    common::physical_optimization::OptimizationList::FTLMSettings settings;
     settings.exact_decomposition_threshold = exact_decomposition_threshold;
     settings.krylov_subspace_size = krylov_subspace_size;
     settings.number_of_seeds = number_of_seeds;
@@ -97,4 +132,59 @@ void OptimizationsParser::ftlmParser(YAML::Node ftlm_node) {
     optimizations_list_->FTLMApproximate(settings);
 }
 
+void OptimizationsParser::boltzmannWindowParser(
+    YAML::Node boltzmann_window_node,
+    std::optional<double> max_temperature_of_job) {
+    if (!boltzmann_window_node.IsDefined()) {
+        return;
+    }
+    common::physical_optimization::OptimizationList::BoltzmannWindowSettings settings;
+    if (boltzmann_window_node["max_temperature"].IsDefined()) {
+        settings.max_temperature = extractValue<double>(boltzmann_window_node, "max_temperature");
+    } else if (max_temperature_of_job.has_value()) {
+        settings.max_temperature = max_temperature_of_job.value();
+    } else {
+        throw std::invalid_argument(
+            "Cannot derive optimizations::custom::boltzmann_window::max_temperature from job");
+    }
+    if (boltzmann_window_node["number_of_kT"].IsDefined()) {
+        settings.number_of_kT = extractValue<double>(boltzmann_window_node, "number_of_kT");
+    }
+
+    throw_if_node_is_not_empty(boltzmann_window_node);
+
+    optimizations_list_->BoltzmannWindow(settings);
+}
+
+void OptimizationsParser::warmStartParser(YAML::Node warm_start_node) {
+    if (!warm_start_node.IsDefined()) {
+        return;
+    }
+    common::physical_optimization::OptimizationList::WarmStartSettings settings;
+    if (warm_start_node["tolerance"].IsDefined()) {
+        settings.tolerance = extractValue<double>(warm_start_node, "tolerance");
+    }
+    if (warm_start_node["max_iterations"].IsDefined()) {
+        settings.max_iterations = extractValue<size_t>(warm_start_node, "max_iterations");
+    }
+
+    throw_if_node_is_not_empty(warm_start_node);
+
+    optimizations_list_->WarmStart(settings);
+}
+
+void OptimizationsParser::degeneracyCompressionParser(YAML::Node degeneracy_compression_node) {
+    if (!degeneracy_compression_node.IsDefined()) {
+        return;
+    }
+    common::physical_optimization::OptimizationList::DegeneracyCompressionSettings settings;
+    if (degeneracy_compression_node["tolerance"].IsDefined()) {
+        settings.tolerance = extractValue<double>(degeneracy_compression_node, "tolerance");
+    }
+
+    throw_if_node_is_not_empty(degeneracy_compression_node);
+
+    optimizations_list_->DegeneracyCompress(settings);
+}
+
 }  // namespace input
\ No newline at end of file
@@ -10,15 +10,23 @@ namespace input {
 
 class OptimizationsParser {
   public:
-    explicit OptimizationsParser(YAML::Node optimizations_node);
+    // max_temperature_of_job is used, if the maximum temperature of Boltzmann window is not set:
+    explicit OptimizationsParser(
+        YAML::Node optimizations_node,
+        std::optional<double> max_temperature_of_job = std::nullopt);
     const std::optional<common::physical_optimization::OptimizationList>&
     getOptimizationList() const;
   private:
     std::optional<common::physical_optimization::OptimizationList> optimizations_list_;
-    void customParser(YAML::Node custom_node);
+    void customParser(YAML::Node custom_node, std::optional<double> max_temperature_of_job);
     void symmetrizerParser(YAML::Node symmetrizer_node);
     void groupParser(YAML::Node group_node);
     void ftlmParser(YAML::Node ftlm_node);
+    void boltzmannWindowParser(
+        YAML::Node boltzmann_window_node,
+        std::optional<double> max_temperature_of_job);
+    void warmStartParser(YAML::Node warm_start_node);
+    void degeneracyCompressionParser(YAML::Node degeneracy_compression_node);
 };
 
 }  // namespace input
@@ -3,6 +3,7 @@
 
 #include "src/common/PrintingFunctions.h"
 
+#include <algorithm>
 #include <yaml-cpp/yaml.h>
 
 namespace input {
@@ -21,13 +22,28 @@ Parser::Parser(const std::string& filename, bool dry_run) {
 
     model_input_parser_.emplace(extractValue<YAML::Node>(input_node, "model_input"));
 
-    optimizations_list_parser_.emplace(extractValue<YAML::Node>(input_node, "optimizations"));
-
     job_parser_.emplace(extractValue<YAML::Node>(input_node, "job"));
 
+    optimizations_list_parser_.emplace(
+        extractValue<YAML::Node>(input_node, "optimizations"),
+        getMaxTemperatureOfJob());
+
     throw_if_node_is_not_empty(input_node);
 }
 
+std::optional<double> Parser::getMaxTemperatureOfJob() const {
+    std::vector<double> temperatures;
+    if (getTemperaturesForSimulation().has_value()) {
+        temperatures = getTemperaturesForSimulation().value();
+    } else if (getExperimentalValuesWorker().has_value()) {
+        temperatures = getExperimentalValuesWorker().value()->getTemperatures();
+    }
+    if (temperatures.empty()) {
+        return std::nullopt;
+    }
+    return *std::max_element(temperatures.begin(), temperatures.end());
+}
+
 const std::vector<model::ModelInput>& Parser::getModelInputs() const {
     return model_input_parser_.value().getModelInputs();
 }
@@ -54,4 +70,9 @@ Parser::getExperimentalValuesWorker() const {
 const std::optional<quantum::linear_algebra::FactoriesList>& Parser::getFactoriesList() const {
     return control_parser_->getFactoriesList();
 }
+
+common::physical_optimization::OptimizationList::BlockSchedulingSettings
+Parser::getBlockSchedulingSettings() const {
+    return {control_parser_->getMemoryBudget(), control_parser_->isStreaming()};
+}
 }  // namespace input
\ No newline at end of file
@@ -24,7 +24,10 @@ class Parser {
     const std::optional<std::shared_ptr<magnetic_susceptibility::ExperimentalValuesWorker>>& getExperimentalValuesWorker() const;
 
     const std::optional<quantum::linear_algebra::FactoriesList>& getFactoriesList() const;
+    common::physical_optimization::OptimizationList::BlockSchedulingSettings getBlockSchedulingSettings() const;
   private:
+    std::optional<double> getMaxTemperatureOfJob() const;
+
     std::optional<input::ModelInputParser> model_input_parser_;
     std::optional<input::OptimizationsParser> optimizations_list_parser_;
     std::optional<input::JobParser> job_parser_;
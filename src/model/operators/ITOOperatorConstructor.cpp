@@ -11,7 +11,14 @@
 
 namespace model::operators {
 ITOOperatorConstructor::ITOOperatorConstructor(std::shared_ptr<index_converter::s_squared::IndexConverter> converter) :
-	converter_(converter) {}
+	converter_(converter) {
+    // the largest spin in the model is the total spin with all local spins summed up in parallel:
+    uint32_t max_doubled_spin = 0;
+    for (auto mult : converter_->get_mults()) {
+        max_doubled_spin += mult - 1;
+    }
+    clebshGordanCalculator_ = std::make_shared<const spin_algebra::ClebshGordanCalculator>(max_doubled_spin);
+}
 
 void ITOOperatorConstructor::emplaceIsotropicExchangeLike(
 	std::shared_ptr<Operator> hamiltonian, 
@@ -19,6 +26,7 @@ void ITOOperatorConstructor::emplaceIsotropicExchangeLike(
     hamiltonian->emplace_back(
         std::make_unique<const operators::ito::T00TwoCenterTerm>(
             converter_,
+            clebshGordanCalculator_,
             parameters,
             2 * sqrt(3))
     );
@@ -60,16 +68,16 @@ std::shared_ptr<Operator> ITOOperatorConstructor::constructGSzSquaredLike(
     );
     // ... + \sum_i g_i^2 T_0^{(2)}(2|i) * sqrt(2/3)
     g_sz_squared_operator_->emplace_back(
-        std::make_unique<const ito::T20OneCenterTerm>(converter_, diagonal_parameters, sqrt(2.0/3.0))
+        std::make_unique<const ito::T20OneCenterTerm>(converter_, clebshGordanCalculator_, diagonal_parameters, sqrt(2.0/3.0))
     );
 
     // \sum_i \sum_j g_i g_j S_i^z S_j^z = \sum_i \sum_j g_i g_j T_0^{(0)}(11|ij) * (-sqrt(1/3)) + ...
     g_sz_squared_operator_->emplace_back(
-        std::make_unique<const ito::T00TwoCenterTerm>(converter_, nondiagonal_parameters, -2.0 * sqrt(1.0/3.0))
+        std::make_unique<const ito::T00TwoCenterTerm>(converter_, clebshGordanCalculator_, nondiagonal_parameters, -2.0 * sqrt(1.0/3.0))
     );
     // ... + \sum_i \sum_j g_i g_j T_0^{(2)}(11|ij) * sqrt(2/3)
     g_sz_squared_operator_->emplace_back(
-        std::make_unique<const ito::T20TwoCenterTerm>(converter_, nondiagonal_parameters, 2 * sqrt(2.0/3.0)));
+        std::make_unique<const ito::T20TwoCenterTerm>(converter_, clebshGordanCalculator_, nondiagonal_parameters, 2 * sqrt(2.0/3.0)));
     // this twos from summation in Submatrix: \sum_{a=1}^N \sum_{b=a+1}^N
     return g_sz_squared_operator_;
 }
@@ -85,7 +93,7 @@ std::shared_ptr<Operator> ITOOperatorConstructor::constructGSquaredT00Like(
     );
 
     g_squared_T00_operator_->emplace_back(
-        std::make_unique<const ito::T00TwoCenterTerm>(converter_, nondiagonal_parameters, -2.0 * sqrt(1.0/3.0))
+        std::make_unique<const ito::T00TwoCenterTerm>(converter_, clebshGordanCalculator_, nondiagonal_parameters, -2.0 * sqrt(1.0/3.0))
     );
     return g_squared_T00_operator_;
 }
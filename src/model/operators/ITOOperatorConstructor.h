@@ -4,6 +4,7 @@
 #include "AbstractOperatorConstructor.h"
 
 #include "src/common/index_converter/s_squared/IndexConverter.h"
+#include "src/spin_algebra/ClebshGordanCalculator.h"
 
 namespace model::operators {
 class ITOOperatorConstructor : public AbstractOperatorConstructor {
@@ -31,6 +32,8 @@ class ITOOperatorConstructor : public AbstractOperatorConstructor {
   
   private:
     std::shared_ptr<index_converter::s_squared::IndexConverter> converter_;
+    // one table of Wigner coefficients is shared by all ITO terms of the model:
+    std::shared_ptr<const spin_algebra::ClebshGordanCalculator> clebshGordanCalculator_;
 
 };
 } // namespace model::operators
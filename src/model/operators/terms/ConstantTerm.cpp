@@ -6,7 +6,7 @@ namespace model::operators {
 void ConstantTerm::construct(
     quantum::linear_algebra::AbstractSymmetricMatrix&
         matrix_in_lexicografical_basis,
-    const std::set<unsigned int>& indexes_of_vectors) const {
+    std::span<const uint32_t> indexes_of_vectors) const {
     for (const auto& index_of_vector : indexes_of_vectors) {
         matrix_in_lexicografical_basis.add_to_position(*constant_, index_of_vector, index_of_vector);
     }
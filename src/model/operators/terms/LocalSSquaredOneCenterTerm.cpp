@@ -12,7 +12,7 @@ std::unique_ptr<Term> LocalSSquaredOneCenterTerm::clone() const {
 void LocalSSquaredOneCenterTerm::construct(
     quantum::linear_algebra::AbstractSymmetricMatrix&
         matrix_in_lexicografical_basis,
-    const std::set<unsigned int>& indexes_of_vectors,
+    std::span<const uint32_t> indexes_of_vectors,
     uint32_t center_a) const {
     double factor = coefficients_->at(center_a) * prefactor_;
 
@@ -20,7 +20,7 @@ class LocalSSquaredOneCenterTerm: public OneCenterTerm {
     void construct(
         quantum::linear_algebra::AbstractSymmetricMatrix&
             matrix_in_lexicografical_basis,
-        const std::set<unsigned int>& indexes_of_vectors,
+        std::span<const uint32_t> indexes_of_vectors,
         uint32_t center_a) const override;
 
   private:
@@ -3,7 +3,7 @@
 
 #include <cstdint>
 #include <memory>
-#include <set>
+#include <span>
 
 #include "src/entities/data_structures/AbstractSymmetricMatrix.h"
 
@@ -12,10 +12,12 @@ class Term {
   public:
     // This method is required for deep copy of std::vector<std::unique_ptr<Term>>
     virtual std::unique_ptr<Term> clone() const = 0;
+    // indexes_of_vectors are sorted unique lexicographic indexes of the block (or of its part),
+    // elements are added for rows of indexes_of_vectors:
     virtual void construct(
         quantum::linear_algebra::AbstractSymmetricMatrix&
             matrix_in_lexicografical_basis,
-        const std::set<unsigned int>& indexes_of_vectors) const = 0;
+        std::span<const uint32_t> indexes_of_vectors) const = 0;
     virtual ~Term() = default;
 };
 
@@ -24,7 +26,7 @@ class ZeroCenterTerm : public Term {
     void construct(
         quantum::linear_algebra::AbstractSymmetricMatrix&
             matrix_in_lexicografical_basis,
-        const std::set<unsigned int>&) const override = 0;
+        std::span<const uint32_t>) const override = 0;
     ~ZeroCenterTerm() override = default;
 };
 
@@ -39,11 +41,11 @@ class OneCenterTerm : public Term {
     virtual void construct(
         quantum::linear_algebra::AbstractSymmetricMatrix&
             matrix_in_lexicografical_basis,
-        const std::set<unsigned int>& indexes_of_vectors,
+        std::span<const uint32_t> indexes_of_vectors,
         uint32_t center_a) const = 0;
     void construct(
         quantum::linear_algebra::AbstractSymmetricMatrix& matrix_in_lexicografical_basis,
-        const std::set<unsigned int>& indexes_of_vectors) const override {
+        std::span<const uint32_t> indexes_of_vectors) const override {
         for (int center_a = 0; center_a < getNumberOfCenters(); ++center_a) {
             construct(
                 matrix_in_lexicografical_basis,
@@ -65,12 +67,12 @@ class TwoCenterTerm : public Term {
     virtual void construct(
         quantum::linear_algebra::AbstractSymmetricMatrix&
             matrix_in_lexicografical_basis,
-        const std::set<unsigned int>& indexes_of_vectors,
+        std::span<const uint32_t> indexes_of_vectors,
         uint32_t center_a,
         uint32_t center_b) const = 0;
     void construct(
         quantum::linear_algebra::AbstractSymmetricMatrix& matrix_in_lexicografical_basis,
-        const std::set<unsigned int>& indexes_of_vectors) const override {
+        std::span<const uint32_t> indexes_of_vectors) const override {
         for (int center_a = 0; center_a < getNumberOfCenters(); ++center_a) {
             for (int center_b = center_a + 1; center_b < getNumberOfCenters(); ++center_b) {
                 construct(
@@ -13,7 +13,7 @@ std::unique_ptr<Term> TotalMSquaredTerm::clone() const {
 void TotalMSquaredTerm::construct(
     quantum::linear_algebra::AbstractSymmetricMatrix&
         matrix_in_lexicografical_basis,
-    const std::set<unsigned int>& indexes_of_vectors) const {
+    std::span<const uint32_t> indexes_of_vectors) const {
 
     for (const auto index_of_vector : indexes_of_vectors) {
         double max_spin = ((double)converter_->get_max_ntz_proj() - 1.0) / 2.0;
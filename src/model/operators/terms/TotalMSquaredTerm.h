@@ -13,7 +13,7 @@ public:
     void construct(
         quantum::linear_algebra::AbstractSymmetricMatrix&
             matrix_in_lexicografical_basis,
-        const std::set<unsigned int>& indexes_of_vectors) const override;
+        std::span<const uint32_t> indexes_of_vectors) const override;
 
 private:
     std::shared_ptr<const index_converter::AbstractIndexConverter> converter_;
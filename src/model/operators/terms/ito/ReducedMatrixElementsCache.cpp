@@ -0,0 +1,59 @@
+#include "ReducedMatrixElementsCache.h"
+
+#include <omp.h>
+
+namespace model::operators::ito {
+
+ReducedMatrixElementsCache::ReducedMatrixElementsCache(size_t max_number_of_elements_per_thread) :
+    max_number_of_elements_per_thread_(max_number_of_elements_per_thread),
+    maps_for_all_threads_(omp_get_max_threads()) {}
+
+uint64_t ReducedMatrixElementsCache::to_key(
+    uint32_t center_a,
+    uint32_t center_b,
+    uint32_t index_of_left_level) noexcept {
+    // NB: number of centers cannot be bigger than 2^16
+    uint64_t answer = index_of_left_level;
+    answer |= (uint64_t)center_b << 32;
+    answer |= (uint64_t)center_a << 48;
+    return answer;
+}
+
+const ReducedMatrixElements* ReducedMatrixElementsCache::find(uint64_t key) const {
+    const Map& map_per_thread = maps_for_all_threads_.at(omp_get_thread_num()).map;
+    auto iterator = map_per_thread.find(key);
+    if (iterator == map_per_thread.end()) {
+        return nullptr;
+    }
+    return &iterator->second;
+}
+
+const ReducedMatrixElements&
+ReducedMatrixElementsCache::emplace(uint64_t key, ReducedMatrixElements elements) const {
+    MapPerThread& map_per_thread = maps_for_all_threads_.at(omp_get_thread_num());
+    if (map_per_thread.number_of_elements + elements.size() > max_number_of_elements_per_thread_) {
+        // the reduced matrix elements are cheap to recalculate, so the whole map is dropped:
+        map_per_thread.map.clear();
+        map_per_thread.number_of_elements = 0;
+    }
+    map_per_thread.number_of_elements += elements.size();
+    return map_per_thread.map.emplace(key, std::move(elements)).first->second;
+}
+
+void ReducedMatrixElementsCache::clear() {
+    for (auto& map_per_thread : maps_for_all_threads_) {
+        // swap with empty map releases the buckets:
+        Map().swap(map_per_thread.map);
+        map_per_thread.number_of_elements = 0;
+    }
+}
+
+size_t ReducedMatrixElementsCache::number_of_elements() const {
+    size_t answer = 0;
+    for (const auto& map_per_thread : maps_for_all_threads_) {
+        answer += map_per_thread.number_of_elements;
+    }
+    return answer;
+}
+
+}  // namespace model::operators::ito
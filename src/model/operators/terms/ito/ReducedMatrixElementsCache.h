@@ -0,0 +1,61 @@
+#ifndef SPINNER_REDUCEDMATRIXELEMENTSCACHE_H
+#define SPINNER_REDUCEDMATRIXELEMENTSCACHE_H
+
+#include <hash_table8.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "src/common/MumxHash.h"
+#include "src/spin_algebra/Multiplicity.h"
+
+namespace model::operators::ito {
+// Reduced matrix element <left||T||right> multiplied by all projection-independent factors.
+// Levels are represented by indexes of their zero projections.
+struct ReducedMatrixElement {
+    uint32_t index_of_right_level;
+    spin_algebra::Multiplicity total_multiplicity_of_right_level;
+    double value;
+};
+
+using ReducedMatrixElements = std::vector<ReducedMatrixElement>;
+
+// Reduced matrix elements depend only on levels and ranks of the operator, but not on projections,
+// so they are calculated once per left level and reused for all its projections (and all blocks).
+// Every thread has its own map, so the cache can be used by const terms in parallel.
+// The map of a thread holds at most one entry per (pair of centers, left level), i.e. the upper triangle
+// of the level-level matrix of the term, and the same entry can be calculated by several threads.
+// To bound the memory, the map of a thread is cleared, when it is going to exceed
+// max_number_of_elements_per_thread reduced matrix elements.
+class ReducedMatrixElementsCache {
+  public:
+    // 2^22 elements are 64 MiB per thread:
+    static constexpr size_t DEFAULT_MAX_NUMBER_OF_ELEMENTS_PER_THREAD = 1ull << 22;
+
+    explicit ReducedMatrixElementsCache(
+        size_t max_number_of_elements_per_thread = DEFAULT_MAX_NUMBER_OF_ELEMENTS_PER_THREAD);
+
+    // centers define ranks of the operator, the key is unique for the term:
+    static uint64_t to_key(uint32_t center_a, uint32_t center_b, uint32_t index_of_left_level) noexcept;
+
+    // returns nullptr, if elements were not calculated by this thread yet:
+    const ReducedMatrixElements* find(uint64_t key) const;
+    // the reference is valid until the next call of emplace by this thread:
+    const ReducedMatrixElements& emplace(uint64_t key, ReducedMatrixElements elements) const;
+
+    // releases the memory of all threads, it must not be called in parallel with find and emplace:
+    void clear();
+    size_t number_of_elements() const;
+
+  private:
+    using Map = emhash8::HashMap<uint64_t, ReducedMatrixElements, ankerl::MumxHash<uint64_t>>;
+    struct MapPerThread {
+        Map map;
+        size_t number_of_elements = 0;
+    };
+    size_t max_number_of_elements_per_thread_;
+    mutable std::vector<MapPerThread> maps_for_all_threads_;
+};
+}  // namespace model::operators::ito
+
+#endif  //SPINNER_REDUCEDMATRIXELEMENTSCACHE_H
@@ -13,17 +13,19 @@ namespace model::operators::ito {
 
 T00TwoCenterTerm::T00TwoCenterTerm(
     std::shared_ptr<const index_converter::s_squared::IndexConverter> converter,
+    std::shared_ptr<const spin_algebra::ClebshGordanCalculator> clebshGordanCalculator,
     std::shared_ptr<const TwoDNumericalParameters<double>> isotropic_exchange_parameters,
     double prefactor) :
     TwoCenterTerm(isotropic_exchange_parameters->size()),
     converter_(converter),
+    clebshGordanCalculator_(clebshGordanCalculator),
     coefficients_(std::move(isotropic_exchange_parameters)),
     prefactor_(prefactor),
-    wigner_eckart_helper_(converter->getOrderOfSummation()) {}
+    wigner_eckart_helper_(converter->getOrderOfSummation(), clebshGordanCalculator) {}
 
 void T00TwoCenterTerm::construct(
     quantum::linear_algebra::AbstractSymmetricMatrix& matrix,
-    const std::set<unsigned int>& indexes_of_vectors,
+    std::span<const uint32_t> indexes_of_vectors,
     uint32_t center_a,
     uint32_t center_b) const {
     if (!std::isnan(coefficients_->at(center_a, center_b))) {
@@ -39,15 +41,13 @@ void T00TwoCenterTerm::construct(
 
 void T00TwoCenterTerm::add_scalar_product(
     quantum::linear_algebra::AbstractSymmetricMatrix& matrix,
-    const std::set<unsigned int>& indexes_of_vectors,
+    std::span<const uint32_t> indexes_of_vectors,
     uint32_t center_a,
     uint32_t center_b,
     double factor) const {
 
     auto ranks = constructRanksOfTZero(center_a, center_b);
 
-    std::vector<index_converter::s_squared::Level> levels_right;
-
     double local_prod = wigner_eckart_helper_.local_product(converter_->get_mults(), ranks);
 
     for (const auto& index_of_vector_row : indexes_of_vectors) {
@@ -55,20 +55,22 @@ void T00TwoCenterTerm::add_scalar_product(
         const auto& level_left = state_left.first;
         auto projection = state_left.second;
 
-        wigner_eckart_helper_.construct_overlapping_levels(level_left, ranks, levels_right);
-        for (const auto& level_right : levels_right) {
-            auto mb_index_of_vector_col = converter_->convert_state_to_index(level_right, projection);
-            if (!mb_index_of_vector_col.has_value()) {
-                continue;
-            }
-            auto index_of_vector_col = mb_index_of_vector_col.value();
-            if (index_of_vector_col < index_of_vector_row) {
-                continue;
-            }
-            double total_9j = wigner_eckart_helper_.total_9j_coefficient(level_left, level_right, ranks, local_prod);
+        uint32_t index_of_level_left = index_of_vector_row - projection;
+
+        auto key = ReducedMatrixElementsCache::to_key(center_a, center_b, index_of_level_left);
+        const auto* reduced_elements = reduced_matrix_elements_cache_.find(key);
+        if (reduced_elements == nullptr) {
+            ReducedMatrixElements calculated_elements;
+            wigner_eckart_helper_.construct_reduced_matrix_elements(
+                level_left, index_of_level_left, ranks, local_prod, *converter_, calculated_elements);
+            reduced_elements = &reduced_matrix_elements_cache_.emplace(key, std::move(calculated_elements));
+        }
+
+        for (const auto& reduced_element : *reduced_elements) {
+            auto index_of_vector_col = reduced_element.index_of_right_level + projection;
             // due to the Wigher-Echart theorem, we also need to multiply by CG-coefficient,
             // but it is (S M 0 0; S M) = 1
-            double value = factor * total_9j;
+            double value = factor * reduced_element.value;
             if (value != 0.0) {
                 matrix.add_to_position(value, index_of_vector_row, index_of_vector_col);
             }
@@ -77,12 +79,11 @@ void T00TwoCenterTerm::add_scalar_product(
 }
 
 std::unique_ptr<Term> T00TwoCenterTerm::clone() const {
-    return std::make_unique<T00TwoCenterTerm>(converter_, coefficients_, prefactor_);
+    return std::make_unique<T00TwoCenterTerm>(converter_, clebshGordanCalculator_, coefficients_, prefactor_);
 }
 
 std::vector<uint8_t>
 T00TwoCenterTerm::constructRanksOfTZero(uint32_t center_a, uint32_t center_b) const {
-    // todo: cache results, there is just O(N^3) memory required
     auto number_of_initial_mults = converter_->get_mults().size();
     auto number_of_all_mults = number_of_initial_mults + 
     converter_->getOrderOfSummation()->getInstructions().size();
@@ -12,6 +12,7 @@ class T00TwoCenterTerm : public TwoCenterTerm {
   public:
     T00TwoCenterTerm(
         std::shared_ptr<const index_converter::s_squared::IndexConverter> converter,
+        std::shared_ptr<const spin_algebra::ClebshGordanCalculator> clebshGordanCalculator,
         std::shared_ptr<const TwoDNumericalParameters<double>> isotropic_exchange_parameters,
         double prefactor = 1);
 
@@ -20,19 +21,21 @@ class T00TwoCenterTerm : public TwoCenterTerm {
     void construct(
         quantum::linear_algebra::AbstractSymmetricMatrix&
             matrix,
-        const std::set<unsigned int>& indexes_of_vectors,
+        std::span<const uint32_t> indexes_of_vectors,
         uint32_t center_a,
         uint32_t center_b) const override;
 
   private:
     std::shared_ptr<const index_converter::s_squared::IndexConverter> converter_;
+    std::shared_ptr<const spin_algebra::ClebshGordanCalculator> clebshGordanCalculator_;
     std::shared_ptr<const TwoDNumericalParameters<double>> coefficients_;
     const double prefactor_;
     WignerEckartHelper wigner_eckart_helper_;
+    ReducedMatrixElementsCache reduced_matrix_elements_cache_;
 
     void add_scalar_product(
     quantum::linear_algebra::AbstractSymmetricMatrix& matrix,
-    const std::set<unsigned int>& indexes_of_vectors,
+    std::span<const uint32_t> indexes_of_vectors,
     uint32_t center_a,
     uint32_t center_b,
     double factor) const;
@@ -7,21 +7,23 @@ namespace model::operators::ito {
 
 T20OneCenterTerm::T20OneCenterTerm(
 	std::shared_ptr<const index_converter::s_squared::IndexConverter> converter,
+	std::shared_ptr<const spin_algebra::ClebshGordanCalculator> clebshGordanCalculator,
 	std::shared_ptr<const OneDNumericalParameters<double>> coefficients,
     double prefactor) :
 	OneCenterTerm(coefficients->size()),
 	converter_(converter), 
+	clebshGordanCalculator_(clebshGordanCalculator),
 	coefficients_(coefficients),
     prefactor_(prefactor),
-    wigner_eckart_helper_(converter->getOrderOfSummation()) {}
+    wigner_eckart_helper_(converter->getOrderOfSummation(), clebshGordanCalculator) {}
 
 std::unique_ptr<Term> T20OneCenterTerm::clone() const {
-	return std::make_unique<T20OneCenterTerm>(converter_, coefficients_, prefactor_);
+	return std::make_unique<T20OneCenterTerm>(converter_, clebshGordanCalculator_, coefficients_, prefactor_);
 };
 
 void T20OneCenterTerm::construct(
 	quantum::linear_algebra::AbstractSymmetricMatrix& matrix,
-	const std::set<unsigned int>& indexes_of_vectors,
+	std::span<const uint32_t> indexes_of_vectors,
 	uint32_t center_a) const {
 	
     if (!std::isnan(coefficients_->at(center_a))) {
@@ -36,14 +38,12 @@ void T20OneCenterTerm::construct(
 
 void T20OneCenterTerm::add_ttwo_term(
 	quantum::linear_algebra::AbstractSymmetricMatrix& matrix,
-	const std::set<unsigned int>& indexes_of_vectors,
+	std::span<const uint32_t> indexes_of_vectors,
 	uint32_t center_a,
 	double factor) const {
 
     auto ranks = constructRanksOfTTwo(center_a);
 
-    std::vector<index_converter::s_squared::Level> levels_right;
-
     double local_prod = wigner_eckart_helper_.local_product(converter_->get_mults(), ranks);
 
 	for (const auto& index_of_vector_row : indexes_of_vectors) {
@@ -51,25 +51,24 @@ void T20OneCenterTerm::add_ttwo_term(
 		const auto& level_left = state_left.first;
 		auto projection = state_left.second;
 
-        wigner_eckart_helper_.construct_overlapping_levels(level_left, ranks, levels_right);
-
-        for (const auto& level_right : levels_right) {
-            auto mb_index_of_vector_col = converter_->convert_state_to_index(level_right, projection);
-            if (!mb_index_of_vector_col.has_value()) {
-                continue;
-            }
-            auto index_of_vector_col = mb_index_of_vector_col.value();
+        uint32_t index_of_level_left = index_of_vector_row - projection;
 
-			if (index_of_vector_col < index_of_vector_row) {
-				continue;
-			}
+        auto key = ReducedMatrixElementsCache::to_key(center_a, center_a, index_of_level_left);
+        const auto* reduced_elements = reduced_matrix_elements_cache_.find(key);
+        if (reduced_elements == nullptr) {
+            ReducedMatrixElements calculated_elements;
+            wigner_eckart_helper_.construct_reduced_matrix_elements(
+                level_left, index_of_level_left, ranks, local_prod, *converter_, calculated_elements);
+            reduced_elements = &reduced_matrix_elements_cache_.emplace(key, std::move(calculated_elements));
+        }
 
-			double total_9j = wigner_eckart_helper_.total_9j_coefficient(level_left, level_right, ranks, local_prod);
-            double value = factor * total_9j;
+        for (const auto& reduced_element : *reduced_elements) {
+            auto index_of_vector_col = reduced_element.index_of_right_level + projection;
+            double value = factor * reduced_element.value;
 
             double real_projection = projection - ((double)level_left.total() - 1.0) / 2.0;
             double left_spin = ((double)level_left.total() - 1.0) / 2.0;
-            double right_spin = ((double)level_right.total() - 1.0) / 2.0;
+            double right_spin = ((double)reduced_element.total_multiplicity_of_right_level - 1.0) / 2.0;
             value *= wigner_eckart_helper_.clebsh_gordan_coefficient(left_spin, 2, right_spin, real_projection, 0);
 			if (value != 0.0) {
 				matrix.add_to_position(value, index_of_vector_row, index_of_vector_col);
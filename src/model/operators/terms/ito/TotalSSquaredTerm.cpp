@@ -12,7 +12,7 @@ std::unique_ptr<Term> TotalSSquaredTerm::clone() const {
 
 void TotalSSquaredTerm::construct(
 	quantum::linear_algebra::AbstractSymmetricMatrix& matrix,
-	const std::set<unsigned int>& indexes_of_vectors) const {
+	std::span<const uint32_t> indexes_of_vectors) const {
     for (const auto& index : indexes_of_vectors) {
 		auto multiplicity = converter_->convert_index_to_total_multiplicity(index);
 		auto spin = ((double)multiplicity - 1.0) / 2.0;
@@ -12,7 +12,7 @@ class TotalSSquaredTerm : public ZeroCenterTerm {
     std::unique_ptr<Term> clone() const override;
     void construct(
         quantum::linear_algebra::AbstractSymmetricMatrix& matrix,
-        const std::set<unsigned int>& indexes_of_vectors) const override;
+        std::span<const uint32_t> indexes_of_vectors) const override;
 
   private:
         std::shared_ptr<const index_converter::s_squared::IndexConverter> converter_;
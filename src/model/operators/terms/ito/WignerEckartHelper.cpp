@@ -4,8 +4,9 @@
 namespace model::operators::ito {
 
 WignerEckartHelper::WignerEckartHelper(
-	std::shared_ptr<const index_converter::s_squared::OrderOfSummation> order_of_summation
-) : order_of_summation_(order_of_summation) {}
+	std::shared_ptr<const index_converter::s_squared::OrderOfSummation> order_of_summation,
+	std::shared_ptr<const spin_algebra::ClebshGordanCalculator> clebshGordanCalculator
+) : clebshGordanCalculator_(std::move(clebshGordanCalculator)), order_of_summation_(order_of_summation) {}
 
 double WignerEckartHelper::clebsh_gordan_coefficient(
 	double l1,
@@ -13,7 +14,7 @@ double WignerEckartHelper::clebsh_gordan_coefficient(
 	double l3,
 	double m1,
 	double m2) const {
-	return clebshGordanCalculator_.clebsh_gordan_coefficient(l1, l2, l3, m1, m2);
+	return clebshGordanCalculator_->clebsh_gordan_coefficient(l1, l2, l3, m1, m2);
 }
 
 double WignerEckartHelper::local_product(
@@ -68,7 +69,7 @@ double WignerEckartHelper::total_9j_coefficient(
 		uint8_t rank_two = ranks.at(pos_two);
 		uint8_t rank_fin = ranks.at(pos_fin);
 
-		ninejs *= clebshGordanCalculator_.ninej_element(left_one, left_two, left_fin,
+		ninejs *= clebshGordanCalculator_->ninej_element(left_one, left_two, left_fin,
 														right_one, right_two, right_fin,
 														rank_one, rank_two, rank_fin);
 		if (ninejs == 0) {
@@ -154,4 +155,32 @@ void WignerEckartHelper::construct_overlapping_levels(
     }
 }
 
+void WignerEckartHelper::construct_reduced_matrix_elements(
+	const index_converter::s_squared::Level& level,
+	uint32_t index_of_level,
+	const std::vector<uint8_t>& ranks,
+	double local_prod,
+	const index_converter::s_squared::IndexConverter& converter,
+	ReducedMatrixElements& answer) const {
+	std::vector<index_converter::s_squared::Level> levels_right;
+	construct_overlapping_levels(level, ranks, levels_right);
+
+	answer.clear();
+	for (const auto& level_right : levels_right) {
+		auto mb_index_of_level_right = converter.convert_state_to_index(level_right, 0);
+		if (!mb_index_of_level_right.has_value()) {
+			continue;
+		}
+		auto index_of_level_right = mb_index_of_level_right.value();
+		if (index_of_level_right < index_of_level) {
+			continue;
+		}
+		double total_9j = total_9j_coefficient(level, level_right, ranks, local_prod);
+		if (total_9j == 0.0) {
+			continue;
+		}
+		answer.push_back({index_of_level_right, level_right.total(), total_9j});
+	}
+}
+
 } // namespace model::operators::ito
\ No newline at end of file
@@ -1,9 +1,11 @@
 #ifndef SPINNER_WIGNERECKARTHELPER_H
 #define SPINNER_WIGNERECKARTHELPER_H
 
+#include "src/common/index_converter/s_squared/IndexConverter.h"
 #include "src/common/index_converter/s_squared/Level.h"
 #include "src/common/index_converter/s_squared/OrderOfSummation.h"
 #include "src/spin_algebra/ClebshGordanCalculator.h"
+#include "ReducedMatrixElementsCache.h"
 
 namespace model::operators::ito {
 class WignerEckartHelper {
@@ -11,8 +13,9 @@ class WignerEckartHelper {
 
 	WignerEckartHelper() = delete;
 
-	explicit WignerEckartHelper(
-		std::shared_ptr<const index_converter::s_squared::OrderOfSummation> order_of_summation
+	WignerEckartHelper(
+		std::shared_ptr<const index_converter::s_squared::OrderOfSummation> order_of_summation,
+		std::shared_ptr<const spin_algebra::ClebshGordanCalculator> clebshGordanCalculator
 	);
 
 	double clebsh_gordan_coefficient(
@@ -36,8 +39,19 @@ class WignerEckartHelper {
 		const std::vector<uint8_t>& ranks,
 		std::vector<index_converter::s_squared::Level>& answer) const;
 
+	// Constructs non-zero total 9j-coefficients between level and all overlapping levels,
+	// which index is not less than index_of_level (i.e. upper triangle of the matrix):
+	void construct_reduced_matrix_elements(
+		const index_converter::s_squared::Level& level,
+		uint32_t index_of_level,
+		const std::vector<uint8_t>& ranks,
+		double local_prod,
+		const index_converter::s_squared::IndexConverter& converter,
+		ReducedMatrixElements& answer) const;
+
   private:
-	spin_algebra::ClebshGordanCalculator clebshGordanCalculator_;
+	// tables of coefficients are shared by all terms and threads:
+	std::shared_ptr<const spin_algebra::ClebshGordanCalculator> clebshGordanCalculator_;
 	std::shared_ptr<const index_converter::s_squared::OrderOfSummation> order_of_summation_;
 };
 } // namespace model::operators::ito
@@ -32,22 +32,60 @@ ScalarProductTerm::ScalarProductTerm(
 void ScalarProductTerm::construct(
     quantum::linear_algebra::AbstractSymmetricMatrix&
         matrix_in_lexicografical_basis,
-    const std::set<unsigned int>& indexes_of_vectors,
-    uint32_t center_a,
-    uint32_t center_b) const {
-    if (!std::isnan(coefficients_->at(center_a, center_b))) {
-        double factor = coefficients_->at(center_a, center_b) * prefactor_;
-        for (const auto& index_of_vector : indexes_of_vectors) {
-            add_scalar_product(
+    std::span<const uint32_t> indexes_of_vectors) const {
+    auto projections = converter_->convert_lex_indexes_to_all_sz_projections(indexes_of_vectors);
+    for (uint32_t center_a = 0; center_a < getNumberOfCenters(); ++center_a) {
+        for (uint32_t center_b = center_a + 1; center_b < getNumberOfCenters(); ++center_b) {
+            add_scalar_products(
                 matrix_in_lexicografical_basis,
-                index_of_vector,
+                indexes_of_vectors,
+                projections,
                 center_a,
-                center_b,
-                factor);
+                center_b);
         }
     }
 }
 
+void ScalarProductTerm::construct(
+    quantum::linear_algebra::AbstractSymmetricMatrix&
+        matrix_in_lexicografical_basis,
+    std::span<const uint32_t> indexes_of_vectors,
+    uint32_t center_a,
+    uint32_t center_b) const {
+    auto projections = converter_->convert_lex_indexes_to_all_sz_projections(indexes_of_vectors);
+    add_scalar_products(
+        matrix_in_lexicografical_basis,
+        indexes_of_vectors,
+        projections,
+        center_a,
+        center_b);
+}
+
+void ScalarProductTerm::add_scalar_products(
+    quantum::linear_algebra::AbstractSymmetricMatrix& matrix,
+    std::span<const uint32_t> indexes_of_vectors,
+    const std::vector<uint8_t>& projections,
+    uint32_t center_a,
+    uint32_t center_b) const {
+    if (std::isnan(coefficients_->at(center_a, center_b))) {
+        return;
+    }
+    double factor = coefficients_->at(center_a, center_b) * prefactor_;
+    const uint8_t* projections_of_center_a = projections.data() + center_a * indexes_of_vectors.size();
+    const uint8_t* projections_of_center_b = projections.data() + center_b * indexes_of_vectors.size();
+    for (size_t i = 0; i < indexes_of_vectors.size(); ++i) {
+        uint32_t index_of_vector = indexes_of_vectors[i];
+        add_scalar_product(
+            matrix,
+            index_of_vector,
+            center_a,
+            center_b,
+            projections_of_center_a[i],
+            projections_of_center_b[i],
+            factor);
+    }
+}
+
 std::unique_ptr<Term> ScalarProductTerm::clone() const {
     return std::make_unique<ScalarProductTerm>(converter_, coefficients_, prefactor_);
 }
@@ -57,11 +95,9 @@ void ScalarProductTerm::add_scalar_product(
     uint32_t index_of_vector,
     uint32_t center_a,
     uint32_t center_b,
+    uint32_t projection_of_center_a,
+    uint32_t projection_of_center_b,
     double factor) const {
-    uint32_t projection_of_center_a =
-        converter_->convert_lex_index_to_one_sz_projection(index_of_vector, center_a);
-    uint32_t projection_of_center_b =
-        converter_->convert_lex_index_to_one_sz_projection(index_of_vector, center_b);
 
     // (Sa, Sb) = Sax*Sbx + Say*Sby + Saz*Sbz = 0.5 * (Sa+Sb- + Sa-Sb+) + Saz*Sbz
 
@@ -17,10 +17,15 @@ class ScalarProductTerm: public TwoCenterTerm {
 
     std::unique_ptr<Term> clone() const override;
 
+    // projections are decoded once for all pairs of centers:
     void construct(
         quantum::linear_algebra::AbstractSymmetricMatrix&
             matrix_in_lexicografical_basis,
-        const std::set<unsigned int>& indexes_of_vectors,
+        std::span<const uint32_t> indexes_of_vectors) const override;
+    void construct(
+        quantum::linear_algebra::AbstractSymmetricMatrix&
+            matrix_in_lexicografical_basis,
+        std::span<const uint32_t> indexes_of_vectors,
         uint32_t center_a,
         uint32_t center_b) const override;
 
@@ -28,11 +33,19 @@ class ScalarProductTerm: public TwoCenterTerm {
     std::shared_ptr<const index_converter::lexicographic::IndexConverter> converter_;
     std::shared_ptr<const TwoDNumericalParameters<double>> coefficients_;
     double prefactor_;
+    void add_scalar_products(
+        quantum::linear_algebra::AbstractSymmetricMatrix& matrix,
+        std::span<const uint32_t> indexes_of_vectors,
+        const std::vector<uint8_t>& projections,
+        uint32_t center_a,
+        uint32_t center_b) const;
     void add_scalar_product(
         quantum::linear_algebra::AbstractSymmetricMatrix& matrix,
         uint32_t index_of_vector,
         uint32_t center_a,
         uint32_t center_b,
+        uint32_t projection_of_center_a,
+        uint32_t projection_of_center_b,
         double factor) const;
     void add_scalar_product_nondiagonal_part(
         quantum::linear_algebra::AbstractSymmetricMatrix& matrix,
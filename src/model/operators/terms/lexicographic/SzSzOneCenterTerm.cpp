@@ -11,23 +11,38 @@ std::unique_ptr<Term> SzSzOneCenterTerm::clone() const {
 void SzSzOneCenterTerm::construct(
     quantum::linear_algebra::AbstractSymmetricMatrix&
         matrix_in_lexicografical_basis,
-    const std::set<unsigned int>& indexes_of_vectors,
-    uint32_t center_a) const {
-    double factor = coefficients_->at(center_a);
+    std::span<const uint32_t> indexes_of_vectors) const {
+    auto projections = converter_->convert_lex_indexes_to_all_sz_projections(indexes_of_vectors);
+    for (uint32_t center_a = 0; center_a < getNumberOfCenters(); ++center_a) {
+        add_szsz(matrix_in_lexicografical_basis, indexes_of_vectors, projections, center_a);
+    }
+}
 
-    if (!std::isnan(factor)) {
-        for (const auto& index_of_vector : indexes_of_vectors) {
-            uint32_t projection_of_center_a =
-                converter_->convert_lex_index_to_one_sz_projection(index_of_vector, center_a);
+void SzSzOneCenterTerm::construct(
+    quantum::linear_algebra::AbstractSymmetricMatrix&
+        matrix_in_lexicografical_basis,
+    std::span<const uint32_t> indexes_of_vectors,
+    uint32_t center_a) const {
+    auto projections = converter_->convert_lex_indexes_to_all_sz_projections(indexes_of_vectors);
+    add_szsz(matrix_in_lexicografical_basis, indexes_of_vectors, projections, center_a);
+}
 
-            // Saz Saz
-            double diagonal_value = (projection_of_center_a - converter_->get_spins()[center_a])
-                * (projection_of_center_a - converter_->get_spins()[center_a]) * factor;
-            matrix_in_lexicografical_basis.add_to_position(
-                diagonal_value,
-                index_of_vector,
-                index_of_vector);
-        }
+void SzSzOneCenterTerm::add_szsz(
+    quantum::linear_algebra::AbstractSymmetricMatrix& matrix,
+    std::span<const uint32_t> indexes_of_vectors,
+    const std::vector<uint8_t>& projections,
+    uint32_t center_a) const {
+    double factor = coefficients_->at(center_a);
+    if (std::isnan(factor)) {
+        return;
+    }
+    const uint8_t* projections_of_center_a = projections.data() + center_a * indexes_of_vectors.size();
+    for (size_t i = 0; i < indexes_of_vectors.size(); ++i) {
+        uint32_t index_of_vector = indexes_of_vectors[i];
+        // Saz Saz
+        double diagonal_value = (projections_of_center_a[i] - converter_->get_spins()[center_a])
+            * (projections_of_center_a[i] - converter_->get_spins()[center_a]) * factor;
+        matrix.add_to_position(diagonal_value, index_of_vector, index_of_vector);
     }
 }
 
@@ -14,15 +14,25 @@ class SzSzOneCenterTerm: public OneCenterTerm {
         std::shared_ptr<const index_converter::lexicographic::IndexConverter> converter,
         std::shared_ptr<const OneDNumericalParameters<double>> coefficients);
     std::unique_ptr<Term> clone() const override;
+    // projections are decoded once for all centers:
     void construct(
         quantum::linear_algebra::AbstractSymmetricMatrix&
             matrix_in_lexicografical_basis,
-        const std::set<unsigned int>& indexes_of_vectors,
+        std::span<const uint32_t> indexes_of_vectors) const override;
+    void construct(
+        quantum::linear_algebra::AbstractSymmetricMatrix&
+            matrix_in_lexicografical_basis,
+        std::span<const uint32_t> indexes_of_vectors,
         uint32_t center_a) const override;
 
   private:
     std::shared_ptr<const index_converter::lexicographic::IndexConverter> converter_;
     std::shared_ptr<const OneDNumericalParameters<double>> coefficients_;
+    void add_szsz(
+        quantum::linear_algebra::AbstractSymmetricMatrix& matrix,
+        std::span<const uint32_t> indexes_of_vectors,
+        const std::vector<uint8_t>& projections,
+        uint32_t center_a) const;
 };
 }  // namespace model::operators::lexicographic
 #endif  //SPINNER_LEXSZSZONECENTERTERM_H
@@ -14,10 +14,15 @@ class SzSzTwoCenterTerm: public TwoCenterTerm {
         std::shared_ptr<const TwoDNumericalParameters<double>> parameters,
         double prefactor = 1);
     std::unique_ptr<Term> clone() const override;
+    // projections are decoded once for all pairs of centers:
     void construct(
         quantum::linear_algebra::AbstractSymmetricMatrix&
             matrix_in_lexicografical_basis,
-        const std::set<unsigned int>& indexes_of_vectors,
+        std::span<const uint32_t> indexes_of_vectors) const override;
+    void construct(
+        quantum::linear_algebra::AbstractSymmetricMatrix&
+            matrix_in_lexicografical_basis,
+        std::span<const uint32_t> indexes_of_vectors,
         uint32_t center_a,
         uint32_t center_b) const override;
 
@@ -25,6 +30,12 @@ class SzSzTwoCenterTerm: public TwoCenterTerm {
     std::shared_ptr<const index_converter::lexicographic::IndexConverter> converter_;
     std::shared_ptr<const TwoDNumericalParameters<double>> coefficients_;
     double prefactor_;
+    void add_szsz(
+        quantum::linear_algebra::AbstractSymmetricMatrix& matrix,
+        std::span<const uint32_t> indexes_of_vectors,
+        const std::vector<uint8_t>& projections,
+        uint32_t center_a,
+        uint32_t center_b) const;
 };
 }  // namespace model::operators::lexicographic
 #endif  //SPINNER_LEXSZSZTWOCENTERTERM_H
@@ -0,0 +1,279 @@
+#include "SpaceCache.h"
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+#include "src/common/CacheFile.h"
+#include "src/common/Logger.h"
+
+namespace {
+const char MAGIC[8] = {'S', 'P', 'A', 'C', 'E', '0', '0', '1'};
+const std::string EXTENSION = ".space";
+
+// All offsets are counted from the beginning of the file.
+// Layout: Header | key | BlockRecords | representations | column pointers | row indexes | values.
+struct Header {
+    char magic[8];
+    uint64_t file_size;
+    uint64_t key_size;
+    uint64_t number_of_blocks;
+};
+
+struct BlockRecord {
+    uint32_t n_proj;
+    uint32_t total_mult;
+    uint32_t dimensionality;
+    uint8_t has_n_proj;
+    uint8_t has_total_mult;
+    uint8_t padding[2];
+    double degeneracy;
+    uint64_t representation_offset;
+    uint64_t representation_size;
+    uint32_t size_rows;
+    uint32_t size_cols;
+    // size_cols + 1 numbers, the j-th column is [column_pointers[j], column_pointers[j+1]):
+    uint64_t column_pointers_offset;
+    uint64_t row_indexes_offset;
+    uint64_t values_offset;
+    uint64_t number_of_nonzeros;
+};
+
+// decomposition of block in compressed sparse column format:
+struct CompressedColumns {
+    std::vector<uint64_t> column_pointers;
+    std::vector<uint32_t> row_indexes;
+    std::vector<double> values;
+};
+
+CompressedColumns compress(const quantum::linear_algebra::AbstractSparseSemiunitaryMatrix& decomposition) {
+    CompressedColumns compressed;
+    compressed.column_pointers.reserve(decomposition.size_cols() + 1);
+    compressed.column_pointers.push_back(0);
+    for (uint32_t j = 0; j < decomposition.size_cols(); ++j) {
+        auto iterator = decomposition.GetNewIterator(j);
+        while (iterator->hasNext()) {
+            auto item = iterator->getNext();
+            compressed.row_indexes.push_back(item.index);
+            compressed.values.push_back(item.value);
+        }
+        compressed.column_pointers.push_back(compressed.values.size());
+    }
+    return compressed;
+}
+}  // namespace
+
+namespace space {
+
+void SpaceCache::setDirectory(std::filesystem::path directory) {
+    std::error_code error_code;
+    std::filesystem::create_directories(directory, error_code);
+    if (error_code || !std::filesystem::is_directory(directory)) {
+        throw std::invalid_argument("Cannot create directory of space cache: " + directory.string());
+    }
+    directory_ = std::move(directory);
+}
+
+void SpaceCache::setSizeLimit(size_t size_limit) {
+    if (size_limit == 0) {
+        throw std::invalid_argument("Size limit of space cache must be positive");
+    }
+    size_limit_ = size_limit;
+}
+
+bool SpaceCache::isEnabled() {
+    return directory_.has_value();
+}
+
+void SpaceCache::disable() {
+    directory_ = std::nullopt;
+    size_limit_ = std::numeric_limits<size_t>::max();
+}
+
+std::string
+SpaceCache::constructKey(const runner::ConsistentModelOptimizationList& consistentModelOptimizationList) {
+    std::ostringstream key;
+
+    key << "mults:";
+    for (auto mult : consistentModelOptimizationList.getIndexConverter()->get_mults()) {
+        key << ' ' << mult;
+    }
+
+    const auto& optimization_list = consistentModelOptimizationList.getOptimizationList();
+    key << "\noptimizations:"
+        << " basis=" << (optimization_list.isITOBasis() ? "ITO" : "LEX")
+        << " tz_sort=" << optimization_list.isTzSorted()
+        << " t_squared_sort=" << optimization_list.isTSquaredSorted()
+        << " positive_projections_elimination=" << optimization_list.isPositiveProjectionsEliminated()
+        << " non_minimal_projections_elimination=" << optimization_list.isNonMinimalProjectionsEliminated()
+        << " non_abelian_simplification=" << optimization_list.isNonAbelianSimplified();
+    for (const auto& group : optimization_list.getGroupsToApply()) {
+        key << "\ngroup:";
+        for (const auto& element : group.getElements()) {
+            key << ' ';
+            for (auto index : element) {
+                key << (unsigned)index << ',';
+            }
+        }
+    }
+
+    return key.str();
+}
+
+std::optional<Space>
+SpaceCache::load(const std::string& key, const quantum::linear_algebra::FactoriesList& factories) {
+    if (!isEnabled()) {
+        return std::nullopt;
+    }
+    auto path = common::cache::pathOfEntry(directory_.value(), key, EXTENSION);
+    if (!std::filesystem::exists(path)) {
+        return std::nullopt;
+    }
+    common::cache::MappedFile file(path);
+    if (!file.contains(0, sizeof(Header))) {
+        return std::nullopt;
+    }
+    Header header;
+    std::memcpy(&header, file.data(), sizeof(Header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.file_size != file.size()
+        || !file.contains(sizeof(Header), header.key_size)
+        || std::string_view(file.data() + sizeof(Header), header.key_size) != key) {
+        // the file is corrupted or it is a hash collision:
+        return std::nullopt;
+    }
+    uint64_t records_offset = common::cache::alignTo8(sizeof(Header) + header.key_size);
+    if (!file.containsArray<BlockRecord>(records_offset, header.number_of_blocks)) {
+        return std::nullopt;
+    }
+
+    std::vector<Subspace> blocks;
+    blocks.reserve(header.number_of_blocks);
+    for (uint64_t i = 0; i < header.number_of_blocks; ++i) {
+        BlockRecord record;
+        std::memcpy(&record, file.data() + records_offset + i * sizeof(BlockRecord), sizeof(BlockRecord));
+        if (!file.contains(record.representation_offset, record.representation_size)
+            || !file.containsArray<uint64_t>(record.column_pointers_offset, (uint64_t)record.size_cols + 1)
+            || !file.containsArray<uint32_t>(record.row_indexes_offset, record.number_of_nonzeros)
+            || !file.containsArray<double>(record.values_offset, record.number_of_nonzeros)) {
+            return std::nullopt;
+        }
+        auto column_pointers = reinterpret_cast<const uint64_t*>(file.data() + record.column_pointers_offset);
+        auto row_indexes = reinterpret_cast<const uint32_t*>(file.data() + record.row_indexes_offset);
+        auto values = reinterpret_cast<const double*>(file.data() + record.values_offset);
+        if (column_pointers[record.size_cols] != record.number_of_nonzeros) {
+            return std::nullopt;
+        }
+
+        auto decomposition = factories.createSparseSemiunitaryMatrix(record.size_cols, record.size_rows);
+        for (uint32_t j = 0; j < record.size_cols; ++j) {
+            if (column_pointers[j] > column_pointers[j + 1]) {
+                return std::nullopt;
+            }
+            for (uint64_t k = column_pointers[j]; k < column_pointers[j + 1]; ++k) {
+                if (row_indexes[k] >= record.size_rows) {
+                    return std::nullopt;
+                }
+                decomposition->add_to_position(values[k], j, row_indexes[k]);
+            }
+        }
+        Subspace subspace(std::move(decomposition));
+        if (record.has_n_proj) {
+            subspace.properties.n_proj = record.n_proj;
+        }
+        if (record.has_total_mult) {
+            subspace.properties.total_mult = record.total_mult;
+        }
+        subspace.properties.dimensionality = record.dimensionality;
+        subspace.properties.degeneracy = record.degeneracy;
+        subspace.properties.representation.assign(
+            file.data() + record.representation_offset,
+            file.data() + record.representation_offset + record.representation_size);
+        blocks.emplace_back(std::move(subspace));
+    }
+
+    common::cache::markAsRecentlyUsed(path);
+    return Space(std::move(blocks));
+}
+
+void SpaceCache::store(const std::string& key, const Space& space) {
+    if (!isEnabled()) {
+        return;
+    }
+    const auto& blocks = space.getBlocks();
+
+    std::vector<CompressedColumns> compressed_blocks;
+    compressed_blocks.reserve(blocks.size());
+    for (const auto& subspace : blocks) {
+        compressed_blocks.push_back(compress(*subspace.decomposition));
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.key_size = key.size();
+    header.number_of_blocks = blocks.size();
+    uint64_t offset = common::cache::alignTo8(sizeof(Header) + key.size()) + blocks.size() * sizeof(BlockRecord);
+    std::vector<BlockRecord> records(blocks.size());
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        const auto& properties = blocks[i].properties;
+        auto& record = records[i];
+        record.has_n_proj = properties.n_proj.has_value();
+        record.n_proj = properties.n_proj.value_or(0);
+        record.has_total_mult = properties.total_mult.has_value();
+        record.total_mult = properties.total_mult.value_or(0);
+        record.dimensionality = properties.dimensionality;
+        record.degeneracy = properties.degeneracy;
+        record.representation_offset = offset;
+        record.representation_size = properties.representation.size();
+        offset += properties.representation.size();
+    }
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        auto& record = records[i];
+        const auto& compressed = compressed_blocks[i];
+        record.size_rows = blocks[i].decomposition->size_rows();
+        record.size_cols = blocks[i].decomposition->size_cols();
+        record.number_of_nonzeros = compressed.values.size();
+        offset = common::cache::alignTo8(offset);
+        record.column_pointers_offset = offset;
+        offset += compressed.column_pointers.size() * sizeof(uint64_t);
+        record.row_indexes_offset = offset;
+        offset += compressed.row_indexes.size() * sizeof(uint32_t);
+        offset = common::cache::alignTo8(offset);
+        record.values_offset = offset;
+        offset += compressed.values.size() * sizeof(double);
+    }
+    header.file_size = offset;
+
+    auto path = common::cache::pathOfEntry(directory_.value(), key, EXTENSION);
+    bool is_written = common::cache::writeEntry(path, [&](std::ofstream& stream) {
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        stream.write(key.data(), key.size());
+        common::cache::writePaddingTo8(stream);
+        stream.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(BlockRecord));
+        for (const auto& subspace : blocks) {
+            const auto& representation = subspace.properties.representation;
+            stream.write(reinterpret_cast<const char*>(representation.data()), representation.size());
+        }
+        for (const auto& compressed : compressed_blocks) {
+            common::cache::writePaddingTo8(stream);
+            stream.write(
+                reinterpret_cast<const char*>(compressed.column_pointers.data()),
+                compressed.column_pointers.size() * sizeof(uint64_t));
+            stream.write(
+                reinterpret_cast<const char*>(compressed.row_indexes.data()),
+                compressed.row_indexes.size() * sizeof(uint32_t));
+            common::cache::writePaddingTo8(stream);
+            stream.write(
+                reinterpret_cast<const char*>(compressed.values.data()),
+                compressed.values.size() * sizeof(double));
+        }
+    });
+    if (!is_written) {
+        common::Logger::detailed("Space cannot be written to the cache: {}", path.string());
+        return;
+    }
+
+    common::cache::removeLeastRecentlyUsedEntries(directory_.value(), EXTENSION, size_limit_);
+}
+
+}  // namespace space
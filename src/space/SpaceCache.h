@@ -0,0 +1,41 @@
+#ifndef SPINNER_SPACECACHE_H
+#define SPINNER_SPACECACHE_H
+
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <string>
+
+#include "src/common/runner/ConsistentModelOptimizationList.h"
+#include "src/entities/data_structures/FactoriesList.h"
+#include "src/space/Space.h"
+
+namespace space {
+// Content-addressed on-disk cache of Space constructed by OptimizedSpaceConstructor.
+// The key describes everything Space depends on: multiplicities, basis and optimizations.
+// Every entry is one file, whose name is the hash of the key. The file contains the key itself
+// (to reject hash collisions), properties of blocks and decompositions of blocks
+// in compressed sparse column format, so it is read by memory mapping.
+// If the total size of the entries exceeds the size limit, the least recently used entries are removed.
+class SpaceCache {
+  public:
+    // the cache is disabled, until the directory is set:
+    static void setDirectory(std::filesystem::path directory);
+    static void setSizeLimit(size_t size_limit);
+    static bool isEnabled();
+    // disables the cache and removes the size limit, entries on disk are kept:
+    static void disable();
+
+    static std::string
+    constructKey(const runner::ConsistentModelOptimizationList& consistentModelOptimizationList);
+    static std::optional<Space>
+    load(const std::string& key, const quantum::linear_algebra::FactoriesList& factories);
+    static void store(const std::string& key, const Space& space);
+
+  private:
+    inline static std::optional<std::filesystem::path> directory_;
+    inline static size_t size_limit_ = std::numeric_limits<size_t>::max();
+};
+}  // namespace space
+
+#endif  //SPINNER_SPACECACHE_H
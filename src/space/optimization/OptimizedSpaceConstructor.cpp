@@ -3,6 +3,7 @@
 
 #include "src/common/Logger.h"
 #include "src/common/physical_optimization/OptimizationList.h"
+#include "src/space/SpaceCache.h"
 #include "src/space/optimization/NonAbelianSimplifier.h"
 #include "src/space/optimization/PositiveProjectionsEliminator.h"
 #include "src/space/optimization/NonMinimalProjectionsEliminator.h"
@@ -38,6 +39,18 @@ Space OptimizedSpaceConstructor::construct(
     const runner::ConsistentModelOptimizationList& consistentModelOptimizationList,
     const quantum::linear_algebra::FactoriesList& factories) {
 
+    std::string cache_key;
+    if (SpaceCache::isEnabled()) {
+        cache_key = SpaceCache::constructKey(consistentModelOptimizationList);
+        auto mb_space = SpaceCache::load(cache_key, factories);
+        if (mb_space.has_value()) {
+            common::Logger::detailed_msg("Space was loaded from the cache.");
+            print_sizes_of_blocks(mb_space.value());
+            common::Logger::separate(0, common::detailed);
+            return std::move(mb_space.value());
+        }
+    }
+
     const common::physical_optimization::OptimizationList& optimizationList =
         consistentModelOptimizationList.getOptimizationList();
 
@@ -133,6 +146,10 @@ Space OptimizedSpaceConstructor::construct(
 
     common::Logger::separate(0, common::detailed);
 
+    if (SpaceCache::isEnabled()) {
+        SpaceCache::store(cache_key, space);
+    }
+
     return space;
 }
 }  // namespace space::optimization
\ No newline at end of file
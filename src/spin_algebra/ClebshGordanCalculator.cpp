@@ -1,14 +1,106 @@
 #include "ClebshGordanCalculator.h"
 
-#include <omp.h>
 #include <wignerSymbols.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 #include <string>
 
+namespace {
+int doubled(double value) {
+    return (int)std::lround(2 * value);
+}
+
+// all arguments are doubled spins:
+bool is_triangle(int a, int b, int c) {
+    return std::abs(a - b) <= c && c <= a + b && (a + b + c) % 2 == 0;
+}
+}  // namespace
+
 namespace spin_algebra {
 
-ClebshGordanCalculator::ClebshGordanCalculator() {
-    hashed_CGs_for_all_threads = std::vector<Map>(omp_get_max_threads());
-    hashed_W6Js_for_all_threads = std::vector<Map>(omp_get_max_threads());
+ClebshGordanCalculator::ClebshGordanCalculator(uint32_t max_doubled_spin) {
+    if (max_doubled_spin == 0) {
+        return;
+    }
+    // ninej_element sums over right_one + 1 and uses ranks as spins in 6j-symbols:
+    number_of_doubled_spins_ = (int)std::max(max_doubled_spin, (uint32_t)2 * MAX_RANK) + 3;
+    // size of 6j-table grows as cube of number of spins, bigger spins are calculated directly:
+    number_of_doubled_spins_ = std::min(number_of_doubled_spins_, MAX_NUMBER_OF_DOUBLED_SPINS);
+    for (int rank = 0; rank <= MAX_RANK; ++rank) {
+        fill_clebsh_gordan_table(rank);
+        fill_wigner6j_table(rank);
+    }
+}
+
+size_t ClebshGordanCalculator::clebsh_gordan_position(int rank, int l1, int l3, int m1, int m2) const {
+    size_t width = 2 * rank + 1;
+    size_t position = l1;
+    position = position * width + (l3 - l1 + 2 * rank) / 2;
+    position = position * number_of_doubled_spins_ + (m1 + l1) / 2;
+    position = position * width + (m2 + 2 * rank) / 2;
+    return position;
+}
+
+size_t ClebshGordanCalculator::wigner6j_position(int rank, int l1, int l2, int l4, int l5, int l6) const {
+    size_t width = 2 * rank + 1;
+    size_t position = l1;
+    position = position * width + (l2 - l1 + 2 * rank) / 2;
+    position = position * number_of_doubled_spins_ + l4;
+    position = position * width + (l5 - l4 + 2 * rank) / 2;
+    position = position * number_of_doubled_spins_ + l6;
+    return position;
+}
+
+void ClebshGordanCalculator::fill_clebsh_gordan_table(int rank) {
+    int width = 2 * rank + 1;
+    auto& table = clebsh_gordan_tables_[rank];
+    table.assign((size_t)number_of_doubled_spins_ * width * number_of_doubled_spins_ * width, 0);
+    for (int l1 = 0; l1 < number_of_doubled_spins_; ++l1) {
+        for (int l3 = l1 - 2 * rank; l3 <= l1 + 2 * rank; l3 += 2) {
+            if (l3 < 0 || !is_triangle(l1, 2 * rank, l3)) {
+                continue;
+            }
+            for (int m1 = -l1; m1 <= l1; m1 += 2) {
+                for (int m2 = -2 * rank; m2 <= 2 * rank; m2 += 2) {
+                    if (std::abs(m1 + m2) > l3) {
+                        continue;
+                    }
+                    table[clebsh_gordan_position(rank, l1, l3, m1, m2)] = WignerSymbols::clebschGordan(
+                        l1 / 2.0, rank, l3 / 2.0, m1 / 2.0, m2 / 2.0, (m1 + m2) / 2.0);
+                }
+            }
+        }
+    }
+}
+
+void ClebshGordanCalculator::fill_wigner6j_table(int rank) {
+    int width = 2 * rank + 1;
+    auto& table = wigner6j_tables_[rank];
+    table.assign(
+        (size_t)number_of_doubled_spins_ * width * number_of_doubled_spins_ * width * number_of_doubled_spins_, 0);
+#pragma omp parallel for schedule(dynamic)
+    for (int l1 = 0; l1 < number_of_doubled_spins_; ++l1) {
+        for (int l2 = std::abs(l1 - 2 * rank); l2 <= l1 + 2 * rank && l2 < number_of_doubled_spins_; l2 += 2) {
+            if (!is_triangle(l1, l2, 2 * rank)) {
+                continue;
+            }
+            for (int l4 = 0; l4 < number_of_doubled_spins_; ++l4) {
+                for (int l5 = std::abs(l4 - 2 * rank); l5 <= l4 + 2 * rank && l5 < number_of_doubled_spins_; l5 += 2) {
+                    if (!is_triangle(l4, l5, 2 * rank)) {
+                        continue;
+                    }
+                    for (int l6 = std::abs(l1 - l5); l6 <= l1 + l5 && l6 < number_of_doubled_spins_; l6 += 2) {
+                        if (!is_triangle(l4, l2, l6)) {
+                            continue;
+                        }
+                        table[wigner6j_position(rank, l1, l2, l4, l5, l6)] = WignerSymbols::wigner6j(
+                            l1 / 2.0, l2 / 2.0, rank, l4 / 2.0, l5 / 2.0, l6 / 2.0);
+                    }
+                }
+            }
+        }
+    }
 }
 
 double ClebshGordanCalculator::clebsh_gordan_coefficient(
@@ -20,17 +112,16 @@ double ClebshGordanCalculator::clebsh_gordan_coefficient(
     if (l1 + l2 < l3 || std::abs(l1 - l2) > l3) {
         return 0;
     }
-    auto key = to_key(l1, l2, l3, m1, m2);
-    // todo: calculate omp_get_thread_num() outside of this function?
-    Map& hashed_CGs_per_thread = hashed_CGs_for_all_threads.at(omp_get_thread_num());
-
-    if (hashed_CGs_per_thread.contains(key)) {
-        return hashed_CGs_per_thread.at(key);
-    } else {
-        double value = WignerSymbols::clebschGordan(l1, l2, l3, m1, m2, m1 + m2);
-        hashed_CGs_per_thread.emplace(key, value);
-        return value;
+    int l1_ = doubled(l1), l2_ = doubled(l2), l3_ = doubled(l3), m1_ = doubled(m1), m2_ = doubled(m2);
+    if (l2_ % 2 == 0 && l2_ <= 2 * MAX_RANK && l1_ < number_of_doubled_spins_ && l3_ < number_of_doubled_spins_) {
+        if (!is_triangle(l1_, l2_, l3_) || std::abs(m1_) > l1_ || (m1_ + l1_) % 2 != 0
+            || std::abs(m2_) > l2_ || m2_ % 2 != 0 || std::abs(m1_ + m2_) > l3_) {
+            return 0;
+        }
+        int rank = l2_ / 2;
+        return clebsh_gordan_tables_[rank][clebsh_gordan_position(rank, l1_, l3_, m1_, m2_)];
     }
+    return WignerSymbols::clebschGordan(l1, l2, l3, m1, m2, m1 + m2);
 }
 
 double ClebshGordanCalculator::wigner6j_coefficient(
@@ -40,54 +131,18 @@ double ClebshGordanCalculator::wigner6j_coefficient(
     double l4,
     double l5,
     double l6) const {
-    auto key = to_key(l1, l2, l3, l4, l5, l6);
-    Map& hashed_W6J_per_thread = hashed_W6Js_for_all_threads.at(omp_get_thread_num());
-
-    if (hashed_W6J_per_thread.contains(key)) {
-        return hashed_W6J_per_thread.at(key);
-    } else {
-        double value = WignerSymbols::wigner6j(l1, l2, l3, l4, l5, l6);
-        hashed_W6J_per_thread.emplace(key, value);
-        return value;
+    int l1_ = doubled(l1), l2_ = doubled(l2), l3_ = doubled(l3), l4_ = doubled(l4), l5_ = doubled(l5),
+        l6_ = doubled(l6);
+    int maximum = std::max({l1_, l2_, l4_, l5_, l6_});
+    if (l3_ % 2 == 0 && l3_ <= 2 * MAX_RANK && maximum < number_of_doubled_spins_) {
+        if (!is_triangle(l1_, l2_, l3_) || !is_triangle(l1_, l5_, l6_)
+            || !is_triangle(l4_, l2_, l6_) || !is_triangle(l4_, l5_, l3_)) {
+            return 0;
+        }
+        int rank = l3_ / 2;
+        return wigner6j_tables_[rank][wigner6j_position(rank, l1_, l2_, l4_, l5_, l6_)];
     }
-}
-
-uint64_t
-ClebshGordanCalculator::to_key(double l1, double l2, double l3, double m1, double m2) noexcept {
-    // NB: each value cannot be bigger than BASE
-    const uint64_t BASE = 4096;
-    auto ul1 = (uint64_t)(2 * l1);
-    auto ul2 = (uint64_t)(2 * l2);
-    auto ul3 = (uint64_t)(2 * l3);
-    auto um1 = (uint64_t)(m1 + l1);
-    auto um2 = (uint64_t)(m2 + l2);
-    uint64_t answer = 0;
-    answer |= ul1;
-    answer |= ul2 * BASE;
-    answer |= ul3 * BASE * BASE;
-    answer |= um1 * BASE * BASE * BASE;
-    answer |= um2 * BASE * BASE * BASE * BASE;
-    return answer;
-}
-
-uint64_t ClebshGordanCalculator::to_key(double l1, double l2, double l3,
-                                        double l4, double l5, double l6) noexcept {
-    // NB: each value cannot be bigger than BASE
-    const uint64_t BASE = 1024;
-    auto ul1 = (uint64_t)(2 * l1);
-    auto ul2 = (uint64_t)(2 * l2);
-    auto ul3 = (uint64_t)(2 * l3);
-    auto ul4 = (uint64_t)(2 * l4);
-    auto ul5 = (uint64_t)(2 * l5);
-    auto ul6 = (uint64_t)(2 * l6);
-    uint64_t answer = 0;
-    answer |= ul1;
-    answer |= ul2 * BASE;
-    answer |= ul3 * BASE * BASE;
-    answer |= ul4 * BASE * BASE * BASE;
-    answer |= ul5 * BASE * BASE * BASE * BASE;
-    answer |= ul6 * BASE * BASE * BASE * BASE * BASE;
-    return answer;
+    return WignerSymbols::wigner6j(l1, l2, l3, l4, l5, l6);
 }
 
 double ClebshGordanCalculator::ninej_element(
@@ -1,17 +1,19 @@
 #ifndef SPINNER_CLEBSHGORDANCALCULATOR_H
 #define SPINNER_CLEBSHGORDANCALCULATOR_H
 
-#include <hash_table8.hpp>
+#include <array>
+#include <cstdint>
 #include <vector>
 
-#include "src/common/MumxHash.h"
-
 namespace spin_algebra {
 class ClebshGordanCalculator {
   public:
-    using Map = emhash8::HashMap<uint64_t, double, ankerl::MumxHash<uint64_t>>;
-
-    ClebshGordanCalculator();
+    // Wigner-Eckart theorem requires CG coefficients (l1 rank l3; m1 m2) and 6j-symbols {l1 l2 rank; l4 l5 l6}
+    // with rank of irreducible tensor operator up to MAX_RANK. They are precomputed for all spins
+    // up to max_doubled_spin / 2 (and a bit more for ninej_element) in dense tables indexed by
+    // doubled quantum numbers. The tables are read-only after construction, so one calculator
+    // can be shared by all threads. Other coefficients are calculated directly.
+    explicit ClebshGordanCalculator(uint32_t max_doubled_spin = 0);
 
     double clebsh_gordan_coefficient(double l1, double l2, double l3, double m1, double m2) const;
 
@@ -22,17 +24,21 @@ class ClebshGordanCalculator {
     double wigner6j_coefficient(double l1, double l2, double l3,
                                 double l4, double l5, double l6) const;
 
-    static uint64_t to_key(double l1, double l2, double l3, double m1, double m2) noexcept;
-    static uint64_t to_key(double l1, double l2, double l3,
-                           double l4, double l5, double l6) noexcept;
-
   private:
-    // we use caching of CG and W6j values to speed up calculations.
-    // real concurrent hashmaps are too slow for our task,
-    // thus we will use ordinary ones -- one per each thread,
-    // this solution already significantly improves performance
-    mutable std::vector<Map> hashed_CGs_for_all_threads;
-    mutable std::vector<Map> hashed_W6Js_for_all_threads;
+    static constexpr int MAX_RANK = 2;
+    static constexpr int MAX_NUMBER_OF_DOUBLED_SPINS = 64;
+    // tabulated doubled spins are [0, number_of_doubled_spins_):
+    int number_of_doubled_spins_ = 0;
+    // clebsh_gordan_tables_[rank] contains (l1 rank l3; m1 m2):
+    std::array<std::vector<double>, MAX_RANK + 1> clebsh_gordan_tables_;
+    // wigner6j_tables_[rank] contains {l1 l2 rank; l4 l5 l6}:
+    std::array<std::vector<double>, MAX_RANK + 1> wigner6j_tables_;
+
+    // all arguments are doubled quantum numbers:
+    size_t clebsh_gordan_position(int rank, int l1, int l3, int m1, int m2) const;
+    size_t wigner6j_position(int rank, int l1, int l2, int l4, int l5, int l6) const;
+    void fill_clebsh_gordan_table(int rank);
+    void fill_wigner6j_table(int rank);
 };
 }  // namespace spin_algebra
 
@@ -0,0 +1,52 @@
+#include <cmath>
+#include "gtest/gtest.h"
+#include "src/common/physical_optimization/OptimizationList.h"
+#include "src/common/runner/Runner.h"
+
+namespace {
+size_t number_of_calculated_states(runner::Runner& runner) {
+    size_t answer = 0;
+    auto spectrum = runner.getSpectrum(common::Energy).value();
+    for (const auto& subspectrum : getOneRef(spectrum).blocks) {
+        answer += subspectrum.get().raw_data->size();
+    }
+    return answer;
+}
+}  // namespace
+
+TEST(boltzmann_window, 8x2_AFM_ring_mu_squared_is_equal_to_exact_one) {
+    std::vector<spin_algebra::Multiplicity> mults = {2, 2, 2, 2, 2, 2, 2, 2};
+    model::ModelInput model(mults);
+    // different g-factors require eigenvectors to calculate M^2:
+    auto g_odd = model.addSymbol("g1", 2.0);
+    auto g_even = model.addSymbol("g2", 2.2);
+    auto J_odd = model.addSymbol("J1", -50.0);
+    auto J_even = model.addSymbol("J2", -30.0);
+    for (int center = 0; center < mults.size(); ++center) {
+        model.assignSymbolToGFactor(center % 2 == 0 ? g_even : g_odd, center);
+        model.assignSymbolToIsotropicExchange(
+            center % 2 == 0 ? J_even : J_odd,
+            center,
+            (center + 1) % mults.size());
+    }
+
+    double max_temperature = 10;
+
+    common::physical_optimization::OptimizationList exact_optimization_list;
+    exact_optimization_list.TzSort();
+    runner::Runner exact_runner(model, exact_optimization_list);
+
+    common::physical_optimization::OptimizationList window_optimization_list;
+    window_optimization_list.TzSort().BoltzmannWindow({max_temperature, 20});
+    runner::Runner window_runner(model, window_optimization_list);
+
+    for (double temperature = 0.5; temperature <= max_temperature; temperature += 0.5) {
+        auto exact_value =
+            exact_runner.getMagneticSusceptibilityController().calculateTheoreticalMuSquared(temperature);
+        auto window_value =
+            window_runner.getMagneticSusceptibilityController().calculateTheoreticalMuSquared(temperature);
+        EXPECT_NEAR(exact_value.mean(), window_value.mean(), 1e-6 * std::abs(exact_value.mean()))
+            << "Temperature: " << temperature;
+    }
+    EXPECT_LT(number_of_calculated_states(window_runner), number_of_calculated_states(exact_runner));
+}
@@ -0,0 +1,68 @@
+#include <cmath>
+#include "gtest/gtest.h"
+#include "src/common/physical_optimization/OptimizationList.h"
+#include "src/common/runner/Runner.h"
+
+namespace {
+model::ModelInput construct6x2AlternatingRing(double J_odd_value, double J_even_value) {
+    std::vector<spin_algebra::Multiplicity> mults = {2, 2, 2, 2, 2, 2};
+    model::ModelInput model(mults);
+    auto g_odd = model.addSymbol("g1", 2.0);
+    auto g_even = model.addSymbol("g2", 2.2);
+    auto J_odd = model.addSymbol("J1", J_odd_value);
+    auto J_even = model.addSymbol("J2", J_even_value);
+    for (int center = 0; center < mults.size(); ++center) {
+        model.assignSymbolToGFactor(center % 2 == 0 ? g_even : g_odd, center);
+        model.assignSymbolToIsotropicExchange(
+            center % 2 == 0 ? J_even : J_odd,
+            center,
+            (center + 1) % mults.size());
+    }
+    return model;
+}
+}  // namespace
+
+TEST(degeneracy_compression, 6x2_alternating_ring_mu_squared_and_derivatives_are_equal_to_uncompressed_ones) {
+    auto model = construct6x2AlternatingRing(-50.0, -30.0);
+
+    for (auto basis : {common::physical_optimization::OptimizationList::LEX, 
+                       common::physical_optimization::OptimizationList::ITO}) {
+        common::physical_optimization::OptimizationList optimization_list(basis);
+        optimization_list.TzSort();
+        runner::Runner runner(model, optimization_list);
+
+        common::physical_optimization::OptimizationList compressed_optimization_list(basis);
+        compressed_optimization_list.TzSort().DegeneracyCompress({});
+        runner::Runner compressed_runner(model, compressed_optimization_list);
+
+        std::vector<magnetic_susceptibility::ValueAtTemperature> experimental_values;
+        for (double temperature = 1; temperature <= 300; temperature += 1) {
+            auto value =
+                runner.getMagneticSusceptibilityController().calculateTheoreticalMuSquared(temperature);
+            auto compressed_value =
+                compressed_runner.getMagneticSusceptibilityController().calculateTheoreticalMuSquared(temperature);
+            EXPECT_NEAR(value.mean(), compressed_value.mean(), 1e-9 * std::abs(value.mean()))
+                << "Temperature: " << temperature;
+            experimental_values.push_back({temperature, 1.1 * value});
+        }
+
+        // derivatives are calculated, only if experimental values are initialized before spectra:
+        runner::Runner fit_runner(model, optimization_list);
+        fit_runner.initializeExperimentalValues(
+            experimental_values,
+            magnetic_susceptibility::mu_squared_in_bohr_magnetons_squared,
+            1);
+        runner::Runner compressed_fit_runner(model, compressed_optimization_list);
+        compressed_fit_runner.initializeExperimentalValues(
+            experimental_values,
+            magnetic_susceptibility::mu_squared_in_bohr_magnetons_squared,
+            1);
+        auto derivatives = fit_runner.calculateTotalDerivatives();
+        auto compressed_derivatives = compressed_fit_runner.calculateTotalDerivatives();
+        ASSERT_EQ(derivatives.size(), compressed_derivatives.size());
+        for (const auto& [symbol_name, derivative] : derivatives) {
+            EXPECT_NEAR(derivative, compressed_derivatives.at(symbol_name), 1e-9 * std::abs(derivative))
+                << "Symbol: " << symbol_name.get_name();
+        }
+    }
+}
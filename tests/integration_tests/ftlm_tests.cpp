@@ -2,16 +2,20 @@
 #include "gtest/gtest.h"
 #include "src/common/physical_optimization/OptimizationList.h"
 #include "src/common/runner/Runner.h"
+#include "src/nonlinear_solver/AbstractNonlinearSolver.h"
 
-void expect_mu_squared_approximate_equality(runner::Runner& exact, runner::Runner& ftlm) {
+std::vector<double> construct_temperatures() {
     std::vector<double> temperatures;
     for (int power = -3; power <= 3; ++power) {
         for (int number = 1; number <= 9; ++number) {
             temperatures.push_back(number * std::pow(10, power));
         }
     }
+    return temperatures;
+}
 
-    for (auto temp : temperatures) {
+void expect_mu_squared_approximate_equality(runner::Runner& exact, runner::Runner& ftlm) {
+    for (auto temp : construct_temperatures()) {
         auto exact_value = exact.getMagneticSusceptibilityController().calculateTheoreticalMuSquared(temp);
         auto ftlm_value = ftlm.getMagneticSusceptibilityController().calculateTheoreticalMuSquared(temp);
         EXPECT_NEAR(exact_value.mean(), ftlm_value.mean(), 2 * ftlm_value.stdev_total()) << "Temperature: " << temp;
@@ -39,6 +43,154 @@ TEST(ftlm_integration_tests, 10x2_FM_ring_SameG) {
     expect_mu_squared_approximate_equality(exact_runner, ftlm_runner);
 }
 
+TEST(ftlm_integration_tests, 10x2_FM_ring_SameG_MatrixFree) {
+    std::vector<spin_algebra::Multiplicity> mults = {2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+    model::ModelInput model(mults);
+    auto g = model.addSymbol("g", 2.0);
+    auto J = model.addSymbol("J", +10.0);
+    for (int center = 0; center < mults.size(); ++center) {
+        model.assignSymbolToGFactor(g, center);
+        model.assignSymbolToIsotropicExchange(J, center, (center + 1) % mults.size());
+    }
+
+    common::physical_optimization::OptimizationList exact_optimization_list;
+    exact_optimization_list.TzSort().EliminatePositiveProjections();
+    runner::Runner exact_runner(model, exact_optimization_list);
+
+    common::physical_optimization::OptimizationList ftlm_optimization_list;
+    ftlm_optimization_list.TzSort().EliminatePositiveProjections().FTLMApproximate({100, 128, 100, 128});
+    runner::Runner ftlm_runner(model, ftlm_optimization_list);
+    
+    expect_mu_squared_approximate_equality(exact_runner, ftlm_runner);
+}
+
+TEST(ftlm_integration_tests, 10x2_FM_ring_SameG_AdaptiveSeeds) {
+    std::vector<spin_algebra::Multiplicity> mults = {2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+    model::ModelInput model(mults);
+    auto g = model.addSymbol("g", 2.0);
+    auto J = model.addSymbol("J", +10.0);
+    for (int center = 0; center < mults.size(); ++center) {
+        model.assignSymbolToGFactor(g, center);
+        model.assignSymbolToIsotropicExchange(J, center, (center + 1) % mults.size());
+    }
+
+    common::physical_optimization::OptimizationList exact_optimization_list;
+    exact_optimization_list.TzSort().EliminatePositiveProjections();
+    runner::Runner exact_runner(model, exact_optimization_list);
+
+    double uncertainty_threshold = 3;
+    common::physical_optimization::OptimizationList ftlm_optimization_list;
+    ftlm_optimization_list.TzSort().EliminatePositiveProjections().FTLMApproximate(
+        {100, 128, 20, 1000000, uncertainty_threshold, 1000});
+    runner::Runner ftlm_runner(model, ftlm_optimization_list);
+    ftlm_runner.initializeSimulationTemperatures(construct_temperatures());
+
+    for (auto temp : construct_temperatures()) {
+        auto ftlm_value = ftlm_runner.getMagneticSusceptibilityController().calculateTheoreticalMuSquared(temp);
+        EXPECT_LE(ftlm_value.stdevs()[common::FTLM], uncertainty_threshold) << "Temperature: " << temp;
+    }
+    expect_mu_squared_approximate_equality(exact_runner, ftlm_runner);
+}
+
+namespace {
+// evaluates the residual error at the given points one by one, as a fit does:
+class ListOfPointsSolver : public nonlinear_solver::AbstractNonlinearSolver {
+  public:
+    explicit ListOfPointsSolver(std::vector<std::vector<double>> points) : points_(std::move(points)) {}
+
+    void optimize(
+        std::function<double(const std::vector<double>&, std::vector<double>&, bool)>
+            oneStepFunction,
+        std::vector<double>& changeable_values) override {
+        for (const auto& point : points_) {
+            changeable_values = point;
+            std::vector<double> gradient(changeable_values.size());
+            oneStepFunction(changeable_values, gradient, false);
+        }
+    }
+
+    bool doesGradientsRequired() const override {
+        return false;
+    }
+
+    std::optional<std::vector<double>> getMainDiagonalOfInverseHessian() const override {
+        return std::nullopt;
+    }
+
+  private:
+    std::vector<std::vector<double>> points_;
+};
+}  // namespace
+
+// spectra are rebuilt at every point of the fit, and seeds are added, if it is required at the new point.
+// The Hamiltonian is proportional to J, so the spectra are rescaled at the zero value of J,
+// and the seeds are added at the next point:
+TEST(ftlm_integration_tests, 10x2_ring_AdaptiveSeeds_are_added_during_fit) {
+    std::vector<spin_algebra::Multiplicity> mults = {2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+    auto construct_model = [&mults](double J_value) {
+        model::ModelInput model(mults);
+        auto g = model.addSymbol("g", 2.0, false);
+        auto J = model.addSymbol("J", J_value);
+        for (int center = 0; center < mults.size(); ++center) {
+            model.assignSymbolToGFactor(g, center);
+            model.assignSymbolToIsotropicExchange(J, center, (center + 1) % mults.size());
+        }
+        return model;
+    };
+    std::vector<double> temperatures = {2, 5, 10, 20, 50, 100, 200};
+
+    common::physical_optimization::OptimizationList exact_optimization_list;
+    exact_optimization_list.TzSort().EliminatePositiveProjections();
+    runner::Runner exact_runner(construct_model(-10.0), exact_optimization_list);
+    std::vector<magnetic_susceptibility::ValueAtTemperature> values;
+    for (double temperature : temperatures) {
+        values.push_back(
+            {temperature,
+             exact_runner.getMagneticSusceptibilityController().calculateTheoreticalMuSquared(
+                 temperature)});
+    }
+
+    double uncertainty_threshold = 3;
+    common::physical_optimization::OptimizationList ftlm_optimization_list;
+    ftlm_optimization_list.TzSort().EliminatePositiveProjections().FTLMApproximate(
+        {100, 128, 10, 1000000, uncertainty_threshold, 1000});
+    runner::Runner ftlm_runner(construct_model(+10.0), ftlm_optimization_list);
+    ftlm_runner.initializeExperimentalValues(
+        values,
+        magnetic_susceptibility::mu_squared_in_bohr_magnetons_squared,
+        1);
+    ftlm_runner.minimizeResidualError(std::make_shared<ListOfPointsSolver>(
+        std::vector<std::vector<double>>{{+10.0}, {0.0}, {-5.0}, {-10.0}}));
+
+    for (double temperature : temperatures) {
+        auto ftlm_value =
+            ftlm_runner.getMagneticSusceptibilityController().calculateTheoreticalMuSquared(temperature);
+        EXPECT_LE(ftlm_value.stdevs()[common::FTLM], uncertainty_threshold) << "Temperature: " << temperature;
+    }
+}
+
+TEST(ftlm_integration_tests, 10x2_FM_ring_SameG_ConvergedKrylov) {
+    std::vector<spin_algebra::Multiplicity> mults = {2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+    model::ModelInput model(mults);
+    auto g = model.addSymbol("g", 2.0);
+    auto J = model.addSymbol("J", +10.0);
+    for (int center = 0; center < mults.size(); ++center) {
+        model.assignSymbolToGFactor(g, center);
+        model.assignSymbolToIsotropicExchange(J, center, (center + 1) % mults.size());
+    }
+
+    common::physical_optimization::OptimizationList exact_optimization_list;
+    exact_optimization_list.TzSort().EliminatePositiveProjections();
+    runner::Runner exact_runner(model, exact_optimization_list);
+
+    common::physical_optimization::OptimizationList ftlm_optimization_list;
+    ftlm_optimization_list.TzSort().EliminatePositiveProjections().FTLMApproximate(
+        {100, 128, 100, 1000000, std::nullopt, 1000, 1e-6, 10});
+    runner::Runner ftlm_runner(model, ftlm_optimization_list);
+    
+    expect_mu_squared_approximate_equality(exact_runner, ftlm_runner);
+}
+
 TEST(ftlm_integration_tests, 12x2_FM_ring_SameG) {
     std::vector<spin_algebra::Multiplicity> mults = {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
     model::ModelInput model(mults);
@@ -108,6 +260,61 @@ TEST(ftlm_integration_tests, 10x2_FM_ring_DifferentG) {
     expect_mu_squared_approximate_equality(exact_runner, ftlm_runner);
 }
 
+TEST(ftlm_integration_tests, 10x2_FM_ring_DifferentG_MatrixFree) {
+    std::vector<spin_algebra::Multiplicity> mults = {2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+    model::ModelInput model(mults);
+    auto g_one = model.addSymbol("g1", 2.0);
+    auto g_two = model.addSymbol("g2", 3.0);
+    auto J = model.addSymbol("J", +10.0);
+    for (int center = 0; center < mults.size(); ++center) {
+        model.assignSymbolToIsotropicExchange(J, center, (center + 1) % mults.size());
+    }
+    for (int center = 0; center < mults.size(); center+=2) {
+        model.assignSymbolToGFactor(g_one, center);
+    }
+    for (int center = 1; center < mults.size(); center+=2) {
+        model.assignSymbolToGFactor(g_two, center);
+    }
+
+    common::physical_optimization::OptimizationList exact_optimization_list;
+    exact_optimization_list.TzSort().EliminatePositiveProjections();
+    runner::Runner exact_runner(model, exact_optimization_list);
+
+    common::physical_optimization::OptimizationList ftlm_optimization_list;
+    ftlm_optimization_list.TzSort().EliminatePositiveProjections().FTLMApproximate({100, 128, 100, 128});
+    runner::Runner ftlm_runner(model, ftlm_optimization_list);
+    
+    expect_mu_squared_approximate_equality(exact_runner, ftlm_runner);
+}
+
+TEST(ftlm_integration_tests, 10x2_FM_ring_DifferentG_TwoPassLanczos) {
+    std::vector<spin_algebra::Multiplicity> mults = {2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+    model::ModelInput model(mults);
+    auto g_one = model.addSymbol("g1", 2.0);
+    auto g_two = model.addSymbol("g2", 3.0);
+    auto J = model.addSymbol("J", +10.0);
+    for (int center = 0; center < mults.size(); ++center) {
+        model.assignSymbolToIsotropicExchange(J, center, (center + 1) % mults.size());
+    }
+    for (int center = 0; center < mults.size(); center+=2) {
+        model.assignSymbolToGFactor(g_one, center);
+    }
+    for (int center = 1; center < mults.size(); center+=2) {
+        model.assignSymbolToGFactor(g_two, center);
+    }
+
+    common::physical_optimization::OptimizationList exact_optimization_list;
+    exact_optimization_list.TzSort().EliminatePositiveProjections();
+    runner::Runner exact_runner(model, exact_optimization_list);
+
+    common::physical_optimization::OptimizationList ftlm_optimization_list;
+    ftlm_optimization_list.TzSort().EliminatePositiveProjections().FTLMApproximate(
+        {100, 128, 100, 1000000, std::nullopt, 1000, std::nullopt, 12000, true});
+    runner::Runner ftlm_runner(model, ftlm_optimization_list);
+    
+    expect_mu_squared_approximate_equality(exact_runner, ftlm_runner);
+}
+
 TEST(ftlm_integration_tests, 12x2_FM_ring_DifferentG) {
     std::vector<spin_algebra::Multiplicity> mults = {2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
     model::ModelInput model(mults);
@@ -0,0 +1,126 @@
+#include <cmath>
+#include "gtest/gtest.h"
+#include "src/common/physical_optimization/OptimizationList.h"
+#include "src/common/runner/Runner.h"
+#include "src/nonlinear_solver/AbstractNonlinearSolver.h"
+
+namespace {
+// Steepest descent with a fixed length of step, it memorizes every point of the fit,
+// so the fits with and without cache can be compared step by step:
+class RecordingSteepestDescent : public nonlinear_solver::AbstractNonlinearSolver {
+  public:
+    struct Step {
+        std::vector<double> changeable_values;
+        double residual_error;
+        std::vector<double> gradient;
+    };
+
+    void optimize(
+        std::function<double(const std::vector<double>&, std::vector<double>&, bool)>
+            oneStepFunction,
+        std::vector<double>& changeable_values) override {
+        for (size_t iteration = 0; iteration < number_of_iterations_; ++iteration) {
+            std::vector<double> gradient(changeable_values.size());
+            double residual_error = oneStepFunction(changeable_values, gradient, true);
+            steps_.push_back({changeable_values, residual_error, gradient});
+
+            double norm = 0;
+            for (double value : gradient) {
+                norm += value * value;
+            }
+            norm = std::sqrt(norm);
+            if (norm == 0) {
+                break;
+            }
+            for (size_t i = 0; i < changeable_values.size(); ++i) {
+                changeable_values[i] -= length_of_step_ * gradient[i] / norm;
+            }
+        }
+    }
+
+    bool doesGradientsRequired() const override {
+        return true;
+    }
+
+    std::optional<std::vector<double>> getMainDiagonalOfInverseHessian() const override {
+        return std::nullopt;
+    }
+
+    const std::vector<Step>& getSteps() const {
+        return steps_;
+    }
+
+  private:
+    size_t number_of_iterations_ = 6;
+    double length_of_step_ = 0.5;
+    std::vector<Step> steps_;
+};
+
+model::ModelInput construct_model(double J_one, double J_two, double D) {
+    model::ModelInput model({2, 3, 4, 3});
+    auto J_one_name = model.addSymbol("J1", J_one);
+    auto J_two_name = model.addSymbol("J2", J_two);
+    auto J_fixed_name = model.addSymbol("J3", -3.0, false);
+    auto D_name = model.addSymbol("D", D, true, model::symbols::D);
+    auto g_name = model.addSymbol("g", 2.0, false);
+    model.assignSymbolToIsotropicExchange(J_one_name, 0, 1)
+        .assignSymbolToIsotropicExchange(J_two_name, 1, 2)
+        .assignSymbolToIsotropicExchange(J_one_name, 2, 3)
+        .assignSymbolToIsotropicExchange(J_fixed_name, 3, 0)
+        .assignSymbolToZFSNoAnisotropy(D_name, 1)
+        .assignSymbolToZFSNoAnisotropy(D_name, 2);
+    for (size_t center = 0; center < 4; ++center) {
+        model.assignSymbolToGFactor(g_name, center);
+    }
+    return model;
+}
+
+std::vector<RecordingSteepestDescent::Step> fit(
+    const std::vector<magnetic_susceptibility::ValueAtTemperature>& values,
+    common::physical_optimization::OptimizationList optimization_list) {
+    runner::Runner runner(construct_model(-8, -4, 3), optimization_list);
+    runner.initializeExperimentalValues(
+        values,
+        magnetic_susceptibility::mu_squared_in_bohr_magnetons_squared,
+        1);
+    auto solver = std::make_shared<RecordingSteepestDescent>();
+    runner.minimizeResidualError(solver);
+    return solver->getSteps();
+}
+}  // namespace
+
+TEST(linear_hamiltonian_cache, fit_with_cache_is_equal_to_fit_without_cache) {
+    std::vector<magnetic_susceptibility::ValueAtTemperature> values;
+    {
+        runner::Runner runner(construct_model(-10, -5, 2));
+        for (size_t i = 1; i < 301; i += 3) {
+            values.push_back(
+                {static_cast<double>(i),
+                 runner.getMagneticSusceptibilityController().calculateTheoreticalMuSquared(i)});
+        }
+    }
+
+    common::physical_optimization::OptimizationList optimization_list;
+    optimization_list.TzSort();
+    auto steps_without_cache = fit(values, optimization_list);
+    optimization_list.CacheLinearHamiltonian();
+    auto steps_with_cache = fit(values, optimization_list);
+
+    ASSERT_EQ(steps_without_cache.size(), steps_with_cache.size());
+    for (size_t step = 0; step < steps_without_cache.size(); ++step) {
+        const auto& expected = steps_without_cache[step];
+        const auto& actual = steps_with_cache[step];
+        EXPECT_NEAR(
+            expected.residual_error,
+            actual.residual_error,
+            1e-9 * std::abs(expected.residual_error))
+            << "Step: " << step;
+        ASSERT_EQ(expected.gradient.size(), actual.gradient.size());
+        for (size_t i = 0; i < expected.gradient.size(); ++i) {
+            EXPECT_NEAR(expected.changeable_values[i], actual.changeable_values[i], 1e-9)
+                << "Step: " << step;
+            EXPECT_NEAR(expected.gradient[i], actual.gradient[i], 1e-7 * std::abs(expected.gradient[i]) + 1e-12)
+                << "Step: " << step;
+        }
+    }
+}
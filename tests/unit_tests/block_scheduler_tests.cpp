@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "src/entities/data_structures/FactoriesList.h"
+#include "src/eigendecompositor/BlockScheduler.h"
+#include "src/eigendecompositor/EigendecompositorConstructor.h"
+#include "src/space/optimization/OptimizedSpaceConstructor.h"
+
+TEST(block_scheduler_tests, estimate_memory) {
+    EXPECT_EQ(eigendecompositor::BlockScheduler::estimateMemory(10, 2), 10 * 10 * sizeof(double) * 2);
+    EXPECT_EQ(eigendecompositor::BlockScheduler::estimateMemory(0, 3), 0);
+    // the result must not overflow uint32_t:
+    EXPECT_EQ(
+        eigendecompositor::BlockScheduler::estimateMemory(100000, 3),
+        (size_t)100000 * 100000 * sizeof(double) * 3);
+}
+
+TEST(block_scheduler_tests, number_of_dense_matrices) {
+    std::map<common::QuantityEnum, std::shared_ptr<const model::operators::Operator>> operators;
+    std::map<
+        std::pair<common::QuantityEnum, model::symbols::SymbolName>,
+        std::shared_ptr<const model::operators::Operator>> derivatives_operators;
+    operators[common::Energy] = std::make_shared<const model::operators::Operator>();
+    size_t values_only =
+        eigendecompositor::BlockScheduler::numberOfDenseMatrices(operators, derivatives_operators);
+    operators[common::S_total_squared] = std::make_shared<const model::operators::Operator>();
+    size_t with_eigenvectors =
+        eigendecompositor::BlockScheduler::numberOfDenseMatrices(operators, derivatives_operators);
+    EXPECT_LT(values_only, with_eigenvectors);
+}
+
+TEST(block_scheduler_tests, admission_respects_budget) {
+    eigendecompositor::BlockScheduler scheduler(100, 4);
+    EXPECT_TRUE(scheduler.tryAdmit(60));
+    EXPECT_FALSE(scheduler.tryAdmit(60));
+    EXPECT_TRUE(scheduler.tryAdmit(40));
+    EXPECT_FALSE(scheduler.tryAdmit(1));
+    int first_threads = scheduler.start(1.0);
+    int second_threads = scheduler.start(1.0);
+    scheduler.finish(60, first_threads);
+    EXPECT_TRUE(scheduler.tryAdmit(60));
+    scheduler.finish(40, second_threads);
+}
+
+TEST(block_scheduler_tests, block_bigger_than_budget_is_admitted_alone) {
+    eigendecompositor::BlockScheduler scheduler(100, 4);
+    EXPECT_TRUE(scheduler.tryAdmit(1000));
+    EXPECT_FALSE(scheduler.tryAdmit(1));
+    int threads = scheduler.start(1.0);
+    EXPECT_EQ(threads, 4);
+    scheduler.finish(1000, threads);
+    EXPECT_TRUE(scheduler.tryAdmit(1));
+}
+
+TEST(block_scheduler_tests, threads_are_shared_between_running_blocks) {
+    for (int max_threads = 1; max_threads < 16; ++max_threads) {
+        eigendecompositor::BlockScheduler scheduler(1000, max_threads);
+        std::vector<int> threads;
+        for (int i = 0; i < max_threads; ++i) {
+            EXPECT_TRUE(scheduler.tryAdmit(1));
+            threads.push_back(scheduler.start(1.0));
+        }
+        int sum = 0;
+        for (auto thread : threads) {
+            EXPECT_GE(thread, 1);
+            sum += thread;
+        }
+        EXPECT_GE(sum, max_threads);
+        for (auto thread : threads) {
+            scheduler.finish(1, thread);
+        }
+    }
+}
+
+TEST(block_scheduler_tests, estimate_cost) {
+    EXPECT_DOUBLE_EQ(eigendecompositor::BlockScheduler::estimateCost(10), 1000.0);
+    EXPECT_LT(
+        eigendecompositor::BlockScheduler::estimateCost(10),
+        eigendecompositor::BlockScheduler::estimateCost(11));
+}
+
+TEST(block_scheduler_tests, plan_starts_from_the_largest_blocks) {
+    quantum::linear_algebra::FactoriesList factories;
+    std::vector<uint32_t> sizes = {3, 100, 1, 50, 100, 7};
+    std::vector<space::Subspace> subspaces;
+    for (auto size : sizes) {
+        subspaces.emplace_back(factories.createSparseSemiunitaryMatrix(size, 1000));
+    }
+    space::Space space(std::move(subspaces));
+
+    eigendecompositor::BlockScheduler scheduler(std::numeric_limits<size_t>::max(), 64);
+    auto plan = scheduler.plan(space, 2);
+
+    ASSERT_EQ(plan.size(), sizes.size());
+    for (size_t i = 1; i < plan.size(); ++i) {
+        EXPECT_GE(plan[i - 1].estimated_cost, plan[i].estimated_cost);
+    }
+    // equal blocks are kept in the initial order:
+    EXPECT_EQ(plan[0].number_of_block, 1);
+    EXPECT_EQ(plan[1].number_of_block, 4);
+    for (const auto& block_plan : plan) {
+        EXPECT_EQ(block_plan.size_of_block, sizes[block_plan.number_of_block]);
+    }
+}
+
+TEST(block_scheduler_tests, threads_are_distributed_by_cost) {
+    quantum::linear_algebra::FactoriesList factories;
+    std::vector<uint32_t> sizes = {1000, 10, 10, 10, 10, 10, 10, 10};
+    std::vector<space::Subspace> subspaces;
+    for (auto size : sizes) {
+        subspaces.emplace_back(factories.createSparseSemiunitaryMatrix(size, 2000));
+    }
+    space::Space space(std::move(subspaces));
+
+    int max_threads = 64;
+    eigendecompositor::BlockScheduler scheduler(std::numeric_limits<size_t>::max(), max_threads);
+    auto plan = scheduler.plan(space, 2);
+
+    std::vector<int> threads;
+    for (const auto& block_plan : plan) {
+        EXPECT_TRUE(scheduler.tryAdmit(block_plan.estimated_memory));
+        threads.push_back(scheduler.start(block_plan.estimated_cost));
+    }
+    // the largest block gets almost all threads, the others get the rest:
+    EXPECT_GE(threads[0], max_threads - (int)sizes.size() + 1);
+    int sum = 0;
+    for (size_t i = 0; i < threads.size(); ++i) {
+        EXPECT_GE(threads[i], 1);
+        sum += threads[i];
+    }
+    EXPECT_LE(sum, max_threads);
+    for (size_t i = 0; i < plan.size(); ++i) {
+        scheduler.finish(plan[i].estimated_memory, threads[i]);
+    }
+}
+
+TEST(block_scheduler_tests, throw_zero_budget) {
+    EXPECT_THROW(eigendecompositor::BlockScheduler(0, 4), std::invalid_argument);
+    EXPECT_THROW(
+        common::physical_optimization::OptimizationList().ScheduleBlocks({0}),
+        std::invalid_argument);
+}
+
+namespace {
+std::vector<double> flatten(const std::optional<OneOrMany<SpectrumRef>>& mb_spectrum) {
+    std::vector<double> values;
+    for (const auto& subspectrum : getOneRef(mb_spectrum.value()).blocks) {
+        for (uint32_t i = 0; i < subspectrum.get().raw_data->size(); ++i) {
+            values.push_back(subspectrum.get().raw_data->at(i));
+        }
+    }
+    return values;
+}
+
+// Boltzmann averages of explicit quantities and energy derivative for several values of the only J.
+// Averages do not depend on the order of states and on the choice of eigenvectors of degenerate states:
+std::vector<double> averages_for_values_of_J(
+    common::physical_optimization::OptimizationList::BlockSchedulingSettings settings) {
+    model::ModelInput model({2, 3, 4});
+    auto J = model.addSymbol("J", 10);
+    auto g = model.addSymbol("g", 2.0, false, model::symbols::g_factor);
+    model.assignSymbolToIsotropicExchange(J, 0, 1)
+        .assignSymbolToIsotropicExchange(J, 1, 2)
+        .assignSymbolToGFactor(g, 0)
+        .assignSymbolToGFactor(g, 1)
+        .assignSymbolToGFactor(g, 2);
+    common::physical_optimization::OptimizationList optimization_list;
+    optimization_list.ScheduleBlocks(settings);
+    runner::ConsistentModelOptimizationList consistent_list(std::move(model), optimization_list);
+    consistent_list.InitializeDerivatives();
+    quantum::linear_algebra::FactoriesList factories;
+    auto space = space::optimization::OptimizedSpaceConstructor::construct(consistent_list, factories);
+
+    auto eigendecompositor = eigendecompositor::EigendecompositorConstructor::construct(consistent_list, factories);
+
+    std::vector<double> answer;
+    for (double value : {10.0, -3.0, 7.5}) {
+        consistent_list.setNewValueToChangeableSymbol(J, value);
+        eigendecompositor->BuildSpectra(
+            consistent_list.getOperatorsForExplicitConstruction(),
+            consistent_list.getDerivativeOperatorsForExplicitConstruction(),
+            space);
+        auto energy = flatten(eigendecompositor->getSpectrum(common::Energy));
+        double min_energy = *std::min_element(energy.begin(), energy.end());
+        std::vector<std::vector<double>> quantities;
+        for (const auto& [quantity_enum, _] : consistent_list.getOperatorsForExplicitConstruction()) {
+            quantities.push_back(flatten(eigendecompositor->getSpectrum(quantity_enum)));
+        }
+        quantities.push_back(flatten(eigendecompositor->getSpectrumDerivative(common::Energy, J)));
+        for (double temperature : {5.0, 50.0, 300.0}) {
+            for (const auto& quantity : quantities) {
+                double sum = 0;
+                double partition_function = 0;
+                for (size_t i = 0; i < energy.size(); ++i) {
+                    double boltzmann_factor = std::exp(-(energy[i] - min_energy) / temperature);
+                    sum += quantity[i] * boltzmann_factor;
+                    partition_function += boltzmann_factor;
+                }
+                answer.push_back(sum / partition_function);
+            }
+        }
+    }
+    return answer;
+}
+}  // namespace
+
+TEST(block_scheduler_tests, streaming_gives_the_same_averages) {
+    auto kept = averages_for_values_of_J({});
+    auto streamed = averages_for_values_of_J({std::nullopt, true});
+    ASSERT_EQ(kept.size(), streamed.size());
+    for (size_t i = 0; i < kept.size(); ++i) {
+        EXPECT_NEAR(kept[i], streamed[i], 1e-8 * std::max(1.0, std::abs(kept[i])));
+    }
+}
+
+TEST(block_scheduler_tests, tiny_memory_budget_gives_the_same_averages) {
+    auto unlimited = averages_for_values_of_J({});
+    // every block does not fit into the budget, so blocks are diagonalized one by one:
+    auto one_by_one = averages_for_values_of_J({1});
+    ASSERT_EQ(unlimited.size(), one_by_one.size());
+    for (size_t i = 0; i < unlimited.size(); ++i) {
+        EXPECT_NEAR(unlimited[i], one_by_one[i], 1e-8 * std::max(1.0, std::abs(unlimited[i])));
+    }
+}
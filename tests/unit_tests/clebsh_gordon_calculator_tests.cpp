@@ -61,4 +61,47 @@ TEST(ClebshGordanCalculatorTest, Wigner9j) {
 		double value = cg_calculator.ninej_element(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8]);
 		EXPECT_NEAR(value, pair.second, EPSILON);
 	}
-}
\ No newline at end of file
+}
+
+TEST(ClebshGordanCalculatorTest, tabulated_coefficients_are_equal_to_calculated_directly) {
+	uint32_t max_doubled_spin = 9;
+	auto tabulated_calculator = spin_algebra::ClebshGordanCalculator(max_doubled_spin);
+	auto direct_calculator = spin_algebra::ClebshGordanCalculator();
+
+	// up to and beyond the tabulated spins:
+	for (int l1 = 0; l1 <= max_doubled_spin + 6; ++l1) {
+		for (int rank = 0; rank <= 3; ++rank) {
+			for (int l3 = std::abs(l1 - 2 * rank); l3 <= l1 + 2 * rank; l3 += 2) {
+				for (int m1 = -l1; m1 <= l1; m1 += 2) {
+					for (int m2 = -2 * rank; m2 <= 2 * rank; m2 += 2) {
+						EXPECT_NEAR(
+							tabulated_calculator.clebsh_gordan_coefficient(l1 / 2.0, rank, l3 / 2.0, m1 / 2.0, m2 / 2.0),
+							direct_calculator.clebsh_gordan_coefficient(l1 / 2.0, rank, l3 / 2.0, m1 / 2.0, m2 / 2.0),
+							EPSILON);
+					}
+				}
+			}
+		}
+	}
+
+	for (int l1 = 0; l1 <= max_doubled_spin + 6; ++l1) {
+		for (int l2 = 0; l2 <= max_doubled_spin + 6; ++l2) {
+			for (int rank = 0; rank <= 3; ++rank) {
+				for (int l4 = 0; l4 <= max_doubled_spin + 6; ++l4) {
+					for (int l5 = 0; l5 <= max_doubled_spin + 6; ++l5) {
+						for (int l6 = 0; l6 <= max_doubled_spin + 6; ++l6) {
+							EXPECT_NEAR(
+								tabulated_calculator.wigner6j_coefficient(l1 / 2.0, l2 / 2.0, rank, l4 / 2.0, l5 / 2.0, l6 / 2.0),
+								direct_calculator.wigner6j_coefficient(l1 / 2.0, l2 / 2.0, rank, l4 / 2.0, l5 / 2.0, l6 / 2.0),
+								EPSILON);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	EXPECT_NEAR(tabulated_calculator.ninej_element(4.0, 4.0, 4.0, 3.0, 4.0, 3.0, 1, 1, 2), sqrt(390.0)/1890.0, EPSILON);
+	EXPECT_NEAR(tabulated_calculator.ninej_element(3.5, 3.5, 1.0, 2.5, 3.5, 2.0, 2, 0, 2), 13*sqrt(42.0)/5040.0, EPSILON);
+	EXPECT_NEAR(tabulated_calculator.ninej_element(1.0, 4.0, 4.0, 1.0, 3.0, 3.0, 0, 1, 1), sqrt(105.0)/252.0, EPSILON);
+}
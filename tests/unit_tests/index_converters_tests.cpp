@@ -4,6 +4,7 @@
 
 #include "src/common/index_converter/lexicographic/IndexConverter.h"
 #include "src/common/index_converter/s_squared/IndexConverter.h"
+#include "src/common/index_converter/s_squared/Level.h"
 #include "src/common/index_converter/s_squared/OrderOfSummation.h"
 #include "src/group/Group.h"
 #include "src/spin_algebra/Multiplicity.h"
@@ -22,6 +23,29 @@ TEST(converter_reversibility, lexicographic_2222_333_2345_44444) {
 	}
 }
 
+TEST(converter_reversibility, lexicographic_batch_decoding_2222_333_2345_44444_1234) {
+	std::vector<std::vector<spin_algebra::Multiplicity>> vector_of_mults =
+        {{2, 2, 2, 2}, {3, 3, 3}, {2, 3, 4, 5}, {4, 4, 4, 4, 4}, {1, 2, 3, 4}};
+	for (const auto& mults : vector_of_mults) {
+		auto converter = std::make_shared<index_converter::lexicographic::IndexConverter>(mults);
+		std::vector<uint32_t> indexes;
+		for (uint32_t index = 0; index < converter->get_total_space_size(); index += 3) {
+			indexes.push_back(index);
+		}
+		auto projections = converter->convert_lex_indexes_to_all_sz_projections(indexes);
+		ASSERT_EQ(projections.size(), indexes.size() * mults.size());
+		size_t i = 0;
+		for (auto index : indexes) {
+			auto state = converter->convert_lex_index_to_all_sz_projections(index);
+			for (size_t center = 0; center < mults.size(); ++center) {
+				EXPECT_EQ(projections[center * indexes.size() + i], state[center]);
+				EXPECT_EQ(converter->convert_lex_index_to_one_sz_projection(index, center), state[center]);
+			}
+			++i;
+		}
+	}
+}
+
 TEST(converter_reversibility, s_squared_2222_3333_4444) {
 	std::vector<std::vector<spin_algebra::Multiplicity>> vector_of_mults =
         {{2, 2, 2, 2}, {3, 3, 3, 3}, {4, 4, 4, 4}};
@@ -48,4 +72,40 @@ TEST(converter_reversibility, s_squared_2222_3333_4444) {
 	}
 }
 
-// TODO: the same test for s_squared converter
\ No newline at end of file
+TEST(s_squared_level, packed_multiplicities_across_words) {
+	using index_converter::s_squared::Level;
+	std::vector<spin_algebra::Multiplicity> initial_mults(10, 6);
+	// nine summations do not fit into one word:
+	size_t number_of_summations = 9;
+
+	Level level(&initial_mults, number_of_summations);
+	for (size_t i = 0; i < number_of_summations; ++i) {
+		level.setMultiplicity(initial_mults.size() + i, 2 * i + 1);
+	}
+	EXPECT_EQ(level.getSize(), initial_mults.size() + number_of_summations);
+	for (size_t i = 0; i < initial_mults.size(); ++i) {
+		EXPECT_EQ(level.getMultiplicity(i), 6);
+	}
+	for (size_t i = 0; i < number_of_summations; ++i) {
+		EXPECT_EQ(level.getMultiplicity(initial_mults.size() + i), 2 * i + 1);
+	}
+	EXPECT_EQ(level.total(), 2 * number_of_summations - 1);
+
+	// levels are ordered by the last intermediate multiplicity first:
+	Level smaller(&initial_mults, number_of_summations);
+	Level same(&initial_mults, number_of_summations);
+	for (size_t i = 0; i < number_of_summations; ++i) {
+		smaller.setMultiplicity(initial_mults.size() + i, i + 1 == number_of_summations ? 2 * i - 1 : 255);
+		same.setMultiplicity(initial_mults.size() + i, 2 * i + 1);
+	}
+	EXPECT_TRUE(smaller < level);
+	EXPECT_TRUE(level == same);
+	EXPECT_EQ(level.hash(), same.hash());
+
+	EXPECT_THROW(level.setMultiplicity(initial_mults.size(), 3), std::invalid_argument);
+	EXPECT_THROW(level.setMultiplicity(0, 3), std::invalid_argument);
+	EXPECT_THROW(
+		Level(&initial_mults, 1).setMultiplicity(initial_mults.size(), Level::MAX_MULTIPLICITY + 1),
+		std::length_error);
+	EXPECT_THROW(Level(&initial_mults, Level::MAX_NUMBER_OF_SUMMATIONS + 1), std::length_error);
+}
\ No newline at end of file
@@ -66,6 +66,40 @@ TYPED_TEST_P(
     }
 }
 
+TYPED_TEST_P(
+    AbstractDenseTransformAndDiagonalizeFactoryIndividualTest,
+    UnitaryTransformationAndReturnMainDiagonal_and_explicit_UnitaryTransformation_Equivalence) {
+    std::random_device dev;
+    std::mt19937 rng(dev());
+    std::uniform_real_distribution<double> dist(-10, +10);
+
+    for (size_t size = 8; size <= 32; size*=2) {
+        auto denseSemiunitaryMatrix =
+            generateDenseDiagonalizableMatrix(size, this->factory_, dist, rng)
+                ->diagonalizeValuesVectors().eigenvectors;
+        std::vector<std::unique_ptr<quantum::linear_algebra::AbstractDiagonalizableMatrix>> matrices;
+        matrices.push_back(generateDenseDiagonalizableMatrix(size, this->factory_, dist, rng));
+        matrices.push_back(generateSparseDiagonalizableMatrix(size, this->factory_, dist, rng));
+
+        for (const auto& matrix : matrices) {
+            auto main_diagonal =
+                denseSemiunitaryMatrix->getUnitaryTransformer()->calculateUnitaryTransformationOfMatrix(matrix);
+            ASSERT_EQ(main_diagonal->size(), size);
+            for (size_t i = 0; i < size; ++i) {
+                // (U^T A U)_{ii} = \sum_{kl} U_{ki} A_{kl} U_{li}, at(i, k) returns U_{ki}
+                double expected = 0;
+                for (size_t k = 0; k < size; ++k) {
+                    for (size_t l = 0; l < size; ++l) {
+                        expected += denseSemiunitaryMatrix->at(i, k) * matrix->at(k, l)
+                            * denseSemiunitaryMatrix->at(i, l);
+                    }
+                }
+                EXPECT_NEAR(main_diagonal->at(i), expected, 1e-3 * (1 + std::abs(expected)));
+            }
+        }
+    }
+}
+
 TYPED_TEST_P(
     AbstractDenseTransformAndDiagonalizeFactoryIndividualTest,
     krylovDiagonalizeValues_and_krylovDiagonalizeValuesVectors) {
@@ -127,6 +161,552 @@ TYPED_TEST_P(
     }
 }
 
+TYPED_TEST_P(
+    AbstractDenseTransformAndDiagonalizeFactoryIndividualTest,
+    krylovOfSeeds_and_krylovOfEverySeed) {
+    std::random_device dev;
+    std::mt19937 rng(dev());
+    std::uniform_real_distribution<double> dist(-100, +100);
+    const size_t krylov_subspace_size = 8;
+    const uint32_t number_of_seeds = 5;
+
+    for (size_t size = 16; size <= 64; size*=2) {
+        auto matrix = generateSparseDiagonalizableMatrix(size, this->factory_, dist, rng);
+        auto seed_vectors = this->factory_->createRandomUnitVectors(size, number_of_seeds);
+
+        auto couples = matrix->krylovDiagonalizeValues(seed_vectors, krylov_subspace_size, std::nullopt);
+        auto triples = matrix->krylovDiagonalizeValuesVectors(seed_vectors, krylov_subspace_size, std::nullopt);
+        ASSERT_EQ(couples.size(), number_of_seeds);
+        ASSERT_EQ(triples.size(), number_of_seeds);
+
+        for (size_t seed = 0; seed < number_of_seeds; ++seed) {
+            auto couple = matrix->krylovDiagonalizeValues(seed_vectors[seed], krylov_subspace_size);
+            double range = std::abs(couple.eigenvalues->at(krylov_subspace_size - 1))
+                + std::abs(couple.eigenvalues->at(0));
+            ASSERT_EQ(couples[seed].eigenvalues->size(), krylov_subspace_size);
+            ASSERT_EQ(triples[seed].eigenvalues->size(), krylov_subspace_size);
+            ASSERT_EQ(triples[seed].eigenvectors->size_rows(), size);
+            for (size_t i = 0; i < krylov_subspace_size; ++i) {
+                EXPECT_NEAR(couples[seed].eigenvalues->at(i), couple.eigenvalues->at(i), 1e-4 * range);
+                EXPECT_NEAR(triples[seed].eigenvalues->at(i), couple.eigenvalues->at(i), 1e-4 * range);
+                EXPECT_NEAR(
+                    couples[seed].ftlm_weights_of_states->at(i),
+                    couple.ftlm_weights_of_states->at(i),
+                    1e-4);
+                EXPECT_NEAR(
+                    triples[seed].ftlm_weights_of_states->at(i),
+                    couple.ftlm_weights_of_states->at(i),
+                    1e-4);
+            }
+        }
+    }
+}
+
+TYPED_TEST_P(
+    AbstractDenseTransformAndDiagonalizeFactoryIndividualTest,
+    krylovOfSeeds_breakdown_and_convergence) {
+    const size_t size = 64;
+    const uint32_t number_of_seeds = 3;
+    auto seed_vectors = this->factory_->createRandomUnitVectors(size, number_of_seeds);
+
+    // eigenvalues are highly degenerate, so the Krylov subspace of any seed is invariant
+    // after number_of_different_eigenvalues steps, spectra of seeds have to be smaller instead of exception:
+    const size_t number_of_different_eigenvalues = 4;
+    auto degenerate_matrix = this->factory_->createSparseDiagonalizableMatrix(size);
+    for (size_t i = 0; i < size; ++i) {
+        degenerate_matrix->add_to_position(10.0 * (i % number_of_different_eigenvalues), i, i);
+    }
+    auto couple = degenerate_matrix->krylovDiagonalizeValues(seed_vectors[0], size);
+    EXPECT_EQ(couple.eigenvalues->size(), number_of_different_eigenvalues);
+    auto triples = degenerate_matrix->krylovDiagonalizeValuesVectors(seed_vectors, size, std::nullopt);
+    for (size_t seed = 0; seed < number_of_seeds; ++seed) {
+        ASSERT_EQ(triples[seed].eigenvalues->size(), number_of_different_eigenvalues);
+        ASSERT_EQ(triples[seed].eigenvectors->size_cols(), number_of_different_eigenvalues);
+        double sum_of_weights = 0;
+        for (size_t i = 0; i < number_of_different_eigenvalues; ++i) {
+            EXPECT_NEAR(triples[seed].eigenvalues->at(i), 10.0 * i, 1e-2);
+            sum_of_weights += triples[seed].ftlm_weights_of_states->at(i);
+        }
+        EXPECT_NEAR(sum_of_weights, 1, 1e-4);
+    }
+
+    // the lowest eigenvalue is well separated, so it converges long before size steps:
+    auto separated_matrix = this->factory_->createSparseDiagonalizableMatrix(size);
+    separated_matrix->add_to_position(-100, 0, 0);
+    for (size_t i = 1; i < size; ++i) {
+        separated_matrix->add_to_position((double)i, i, i);
+    }
+    quantum::linear_algebra::KrylovConvergence convergence = {1e-4, 1};
+    auto couples = separated_matrix->krylovDiagonalizeValues(seed_vectors, size, convergence);
+    for (size_t seed = 0; seed < number_of_seeds; ++seed) {
+        EXPECT_LT(couples[seed].eigenvalues->size(), size);
+        EXPECT_NEAR(couples[seed].eigenvalues->at(0), -100, 1e-3);
+    }
+}
+
+TYPED_TEST_P(
+    AbstractDenseTransformAndDiagonalizeFactoryIndividualTest,
+    krylovTwoPass_and_krylovOfSeeds_Equivalence) {
+    std::random_device dev;
+    std::mt19937 rng(dev());
+    std::uniform_real_distribution<double> dist(-100, +100);
+    const size_t krylov_subspace_size = 8;
+    const uint32_t number_of_seeds = 3;
+
+    for (size_t size = 16; size <= 64; size*=2) {
+        // eigenvectors of two-pass procedure share the ownership of the matrix:
+        std::shared_ptr<quantum::linear_algebra::AbstractDiagonalizableMatrix> matrix =
+            generateSparseDiagonalizableMatrix(size, this->factory_, dist, rng);
+        auto matrix_for_transform = generateSparseDiagonalizableMatrix(size, this->factory_, dist, rng);
+        auto seed_vectors = this->factory_->createRandomUnitVectors(size, number_of_seeds);
+
+        auto triples = matrix->krylovDiagonalizeValuesVectors(seed_vectors, krylov_subspace_size, std::nullopt);
+        auto two_pass_triples =
+            matrix->krylovDiagonalizeValuesVectorsTwoPass(seed_vectors, krylov_subspace_size, std::nullopt);
+        ASSERT_EQ(two_pass_triples.size(), number_of_seeds);
+        // the matrix has to outlive the caller's pointer:
+        matrix.reset();
+
+        for (size_t seed = 0; seed < number_of_seeds; ++seed) {
+            ASSERT_EQ(two_pass_triples[seed].eigenvalues->size(), triples[seed].eigenvalues->size());
+            ASSERT_EQ(two_pass_triples[seed].eigenvectors->size_rows(), size);
+            ASSERT_EQ(two_pass_triples[seed].eigenvectors->size_cols(), krylov_subspace_size);
+            auto main_diagonal = triples[seed].eigenvectors->getUnitaryTransformer()
+                ->calculateUnitaryTransformationOfMatrix(matrix_for_transform);
+            auto two_pass_main_diagonal = two_pass_triples[seed].eigenvectors->getUnitaryTransformer()
+                ->calculateUnitaryTransformationOfMatrix(matrix_for_transform);
+            for (size_t i = 0; i < krylov_subspace_size; ++i) {
+                EXPECT_NEAR(
+                    two_pass_triples[seed].eigenvalues->at(i),
+                    triples[seed].eigenvalues->at(i),
+                    1e-4 * std::abs(triples[seed].eigenvalues->at(i)) + 1e-4);
+                EXPECT_NEAR(
+                    two_pass_triples[seed].ftlm_weights_of_states->at(i),
+                    triples[seed].ftlm_weights_of_states->at(i),
+                    1e-4);
+                // weighted by |<r|n>|^2, as in FTLM, to get rid of small back projections:
+                double weight = triples[seed].ftlm_weights_of_states->at(i);
+                EXPECT_NEAR(
+                    two_pass_main_diagonal->at(i) * weight,
+                    main_diagonal->at(i) * weight,
+                    1e-2 * (std::abs(main_diagonal->at(i) * weight) + 1e-2));
+                for (size_t j = 0; j < size; j += size / 4) {
+                    EXPECT_NEAR(
+                        two_pass_triples[seed].eigenvectors->at(i, j),
+                        triples[seed].eigenvectors->at(i, j),
+                        1e-2);
+                }
+            }
+        }
+    }
+}
+
+TYPED_TEST_P(
+    AbstractDenseTransformAndDiagonalizeFactoryIndividualTest,
+    krylovTwoPass_and_krylovOfSeeds_large_krylov_subspace) {
+    std::random_device dev;
+    std::mt19937 rng(dev());
+    std::uniform_real_distribution<double> dist(-100, +100);
+    // Krylov vectors lose their orthogonality long before krylov_subspace_size steps,
+    // so the regenerated vectors are the same only if the second pass repeats the first one:
+    const size_t size = 512;
+    const size_t krylov_subspace_size = 256;
+    const uint32_t number_of_seeds = 3;
+    const size_t number_of_matrices = 3;
+
+    std::shared_ptr<quantum::linear_algebra::AbstractDiagonalizableMatrix> matrix =
+        generateSparseDiagonalizableMatrix(size, this->factory_, dist, rng);
+    std::vector<std::unique_ptr<quantum::linear_algebra::AbstractDiagonalizableMatrix>> matrices_for_transform;
+    std::vector<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDiagonalizableMatrix>>>
+        references_for_transform;
+    for (size_t j = 0; j < number_of_matrices; ++j) {
+        matrices_for_transform.push_back(generateSparseDiagonalizableMatrix(size, this->factory_, dist, rng));
+    }
+    for (const auto& matrix_for_transform : matrices_for_transform) {
+        references_for_transform.emplace_back(matrix_for_transform);
+    }
+    auto seed_vectors = this->factory_->createRandomUnitVectors(size, number_of_seeds);
+
+    auto triples = matrix->krylovDiagonalizeValuesVectors(seed_vectors, krylov_subspace_size, std::nullopt);
+    auto two_pass_triples =
+        matrix->krylovDiagonalizeValuesVectorsTwoPass(seed_vectors, krylov_subspace_size, std::nullopt);
+    ASSERT_EQ(two_pass_triples.size(), number_of_seeds);
+
+    for (size_t seed = 0; seed < number_of_seeds; ++seed) {
+        ASSERT_EQ(two_pass_triples[seed].eigenvalues->size(), triples[seed].eigenvalues->size());
+        // all matrices are transformed by one regeneration of Krylov vectors:
+        auto two_pass_main_diagonals = two_pass_triples[seed].eigenvectors->getUnitaryTransformer()
+            ->calculateUnitaryTransformationOfMatrices(references_for_transform);
+        ASSERT_EQ(two_pass_main_diagonals.size(), number_of_matrices);
+        for (size_t j = 0; j < number_of_matrices; ++j) {
+            auto main_diagonal = triples[seed].eigenvectors->getUnitaryTransformer()
+                ->calculateUnitaryTransformationOfMatrix(matrices_for_transform[j]);
+            ASSERT_EQ(two_pass_main_diagonals[j]->size(), main_diagonal->size());
+            // FTLM sums <n|A|r>/<r|n> * |<r|n>|^2, so only the weighted values are compared:
+            double scale = 0;
+            for (size_t i = 0; i < main_diagonal->size(); ++i) {
+                double weight = triples[seed].ftlm_weights_of_states->at(i);
+                scale = std::max(scale, std::abs(main_diagonal->at(i) * weight));
+            }
+            for (size_t i = 0; i < main_diagonal->size(); ++i) {
+                double weight = triples[seed].ftlm_weights_of_states->at(i);
+                EXPECT_NEAR(
+                    two_pass_main_diagonals[j]->at(i) * weight,
+                    main_diagonal->at(i) * weight,
+                    1e-4 * scale) << "seed: " << seed << ", matrix: " << j << ", i: " << i;
+            }
+        }
+    }
+}
+
+TYPED_TEST_P(
+    AbstractDenseTransformAndDiagonalizeFactoryIndividualTest,
+    assign_stored_values_and_add_scaled_Equivalence) {
+    const size_t size = 32;
+    std::vector<std::unique_ptr<quantum::linear_algebra::AbstractDiagonalizableMatrix>> matrices;
+    matrices.push_back(this->factory_->createSparseDiagonalizableMatrix(size));
+    matrices.push_back(this->factory_->createSparseDiagonalizableMatrix(size));
+    matrices.push_back(this->factory_->createDenseDiagonalizableMatrix(size));
+    matrices.push_back(this->factory_->createDenseDiagonalizableMatrix(size));
+    // sparsity patterns of the first and the second matrices are different:
+    for (size_t k = 0; k < matrices.size(); k += 2) {
+        for (uint32_t i = 0; i < size; ++i) {
+            matrices[k]->add_to_position(i, i, i);
+            if (i % 3 == 0) {
+                matrices[k]->add_to_position(1, i, (i + 5) % size);
+            }
+            if (i % 2 == 0) {
+                matrices[k + 1]->add_to_position(-2, i, (i + 1) % size);
+            }
+        }
+    }
+
+    for (size_t k = 0; k < matrices.size(); k += 2) {
+        const auto& first = matrices[k];
+        const auto& second = matrices[k + 1];
+        auto pattern = first->multiply_by(1);
+        pattern->add_sparsity_pattern(*second);
+        auto first_values = pattern->stored_values_of(*first);
+        auto second_values = pattern->stored_values_of(*second);
+        ASSERT_EQ(first_values.size(), second_values.size());
+
+        for (double multiplier : {3.0, 0.0, -0.5}) {
+            std::vector<double> values(first_values.size());
+            for (size_t i = 0; i < values.size(); ++i) {
+                values[i] = first_values[i] + multiplier * second_values[i];
+            }
+            // explicitly stored zeros are kept by copy:
+            auto assigned = pattern->multiply_by(1);
+            assigned->assign_stored_values(values);
+            auto expected = first->multiply_by(1);
+            expected->add_scaled(multiplier, *second);
+            for (uint32_t i = 0; i < size; ++i) {
+                for (uint32_t j = 0; j < size; ++j) {
+                    EXPECT_NEAR(assigned->at(i, j), expected->at(i, j), 1e-5);
+                }
+            }
+        }
+        EXPECT_THROW(pattern->assign_stored_values(std::vector<double>(1)), std::length_error);
+    }
+    // stored elements of the second matrix are not in the sparsity pattern of the first one:
+    EXPECT_THROW(matrices[0]->stored_values_of(*matrices[1]), std::invalid_argument);
+}
+
+TYPED_TEST_P(
+    AbstractDenseTransformAndDiagonalizeFactoryIndividualTest,
+    diagonalizeValuesVectorsInWindow_and_diagonalizeValuesVectors) {
+    std::random_device dev;
+    std::mt19937 rng(dev());
+    std::uniform_real_distribution<double> dist(-10, +10);
+
+    for (size_t size = 16; size <= 128; size*=2) {
+        std::vector<std::unique_ptr<quantum::linear_algebra::AbstractDiagonalizableMatrix>> matrices;
+        matrices.push_back(generateDenseDiagonalizableMatrix(size, this->factory_, dist, rng));
+        // direct sum of two equal matrices has twice degenerate eigenvalues:
+        auto degenerate_matrix = this->factory_->createDenseDiagonalizableMatrix(2 * size);
+        for (size_t i = 0; i < size; ++i) {
+            for (size_t j = i; j < size; ++j) {
+                degenerate_matrix->add_to_position(matrices[0]->at(i, j), i, j);
+                degenerate_matrix->add_to_position(matrices[0]->at(i, j), i + size, j + size);
+            }
+        }
+        matrices.push_back(std::move(degenerate_matrix));
+
+        for (const auto& matrix : matrices) {
+            auto full_eigenvalues = matrix->diagonalizeValues();
+            size_t matrix_size = full_eigenvalues->size();
+            double range = full_eigenvalues->at(matrix_size - 1) - full_eigenvalues->at(0);
+            // energy window is chosen in the middle of the gap between two eigenvalues:
+            size_t expected_size = matrix_size / 8 + 1;
+            while (expected_size < matrix_size
+                   && full_eigenvalues->at(expected_size) - full_eigenvalues->at(expected_size - 1)
+                       < 1e-3 * range) {
+                ++expected_size;
+            }
+            double energy_window = expected_size == matrix_size
+                ? 2 * range
+                : (full_eigenvalues->at(expected_size) + full_eigenvalues->at(expected_size - 1)) / 2
+                    - full_eigenvalues->at(0);
+
+            auto window_couple = matrix->diagonalizeValuesVectorsInWindow(energy_window);
+            ASSERT_EQ(window_couple.eigenvalues->size(), expected_size);
+            ASSERT_EQ(window_couple.eigenvectors->size_cols(), expected_size);
+            ASSERT_EQ(window_couple.eigenvectors->size_rows(), matrix_size);
+
+            for (size_t k = 0; k < expected_size; ++k) {
+                double eigenvalue = window_couple.eigenvalues->at(k);
+                EXPECT_NEAR(eigenvalue, full_eigenvalues->at(k), 1e-4 * range);
+                // A v = \lambda v, at(k, i) returns the i-th component of the k-th eigenvector
+                for (size_t i = 0; i < matrix_size; ++i) {
+                    double residual = -eigenvalue * window_couple.eigenvectors->at(k, i);
+                    for (size_t j = 0; j < matrix_size; ++j) {
+                        residual += matrix->at(i, j) * window_couple.eigenvectors->at(k, j);
+                    }
+                    EXPECT_NEAR(residual, 0, 1e-4 * range);
+                }
+                // eigenvectors are orthonormal, even for degenerate eigenvalues
+                for (size_t l = 0; l <= k; ++l) {
+                    double scalar_product = 0;
+                    for (size_t i = 0; i < matrix_size; ++i) {
+                        scalar_product += window_couple.eigenvectors->at(k, i)
+                            * window_couple.eigenvectors->at(l, i);
+                    }
+                    EXPECT_NEAR(scalar_product, k == l ? 1 : 0, 1e-3);
+                }
+            }
+        }
+    }
+}
+
+TYPED_TEST_P(
+    AbstractDenseTransformAndDiagonalizeFactoryIndividualTest,
+    diagonalizeValuesVectorsInWindow_highly_degenerate_spectrum) {
+    std::random_device dev;
+    std::mt19937 rng(dev());
+    std::uniform_real_distribution<double> dist(-10, +10);
+
+    size_t number_of_levels = 8;
+    size_t multiplicity = 8;
+    size_t matrix_size = number_of_levels * multiplicity;
+    // A = Q D Q^T, where Q is the random orthogonal matrix and D has number_of_levels
+    // eigenvalues 0, 1, 2, ..., every one is multiplicity times degenerate:
+    auto random_matrix = generateDenseDiagonalizableMatrix(matrix_size, this->factory_, dist, rng);
+    auto orthogonal_matrix = random_matrix->diagonalizeValuesVectors().eigenvectors;
+    auto matrix = this->factory_->createDenseDiagonalizableMatrix(matrix_size);
+    for (size_t i = 0; i < matrix_size; ++i) {
+        for (size_t j = i; j < matrix_size; ++j) {
+            double value = 0;
+            for (size_t k = 0; k < matrix_size; ++k) {
+                double level = (double)(k / multiplicity);
+                value += level * orthogonal_matrix->at(k, i) * orthogonal_matrix->at(k, j);
+            }
+            matrix->add_to_position(value, i, j);
+        }
+    }
+
+    // two lowest levels are in the window:
+    size_t expected_size = 2 * multiplicity;
+    auto window_couple = matrix->diagonalizeValuesVectorsInWindow(1.5);
+    ASSERT_EQ(window_couple.eigenvalues->size(), expected_size);
+    ASSERT_EQ(window_couple.eigenvectors->size_cols(), expected_size);
+    ASSERT_EQ(window_couple.eigenvectors->size_rows(), matrix_size);
+
+    for (size_t k = 0; k < expected_size; ++k) {
+        double eigenvalue = window_couple.eigenvalues->at(k);
+        EXPECT_NEAR(eigenvalue, (double)(k / multiplicity), 1e-4);
+        // A v = \lambda v, at(k, i) returns the i-th component of the k-th eigenvector
+        for (size_t i = 0; i < matrix_size; ++i) {
+            double residual = -eigenvalue * window_couple.eigenvectors->at(k, i);
+            for (size_t j = 0; j < matrix_size; ++j) {
+                residual += matrix->at(i, j) * window_couple.eigenvectors->at(k, j);
+            }
+            EXPECT_NEAR(residual, 0, 1e-4);
+        }
+        // eigenvectors of the degenerate level span its whole eigenspace, so they are orthonormal:
+        for (size_t l = 0; l <= k; ++l) {
+            double scalar_product = 0;
+            for (size_t i = 0; i < matrix_size; ++i) {
+                scalar_product += window_couple.eigenvectors->at(k, i)
+                    * window_couple.eigenvectors->at(l, i);
+            }
+            EXPECT_NEAR(scalar_product, k == l ? 1 : 0, 1e-3);
+        }
+    }
+}
+
+TYPED_TEST_P(
+    AbstractDenseTransformAndDiagonalizeFactoryIndividualTest,
+    refineDiagonalizeValuesVectors_and_diagonalizeValuesVectors) {
+    std::random_device dev;
+    std::mt19937 rng(dev());
+    std::uniform_real_distribution<double> dist(-10, +10);
+    std::uniform_real_distribution<double> small_dist(-1e-2, +1e-2);
+
+    for (size_t size = 16; size <= 64; size*=2) {
+        auto initial_matrix = generateDenseDiagonalizableMatrix(size, this->factory_, dist, rng);
+        auto perturbation = generateDenseDiagonalizableMatrix(size, this->factory_, small_dist, rng);
+        auto matrix = this->factory_->createDenseDiagonalizableMatrix(size);
+        for (size_t i = 0; i < size; ++i) {
+            for (size_t j = i; j < size; ++j) {
+                matrix->add_to_position(initial_matrix->at(i, j) + perturbation->at(i, j), i, j);
+            }
+        }
+        auto full_eigenvalues = matrix->diagonalizeValues();
+        double range = full_eigenvalues->at(size - 1) - full_eigenvalues->at(0);
+
+        std::vector<std::unique_ptr<quantum::linear_algebra::AbstractDenseSemiunitaryMatrix>> initial_eigenvectors;
+        // all eigenvectors:
+        initial_eigenvectors.push_back(initial_matrix->diagonalizeValuesVectors().eigenvectors);
+        // only the lowest eigenvectors:
+        initial_eigenvectors.push_back(
+            initial_matrix->diagonalizeValuesVectorsInWindow(range / 4).eigenvectors);
+
+        for (const auto& initial : initial_eigenvectors) {
+            auto mb_couple = matrix->refineDiagonalizeValuesVectors(*initial, 1e-5, 20, std::nullopt);
+            ASSERT_TRUE(mb_couple.has_value());
+            const auto& couple = mb_couple.value();
+            size_t number_of_eigenpairs = initial->size_cols();
+            ASSERT_EQ(couple.eigenvalues->size(), number_of_eigenpairs);
+            ASSERT_EQ(couple.eigenvectors->size_cols(), number_of_eigenpairs);
+            for (size_t k = 0; k < number_of_eigenpairs; ++k) {
+                double eigenvalue = couple.eigenvalues->at(k);
+                EXPECT_NEAR(eigenvalue, full_eigenvalues->at(k), 1e-4 * range);
+                // A v = \lambda v, at(k, i) returns the i-th component of the k-th eigenvector
+                for (size_t i = 0; i < size; ++i) {
+                    double residual = -eigenvalue * couple.eigenvectors->at(k, i);
+                    for (size_t j = 0; j < size; ++j) {
+                        residual += matrix->at(i, j) * couple.eigenvectors->at(k, j);
+                    }
+                    EXPECT_NEAR(residual, 0, 1e-3 * range);
+                }
+            }
+        }
+    }
+}
+
+TYPED_TEST_P(
+    AbstractDenseTransformAndDiagonalizeFactoryIndividualTest,
+    refineDiagonalizeValuesVectors_window_edge) {
+    std::random_device dev;
+    std::mt19937 rng(dev());
+    std::uniform_real_distribution<double> dist(-10, +10);
+
+    size_t size = 32;
+    auto random_matrix = generateDenseDiagonalizableMatrix(size, this->factory_, dist, rng);
+    auto orthogonal_matrix = random_matrix->diagonalizeValuesVectors().eigenvectors;
+    // Q D Q^T with the given eigenvalues D:
+    auto construct_matrix = [&](const std::vector<double>& eigenvalues) {
+        auto matrix = this->factory_->createDenseDiagonalizableMatrix(size);
+        for (size_t i = 0; i < size; ++i) {
+            for (size_t j = i; j < size; ++j) {
+                double value = 0;
+                for (size_t k = 0; k < size; ++k) {
+                    value += eigenvalues[k] * orthogonal_matrix->at(k, i) * orthogonal_matrix->at(k, j);
+                }
+                matrix->add_to_position(value, i, j);
+            }
+        }
+        return matrix;
+    };
+    std::vector<double> initial_eigenvalues(size);
+    for (size_t k = 0; k < size; ++k) {
+        initial_eigenvalues[k] = k < 3 ? (double)k : 10.0 + (double)k;
+    }
+    double energy_window = 5;
+    auto initial_eigenvectors =
+        construct_matrix(initial_eigenvalues)->diagonalizeValuesVectorsInWindow(energy_window).eigenvectors;
+    ASSERT_EQ(initial_eigenvectors->size_cols(), 3);
+
+    // all states above the window are still far from it:
+    auto shifted_eigenvalues = initial_eigenvalues;
+    for (size_t k = 0; k < size; ++k) {
+        shifted_eigenvalues[k] += 0.01 * (double)k;
+    }
+    auto mb_couple = construct_matrix(shifted_eigenvalues)
+                         ->refineDiagonalizeValuesVectors(*initial_eigenvectors, 1e-6, 200, energy_window);
+    ASSERT_TRUE(mb_couple.has_value());
+    ASSERT_EQ(mb_couple->eigenvalues->size(), 3);
+    for (size_t k = 0; k < 3; ++k) {
+        EXPECT_NEAR(mb_couple->eigenvalues->at(k), shifted_eigenvalues[k], 1e-4);
+    }
+
+    // the fourth state has come into the window:
+    auto entered_eigenvalues = initial_eigenvalues;
+    entered_eigenvalues[3] = 4;
+    EXPECT_FALSE(construct_matrix(entered_eigenvalues)
+                     ->refineDiagonalizeValuesVectors(*initial_eigenvectors, 1e-6, 200, energy_window)
+                     .has_value());
+}
+
+TYPED_TEST_P(
+    AbstractDenseTransformAndDiagonalizeFactoryIndividualTest,
+    mixedPrecisionDiagonalizeValuesVectors_and_diagonalizeValuesVectors) {
+    std::random_device dev;
+    std::mt19937 rng(dev());
+    std::uniform_real_distribution<double> dist(-10, +10);
+
+    for (size_t size = 16; size <= 128; size*=2) {
+        this->factory_->setPrecision(quantum::linear_algebra::DOUBLE);
+        auto block = generateDenseDiagonalizableMatrix(size / 2, this->factory_, dist, rng);
+        auto random = generateDenseDiagonalizableMatrix(size, this->factory_, dist, rng);
+        this->factory_->setPrecision(quantum::linear_algebra::MIXED);
+        // random matrix and direct sum of two equal blocks with doubly degenerate eigenvalues:
+        std::vector<std::unique_ptr<quantum::linear_algebra::AbstractDiagonalizableMatrix>> matrices;
+        matrices.push_back(this->factory_->createDenseDiagonalizableMatrix(size));
+        matrices.push_back(this->factory_->createDenseDiagonalizableMatrix(size));
+        for (size_t i = 0; i < size; ++i) {
+            for (size_t j = i; j < size; ++j) {
+                matrices[0]->add_to_position(random->at(i, j), i, j);
+            }
+        }
+        for (size_t shift = 0; shift < size; shift += size / 2) {
+            for (size_t i = 0; i < size / 2; ++i) {
+                for (size_t j = i; j < size / 2; ++j) {
+                    matrices[1]->add_to_position(block->at(i, j), shift + i, shift + j);
+                }
+            }
+        }
+        this->factory_->setPrecision(quantum::linear_algebra::DOUBLE);
+
+        for (const auto& matrix : matrices) {
+            auto reference_matrix = this->factory_->createDenseDiagonalizableMatrix(size);
+            for (size_t i = 0; i < size; ++i) {
+                for (size_t j = i; j < size; ++j) {
+                    reference_matrix->add_to_position(matrix->at(i, j), i, j);
+                }
+            }
+            auto reference_eigenvalues = reference_matrix->diagonalizeValues();
+            double range = reference_eigenvalues->at(size - 1) - reference_eigenvalues->at(0);
+
+            auto eigenvalues = matrix->diagonalizeValues();
+            auto couple = matrix->diagonalizeValuesVectors();
+            ASSERT_EQ(eigenvalues->size(), size);
+            ASSERT_EQ(couple.eigenvalues->size(), size);
+            ASSERT_EQ(couple.eigenvectors->size_cols(), size);
+            for (size_t k = 0; k < size; ++k) {
+                // much more accurate than single precision:
+                EXPECT_NEAR(eigenvalues->at(k), reference_eigenvalues->at(k), 1e-10 * range);
+                EXPECT_NEAR(couple.eigenvalues->at(k), reference_eigenvalues->at(k), 1e-10 * range);
+                // A v = \lambda v, at(k, i) returns the i-th component of the k-th eigenvector
+                for (size_t i = 0; i < size; ++i) {
+                    double residual = -couple.eigenvalues->at(k) * couple.eigenvectors->at(k, i);
+                    for (size_t j = 0; j < size; ++j) {
+                        residual += matrix->at(i, j) * couple.eigenvectors->at(k, j);
+                    }
+                    EXPECT_NEAR(residual, 0, 1e-10 * range);
+                }
+                for (size_t l = k; l < size; ++l) {
+                    double overlap = 0;
+                    for (size_t i = 0; i < size; ++i) {
+                        overlap += couple.eigenvectors->at(k, i) * couple.eigenvectors->at(l, i);
+                    }
+                    EXPECT_NEAR(overlap, k == l ? 1 : 0, 1e-10);
+                }
+            }
+        }
+    }
+}
+
 TYPED_TEST_P(
     AbstractDenseTransformAndDiagonalizeFactoryIndividualTest,
     randomUnitVectorsAreUnit) {
@@ -194,15 +774,57 @@ TYPED_TEST_P(
     }
 }
 
+TYPED_TEST_P(
+    AbstractDenseTransformAndDiagonalizeFactoryIndividualTest,
+    boltzmannSums_and_dot_triple_dot_Equivalence) {
+    std::vector<double> temperatures = {0.5, 1, 2, 10, 100, 300};
+    for (uint32_t size : {1, 1000, 1024, 3000}) {
+        auto random_vectors = this->factory_->createRandomUnitVectors(size, 4);
+        auto energy = random_vectors[0]->multiply_by(100);
+        energy->subtract_minimum();
+        const auto& weights = random_vectors[1];
+        std::vector<std::reference_wrapper<const std::unique_ptr<quantum::linear_algebra::AbstractDenseVector>>>
+            values = {random_vectors[2], random_vectors[3]};
+
+        auto [numerators, partition_functions] = energy->boltzmann_sums(weights, values, temperatures);
+
+        ASSERT_EQ(partition_functions.size(), temperatures.size());
+        ASSERT_EQ(numerators.size(), values.size());
+        for (size_t j = 0; j < temperatures.size(); ++j) {
+            auto boltzmann_factors = energy->multiply_by(-1.0 / temperatures[j]);
+            boltzmann_factors->wise_exp();
+            double partition_function = boltzmann_factors->dot(weights);
+            EXPECT_NEAR(partition_functions[j], partition_function, 1e-4 * std::abs(partition_function) + 1e-10);
+            for (size_t k = 0; k < values.size(); ++k) {
+                ASSERT_EQ(numerators[k].size(), temperatures.size());
+                double numerator = values[k].get()->triple_dot(weights, boltzmann_factors);
+                EXPECT_NEAR(numerators[k][j], numerator, 1e-4 * std::abs(numerator) + 1e-10);
+            }
+        }
+    }
+}
+
 REGISTER_TYPED_TEST_SUITE_P(
     AbstractDenseTransformAndDiagonalizeFactoryIndividualTest,
     NonNullptrObjects,
     krylovUnitaryTransformationAndReturnMainDiagonal_and_UnitaryTransformationAndReturnMainDiagonal_Equivalence,
+    UnitaryTransformationAndReturnMainDiagonal_and_explicit_UnitaryTransformation_Equivalence,
     krylovDiagonalizeValues_and_krylovDiagonalizeValuesVectors,
     krylovDiagonalizeValues_and_diagonalizeValues,
+    krylovOfSeeds_and_krylovOfEverySeed,
+    krylovOfSeeds_breakdown_and_convergence,
+    krylovTwoPass_and_krylovOfSeeds_Equivalence,
+    krylovTwoPass_and_krylovOfSeeds_large_krylov_subspace,
+    assign_stored_values_and_add_scaled_Equivalence,
+    diagonalizeValuesVectorsInWindow_and_diagonalizeValuesVectors,
+    diagonalizeValuesVectorsInWindow_highly_degenerate_spectrum,
+    refineDiagonalizeValuesVectors_and_diagonalizeValuesVectors,
+    refineDiagonalizeValuesVectors_window_edge,
+    mixedPrecisionDiagonalizeValuesVectors_and_diagonalizeValuesVectors,
     randomUnitVectorsAreUnit,
     randomUnitVectorsAreUnbiased,
     correctNumberOfRandomUnitVectors,
-    randomUnitVectorsAreIndependent);
+    randomUnitVectorsAreIndependent,
+    boltzmannSums_and_dot_triple_dot_Equivalence);
 
 #endif  //SPINNER_ABSTRACT_INDIVIDUAL_TESTS_H
@@ -0,0 +1,91 @@
+#include "gtest/gtest.h"
+#include "src/common/runner/Runner.h"
+#include "src/eigendecompositor/LinearHamiltonianCache.h"
+
+namespace {
+model::ModelInput construct_model(double J_one, double J_two, double J_fixed, double D) {
+    model::ModelInput model({2, 3, 4});
+    auto J_one_name = model.addSymbol("J1", J_one);
+    auto J_two_name = model.addSymbol("J2", J_two);
+    auto J_fixed_name = model.addSymbol("J3", J_fixed, false);
+    auto D_name = model.addSymbol("D", D, true, model::symbols::D);
+    model.assignSymbolToIsotropicExchange(J_one_name, 0, 1)
+        .assignSymbolToIsotropicExchange(J_two_name, 1, 2)
+        .assignSymbolToIsotropicExchange(J_fixed_name, 0, 2)
+        .assignSymbolToZFSNoAnisotropy(D_name, 1)
+        .assignSymbolToZFSNoAnisotropy(D_name, 2);
+    return model;
+}
+
+void expect_assembled_hamiltonian_is_equal_to_constructed_one(bool return_sparse_if_possible) {
+    double J_one = 10, J_two = -5, J_fixed = 3, D = 2;
+    runner::Runner initial_runner(construct_model(J_one, J_two, J_fixed, D));
+
+    std::vector<eigendecompositor::LinearHamiltonianCache::SymbolPart> symbol_parts;
+    for (auto [name, value_ptr] : std::vector<std::pair<std::string, double*>>{
+             {"J1", &J_one},
+             {"J2", &J_two},
+             {"D", &D}}) {
+        model::symbols::SymbolName symbol_name(name);
+        symbol_parts.push_back(
+            {symbol_name,
+             initial_runner.getOperatorDerivative(common::Energy, symbol_name).value(),
+             [value_ptr]() { return *value_ptr; }});
+    }
+    eigendecompositor::LinearHamiltonianCache cache(
+        std::move(symbol_parts),
+        initial_runner.getIndexConverter(),
+        initial_runner.getDataStructuresFactories(),
+        return_sparse_if_possible);
+
+    const auto& space = initial_runner.getSpace();
+    const auto& initial_energy_operator = *initial_runner.getOperator(common::Energy).value();
+    cache.initialize(space.getBlocks().size());
+
+    for (size_t number_of_block = 0; number_of_block < space.getBlocks().size(); ++number_of_block) {
+        const auto& subspace = space.getBlocks()[number_of_block];
+        auto constructed = Submatrix(
+            subspace,
+            initial_energy_operator,
+            initial_runner.getIndexConverter(),
+            initial_runner.getDataStructuresFactories(),
+            return_sparse_if_possible);
+        auto cached = cache.construct(number_of_block, subspace, initial_energy_operator);
+        for (uint32_t i = 0; i < subspace.size(); ++i) {
+            for (uint32_t j = 0; j < subspace.size(); ++j) {
+                EXPECT_NEAR(constructed.raw_data->at(i, j), cached.raw_data->at(i, j), 1e-9);
+            }
+        }
+    }
+
+    J_one = -7, J_two = 4, D = -1;
+    runner::Runner final_runner(construct_model(J_one, J_two, J_fixed, D));
+    const auto& final_energy_operator = *final_runner.getOperator(common::Energy).value();
+
+    for (size_t number_of_block = 0; number_of_block < space.getBlocks().size(); ++number_of_block) {
+        const auto& subspace = space.getBlocks()[number_of_block];
+        auto constructed = Submatrix(
+            subspace,
+            final_energy_operator,
+            final_runner.getIndexConverter(),
+            final_runner.getDataStructuresFactories(),
+            return_sparse_if_possible);
+        // the energy operator is not used, when the block has been cached:
+        auto assembled = cache.construct(number_of_block, subspace, initial_energy_operator);
+        for (uint32_t i = 0; i < subspace.size(); ++i) {
+            for (uint32_t j = 0; j < subspace.size(); ++j) {
+                EXPECT_NEAR(constructed.raw_data->at(i, j), assembled.raw_data->at(i, j), 1e-9);
+            }
+        }
+    }
+}
+}  // namespace
+
+TEST(linear_hamiltonian_cache, assembled_hamiltonian_is_equal_to_constructed_one) {
+    expect_assembled_hamiltonian_is_equal_to_constructed_one(false);
+}
+
+// sparsity patterns of H_0 and H_k are different, the assembled Hamiltonian is stored on their union:
+TEST(linear_hamiltonian_cache, assembled_sparse_hamiltonian_is_equal_to_constructed_one) {
+    expect_assembled_hamiltonian_is_equal_to_constructed_one(true);
+}
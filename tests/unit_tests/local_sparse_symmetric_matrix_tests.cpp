@@ -0,0 +1,91 @@
+#include <random>
+
+#include "gtest/gtest.h"
+#include "src/entities/data_structures/FactoriesList.h"
+#include "src/entities/data_structures/hashmap/HashmapFactories.h"
+#ifdef _Arma_BUILT
+#include "src/entities/data_structures/arma/ArmaFactories.h"
+#endif
+
+namespace {
+std::vector<quantum::linear_algebra::FactoriesList> construct_factories_with_all_sparse_factories() {
+    std::vector<quantum::linear_algebra::FactoriesList> answer;
+    answer.emplace_back(
+        quantum::linear_algebra::AbstractDenseTransformAndDiagonalizeFactory::defaultFactory(),
+        std::make_shared<quantum::linear_algebra::EmhashSparseTransformFactory>());
+#ifdef _Arma_BUILT
+    answer.emplace_back(
+        quantum::linear_algebra::AbstractDenseTransformAndDiagonalizeFactory::defaultFactory(),
+        std::make_shared<quantum::linear_algebra::ArmaSparseTransformFactory>());
+#endif
+    return answer;
+}
+}  // namespace
+
+TEST(local_sparse_symmetric_matrix, skip_elements_outside_of_local_vectors) {
+    for (const auto& factories : construct_factories_with_all_sparse_factories()) {
+        auto matrix = factories.createLocalSparseSymmetricMatrix({7, 2, 5, 2});
+
+        EXPECT_EQ(matrix->size(), 3);
+
+        matrix->add_to_position(1.0, 2, 5);
+        matrix->add_to_position(2.0, 7, 7);
+        matrix->add_to_position(3.0, 2, 3);
+        matrix->add_to_position(4.0, 4, 4);
+        matrix->add_to_position(0.5, 5, 2);
+
+        EXPECT_DOUBLE_EQ(matrix->at(2, 5), 1.5);
+        EXPECT_DOUBLE_EQ(matrix->at(5, 2), 1.5);
+        EXPECT_DOUBLE_EQ(matrix->at(7, 7), 2.0);
+        EXPECT_DOUBLE_EQ(matrix->at(2, 3), 0.0);
+        EXPECT_DOUBLE_EQ(matrix->at(4, 4), 0.0);
+        EXPECT_DOUBLE_EQ(matrix->at(2, 7), 0.0);
+    }
+}
+
+TEST(local_sparse_symmetric_matrix, unitary_transform_is_equal_to_total_space_one) {
+    for (const auto& factories : construct_factories_with_all_sparse_factories()) {
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+        uint32_t total_space_size = 60;
+        // every space vector is built from a few lexicographic vectors with even indexes,
+        // so odd lexicographic vectors do not belong to the block:
+        uint32_t size_of_block = 12;
+        auto decomposition = factories.createSparseSemiunitaryMatrix(size_of_block, total_space_size);
+        std::vector<uint32_t> indexes_of_vectors;
+        for (uint32_t i = 0; i < size_of_block; ++i) {
+            for (uint32_t k = 0; k < 3; ++k) {
+                uint32_t lex_index = 2 * ((5 * i + 7 * k) % (total_space_size / 2));
+                decomposition->add_to_position(distribution(generator), i, lex_index);
+                indexes_of_vectors.push_back(lex_index);
+            }
+        }
+        decomposition->normalize();
+
+        auto total_space_matrix = factories.createSparseSymmetricMatrix(total_space_size);
+        auto local_matrix = factories.createLocalSparseSymmetricMatrix(indexes_of_vectors);
+        for (uint32_t i = 0; i < total_space_size; ++i) {
+            for (uint32_t j = i; j < total_space_size; ++j) {
+                if ((i * j + i + j) % 3 == 0) {
+                    double value = distribution(generator);
+                    total_space_matrix->add_to_position(value, i, j);
+                    local_matrix->add_to_position(value, i, j);
+                }
+            }
+        }
+
+        std::unique_ptr<quantum::linear_algebra::AbstractDiagonalizableMatrix> total_space_result =
+            factories.createDenseDiagonalizableMatrix(size_of_block);
+        std::unique_ptr<quantum::linear_algebra::AbstractDiagonalizableMatrix> local_result =
+            factories.createDenseDiagonalizableMatrix(size_of_block);
+        decomposition->unitaryTransform(total_space_matrix, total_space_result);
+        decomposition->unitaryTransform(local_matrix, local_result);
+
+        for (uint32_t i = 0; i < size_of_block; ++i) {
+            for (uint32_t j = 0; j < size_of_block; ++j) {
+                EXPECT_NEAR(total_space_result->at(i, j), local_result->at(i, j), 1e-12);
+            }
+        }
+    }
+}
@@ -0,0 +1,155 @@
+#include <omp.h>
+
+#include <chrono>
+#include <random>
+
+#include "gtest/gtest.h"
+#include "src/common/runner/Runner.h"
+#include "src/entities/matrix/MatrixFreeSubmatrix.h"
+
+namespace {
+runner::Runner construct_runner() {
+    model::ModelInput model({2, 3, 2, 3});
+    auto J_one = model.addSymbol("J1", 10);
+    auto J_two = model.addSymbol("J2", -5);
+    auto D = model.addSymbol("D", 2, true, model::symbols::D);
+    model.assignSymbolToIsotropicExchange(J_one, 0, 1)
+        .assignSymbolToIsotropicExchange(J_one, 2, 3)
+        .assignSymbolToIsotropicExchange(J_two, 1, 2)
+        .assignSymbolToIsotropicExchange(J_two, 3, 0)
+        .assignSymbolToZFSNoAnisotropy(D, 1)
+        .assignSymbolToZFSNoAnisotropy(D, 3);
+    common::physical_optimization::OptimizationList optimization_list;
+    optimization_list.TzSort().Symmetrize(group::Group::S2, {{2, 3, 0, 1}});
+    return runner::Runner(model, optimization_list);
+}
+}  // namespace
+
+TEST(matrix_free_submatrix, apply_is_equal_to_multiplication_by_constructed_submatrix) {
+    auto runner = construct_runner();
+    auto energy_operator = runner.getOperator(common::Energy).value();
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(-1, 1);
+    const uint32_t number_of_vectors = 3;
+
+    for (const auto& subspace : runner.getSpace().getBlocks()) {
+        auto constructed = Submatrix(
+            subspace,
+            *energy_operator,
+            runner.getIndexConverter(),
+            runner.getDataStructuresFactories(),
+            false);
+        MatrixFreeSubmatrix matrix_free(subspace, energy_operator);
+        uint32_t size = subspace.size();
+        ASSERT_EQ(matrix_free.size(), size);
+
+        std::vector<double> x(size * number_of_vectors);
+        for (auto& el : x) {
+            el = distribution(generator);
+        }
+        std::vector<double> y(size * number_of_vectors);
+        matrix_free.apply(x.data(), y.data(), number_of_vectors);
+
+        for (uint32_t vector = 0; vector < number_of_vectors; ++vector) {
+            for (uint32_t i = 0; i < size; ++i) {
+                double expected = 0;
+                for (uint32_t j = 0; j < size; ++j) {
+                    expected += constructed.raw_data->at(i, j) * x[j + vector * size];
+                }
+                EXPECT_NEAR(y[i + vector * size], expected, 1e-9);
+            }
+        }
+    }
+}
+
+TEST(matrix_free_submatrix, matrix_free_diagonalizable_matrix_is_equal_to_constructed_submatrix) {
+    auto runner = construct_runner();
+    auto energy_operator = runner.getOperator(common::Energy).value();
+
+    for (const auto& subspace : runner.getSpace().getBlocks()) {
+        auto constructed = Submatrix(
+            subspace,
+            *energy_operator,
+            runner.getIndexConverter(),
+            runner.getDataStructuresFactories(),
+            false);
+        auto matrix_free = runner.getDataStructuresFactories().createMatrixFreeDiagonalizableMatrix(
+            std::make_shared<MatrixFreeSubmatrix>(subspace, energy_operator));
+        auto multiplied = matrix_free->multiply_by(-2);
+        ASSERT_EQ(matrix_free->size(), subspace.size());
+
+        for (uint32_t i = 0; i < subspace.size(); ++i) {
+            for (uint32_t j = 0; j < subspace.size(); ++j) {
+                EXPECT_NEAR(constructed.raw_data->at(i, j), matrix_free->at(i, j), 1e-9);
+                EXPECT_NEAR(-2 * constructed.raw_data->at(i, j), multiplied->at(i, j), 1e-9);
+            }
+        }
+    }
+}
+
+// the largest block contains more rows than chunks of all threads, so elements of rows
+// of other chunks are added concurrently:
+TEST(matrix_free_submatrix, apply_is_independent_of_number_of_threads_and_faster_than_construction) {
+    model::ModelInput model({3, 3, 3, 3, 3, 3, 3, 3});
+    auto J_one = model.addSymbol("J1", 10);
+    auto J_two = model.addSymbol("J2", -5);
+    auto D = model.addSymbol("D", 2, true, model::symbols::D);
+    for (uint32_t center = 0; center < 8; ++center) {
+        model.assignSymbolToIsotropicExchange(center % 2 == 0 ? J_one : J_two, center, (center + 1) % 8)
+            .assignSymbolToZFSNoAnisotropy(D, center);
+    }
+    common::physical_optimization::OptimizationList optimization_list;
+    optimization_list.TzSort();
+    runner::Runner runner(model, optimization_list);
+    auto energy_operator = runner.getOperator(common::Energy).value();
+
+    const auto& blocks = runner.getSpace().getBlocks();
+    const auto& subspace = *std::max_element(
+        blocks.cbegin(),
+        blocks.cend(),
+        [](const auto& lhs, const auto& rhs) { return lhs.size() < rhs.size(); });
+    uint32_t size = subspace.size();
+    ASSERT_GT(size, 1000);
+
+    auto construction_start = std::chrono::steady_clock::now();
+    auto constructed = Submatrix(
+        subspace,
+        *energy_operator,
+        runner.getIndexConverter(),
+        runner.getDataStructuresFactories(),
+        false);
+    auto construction_time = std::chrono::steady_clock::now() - construction_start;
+
+    MatrixFreeSubmatrix matrix_free(subspace, energy_operator);
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(-1, 1);
+    const uint32_t number_of_vectors = 2;
+    std::vector<double> x(size * number_of_vectors);
+    for (auto& el : x) {
+        el = distribution(generator);
+    }
+
+    std::vector<double> y(size * number_of_vectors);
+    auto apply_start = std::chrono::steady_clock::now();
+    matrix_free.apply(x.data(), y.data(), number_of_vectors);
+    auto apply_time = std::chrono::steady_clock::now() - apply_start;
+    // applying does not construct the submatrix, so it has to be much faster:
+    EXPECT_LT(apply_time, construction_time);
+
+    int max_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    std::vector<double> single_threaded_y(size * number_of_vectors);
+    matrix_free.apply(x.data(), single_threaded_y.data(), number_of_vectors);
+    omp_set_num_threads(max_threads);
+
+    for (uint32_t vector = 0; vector < number_of_vectors; ++vector) {
+        for (uint32_t i = 0; i < size; ++i) {
+            double expected = 0;
+            for (uint32_t j = 0; j < size; ++j) {
+                expected += constructed.raw_data->at(i, j) * x[j + vector * size];
+            }
+            EXPECT_NEAR(y[i + vector * size], expected, 1e-9);
+            EXPECT_NEAR(y[i + vector * size], single_threaded_y[i + vector * size], 1e-9);
+        }
+    }
+}
@@ -245,6 +245,136 @@ custom:
     }
 }
 
+TEST(parser_tests, optimizations_parser_boltzmann_window) {
+    {
+        std::string string = R""""(
+mode: custom
+custom:
+  basis: lex
+  boltzmann_window:
+    max_temperature: 300
+    number_of_kT: 20
+)"""";
+        auto parser = input::OptimizationsParser(YAML::Load(string));
+
+        const auto& optimizationList = parser.getOptimizationList().value();
+
+        EXPECT_TRUE(optimizationList.isBoltzmannWindowed());
+        EXPECT_DOUBLE_EQ(optimizationList.getBoltzmannWindowSettings().max_temperature, 300);
+        EXPECT_DOUBLE_EQ(optimizationList.getBoltzmannWindowSettings().number_of_kT, 20);
+    }
+    {
+        std::string string = R""""(
+mode: custom
+custom:
+  basis: lex
+  boltzmann_window:
+)"""";
+        // the maximum temperature of job is used by default:
+        auto parser = input::OptimizationsParser(YAML::Load(string), 150);
+
+        const auto& optimizationList = parser.getOptimizationList().value();
+
+        EXPECT_TRUE(optimizationList.isBoltzmannWindowed());
+        EXPECT_DOUBLE_EQ(optimizationList.getBoltzmannWindowSettings().max_temperature, 150);
+        EXPECT_DOUBLE_EQ(optimizationList.getBoltzmannWindowSettings().number_of_kT, 40);
+
+        EXPECT_ANY_THROW(input::OptimizationsParser(YAML::Load(string)));
+    }
+    {
+        std::string string = R""""(
+mode: custom
+custom:
+  basis: lex
+  boltzmann_window:
+    max_temperature: -300
+)"""";
+        EXPECT_ANY_THROW(input::OptimizationsParser(YAML::Load(string)));
+    }
+    {
+        std::string string = R""""(
+mode: custom
+custom:
+  basis: lex
+  tz_sorter:
+  positive_tz_eliminator:
+  ftlm:
+    krylov_subspace_size: 10
+    exact_decomposition_threshold: 20
+    number_of_seeds: 10
+  boltzmann_window:
+    max_temperature: 300
+)"""";
+        EXPECT_ANY_THROW(input::OptimizationsParser(YAML::Load(string)));
+    }
+}
+
+TEST(parser_tests, optimizations_parser_degeneracy_compression) {
+    {
+        std::string string = R""""(
+mode: custom
+custom:
+  basis: ito
+  degeneracy_compression:
+    tolerance: 1e-6
+)"""";
+        auto parser = input::OptimizationsParser(YAML::Load(string));
+
+        const auto& optimizationList = parser.getOptimizationList().value();
+
+        EXPECT_TRUE(optimizationList.isDegeneracyCompressed());
+        EXPECT_DOUBLE_EQ(optimizationList.getDegeneracyCompressionSettings().tolerance, 1e-6);
+    }
+    {
+        std::string string = R""""(
+mode: custom
+custom:
+  basis: ito
+  degeneracy_compression:
+)"""";
+        auto parser = input::OptimizationsParser(YAML::Load(string));
+
+        const auto& optimizationList = parser.getOptimizationList().value();
+
+        EXPECT_TRUE(optimizationList.isDegeneracyCompressed());
+        EXPECT_DOUBLE_EQ(optimizationList.getDegeneracyCompressionSettings().tolerance, 1e-8);
+    }
+    {
+        std::string string = R""""(
+mode: custom
+custom:
+  basis: ito
+  degeneracy_compression:
+    tolerance: -1
+)"""";
+        EXPECT_ANY_THROW(input::OptimizationsParser(YAML::Load(string)));
+    }
+}
+
+TEST(parser_tests, optimizations_parser_linear_hamiltonian_cache) {
+    {
+        std::string string = R""""(
+mode: custom
+custom:
+  basis: lex
+  linear_hamiltonian_cache:
+)"""";
+        auto parser = input::OptimizationsParser(YAML::Load(string));
+
+        EXPECT_TRUE(parser.getOptimizationList().value().isLinearHamiltonianCached());
+    }
+    {
+        std::string string = R""""(
+mode: custom
+custom:
+  basis: lex
+)"""";
+        auto parser = input::OptimizationsParser(YAML::Load(string));
+
+        EXPECT_FALSE(parser.getOptimizationList().value().isLinearHamiltonianCached());
+    }
+}
+
 TEST(parser_tests, job_parser_modes) {
     {
         std::string string = R""""(
@@ -0,0 +1,53 @@
+#include "gtest/gtest.h"
+#include "src/model/operators/terms/ito/ReducedMatrixElementsCache.h"
+
+namespace {
+model::operators::ito::ReducedMatrixElements constructElements(size_t size) {
+    model::operators::ito::ReducedMatrixElements elements;
+    for (size_t i = 0; i < size; ++i) {
+        elements.push_back({(uint32_t)i, 2, 0.5 * i});
+    }
+    return elements;
+}
+}  // namespace
+
+TEST(reduced_matrix_elements_cache, emplaced_elements_are_found) {
+    model::operators::ito::ReducedMatrixElementsCache cache;
+    auto key = model::operators::ito::ReducedMatrixElementsCache::to_key(0, 1, 4);
+    EXPECT_EQ(cache.find(key), nullptr);
+
+    cache.emplace(key, constructElements(3));
+    const auto* elements = cache.find(key);
+    ASSERT_NE(elements, nullptr);
+    ASSERT_EQ(elements->size(), 3);
+    EXPECT_EQ(elements->at(2).index_of_right_level, 2);
+    EXPECT_EQ(elements->at(2).value, 1.0);
+    EXPECT_EQ(cache.number_of_elements(), 3);
+    EXPECT_EQ(cache.find(model::operators::ito::ReducedMatrixElementsCache::to_key(1, 0, 4)), nullptr);
+}
+
+TEST(reduced_matrix_elements_cache, map_is_cleared_when_it_exceeds_the_limit) {
+    model::operators::ito::ReducedMatrixElementsCache cache(4);
+    auto first_key = model::operators::ito::ReducedMatrixElementsCache::to_key(0, 1, 0);
+    auto second_key = model::operators::ito::ReducedMatrixElementsCache::to_key(0, 1, 1);
+
+    cache.emplace(first_key, constructElements(3));
+    const auto& second_elements = cache.emplace(second_key, constructElements(3));
+    EXPECT_EQ(second_elements.size(), 3);
+    EXPECT_EQ(cache.find(first_key), nullptr);
+    EXPECT_NE(cache.find(second_key), nullptr);
+    EXPECT_EQ(cache.number_of_elements(), 3);
+}
+
+TEST(reduced_matrix_elements_cache, clear_releases_all_elements) {
+    model::operators::ito::ReducedMatrixElementsCache cache;
+    auto key = model::operators::ito::ReducedMatrixElementsCache::to_key(2, 3, 7);
+    cache.emplace(key, constructElements(5));
+
+    cache.clear();
+    EXPECT_EQ(cache.find(key), nullptr);
+    EXPECT_EQ(cache.number_of_elements(), 0);
+
+    cache.emplace(key, constructElements(1));
+    EXPECT_NE(cache.find(key), nullptr);
+}
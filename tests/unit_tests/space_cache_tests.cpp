@@ -0,0 +1,100 @@
+#include <filesystem>
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "src/space/SpaceCache.h"
+#include "src/space/optimization/OptimizedSpaceConstructor.h"
+#include "tests/tools/OptimizationListsGenerator.h"
+
+namespace {
+std::vector<common::physical_optimization::OptimizationList> generateOptimizationLists() {
+    return generate_all_optimization_lists({group::Group({group::Group::Dihedral, 3}, {{1, 2, 0}, {0, 2, 1}})});
+}
+
+void expectEqualSpaces(const space::Space& first, const space::Space& second) {
+    ASSERT_EQ(first.getBlocks().size(), second.getBlocks().size());
+    for (size_t i = 0; i < first.getBlocks().size(); ++i) {
+        const auto& first_block = first.getBlocks()[i];
+        const auto& second_block = second.getBlocks()[i];
+        EXPECT_EQ(first_block.properties, second_block.properties);
+        ASSERT_EQ(first_block.decomposition->size_cols(), second_block.decomposition->size_cols());
+        ASSERT_EQ(first_block.decomposition->size_rows(), second_block.decomposition->size_rows());
+        for (uint32_t j = 0; j < first_block.decomposition->size_cols(); ++j) {
+            auto first_iterator = first_block.decomposition->GetNewIterator(j);
+            ASSERT_EQ(first_iterator->size(), second_block.decomposition->GetNewIterator(j)->size());
+            while (first_iterator->hasNext()) {
+                auto item = first_iterator->getNext();
+                EXPECT_EQ(item.value, second_block.decomposition->at(j, item.index));
+            }
+        }
+    }
+}
+
+size_t numberOfEntries(const std::filesystem::path& directory) {
+    size_t number = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        number += entry.path().extension() == ".space";
+    }
+    return number;
+}
+
+class space_cache_tests : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path()
+            / ("spinner_space_cache_tests_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()));
+        std::filesystem::remove_all(directory_);
+    }
+    void TearDown() override {
+        space::SpaceCache::disable();
+        std::filesystem::remove_all(directory_);
+    }
+    std::filesystem::path directory_;
+};
+}  // namespace
+
+TEST_F(space_cache_tests, keys_of_different_optimizations_are_different) {
+    std::set<std::string> keys;
+    auto optimization_lists = generateOptimizationLists();
+    for (const auto& optimization_list : optimization_lists) {
+        runner::ConsistentModelOptimizationList consistent_list(model::ModelInput({2, 2, 2}), optimization_list);
+        keys.insert(space::SpaceCache::constructKey(consistent_list));
+    }
+    EXPECT_EQ(keys.size(), optimization_lists.size());
+}
+
+TEST_F(space_cache_tests, cached_space_is_equal_to_constructed) {
+    quantum::linear_algebra::FactoriesList factories;
+    auto optimization_lists = generateOptimizationLists();
+    for (const auto& optimization_list : optimization_lists) {
+        runner::ConsistentModelOptimizationList consistent_list(model::ModelInput({3, 3, 3}), optimization_list);
+
+        space::SpaceCache::disable();
+        auto constructed = space::optimization::OptimizedSpaceConstructor::construct(consistent_list, factories);
+
+        space::SpaceCache::setDirectory(directory_);
+        auto stored = space::optimization::OptimizedSpaceConstructor::construct(consistent_list, factories);
+        expectEqualSpaces(constructed, stored);
+
+        auto key = space::SpaceCache::constructKey(consistent_list);
+        auto mb_loaded = space::SpaceCache::load(key, factories);
+        ASSERT_TRUE(mb_loaded.has_value());
+        expectEqualSpaces(constructed, mb_loaded.value());
+    }
+    EXPECT_EQ(numberOfEntries(directory_), optimization_lists.size());
+}
+
+TEST_F(space_cache_tests, corrupted_entry_is_ignored) {
+    quantum::linear_algebra::FactoriesList factories;
+    space::SpaceCache::setDirectory(directory_);
+    runner::ConsistentModelOptimizationList consistent_list(model::ModelInput({3, 3, 3}), {});
+    auto key = space::SpaceCache::constructKey(consistent_list);
+    space::optimization::OptimizedSpaceConstructor::construct(consistent_list, factories);
+    ASSERT_TRUE(space::SpaceCache::load(key, factories).has_value());
+
+    for (const auto& entry : std::filesystem::directory_iterator(directory_)) {
+        std::filesystem::resize_file(entry.path(), std::filesystem::file_size(entry.path()) - 1);
+    }
+    EXPECT_FALSE(space::SpaceCache::load(key, factories).has_value());
+}
@@ -0,0 +1,112 @@
+#include <filesystem>
+#include <fstream>
+
+#include "gtest/gtest.h"
+#include "src/common/runner/Runner.h"
+#include "src/eigendecompositor/SpectrumCache.h"
+
+namespace {
+model::ModelInput constructModel(double J_value) {
+    model::ModelInput model({2, 3, 4});
+    auto J = model.addSymbol("J", J_value);
+    auto g = model.addSymbol("g", 2.0);
+    model.assignSymbolToIsotropicExchange(J, 0, 1)
+        .assignSymbolToIsotropicExchange(J, 1, 2)
+        .assignSymbolToGFactor(g, 0)
+        .assignSymbolToGFactor(g, 1)
+        .assignSymbolToGFactor(g, 2);
+    return model;
+}
+
+std::vector<double> calculateMuSquared(runner::Runner& runner) {
+    std::vector<double> values;
+    for (double temperature = 1; temperature < 301; temperature += 10) {
+        values.push_back(
+            runner.getMagneticSusceptibilityController().calculateTheoreticalMuSquared(temperature).mean());
+    }
+    return values;
+}
+
+size_t numberOfEntries(const std::filesystem::path& directory) {
+    size_t number = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        number += entry.path().extension() == ".spectra";
+    }
+    return number;
+}
+
+class spectrum_cache_tests : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path()
+            / ("spinner_spectrum_cache_tests_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()));
+        std::filesystem::remove_all(directory_);
+        eigendecompositor::SpectrumCache::setDirectory(directory_);
+    }
+    void TearDown() override {
+        eigendecompositor::SpectrumCache::disable();
+        std::filesystem::remove_all(directory_);
+    }
+    std::filesystem::path directory_;
+};
+}  // namespace
+
+TEST_F(spectrum_cache_tests, key_depends_on_values_of_symbols) {
+    runner::ConsistentModelOptimizationList first(constructModel(10), {});
+    runner::ConsistentModelOptimizationList same(constructModel(10), {});
+    runner::ConsistentModelOptimizationList other(constructModel(10 + 1e-12), {});
+    quantum::linear_algebra::FactoriesList factories;
+    auto key = eigendecompositor::SpectrumCache::constructKey(first, factories);
+    EXPECT_EQ(key, eigendecompositor::SpectrumCache::constructKey(same, factories));
+    EXPECT_NE(key, eigendecompositor::SpectrumCache::constructKey(other, factories));
+}
+
+TEST_F(spectrum_cache_tests, cached_spectra_are_equal_to_calculated) {
+    eigendecompositor::SpectrumCache::disable();
+    runner::Runner reference(constructModel(10));
+    auto reference_values = calculateMuSquared(reference);
+
+    eigendecompositor::SpectrumCache::setDirectory(directory_);
+    runner::Runner storing(constructModel(10));
+    EXPECT_EQ(calculateMuSquared(storing), reference_values);
+    EXPECT_EQ(numberOfEntries(directory_), 1);
+
+    runner::Runner loading(constructModel(10));
+    auto loaded_values = calculateMuSquared(loading);
+    ASSERT_EQ(loaded_values.size(), reference_values.size());
+    for (size_t i = 0; i < loaded_values.size(); ++i) {
+        EXPECT_EQ(loaded_values[i], reference_values[i]);
+    }
+    EXPECT_EQ(numberOfEntries(directory_), 1);
+    // spectra of blocks are not cached, so they are calculated on demand:
+    EXPECT_TRUE(loading.getSpectrum(common::Energy).has_value());
+
+    runner::Runner other(constructModel(20));
+    EXPECT_NE(calculateMuSquared(other), reference_values);
+    EXPECT_EQ(numberOfEntries(directory_), 2);
+}
+
+TEST_F(spectrum_cache_tests, corrupted_entry_is_ignored) {
+    runner::Runner storing(constructModel(10));
+    auto reference_values = calculateMuSquared(storing);
+    for (const auto& entry : std::filesystem::directory_iterator(directory_)) {
+        std::filesystem::resize_file(entry.path(), std::filesystem::file_size(entry.path()) / 2);
+    }
+
+    runner::Runner loading(constructModel(10));
+    EXPECT_EQ(calculateMuSquared(loading), reference_values);
+}
+
+TEST_F(spectrum_cache_tests, least_recently_used_entries_are_removed) {
+    runner::Runner first(constructModel(10));
+    calculateMuSquared(first);
+    auto size_of_entry = std::filesystem::file_size(std::filesystem::directory_iterator(directory_)->path());
+
+    // only one entry fits into the limit:
+    eigendecompositor::SpectrumCache::setSizeLimit(size_of_entry * 3 / 2);
+    runner::Runner second(constructModel(20));
+    calculateMuSquared(second);
+    EXPECT_EQ(numberOfEntries(directory_), 1);
+
+    EXPECT_THROW(eigendecompositor::SpectrumCache::setSizeLimit(0), std::invalid_argument);
+}
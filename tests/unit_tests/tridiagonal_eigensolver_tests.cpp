@@ -0,0 +1,86 @@
+#include <cmath>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "src/entities/data_structures/TridiagonalEigensolver.h"
+
+using quantum::linear_algebra::SymmetricTridiagonalMatrix;
+using quantum::linear_algebra::diagonalizeSymmetricTridiagonal;
+
+TEST(tridiagonal_eigensolver, toeplitz_analytical_eigenvalues_and_first_components) {
+    const double a = 1.5;
+    const double b = -0.7;
+    for (size_t size = 1; size <= 100; ++size) {
+        SymmetricTridiagonalMatrix matrix;
+        matrix.diagonal.assign(size, a);
+        matrix.subdiagonal.assign(size - 1, b);
+
+        std::vector<double> first_components;
+        auto eigenvalues = diagonalizeSymmetricTridiagonal(matrix, 1, first_components);
+        ASSERT_EQ(eigenvalues.size(), size);
+        ASSERT_EQ(first_components.size(), size);
+        // b < 0, so the eigenvalues a + 2b cos(k pi / (n+1)) are in ascending order,
+        // the first component of the k-th eigenvector is sqrt(2/(n+1)) sin(k pi / (n+1)):
+        for (size_t k = 1; k <= size; ++k) {
+            double angle = k * M_PI / (size + 1);
+            EXPECT_NEAR(eigenvalues[k - 1], a + 2 * b * std::cos(angle), 1e-12);
+            double first_component_squared = 2.0 / (size + 1) * std::sin(angle) * std::sin(angle);
+            EXPECT_NEAR(first_components[k - 1] * first_components[k - 1], first_component_squared, 1e-12);
+        }
+    }
+}
+
+TEST(tridiagonal_eigensolver, random_all_eigenvectors_and_first_components) {
+    std::random_device dev;
+    std::mt19937 rng(dev());
+    std::uniform_real_distribution<double> dist(-10, +10);
+
+    for (size_t size = 1; size <= 64; size *= 2) {
+        SymmetricTridiagonalMatrix matrix;
+        for (size_t i = 0; i < size; ++i) {
+            matrix.diagonal.push_back(dist(rng));
+        }
+        for (size_t i = 0; i + 1 < size; ++i) {
+            // some zeros split the matrix:
+            matrix.subdiagonal.push_back(i % 7 == 3 ? 0 : dist(rng));
+        }
+
+        std::vector<double> eigenvectors;
+        auto eigenvalues = diagonalizeSymmetricTridiagonal(matrix, size, eigenvectors);
+        std::vector<double> first_components;
+        auto eigenvalues_of_first_components = diagonalizeSymmetricTridiagonal(matrix, 1, first_components);
+        ASSERT_EQ(eigenvectors.size(), size * size);
+
+        for (size_t k = 0; k < size; ++k) {
+            if (k > 0) {
+                EXPECT_LE(eigenvalues[k - 1], eigenvalues[k]);
+            }
+            EXPECT_NEAR(eigenvalues[k], eigenvalues_of_first_components[k], 1e-10);
+            EXPECT_NEAR(std::abs(first_components[k]), std::abs(eigenvectors[k * size]), 1e-10);
+            // T v = \lambda v:
+            for (size_t i = 0; i < size; ++i) {
+                double residual = (matrix.diagonal[i] - eigenvalues[k]) * eigenvectors[i + k * size];
+                if (i > 0) {
+                    residual += matrix.subdiagonal[i - 1] * eigenvectors[i - 1 + k * size];
+                }
+                if (i + 1 < size) {
+                    residual += matrix.subdiagonal[i] * eigenvectors[i + 1 + k * size];
+                }
+                EXPECT_NEAR(residual, 0, 1e-10);
+            }
+            for (size_t l = k; l < size; ++l) {
+                double overlap = 0;
+                for (size_t i = 0; i < size; ++i) {
+                    overlap += eigenvectors[i + k * size] * eigenvectors[i + l * size];
+                }
+                EXPECT_NEAR(overlap, k == l ? 1 : 0, 1e-10);
+            }
+        }
+    }
+}
+
+TEST(tridiagonal_eigensolver, throw_on_inconsistent_sizes) {
+    std::vector<double> eigenvectors;
+    EXPECT_THROW(diagonalizeSymmetricTridiagonal({{1, 2, 3}, {1}}, 1, eigenvectors), std::length_error);
+    EXPECT_THROW(diagonalizeSymmetricTridiagonal({{1, 2}, {1}}, 3, eigenvectors), std::length_error);
+}
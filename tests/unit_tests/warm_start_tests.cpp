@@ -0,0 +1,72 @@
+#include "gtest/gtest.h"
+#include "src/common/runner/Runner.h"
+#include "src/eigendecompositor/ExactEigendecompositor.h"
+
+namespace {
+model::ModelInput construct_model(double J_one, double J_two, double D) {
+    model::ModelInput model({2, 3, 4, 3});
+    auto J_one_name = model.addSymbol("J1", J_one);
+    auto J_two_name = model.addSymbol("J2", J_two);
+    auto D_name = model.addSymbol("D", D, true, model::symbols::D);
+    model.assignSymbolToIsotropicExchange(J_one_name, 0, 1)
+        .assignSymbolToIsotropicExchange(J_two_name, 1, 2)
+        .assignSymbolToIsotropicExchange(J_one_name, 2, 3)
+        .assignSymbolToZFSNoAnisotropy(D_name, 1)
+        .assignSymbolToZFSNoAnisotropy(D_name, 2);
+    return model;
+}
+
+void build_spectra(
+    eigendecompositor::ExactEigendecompositor& eigendecompositor,
+    runner::Runner& runner) {
+    // S^2 is requested, so eigenvectors are required:
+    std::map<common::QuantityEnum, std::shared_ptr<const model::operators::Operator>> operators = {
+        {common::Energy, runner.getOperator(common::Energy).value()},
+        {common::S_total_squared, runner.getOperator(common::S_total_squared).value()}};
+    std::map<
+        std::pair<common::QuantityEnum, model::symbols::SymbolName>,
+        std::shared_ptr<const model::operators::Operator>>
+        derivatives_operators;
+    const auto& space = runner.getSpace();
+    eigendecompositor.initialize(operators, derivatives_operators, space.getBlocks().size());
+    for (size_t number_of_block = 0; number_of_block < space.getBlocks().size(); ++number_of_block) {
+        eigendecompositor.BuildSubspectra(number_of_block, space.getBlocks()[number_of_block]);
+    }
+    eigendecompositor.finalize();
+}
+}  // namespace
+
+TEST(warm_start, refined_spectrum_is_equal_to_exact_one) {
+    runner::Runner initial_runner(construct_model(10, -5, 2));
+    runner::Runner final_runner(construct_model(10.5, -4.8, 2.1));
+
+    eigendecompositor::ExactEigendecompositor exact_eigendecompositor(
+        initial_runner.getIndexConverter(),
+        initial_runner.getDataStructuresFactories());
+    common::physical_optimization::OptimizationList::WarmStartSettings settings;
+    settings.tolerance = 1e-10;
+    settings.max_iterations = 10;
+    eigendecompositor::ExactEigendecompositor warm_started_eigendecompositor(
+        initial_runner.getIndexConverter(),
+        initial_runner.getDataStructuresFactories(),
+        std::nullopt,
+        std::nullopt,
+        settings);
+
+    build_spectra(warm_started_eigendecompositor, initial_runner);
+    // the second iteration starts from eigenvectors of the first one:
+    build_spectra(warm_started_eigendecompositor, final_runner);
+    build_spectra(exact_eigendecompositor, final_runner);
+
+    const auto& space = final_runner.getSpace();
+    for (size_t number_of_block = 0; number_of_block < space.getBlocks().size(); ++number_of_block) {
+        const auto& exact = getOneRef(
+            exact_eigendecompositor.getSubspectrum(common::Energy, number_of_block).value()).get();
+        const auto& refined = getOneRef(
+            warm_started_eigendecompositor.getSubspectrum(common::Energy, number_of_block).value()).get();
+        ASSERT_EQ(exact.raw_data->size(), refined.raw_data->size());
+        for (uint32_t i = 0; i < exact.raw_data->size(); ++i) {
+            EXPECT_NEAR(exact.raw_data->at(i), refined.raw_data->at(i), 1e-8);
+        }
+    }
+}